@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/Assertions.h>
+#include <AK/Noncopyable.h>
+#include <AK/StdLibExtras.h>
+#include <AK/StringView.h>
+#include <AK/Types.h>
+#include <AK/kmalloc.h>
+
+namespace AK {
+
+// A bump allocator for data that lives and dies together, like the nodes of a
+// parse tree or the scratch data of a single request. Allocations are carved
+// out of large chunks and given back all at once by clear() or ~Arena().
+//
+// Objects created with make<T>() are destroyed (in reverse order of creation)
+// when the arena is cleared. Memory from allocate() is simply forgotten.
+//
+// Retained allocations are for objects that manage their own lifetime, e.g.
+// ref-counted ones: each keeps its chunk alive until release_retained() is
+// called on it, so they may safely outlive the arena that created them.
+//
+// An Arena is not thread-safe.
+class Arena {
+    AK_MAKE_NONCOPYABLE(Arena);
+    AK_MAKE_NONMOVABLE(Arena);
+
+public:
+    static constexpr size_t default_alignment = 2 * sizeof(void*);
+    static constexpr size_t default_chunk_size = 4 * KB;
+    static constexpr size_t max_chunk_size = 64 * KB;
+
+    explicit Arena(size_t initial_chunk_size = default_chunk_size)
+        : m_next_chunk_size(initial_chunk_size)
+    {
+        ASSERT(initial_chunk_size);
+    }
+
+    ~Arena() { clear(); }
+
+    void* allocate(size_t size, size_t alignment = default_alignment)
+    {
+        Chunk* chunk;
+        return allocate(size, alignment, 0, chunk);
+    }
+
+    template<typename T, typename... Args>
+    T& make(Args&&... args)
+    {
+        if constexpr (__has_trivial_destructor(T)) {
+            return *new (allocate(sizeof(T), alignof(T))) T(forward<Args>(args)...);
+        } else {
+            auto* destructor = static_cast<Destructor*>(allocate(sizeof(Destructor), alignof(Destructor)));
+            auto* object = new (allocate(sizeof(T), alignof(T))) T(forward<Args>(args)...);
+            destructor->destroy = [](void* object) { static_cast<T*>(object)->~T(); };
+            destructor->object = object;
+            destructor->next = m_destructors;
+            m_destructors = destructor;
+            return *object;
+        }
+    }
+
+    StringView copy(const StringView& string)
+    {
+        if (string.is_empty())
+            return string.is_null() ? StringView() : StringView("");
+        auto* characters = static_cast<char*>(allocate(string.length(), 1));
+        __builtin_memcpy(characters, string.characters_without_null_termination(), string.length());
+        return { characters, string.length() };
+    }
+
+    void* allocate_retained(size_t size)
+    {
+        Chunk* chunk;
+        auto* ptr = allocate(size, default_alignment, sizeof(Chunk*), chunk);
+        reinterpret_cast<Chunk**>(ptr)[-1] = chunk;
+        ++chunk->retained_count;
+        return ptr;
+    }
+
+    // For objects that are normally retained from an arena, but sometimes have to
+    // be created without one at hand. Release these with release_retained() too.
+    static void* allocate_retained_without_arena(size_t size)
+    {
+        auto* ptr = static_cast<u8*>(kmalloc(default_alignment + size)) + default_alignment;
+        reinterpret_cast<Chunk**>(ptr)[-1] = nullptr;
+        return ptr;
+    }
+
+    static void release_retained(void* ptr)
+    {
+        if (!ptr)
+            return;
+        auto* chunk = reinterpret_cast<Chunk**>(ptr)[-1];
+        if (!chunk) {
+            kfree(static_cast<u8*>(ptr) - default_alignment);
+            return;
+        }
+        ASSERT(chunk->retained_count);
+        if (--chunk->retained_count == 0 && chunk->orphaned)
+            kfree(chunk);
+    }
+
+    void clear()
+    {
+        for (auto* destructor = m_destructors; destructor; destructor = destructor->next)
+            destructor->destroy(destructor->object);
+        m_destructors = nullptr;
+
+        for (auto* chunk = m_chunks; chunk;) {
+            auto* next = chunk->next;
+            if (chunk->retained_count)
+                chunk->orphaned = true;
+            else
+                kfree(chunk);
+            chunk = next;
+        }
+        m_chunks = nullptr;
+        m_current_chunk = nullptr;
+        m_chunk_count = 0;
+    }
+
+    size_t chunk_count() const { return m_chunk_count; }
+
+private:
+    struct Chunk {
+        Chunk* next;
+        size_t capacity;
+        size_t used;
+        size_t retained_count;
+        bool orphaned;
+
+        FlatPtr data() const { return reinterpret_cast<FlatPtr>(this + 1); }
+
+        void* try_allocate(size_t size, size_t alignment, size_t prefix)
+        {
+            FlatPtr start = (data() + used + prefix + alignment - 1) & ~(FlatPtr)(alignment - 1);
+            FlatPtr end = data() + capacity;
+            if (start > end || size > end - start)
+                return nullptr;
+            used = start + size - data();
+            return reinterpret_cast<void*>(start);
+        }
+    };
+
+    struct Destructor {
+        void (*destroy)(void*);
+        void* object;
+        Destructor* next;
+    };
+
+    void* allocate(size_t size, size_t alignment, size_t prefix, Chunk*& chunk)
+    {
+        ASSERT(alignment && !(alignment & (alignment - 1)));
+        if (m_current_chunk) {
+            if (auto* ptr = m_current_chunk->try_allocate(size, alignment, prefix)) {
+                chunk = m_current_chunk;
+                return ptr;
+            }
+        }
+        return allocate_in_new_chunk(size, alignment, prefix, chunk);
+    }
+
+    void* allocate_in_new_chunk(size_t size, size_t alignment, size_t prefix, Chunk*& chunk)
+    {
+        size_t needed = prefix + alignment - 1 + size;
+        bool oversized = needed > m_next_chunk_size / 2;
+        size_t capacity = oversized ? needed : m_next_chunk_size;
+
+        chunk = static_cast<Chunk*>(kmalloc(sizeof(Chunk) + capacity));
+        chunk->next = m_chunks;
+        chunk->capacity = capacity;
+        chunk->used = 0;
+        chunk->retained_count = 0;
+        chunk->orphaned = false;
+        m_chunks = chunk;
+        ++m_chunk_count;
+
+        // Big allocations get a chunk of their own, so the current chunk can keep filling up.
+        if (!oversized || !m_current_chunk) {
+            m_current_chunk = chunk;
+            if (m_next_chunk_size < max_chunk_size)
+                m_next_chunk_size = min(m_next_chunk_size * 2, max_chunk_size);
+        }
+
+        auto* ptr = chunk->try_allocate(size, alignment, prefix);
+        ASSERT(ptr);
+        return ptr;
+    }
+
+    Chunk* m_chunks { nullptr };
+    Chunk* m_current_chunk { nullptr };
+    Destructor* m_destructors { nullptr };
+    size_t m_next_chunk_size { default_chunk_size };
+    size_t m_chunk_count { 0 };
+};
+
+}
+
+using AK::Arena;
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/StringView.h>
+#include <AK/Types.h>
+
+namespace AK {
+
+// Conversions between doubles and their decimal representations.
+//
+// decimal_to_double() is correctly rounded: it tries the Eisel-Lemire
+// algorithm first, which settles almost every input with a couple of
+// 64-bit multiplications, and only falls back to exact decimal arithmetic
+// (ExactDecimal below) for the rare ambiguous cases.
+//
+// shortest_decimal() implements Schubfach, which finds the shortest decimal
+// that converts back to the same double without any big number arithmetic.
+
+// Returns the double nearest to significand * 10^exponent, rounding ties to
+// even. The significand is a run of decimal digits with at most one '.'.
+double decimal_to_double(const StringView& significand, int exponent = 0, bool negative = false);
+
+struct ShortestDecimal {
+    u64 significand { 0 };
+    i32 exponent { 0 };
+};
+
+// The shortest significand * 10^exponent that converts back to `value`.
+// The significand has no trailing zeros. `value` must be finite and > 0.
+ShortestDecimal shortest_decimal(double value);
+
+// Enough for "-1.2345678901234567e-308" and "-0.000001234567890123456".
+static constexpr size_t max_shortest_double_length = 26;
+
+// Writes the shortest representation of `value` that converts back to the
+// same double, in the style of ECMAScript's Number::toString (e.g. "0.1",
+// "123", "1e+21", "5e-7", "NaN", "-Infinity"), and returns its length.
+// The buffer must hold max_shortest_double_length characters and is not
+// null-terminated.
+size_t format_shortest(double value, char* buffer);
+
+// The exact decimal expansion of a double: 0.d[0]d[1]... * 10^decimal_point.
+// Used when a specific number of digits is asked for (printf's %f, %e and %g),
+// as rounding the shortest representation instead would round twice.
+class ExactDecimal {
+public:
+    ExactDecimal() { }
+    // Expands |value|, which must be finite.
+    explicit ExactDecimal(double value);
+
+    // Rounds to `count` significant digits, ties to even. Rounding at or
+    // above the first digit is a no-op, and may change decimal_point().
+    void round(int count);
+
+    bool is_zero() const { return m_digit_count == 0; }
+    int digit_count() const { return m_digit_count; }
+    int decimal_point() const { return m_decimal_point; }
+    char digit(int index) const { return (index >= 0 && index < m_digit_count) ? m_digits[index] : '0'; }
+
+private:
+    friend double decimal_to_double(const StringView&, int, bool);
+
+    void assign(u64);
+    void assign(const StringView& significand, int exponent);
+    void shift(int);
+    void left_shift(unsigned);
+    void right_shift(unsigned);
+    void trim();
+    bool should_round_up(int count) const;
+    u64 rounded_integer() const;
+    u64 to_double_bits();
+
+    // Enough for the exact expansion of any double, the longest of which
+    // (just below the smallest normal) has 767 significant digits.
+    static constexpr int max_digits = 800;
+
+    char m_digits[max_digits];
+    int m_digit_count { 0 };
+    int m_decimal_point { 0 };
+    // Whether nonzero digits were cut off beyond max_digits.
+    bool m_truncated { false };
+};
+
+}
+
+using AK::decimal_to_double;
+using AK::ExactDecimal;
+using AK::format_shortest;
+using AK::max_shortest_double_length;
+using AK::shortest_decimal;
+using AK::ShortestDecimal;
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/Format.h>
+#include <AK/LogStream.h>
+#include <AK/StringBuilder.h>
+
+#ifndef KERNEL
+#    include <AK/DoubleConversion.h>
+#    include <AK/PrintfImplementation.h>
+#endif
+
+namespace AK {
+
+void FormatBuilder::append_repeated(char ch, size_t count)
+{
+    char chunk[32];
+    __builtin_memset(chunk, ch, min(count, sizeof(chunk)));
+    while (count) {
+        size_t length = min(count, sizeof(chunk));
+        append(chunk, length);
+        count -= length;
+    }
+}
+
+static bool is_digit(char ch)
+{
+    return ch >= '0' && ch <= '9';
+}
+
+static size_t parse_decimal(const char* characters, size_t length, size_t& index)
+{
+    size_t value = 0;
+    while (index < length && is_digit(characters[index]))
+        value = value * 10 + (characters[index++] - '0');
+    return value;
+}
+
+static bool parse_align(char ch, FormatSpecifier::Align& align)
+{
+    switch (ch) {
+    case '<':
+        align = FormatSpecifier::Align::Left;
+        return true;
+    case '^':
+        align = FormatSpecifier::Align::Center;
+        return true;
+    case '>':
+        align = FormatSpecifier::Align::Right;
+        return true;
+    default:
+        return false;
+    }
+}
+
+static void parse_specifier(const char* characters, size_t length, size_t& index, FormatSpecifier& specifier)
+{
+    if (index + 1 < length && parse_align(characters[index + 1], specifier.align)) {
+        specifier.fill = characters[index];
+        index += 2;
+    } else if (index < length && parse_align(characters[index], specifier.align)) {
+        ++index;
+    }
+
+    if (index < length) {
+        if (characters[index] == '+') {
+            specifier.sign = FormatSpecifier::Sign::Always;
+            ++index;
+        } else if (characters[index] == ' ') {
+            specifier.sign = FormatSpecifier::Sign::Space;
+            ++index;
+        } else if (characters[index] == '-') {
+            ++index;
+        }
+    }
+
+    if (index < length && characters[index] == '#') {
+        specifier.alternate_form = true;
+        ++index;
+    }
+
+    if (index < length && characters[index] == '0') {
+        specifier.zero_pad = true;
+        ++index;
+    }
+
+    specifier.width = parse_decimal(characters, length, index);
+
+    if (index < length && characters[index] == '.') {
+        ++index;
+        specifier.precision = parse_decimal(characters, length, index);
+    }
+
+    if (index < length && characters[index] != '}')
+        specifier.type = characters[index++];
+}
+
+void vformat(FormatBuilder& builder, const StringView& fmtstr, const TypeErasedFormatParams& params)
+{
+    auto* characters = fmtstr.characters_without_null_termination();
+    size_t length = fmtstr.length();
+    size_t next_parameter = 0;
+    size_t literal_start = 0;
+    size_t index = 0;
+
+    while (index < length) {
+        char ch = characters[index];
+        if (ch != '{' && ch != '}') {
+            ++index;
+            continue;
+        }
+
+        builder.append(characters + literal_start, index - literal_start);
+
+        if (index + 1 < length && characters[index + 1] == ch) {
+            builder.append(ch);
+            index += 2;
+            literal_start = index;
+            continue;
+        }
+
+        // A '}' must either close a placeholder or be doubled.
+        ASSERT(ch == '{');
+        ++index;
+
+        size_t parameter_index;
+        if (index < length && is_digit(characters[index]))
+            parameter_index = parse_decimal(characters, length, index);
+        else
+            parameter_index = next_parameter++;
+
+        FormatSpecifier specifier;
+        if (index < length && characters[index] == ':')
+            parse_specifier(characters, length, ++index, specifier);
+
+        ASSERT(index < length && characters[index] == '}');
+        ++index;
+        literal_start = index;
+
+        ASSERT(parameter_index < params.size());
+        auto& parameter = params.parameters()[parameter_index];
+        parameter.format(builder, parameter.value, specifier);
+    }
+
+    builder.append(characters + literal_start, length - literal_start);
+}
+
+void vformat(StringBuilder& builder, const StringView& fmtstr, const TypeErasedFormatParams& params)
+{
+    FormatBuilderFor<StringBuilder> format_builder(builder);
+    vformat(format_builder, fmtstr, params);
+}
+
+// Formats straight into the stream's fixed buffer, so logging never allocates.
+class LogStreamFormatBuilder final : public FormatBuilder {
+public:
+    explicit LogStreamFormatBuilder(const LogStream& stream)
+        : m_stream(stream)
+    {
+    }
+
+    using FormatBuilder::append;
+    virtual void append(const char* characters, size_t length) override { m_stream.write(characters, length); }
+
+private:
+    const LogStream& m_stream;
+};
+
+void vdbgln(const StringView& fmtstr, const TypeErasedFormatParams& params)
+{
+    auto stream = dbg();
+    LogStreamFormatBuilder builder(stream);
+    vformat(builder, fmtstr, params);
+}
+
+// Writes the prefix (sign and radix prefix) and body, padded out to the requested width.
+static void append_padded(FormatBuilder& builder, const StringView& prefix, const StringView& body, const FormatSpecifier& specifier, FormatSpecifier::Align default_align)
+{
+    size_t length = prefix.length() + body.length();
+    if (specifier.width <= length) {
+        builder.append(prefix);
+        builder.append(body);
+        return;
+    }
+
+    size_t padding = specifier.width - length;
+    if (specifier.zero_pad && specifier.align == FormatSpecifier::Align::Default) {
+        builder.append(prefix);
+        builder.append_repeated('0', padding);
+        builder.append(body);
+        return;
+    }
+
+    auto align = specifier.align == FormatSpecifier::Align::Default ? default_align : specifier.align;
+    size_t padding_before = 0;
+    if (align == FormatSpecifier::Align::Right)
+        padding_before = padding;
+    else if (align == FormatSpecifier::Align::Center)
+        padding_before = padding / 2;
+
+    builder.append_repeated(specifier.fill, padding_before);
+    builder.append(prefix);
+    builder.append(body);
+    builder.append_repeated(specifier.fill, padding - padding_before);
+}
+
+void format_string(FormatBuilder& builder, const StringView& string, const FormatSpecifier& specifier)
+{
+    auto view = string;
+    if (specifier.precision >= 0 && static_cast<size_t>(specifier.precision) < view.length())
+        view = view.substring_view(0, specifier.precision);
+    append_padded(builder, {}, view, specifier, FormatSpecifier::Align::Left);
+}
+
+void format_integer(FormatBuilder& builder, u64 value, bool is_negative, const FormatSpecifier& specifier)
+{
+    if (specifier.type == 'c') {
+        char ch = value;
+        return format_string(builder, { &ch, 1 }, specifier);
+    }
+
+    unsigned base = 10;
+    const char* digits = "0123456789abcdef";
+    const char* radix_prefix = "";
+    switch (specifier.type) {
+    case 'x':
+        base = 16;
+        radix_prefix = "0x";
+        break;
+    case 'X':
+        base = 16;
+        digits = "0123456789ABCDEF";
+        radix_prefix = "0X";
+        break;
+    case 'o':
+        base = 8;
+        radix_prefix = "0";
+        break;
+    case 'b':
+        base = 2;
+        radix_prefix = "0b";
+        break;
+    default:
+        break;
+    }
+
+    char buffer[64];
+    size_t start = sizeof(buffer);
+    if (base == 10) {
+        do {
+            buffer[--start] = '0' + value % 10;
+            value /= 10;
+        } while (value);
+    } else {
+        do {
+            buffer[--start] = digits[value % base];
+            value /= base;
+        } while (value);
+    }
+
+    char prefix[4];
+    size_t prefix_length = 0;
+    if (is_negative)
+        prefix[prefix_length++] = '-';
+    else if (specifier.sign == FormatSpecifier::Sign::Always)
+        prefix[prefix_length++] = '+';
+    else if (specifier.sign == FormatSpecifier::Sign::Space)
+        prefix[prefix_length++] = ' ';
+    if (specifier.alternate_form) {
+        for (auto* p = radix_prefix; *p; ++p)
+            prefix[prefix_length++] = *p;
+    }
+
+    append_padded(builder, { prefix, prefix_length }, { buffer + start, sizeof(buffer) - start }, specifier, FormatSpecifier::Align::Right);
+}
+
+#ifndef KERNEL
+void format_double(FormatBuilder& builder, double value, const FormatSpecifier& specifier)
+{
+    StringBuilder formatted;
+    if (!specifier.type && specifier.precision < 0 && value - value == 0) {
+        // The shortest representation that reads back as the same double.
+        char buffer[max_shortest_double_length];
+        formatted.append(buffer, format_shortest(value, buffer));
+    } else {
+        char type = specifier.type ? specifier.type : 'f';
+        u32 precision = specifier.precision < 0 ? 6 : specifier.precision;
+        char* bufptr = nullptr;
+        print_double([&](char*&, char ch) { formatted.append(ch); }, bufptr, value, false, false, false, specifier.alternate_form, 0, precision, type);
+    }
+
+    auto body = formatted.string_view();
+    char prefix = 0;
+    if (body.starts_with('-')) {
+        prefix = '-';
+        body = body.substring_view(1, body.length() - 1);
+    } else if (value == value) {
+        if (specifier.sign == FormatSpecifier::Sign::Always)
+            prefix = '+';
+        else if (specifier.sign == FormatSpecifier::Sign::Space)
+            prefix = ' ';
+    }
+
+    // Don't zero-pad things like "inf".
+    auto padding_specifier = specifier;
+    if (body.is_empty() || !is_digit(body[0]))
+        padding_specifier.zero_pad = false;
+
+    append_padded(builder, prefix ? StringView(&prefix, 1) : StringView(), body, padding_specifier, FormatSpecifier::Align::Right);
+}
+#endif
+
+}
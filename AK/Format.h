@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/Forward.h>
+#include <AK/StdLibExtras.h>
+#include <AK/StringView.h>
+#include <AK/Types.h>
+
+namespace AK {
+
+// A type-safe replacement for printf-style formatting.
+//
+// Placeholders look like "{}", "{1}" or "{:spec}", where spec is
+// [[fill]align][sign][#][0][width][.precision][type], a subset of the syntax
+// used by Python and fmtlib. "{{" and "}}" produce literal braces.
+//
+// Each argument is written by Formatter<T>, which can be specialized to teach
+// the formatter about new types. Passing a type without a Formatter is a
+// compile-time error. When building as C++20, so is a literal format string
+// with a stray brace or a placeholder for a parameter that wasn't passed.
+
+struct FormatSpecifier {
+    enum class Align : u8 {
+        Default,
+        Left,
+        Center,
+        Right,
+    };
+
+    enum class Sign : u8 {
+        OnlyIfNeeded,
+        Always,
+        Space,
+    };
+
+    char fill { ' ' };
+    Align align { Align::Default };
+    Sign sign { Sign::OnlyIfNeeded };
+    bool alternate_form { false };
+    bool zero_pad { false };
+    size_t width { 0 };
+    int precision { -1 };
+    char type { 0 };
+};
+
+// Where formatted output goes. Wrap any builder that has append(const char*, size_t)
+// in a FormatBuilderFor to format straight into it.
+class FormatBuilder {
+public:
+    virtual void append(const char*, size_t) = 0;
+
+    void append(const StringView& string) { append(string.characters_without_null_termination(), string.length()); }
+    void append(char ch) { append(&ch, 1); }
+    void append_repeated(char, size_t count);
+
+protected:
+    ~FormatBuilder() { }
+};
+
+template<typename BuilderType>
+class FormatBuilderFor final : public FormatBuilder {
+public:
+    explicit FormatBuilderFor(BuilderType& builder)
+        : m_builder(builder)
+    {
+    }
+
+    using FormatBuilder::append;
+    virtual void append(const char* characters, size_t length) override { m_builder.append(characters, length); }
+
+private:
+    BuilderType& m_builder;
+};
+
+struct TypeErasedParameter {
+    const void* value;
+    void (*format)(FormatBuilder&, const void* value, const FormatSpecifier&);
+};
+
+class TypeErasedFormatParams {
+public:
+    const TypeErasedParameter* parameters() const { return m_parameters; }
+    size_t size() const { return m_size; }
+
+protected:
+    TypeErasedFormatParams(const TypeErasedParameter* parameters, size_t size)
+        : m_parameters(parameters)
+        , m_size(size)
+    {
+    }
+
+private:
+    const TypeErasedParameter* m_parameters;
+    size_t m_size;
+};
+
+void vformat(FormatBuilder&, const StringView& fmtstr, const TypeErasedFormatParams&);
+void vformat(StringBuilder&, const StringView& fmtstr, const TypeErasedFormatParams&);
+void vdbgln(const StringView& fmtstr, const TypeErasedFormatParams&);
+
+void format_string(FormatBuilder&, const StringView&, const FormatSpecifier&);
+void format_integer(FormatBuilder&, u64 absolute_value, bool is_negative, const FormatSpecifier&);
+#ifndef KERNEL
+void format_double(FormatBuilder&, double, const FormatSpecifier&);
+#endif
+
+template<typename T, typename = void>
+struct Formatter;
+
+template<>
+struct Formatter<StringView> {
+    static void format(FormatBuilder& builder, const StringView& value, const FormatSpecifier& specifier)
+    {
+        format_string(builder, value, specifier);
+    }
+};
+
+template<>
+struct Formatter<const char*> : Formatter<StringView> {
+};
+
+template<>
+struct Formatter<char*> : Formatter<StringView> {
+};
+
+template<size_t Size>
+struct Formatter<char[Size]> : Formatter<StringView> {
+};
+
+template<>
+struct Formatter<String> : Formatter<StringView> {
+};
+
+template<>
+struct Formatter<FlyString> : Formatter<StringView> {
+};
+
+template<typename T>
+struct IntegerFormatter {
+    static void format(FormatBuilder& builder, T value, const FormatSpecifier& specifier)
+    {
+        if constexpr (static_cast<T>(-1) < 0) {
+            if (value < 0)
+                return format_integer(builder, 0 - static_cast<u64>(value), true, specifier);
+        }
+        format_integer(builder, static_cast<u64>(value), false, specifier);
+    }
+};
+
+template<>
+struct Formatter<signed char> : IntegerFormatter<signed char> {
+};
+template<>
+struct Formatter<unsigned char> : IntegerFormatter<unsigned char> {
+};
+template<>
+struct Formatter<short> : IntegerFormatter<short> {
+};
+template<>
+struct Formatter<unsigned short> : IntegerFormatter<unsigned short> {
+};
+template<>
+struct Formatter<int> : IntegerFormatter<int> {
+};
+template<>
+struct Formatter<unsigned> : IntegerFormatter<unsigned> {
+};
+template<>
+struct Formatter<long> : IntegerFormatter<long> {
+};
+template<>
+struct Formatter<unsigned long> : IntegerFormatter<unsigned long> {
+};
+template<>
+struct Formatter<long long> : IntegerFormatter<long long> {
+};
+template<>
+struct Formatter<unsigned long long> : IntegerFormatter<unsigned long long> {
+};
+
+template<>
+struct Formatter<char> {
+    static void format(FormatBuilder& builder, char value, const FormatSpecifier& specifier)
+    {
+        if (specifier.type && specifier.type != 'c')
+            return Formatter<unsigned char>::format(builder, value, specifier);
+        format_string(builder, { &value, 1 }, specifier);
+    }
+};
+
+template<>
+struct Formatter<bool> {
+    static void format(FormatBuilder& builder, bool value, const FormatSpecifier& specifier)
+    {
+        if (specifier.type)
+            return format_integer(builder, value, false, specifier);
+        format_string(builder, value ? "true" : "false", specifier);
+    }
+};
+
+template<typename T>
+struct Formatter<T*> {
+    static void format(FormatBuilder& builder, const T* value, const FormatSpecifier& specifier)
+    {
+        FormatSpecifier pointer_specifier = specifier;
+        if (!pointer_specifier.type || pointer_specifier.type == 'p') {
+            pointer_specifier.type = 'x';
+            pointer_specifier.alternate_form = true;
+            pointer_specifier.zero_pad = true;
+            pointer_specifier.width = 2 + 2 * sizeof(void*);
+        }
+        format_integer(builder, reinterpret_cast<FlatPtr>(value), false, pointer_specifier);
+    }
+};
+
+#ifndef KERNEL
+template<>
+struct Formatter<double> {
+    static void format(FormatBuilder& builder, double value, const FormatSpecifier& specifier)
+    {
+        format_double(builder, value, specifier);
+    }
+};
+
+template<>
+struct Formatter<float> : Formatter<double> {
+};
+#endif
+
+template<typename T>
+void __format_erased(FormatBuilder& builder, const void* value, const FormatSpecifier& specifier)
+{
+    Formatter<T>::format(builder, *static_cast<const T*>(value), specifier);
+}
+
+template<typename... Parameters>
+class VariadicFormatParams : public TypeErasedFormatParams {
+public:
+    explicit VariadicFormatParams(const Parameters&... parameters)
+        : TypeErasedFormatParams(m_data, sizeof...(Parameters))
+        , m_data { { &parameters, __format_erased<Parameters> }..., { nullptr, nullptr } }
+    {
+    }
+
+private:
+    TypeErasedParameter m_data[sizeof...(Parameters) + 1];
+};
+
+#if __cplusplus > 201703L
+// Deliberately not constexpr: reaching a call to this while checking a format string at compile
+// time makes the compiler report it, along with the reason and the offending format string.
+void __invalid_format_string(const char* reason);
+
+// Follows the parsing in vformat(), where each of these mistakes is an assertion failure.
+consteval void __check_format_string(const char* characters, size_t parameter_count)
+{
+    size_t next_parameter = 0;
+    for (size_t index = 0; characters[index]; ++index) {
+        char ch = characters[index];
+        if (ch != '{' && ch != '}')
+            continue;
+        if (characters[index + 1] == ch) {
+            ++index;
+            continue;
+        }
+        if (ch == '}')
+            __invalid_format_string("'}' must either close a placeholder or be doubled");
+
+        ++index;
+        size_t parameter_index = 0;
+        if (characters[index] >= '0' && characters[index] <= '9') {
+            while (characters[index] >= '0' && characters[index] <= '9')
+                parameter_index = parameter_index * 10 + (characters[index++] - '0');
+        } else {
+            parameter_index = next_parameter++;
+        }
+        if (characters[index] == ':') {
+            // The fill character may be a brace, so skip it along with the alignment.
+            char align = characters[index + 1] ? characters[index + 2] : 0;
+            if (align == '<' || align == '^' || align == '>')
+                index += 2;
+            while (characters[index] && characters[index] != '}')
+                ++index;
+        }
+        if (characters[index] != '}')
+            __invalid_format_string("Unterminated placeholder");
+        if (parameter_index >= parameter_count)
+            __invalid_format_string("Placeholder refers to a parameter that wasn't passed");
+    }
+}
+
+template<typename... Parameters>
+class CheckedFormatString {
+public:
+    template<size_t Size>
+    consteval CheckedFormatString(const char (&fmtstr)[Size])
+        : m_string(fmtstr)
+    {
+        __check_format_string(fmtstr, sizeof...(Parameters));
+    }
+
+    // Format strings that aren't literals can only be checked at runtime.
+    template<typename T>
+    CheckedFormatString(const T& fmtstr)
+        : m_string(fmtstr)
+    {
+    }
+
+    operator StringView() const { return m_string; }
+
+private:
+    StringView m_string;
+};
+
+// The parameters are only deduced from the arguments that follow the format string.
+template<typename... Parameters>
+using FormatString = CheckedFormatString<typename IdentityType<Parameters>::Type...>;
+#else
+template<typename... Parameters>
+using FormatString = StringView;
+#endif
+
+// Writes one formatted line to the debug log.
+template<typename... Parameters>
+void dbgln(FormatString<Parameters...> fmtstr, const Parameters&... parameters)
+{
+    vdbgln(fmtstr, VariadicFormatParams { parameters... });
+}
+
+}
+
+using AK::dbgln;
+using AK::FormatBuilder;
+using AK::FormatBuilderFor;
+using AK::FormatSpecifier;
+using AK::FormatString;
+using AK::Formatter;
+using AK::TypeErasedFormatParams;
+using AK::VariadicFormatParams;
@@ -27,31 +27,23 @@
 #pragma once
 
 #include <AK/Assertions.h>
-#include <AK/SinglyLinkedList.h>
 #include <AK/StdLibExtras.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Traits.h>
+#include <AK/kmalloc.h>
 
 namespace AK {
 
 template<typename T, typename>
 class HashTable;
 
-template<typename HashTableType, typename ElementType, typename BucketIteratorType>
+template<typename HashTableType, typename ElementType, typename BucketType>
 class HashTableIterator {
 public:
-    bool operator!=(const HashTableIterator& other) const
-    {
-        if (m_is_end && other.m_is_end)
-            return false;
-        return &m_table != &other.m_table
-            || m_is_end != other.m_is_end
-            || m_bucket_index != other.m_bucket_index
-            || m_bucket_iterator != other.m_bucket_iterator;
-    }
-    bool operator==(const HashTableIterator& other) const { return !(*this != other); }
-    ElementType& operator*() { return *m_bucket_iterator; }
-    ElementType* operator->() { return m_bucket_iterator.operator->(); }
+    bool operator!=(const HashTableIterator& other) const { return m_bucket != other.m_bucket; }
+    bool operator==(const HashTableIterator& other) const { return m_bucket == other.m_bucket; }
+    ElementType& operator*() { return *m_bucket->slot(); }
+    ElementType* operator->() { return m_bucket->slot(); }
     HashTableIterator& operator++()
     {
         skip_to_next();
@@ -60,18 +52,9 @@ public:
 
     void skip_to_next()
     {
-        while (!m_is_end) {
-            if (m_bucket_iterator.is_end()) {
-                ++m_bucket_index;
-                if (m_bucket_index >= m_table.capacity()) {
-                    m_is_end = true;
-                    return;
-                }
-                m_bucket_iterator = m_table.bucket(m_bucket_index).begin();
-            } else {
-                ++m_bucket_iterator;
-            }
-            if (!m_bucket_iterator.is_end())
+        while (m_bucket != m_end) {
+            ++m_bucket;
+            if (m_bucket == m_end || m_bucket->is_used())
                 return;
         }
     }
@@ -79,31 +62,46 @@ public:
 private:
     friend HashTableType;
 
-    explicit HashTableIterator(HashTableType& table, bool is_end, BucketIteratorType bucket_iterator = {}, size_t bucket_index = 0)
-        : m_table(table)
-        , m_bucket_index(bucket_index)
-        , m_is_end(is_end)
-        , m_bucket_iterator(bucket_iterator)
+    explicit HashTableIterator(HashTableType& table, BucketType* bucket)
+        : m_bucket(bucket)
+        , m_end(table.m_buckets + table.m_capacity)
     {
         ASSERT(!table.m_clearing);
         ASSERT(!table.m_rehashing);
-        if (!is_end && !m_table.is_empty() && m_bucket_iterator.is_end()) {
-            m_bucket_iterator = m_table.bucket(0).begin();
-            if (m_bucket_iterator.is_end())
-                skip_to_next();
-        }
+        if (m_bucket != m_end && !m_bucket->is_used())
+            skip_to_next();
     }
 
-    HashTableType& m_table;
-    size_t m_bucket_index { 0 };
-    bool m_is_end { false };
-    BucketIteratorType m_bucket_iterator;
+    BucketType* m_bucket { nullptr };
+    BucketType* m_end { nullptr };
 };
 
+// An open-addressing hash table. All elements live inline in a single
+// power-of-two sized array of buckets, and collisions are resolved by
+// linear probing. Removed elements leave a tombstone behind so that probe
+// sequences passing through them stay intact; tombstones are dropped again
+// whenever the table is rehashed.
 template<typename T, typename TraitsForT>
 class HashTable {
 private:
-    using Bucket = SinglyLinkedList<T>;
+    enum class BucketState : u8 {
+        Free = 0,
+        Used,
+        Deleted,
+    };
+
+    struct Bucket {
+        BucketState state { BucketState::Free };
+        alignas(T) u8 storage[sizeof(T)];
+
+        bool is_used() const { return state == BucketState::Used; }
+        T* slot() { return reinterpret_cast<T*>(storage); }
+        const T* slot() const { return reinterpret_cast<const T*>(storage); }
+    };
+
+    // Keep the load factor (live elements plus tombstones) at or below 3/4.
+    static constexpr size_t min_capacity = 8;
+    static constexpr bool exceeds_load_factor(size_t used, size_t capacity) { return used * 4 > capacity * 3; }
 
 public:
     HashTable() {}
@@ -127,9 +125,11 @@ public:
         : m_buckets(other.m_buckets)
         , m_size(other.m_size)
         , m_capacity(other.m_capacity)
+        , m_deleted_count(other.m_deleted_count)
     {
         other.m_size = 0;
         other.m_capacity = 0;
+        other.m_deleted_count = 0;
         other.m_buckets = nullptr;
     }
     HashTable& operator=(HashTable&& other)
@@ -139,8 +139,10 @@ public:
             m_buckets = other.m_buckets;
             m_size = other.m_size;
             m_capacity = other.m_capacity;
+            m_deleted_count = other.m_deleted_count;
             other.m_size = 0;
             other.m_capacity = 0;
+            other.m_deleted_count = 0;
             other.m_buckets = nullptr;
         }
         return *this;
@@ -154,34 +156,36 @@ public:
     void ensure_capacity(size_t capacity)
     {
         ASSERT(capacity >= size());
-        rehash(capacity);
+        size_t new_capacity = min_capacity;
+        while (exceeds_load_factor(capacity, new_capacity))
+            new_capacity *= 2;
+        if (new_capacity > m_capacity)
+            rehash(new_capacity);
     }
 
     void set(const T&);
     void set(T&&);
-    bool contains(const T&) const;
+    bool contains(const T& value) const { return find(value) != end(); }
     void clear();
 
-    using Iterator = HashTableIterator<HashTable, T, typename Bucket::Iterator>;
+    using Iterator = HashTableIterator<HashTable, T, Bucket>;
     friend Iterator;
-    Iterator begin() { return Iterator(*this, is_empty()); }
-    Iterator end() { return Iterator(*this, true); }
+    Iterator begin() { return Iterator(*this, m_buckets); }
+    Iterator end() { return Iterator(*this, m_buckets + m_capacity); }
 
-    using ConstIterator = HashTableIterator<const HashTable, const T, typename Bucket::ConstIterator>;
+    using ConstIterator = HashTableIterator<const HashTable, const T, const Bucket>;
     friend ConstIterator;
-    ConstIterator begin() const { return ConstIterator(*this, is_empty()); }
-    ConstIterator end() const { return ConstIterator(*this, true); }
+    ConstIterator begin() const { return ConstIterator(*this, m_buckets); }
+    ConstIterator end() const { return ConstIterator(*this, m_buckets + m_capacity); }
 
     template<typename Finder>
     Iterator find(unsigned hash, Finder finder)
     {
         if (is_empty())
             return end();
-        size_t bucket_index;
-        auto& bucket = lookup_with_hash(hash, &bucket_index);
-        auto bucket_iterator = bucket.find(finder);
-        if (bucket_iterator != bucket.end())
-            return Iterator(*this, false, bucket_iterator, bucket_index);
+        auto* bucket = lookup_with_hash(hash, finder);
+        if (bucket)
+            return Iterator(*this, bucket);
         return end();
     }
 
@@ -190,11 +194,9 @@ public:
     {
         if (is_empty())
             return end();
-        size_t bucket_index;
-        auto& bucket = lookup_with_hash(hash, &bucket_index);
-        auto bucket_iterator = bucket.find(finder);
-        if (bucket_iterator != bucket.end())
-            return ConstIterator(*this, false, bucket_iterator, bucket_index);
+        auto* bucket = const_cast<HashTable&>(*this).lookup_with_hash(hash, finder);
+        if (bucket)
+            return ConstIterator(*this, bucket);
         return end();
     }
 
@@ -218,95 +220,119 @@ public:
     void remove(Iterator);
 
 private:
-    Bucket& lookup(const T&, size_t* bucket_index = nullptr);
-    const Bucket& lookup(const T&, size_t* bucket_index = nullptr) const;
-
-    Bucket& lookup_with_hash(unsigned hash, size_t* bucket_index)
+    // Fibonacci hashing spreads the incoming hash over the whole table,
+    // so weak hash functions don't pile up in a single cluster.
+    size_t bucket_index_for_hash(unsigned hash) const
     {
-        if (bucket_index)
-            *bucket_index = hash % m_capacity;
-        return m_buckets[hash % m_capacity];
+        return (u32)(hash * 2654435769u) >> (32 - __builtin_ctzl(m_capacity));
     }
 
-    const Bucket& lookup_with_hash(unsigned hash, size_t* bucket_index) const
+    template<typename Finder>
+    Bucket* lookup_with_hash(unsigned hash, Finder finder)
     {
-        if (bucket_index)
-            *bucket_index = hash % m_capacity;
-        return m_buckets[hash % m_capacity];
+        size_t mask = m_capacity - 1;
+        for (size_t index = bucket_index_for_hash(hash);; index = (index + 1) & mask) {
+            auto& bucket = m_buckets[index];
+            if (bucket.state == BucketState::Free)
+                return nullptr;
+            if (bucket.is_used() && finder(*bucket.slot()))
+                return &bucket;
+        }
     }
 
+    Bucket& lookup_for_writing(const T&);
     void rehash(size_t capacity);
-    void insert(const T&);
-    void insert(T&&);
-
-    Bucket& bucket(size_t index) { return m_buckets[index]; }
-    const Bucket& bucket(size_t index) const { return m_buckets[index]; }
 
     Bucket* m_buckets { nullptr };
 
     size_t m_size { 0 };
     size_t m_capacity { 0 };
+    size_t m_deleted_count { 0 };
     bool m_clearing { false };
     bool m_rehashing { false };
 };
 
 template<typename T, typename TraitsForT>
-void HashTable<T, TraitsForT>::set(T&& value)
+auto HashTable<T, TraitsForT>::lookup_for_writing(const T& value) -> Bucket&
 {
-    if (!m_capacity)
-        rehash(1);
-    auto& bucket = lookup(value);
-    for (auto& e : bucket) {
-        if (TraitsForT::equals(e, value)) {
-            e = move(value);
-            return;
+    if (exceeds_load_factor(m_size + m_deleted_count + 1, m_capacity)) {
+        // If most of the load is tombstones, rehashing in place is enough.
+        if (exceeds_load_factor((m_size + 1) * 2, m_capacity))
+            rehash(max(m_capacity * 2, min_capacity));
+        else
+            rehash(m_capacity);
+    }
+
+    unsigned hash = TraitsForT::hash(value);
+    size_t mask = m_capacity - 1;
+    Bucket* first_deleted = nullptr;
+    for (size_t index = bucket_index_for_hash(hash);; index = (index + 1) & mask) {
+        auto& bucket = m_buckets[index];
+        if (bucket.state == BucketState::Free)
+            return first_deleted ? *first_deleted : bucket;
+        if (bucket.state == BucketState::Deleted) {
+            if (!first_deleted)
+                first_deleted = &bucket;
+            continue;
         }
+        if (TraitsForT::equals(*bucket.slot(), value))
+            return bucket;
     }
-    if (size() >= capacity()) {
-        rehash(size() + 1);
-        insert(move(value));
-    } else {
-        bucket.append(move(value));
+}
+
+template<typename T, typename TraitsForT>
+void HashTable<T, TraitsForT>::set(T&& value)
+{
+    auto& bucket = lookup_for_writing(value);
+    if (bucket.is_used()) {
+        *bucket.slot() = move(value);
+        return;
     }
-    m_size++;
+    new (bucket.slot()) T(move(value));
+    if (bucket.state == BucketState::Deleted)
+        --m_deleted_count;
+    bucket.state = BucketState::Used;
+    ++m_size;
 }
 
 template<typename T, typename TraitsForT>
 void HashTable<T, TraitsForT>::set(const T& value)
 {
-    if (!m_capacity)
-        rehash(1);
-    auto& bucket = lookup(value);
-    for (auto& e : bucket) {
-        if (TraitsForT::equals(e, value)) {
-            e = value;
-            return;
-        }
-    }
-    if (size() >= capacity()) {
-        rehash(size() + 1);
-        insert(value);
-    } else {
-        bucket.append(value);
+    auto& bucket = lookup_for_writing(value);
+    if (bucket.is_used()) {
+        *bucket.slot() = value;
+        return;
     }
-    m_size++;
+    new (bucket.slot()) T(value);
+    if (bucket.state == BucketState::Deleted)
+        --m_deleted_count;
+    bucket.state = BucketState::Used;
+    ++m_size;
 }
 
 template<typename T, typename TraitsForT>
 void HashTable<T, TraitsForT>::rehash(size_t new_capacity)
 {
     TemporaryChange<bool> change(m_rehashing, true);
-    new_capacity *= 2;
-    auto* new_buckets = new Bucket[new_capacity];
+    ASSERT(new_capacity && !(new_capacity & (new_capacity - 1)));
     auto* old_buckets = m_buckets;
     size_t old_capacity = m_capacity;
-    m_buckets = new_buckets;
+    m_buckets = new Bucket[new_capacity];
     m_capacity = new_capacity;
+    m_deleted_count = 0;
 
+    size_t mask = m_capacity - 1;
     for (size_t i = 0; i < old_capacity; ++i) {
-        for (auto& value : old_buckets[i]) {
-            insert(move(value));
-        }
+        auto& old_bucket = old_buckets[i];
+        if (!old_bucket.is_used())
+            continue;
+        size_t index = bucket_index_for_hash(TraitsForT::hash(*old_bucket.slot()));
+        while (m_buckets[index].state != BucketState::Free)
+            index = (index + 1) & mask;
+        auto& new_bucket = m_buckets[index];
+        new (new_bucket.slot()) T(move(*old_bucket.slot()));
+        new_bucket.state = BucketState::Used;
+        old_bucket.slot()->~T();
     }
 
     delete[] old_buckets;
@@ -317,64 +343,41 @@ void HashTable<T, TraitsForT>::clear()
 {
     TemporaryChange<bool> change(m_clearing, true);
     if (m_buckets) {
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (m_buckets[i].is_used())
+                m_buckets[i].slot()->~T();
+        }
         delete[] m_buckets;
         m_buckets = nullptr;
     }
     m_capacity = 0;
     m_size = 0;
-}
-
-template<typename T, typename TraitsForT>
-void HashTable<T, TraitsForT>::insert(T&& value)
-{
-    auto& bucket = lookup(value);
-    bucket.append(move(value));
-}
-
-template<typename T, typename TraitsForT>
-void HashTable<T, TraitsForT>::insert(const T& value)
-{
-    auto& bucket = lookup(value);
-    bucket.append(value);
-}
-
-template<typename T, typename TraitsForT>
-bool HashTable<T, TraitsForT>::contains(const T& value) const
-{
-    if (is_empty())
-        return false;
-    auto& bucket = lookup(value);
-    for (auto& e : bucket) {
-        if (TraitsForT::equals(e, value))
-            return true;
-    }
-    return false;
+    m_deleted_count = 0;
 }
 
 template<typename T, typename TraitsForT>
 void HashTable<T, TraitsForT>::remove(Iterator it)
 {
     ASSERT(!is_empty());
-    m_buckets[it.m_bucket_index].remove(it.m_bucket_iterator);
+    auto* bucket = it.m_bucket;
+    ASSERT(bucket && bucket->is_used());
+    bucket->slot()->~T();
     --m_size;
-}
-
-template<typename T, typename TraitsForT>
-auto HashTable<T, TraitsForT>::lookup(const T& value, size_t* bucket_index) -> Bucket&
-{
-    unsigned hash = TraitsForT::hash(value);
-    if (bucket_index)
-        *bucket_index = hash % m_capacity;
-    return m_buckets[hash % m_capacity];
-}
 
-template<typename T, typename TraitsForT>
-auto HashTable<T, TraitsForT>::lookup(const T& value, size_t* bucket_index) const -> const Bucket&
-{
-    unsigned hash = TraitsForT::hash(value);
-    if (bucket_index)
-        *bucket_index = hash % m_capacity;
-    return m_buckets[hash % m_capacity];
+    // If the next bucket ends every probe sequence passing through here anyway,
+    // this bucket (and any tombstones right before it) can be freed outright.
+    size_t mask = m_capacity - 1;
+    size_t index = bucket - m_buckets;
+    if (m_buckets[(index + 1) & mask].state != BucketState::Free) {
+        bucket->state = BucketState::Deleted;
+        ++m_deleted_count;
+        return;
+    }
+    bucket->state = BucketState::Free;
+    for (index = (index - 1) & mask; m_buckets[index].state == BucketState::Deleted; index = (index - 1) & mask) {
+        m_buckets[index].state = BucketState::Free;
+        --m_deleted_count;
+    }
 }
 
 }
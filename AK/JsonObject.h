@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <AK/DoubleConversion.h>
 #include <AK/HashMap.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObjectSerializer.h>
@@ -162,7 +163,7 @@ inline void JsonValue::serialize(Builder& builder) const
                 builder.append("\\\\");
                 break;
             default:
-                builder.appendf("%c", ch);
+                builder.append(ch);
             }
         }
         builder.append("\"");
@@ -177,21 +178,23 @@ inline void JsonValue::serialize(Builder& builder) const
         builder.append(m_value.as_bool ? "true" : "false");
         break;
 #if !defined(KERNEL)
-    case Type::Double:
-        builder.appendf("%g", m_value.as_double);
+    case Type::Double: {
+        char buffer[max_shortest_double_length];
+        builder.append(StringView(buffer, format_shortest(m_value.as_double, buffer)));
         break;
+    }
 #endif
     case Type::Int32:
-        builder.appendf("%d", as_i32());
+        builder.appendff("{}", as_i32());
         break;
     case Type::Int64:
-        builder.appendf("%lld", as_i64());
+        builder.appendff("{}", as_i64());
         break;
     case Type::UnsignedInt32:
-        builder.appendf("%u", as_u32());
+        builder.appendff("{}", as_u32());
         break;
     case Type::UnsignedInt64:
-        builder.appendf("%llu", as_u64());
+        builder.appendff("{}", as_u64());
         break;
     case Type::Undefined:
         builder.append("undefined");
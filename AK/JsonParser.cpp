@@ -24,6 +24,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <AK/DoubleConversion.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonParser.h>
@@ -71,6 +72,18 @@ void JsonParser::consume_specific(char expected_ch)
 String JsonParser::consume_quoted_string()
 {
     consume_specific('"');
+
+    // Fast path: if there are no escape sequences, use the input directly.
+    size_t end_index = m_index;
+    while (end_index < m_input.length() && m_input[end_index] != '"' && m_input[end_index] != '\\')
+        ++end_index;
+    if (end_index < m_input.length() && m_input[end_index] == '"') {
+        auto string = m_input.substring_view(m_index, end_index - m_index);
+        m_index = end_index;
+        consume_specific('"');
+        return intern_string(string);
+    }
+
     Vector<char, 1024> buffer;
 
     for (;;) {
@@ -139,16 +152,21 @@ String JsonParser::consume_quoted_string()
     }
     consume_specific('"');
 
-    if (buffer.is_empty())
+    return intern_string(StringView(buffer.data(), buffer.size()));
+}
+
+String JsonParser::intern_string(const StringView& string)
+{
+    if (string.is_empty())
         return String::empty();
 
-    auto& last_string_starting_with_character = m_last_string_starting_with_character[(u8)buffer.first()];
-    if (last_string_starting_with_character.length() == buffer.size()) {
-        if (!memcmp(last_string_starting_with_character.characters(), buffer.data(), buffer.size()))
+    auto& last_string_starting_with_character = m_last_string_starting_with_character[(u8)string[0]];
+    if (last_string_starting_with_character.length() == string.length()) {
+        if (!memcmp(last_string_starting_with_character.characters(), string.characters_without_null_termination(), string.length()))
             return last_string_starting_with_character;
     }
 
-    last_string_starting_with_character = String::copy(buffer);
+    last_string_starting_with_character = string;
     return last_string_starting_with_character;
 }
 
@@ -204,10 +222,11 @@ JsonValue JsonParser::parse_number()
 {
     bool ok;
     JsonValue value;
-    Vector<char, 128> number_buffer;
-    Vector<char, 128> fraction_buffer;
 
+    // The number is a contiguous run of the input, so it can be used in
+    // place instead of being copied out.
     bool is_double = false;
+    size_t number_start = m_index;
     for (;;) {
         char ch = peek();
         if (ch == '.') {
@@ -216,35 +235,19 @@ JsonValue JsonParser::parse_number()
             continue;
         }
         if (ch == '-' || (ch >= '0' && ch <= '9')) {
-            if (is_double)
-                fraction_buffer.append(ch);
-            else
-                number_buffer.append(ch);
             ++m_index;
             continue;
         }
         break;
     }
 
-    StringView number_string(number_buffer.data(), number_buffer.size());
-    StringView fraction_string(fraction_buffer.data(), fraction_buffer.size());
+    StringView number_string = m_input.substring_view(number_start, m_index - number_start);
 
 #ifndef KERNEL
     if (is_double) {
-        int whole = number_string.to_uint(ok);
-        if (!ok)
-            whole = number_string.to_int(ok);
-        ASSERT(ok);
-
-        int fraction = fraction_string.to_uint(ok);
-        fraction *= (whole < 0) ? -1 : 1;
-        ASSERT(ok);
-
-        auto divider = 1;
-        for (size_t i = 0; i < fraction_buffer.size(); ++i) {
-            divider *= 10;
-        }
-        value = JsonValue((double)whole + ((double)fraction / divider));
+        bool negative = number_string.starts_with('-');
+        auto significand = negative ? number_string.substring_view(1, number_string.length() - 1) : number_string;
+        value = JsonValue(decimal_to_double(significand, 0, negative));
     } else {
 #endif
         value = JsonValue(number_string.to_uint(ok));
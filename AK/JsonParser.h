@@ -49,6 +49,7 @@ private:
     void consume_specific(char expected_ch);
     void consume_string(const char*);
     String consume_quoted_string();
+    String intern_string(const StringView&);
     JsonArray parse_array();
     JsonObject parse_object();
     JsonValue parse_number();
@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/Checked.h>
+#include <AK/DoubleConversion.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonPullParser.h>
+#include <AK/Memory.h>
+#include <AK/NumericLimits.h>
+#include <AK/StringUtils.h>
+
+namespace AK {
+
+static inline bool is_whitespace(char ch)
+{
+    return ch == ' ' || ch == '\n' || ch == '\t' || ch == '\v' || ch == '\r';
+}
+
+static inline bool is_digit(char ch)
+{
+    return ch >= '0' && ch <= '9';
+}
+
+void JsonPullParser::skip_whitespace()
+{
+    while (m_index < m_input.length() && is_whitespace(m_input[m_index]))
+        ++m_index;
+}
+
+auto JsonPullParser::next() -> Token
+{
+    if (m_token == Token::Error)
+        return m_token;
+
+    for (;;) {
+        skip_whitespace();
+        if (m_state == State::Done) {
+            if (m_index == m_input.length())
+                return set_token(Token::EndOfInput);
+            return fail();
+        }
+        if (m_index == m_input.length())
+            return fail();
+
+        char ch = m_input[m_index];
+        switch (m_state) {
+        case State::Value:
+            return lex_value();
+        case State::FirstValueOrEnd:
+            if (ch == ']') {
+                ++m_index;
+                m_containers.take_last();
+                return finish_value(Token::EndArray);
+            }
+            return lex_value();
+        case State::FirstKeyOrEnd:
+            if (ch == '}') {
+                ++m_index;
+                m_containers.take_last();
+                return finish_value(Token::EndObject);
+            }
+            [[fallthrough]];
+        case State::Key:
+            if (ch != '"' || !lex_string(m_key_buffer))
+                return fail();
+            m_state = State::Colon;
+            return set_token(Token::Key);
+        case State::Colon:
+            if (ch != ':')
+                return fail();
+            ++m_index;
+            m_state = State::Value;
+            continue;
+        case State::CommaOrEnd: {
+            ++m_index;
+            bool in_object = m_containers.last() == Container::Object;
+            if (ch == ',') {
+                m_state = in_object ? State::Key : State::Value;
+                continue;
+            }
+            if (ch == (in_object ? '}' : ']')) {
+                m_containers.take_last();
+                return finish_value(in_object ? Token::EndObject : Token::EndArray);
+            }
+            return fail();
+        }
+        case State::Done:
+            ASSERT_NOT_REACHED();
+        }
+    }
+}
+
+auto JsonPullParser::finish_value(Token token) -> Token
+{
+    m_state = m_containers.is_empty() ? State::Done : State::CommaOrEnd;
+    return set_token(token);
+}
+
+auto JsonPullParser::lex_value() -> Token
+{
+    char ch = m_input[m_index];
+    switch (ch) {
+    case '{':
+        ++m_index;
+        m_containers.append(Container::Object);
+        m_state = State::FirstKeyOrEnd;
+        return set_token(Token::BeginObject);
+    case '[':
+        ++m_index;
+        m_containers.append(Container::Array);
+        m_state = State::FirstValueOrEnd;
+        return set_token(Token::BeginArray);
+    case '"':
+        if (!lex_string(m_string_buffer))
+            return fail();
+        return finish_value(Token::String);
+    case 't':
+        if (!lex_literal("true"))
+            return fail();
+        return finish_value(Token::True);
+    case 'f':
+        if (!lex_literal("false"))
+            return fail();
+        return finish_value(Token::False);
+    case 'n':
+        if (!lex_literal("null"))
+            return fail();
+        return finish_value(Token::Null);
+    case 'u':
+        if (!lex_literal("undefined"))
+            return fail();
+        return finish_value(Token::Undefined);
+    }
+
+    if (!lex_number())
+        return fail();
+    return finish_value(Token::Number);
+}
+
+bool JsonPullParser::lex_number()
+{
+    auto consume_digits = [this] {
+        size_t start = m_index;
+        while (m_index < m_input.length() && is_digit(m_input[m_index]))
+            ++m_index;
+        return m_index != start;
+    };
+    auto consume_specific = [this](char ch) {
+        if (m_index >= m_input.length() || m_input[m_index] != ch)
+            return false;
+        ++m_index;
+        return true;
+    };
+
+    // -?digits(.digits)?([eE][+-]?digits)?
+    size_t start = m_index;
+    consume_specific('-');
+    if (!consume_digits())
+        return false;
+    if (consume_specific('.') && !consume_digits())
+        return false;
+    if (consume_specific('e') || consume_specific('E')) {
+        if (!consume_specific('+'))
+            consume_specific('-');
+        if (!consume_digits())
+            return false;
+    }
+    m_number = m_input.substring_view(start, m_index - start);
+    return true;
+}
+
+Optional<i64> JsonPullParser::integer_value() const
+{
+    // Works on the digits directly so that exponents and fractions can be
+    // resolved without floating point, which the kernel can't use.
+    size_t index = 0;
+    bool negative = m_number.starts_with('-');
+    if (negative)
+        ++index;
+
+    Checked<i64> value = 0;
+    int exponent = 0;
+    bool in_fraction = false;
+    for (; index < m_number.length(); ++index) {
+        char ch = m_number[index];
+        if (ch == '.') {
+            in_fraction = true;
+            continue;
+        }
+        if (!is_digit(ch))
+            break;
+        value *= 10;
+        value += ch - '0';
+        if (value.has_overflow())
+            return {};
+        if (in_fraction)
+            --exponent;
+    }
+    if (index < m_number.length()) {
+        bool ok;
+        auto exponent_part = m_number.substring_view(index + 1, m_number.length() - index - 1);
+        if (exponent_part.starts_with('+'))
+            exponent_part = exponent_part.substring_view(1, exponent_part.length() - 1);
+        int explicit_exponent = exponent_part.to_int(ok);
+        if (!ok)
+            return {};
+        exponent += explicit_exponent;
+    }
+
+    // Like a C cast, anything after the decimal point is truncated.
+    for (; exponent < 0 && value.value(); ++exponent)
+        value = value.value() / 10;
+    for (; exponent > 0 && value.value(); --exponent) {
+        value *= 10;
+        if (value.has_overflow())
+            return {};
+    }
+    return negative ? -value.value() : value.value();
+}
+
+bool JsonPullParser::lex_literal(const char* literal)
+{
+    size_t length = strlen(literal);
+    if (m_index + length > m_input.length())
+        return false;
+    if (memcmp(m_input.characters_without_null_termination() + m_index, literal, length))
+        return false;
+    m_index += length;
+    return true;
+}
+
+bool JsonPullParser::lex_string(Vector<char, 128>& buffer)
+{
+    ASSERT(m_input[m_index] == '"');
+    size_t start = ++m_index;
+    const char* characters = m_input.characters_without_null_termination();
+
+    // Fast path: strings without escape sequences are just a slice of the input.
+    while (m_index < m_input.length() && characters[m_index] != '"' && characters[m_index] != '\\')
+        ++m_index;
+    if (m_index == m_input.length())
+        return false;
+    if (characters[m_index] == '"') {
+        m_string = m_input.substring_view(start, m_index - start);
+        ++m_index;
+        return true;
+    }
+
+    buffer.clear();
+    buffer.append(characters + start, m_index - start);
+    while (m_index < m_input.length()) {
+        char ch = characters[m_index++];
+        if (ch == '"') {
+            m_string = StringView(buffer.data(), buffer.size());
+            return true;
+        }
+        if (ch != '\\') {
+            buffer.append(ch);
+            continue;
+        }
+        if (m_index == m_input.length())
+            return false;
+        char escaped_ch = characters[m_index++];
+        switch (escaped_ch) {
+        case 'n':
+            buffer.append('\n');
+            break;
+        case 'r':
+            buffer.append('\r');
+            break;
+        case 't':
+            buffer.append('\t');
+            break;
+        case 'b':
+            buffer.append('\b');
+            break;
+        case 'f':
+            buffer.append('\f');
+            break;
+        case 'u': {
+            if (m_index + 4 > m_input.length())
+                return false;
+            bool ok;
+            u32 codepoint = StringUtils::convert_to_uint_from_hex(m_input.substring_view(m_index, 4), ok);
+            m_index += 4;
+            // FIXME: This is obviously not correct, but we don't have non-ASCII support so meh.
+            buffer.append(ok && codepoint < 128 ? (char)codepoint : '?');
+        } break;
+        default:
+            buffer.append(escaped_ch);
+            break;
+        }
+    }
+    return false;
+}
+
+String JsonPullParser::to_string() const
+{
+    switch (m_token) {
+    case Token::Key:
+    case Token::String:
+        return m_string;
+    case Token::Number:
+        return m_number;
+    case Token::True:
+        return "true";
+    case Token::False:
+        return "false";
+    case Token::Null:
+        return "null";
+    case Token::Undefined:
+        return "undefined";
+    default:
+        return {};
+    }
+}
+
+void JsonPullParser::skip_value()
+{
+    if (m_token != Token::BeginObject && m_token != Token::BeginArray)
+        return;
+    size_t target_depth = depth() - 1;
+    while (depth() > target_depth) {
+        if (next() == Token::Error)
+            return;
+    }
+}
+
+JsonValue JsonPullParser::number_value() const
+{
+    bool ok;
+#ifndef KERNEL
+    auto exponent_start = m_number.find_first_of("eE");
+    if (m_number.contains('.') || exponent_start.has_value()) {
+        bool negative = m_number.starts_with('-');
+        size_t significand_start = negative ? 1 : 0;
+        size_t significand_end = exponent_start.value_or(m_number.length());
+        auto significand = m_number.substring_view(significand_start, significand_end - significand_start);
+        int exponent = 0;
+        if (exponent_start.has_value()) {
+            auto exponent_part = m_number.substring_view(significand_end + 1, m_number.length() - significand_end - 1);
+            exponent = exponent_part.to_int(ok);
+            // An exponent that doesn't fit in an int is far past the point
+            // where any double overflows or underflows.
+            if (!ok)
+                exponent = exponent_part.starts_with('-') ? NumericLimits<i32>::min() : NumericLimits<i32>::max();
+        }
+        return JsonValue(decimal_to_double(significand, exponent, negative));
+    }
+#endif
+    auto unsigned_value = m_number.to_uint(ok);
+    if (ok)
+        return JsonValue(unsigned_value);
+    auto signed_value = m_number.to_int(ok);
+    if (ok)
+        return JsonValue(signed_value);
+    auto integer = integer_value();
+    if (!integer.has_value())
+        return JsonValue();
+    if (integer.value() >= 0 && integer.value() <= NumericLimits<u32>::max())
+        return JsonValue((unsigned)integer.value());
+    if (integer.value() >= NumericLimits<i32>::min() && integer.value() <= NumericLimits<i32>::max())
+        return JsonValue((int)integer.value());
+    return JsonValue((long long)integer.value());
+}
+
+JsonValue JsonPullParser::value()
+{
+    switch (m_token) {
+    case Token::BeginObject: {
+        JsonObject object;
+        while (next() == Token::Key) {
+            auto key = to_string();
+            next();
+            object.set(key, value());
+        }
+        return object;
+    }
+    case Token::BeginArray: {
+        JsonArray array;
+        while (next() != Token::EndArray) {
+            if (has_error())
+                break;
+            array.append(value());
+        }
+        return array;
+    }
+    case Token::String:
+        return to_string();
+    case Token::Number:
+        return number_value();
+    case Token::True:
+        return JsonValue(true);
+    case Token::False:
+        return JsonValue(false);
+    case Token::Null:
+        return JsonValue(JsonValue::Type::Null);
+    case Token::Undefined:
+        return JsonValue(JsonValue::Type::Undefined);
+    default:
+        return JsonValue();
+    }
+}
+
+}
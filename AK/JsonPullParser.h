@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/JsonValue.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// JsonPullParser walks a JSON document one token at a time without building
+// a JsonValue tree. Strings without escape sequences are reported as views
+// into the input, so reading through a document doesn't allocate at all.
+// A key stays valid while its value is read, up until the next key (which
+// may be a key inside that value).
+//
+//     JsonPullParser parser(input);
+//     if (parser.next() != JsonPullParser::Token::BeginObject)
+//         return;
+//     while (parser.next() == JsonPullParser::Token::Key) {
+//         auto key = parser.string();
+//         parser.next();
+//         if (key == "pid")
+//             pid = parser.to_u32();
+//         else
+//             parser.skip_value();
+//     }
+
+class JsonPullParser {
+public:
+    enum class Token {
+        None,
+        BeginObject,
+        EndObject,
+        BeginArray,
+        EndArray,
+        Key,
+        String,
+        Number,
+        True,
+        False,
+        Null,
+        Undefined,
+        EndOfInput,
+        Error,
+    };
+
+    explicit JsonPullParser(const StringView& input)
+        : m_input(input)
+    {
+    }
+
+    Token next();
+    Token token() const { return m_token; }
+    bool has_error() const { return m_token == Token::Error; }
+    size_t depth() const { return m_containers.size(); }
+
+    // Valid for Key and String tokens. Strings containing escape sequences
+    // are decoded into a scratch buffer. Keys and values have separate
+    // buffers, which are reused by the next key or string value respectively.
+    StringView string() const { return m_string; }
+
+    // Like JsonValue::to_string(), this also works for numbers and literals.
+    String to_string() const;
+
+    // Valid for Number tokens.
+    StringView number() const { return m_number; }
+    i32 to_i32(i32 default_value = 0) const { return to_number<i32>(default_value); }
+    u32 to_u32(u32 default_value = 0) const { return to_number<u32>(default_value); }
+    bool to_bool(bool default_value = false) const
+    {
+        if (m_token == Token::True)
+            return true;
+        if (m_token == Token::False)
+            return false;
+        return default_value;
+    }
+
+    // Skips the value starting at the current token, including everything
+    // up to the matching end token if it's an object or array.
+    void skip_value();
+
+    // Builds a JsonValue from the value starting at the current token.
+    JsonValue value();
+
+private:
+    enum class State {
+        Value,
+        FirstValueOrEnd,
+        FirstKeyOrEnd,
+        Key,
+        Colon,
+        CommaOrEnd,
+        Done,
+    };
+
+    enum class Container {
+        Object,
+        Array,
+    };
+
+    template<typename T>
+    T to_number(T default_value) const
+    {
+        if (m_token != Token::Number)
+            return default_value;
+        auto value = integer_value();
+        if (!value.has_value())
+            return default_value;
+        return (T)value.value();
+    }
+
+    Optional<i64> integer_value() const;
+    JsonValue number_value() const;
+
+    void skip_whitespace();
+    Token set_token(Token token) { return m_token = token; }
+    Token fail() { return set_token(Token::Error); }
+    Token finish_value(Token);
+    Token lex_value();
+    bool lex_string(Vector<char, 128>& buffer);
+    bool lex_literal(const char*);
+    bool lex_number();
+
+    StringView m_input;
+    size_t m_index { 0 };
+    Token m_token { Token::None };
+    State m_state { State::Value };
+    Vector<Container, 32> m_containers;
+
+    StringView m_string;
+    StringView m_number;
+    Vector<char, 128> m_key_buffer;
+    Vector<char, 128> m_string_buffer;
+};
+
+}
+
+using AK::JsonPullParser;
@@ -57,53 +57,70 @@ const LogStream& operator<<(const LogStream& stream, const StringView& value)
     return stream;
 }
 
+static const LogStream& write_integer(const LogStream& stream, u64 value, bool is_negative)
+{
+    char buffer[24];
+    size_t start = sizeof(buffer);
+    do {
+        buffer[--start] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+    if (is_negative)
+        buffer[--start] = '-';
+    stream.write(buffer + start, sizeof(buffer) - start);
+    return stream;
+}
+
+template<typename T>
+static const LogStream& write_signed_integer(const LogStream& stream, T value)
+{
+    if (value < 0)
+        return write_integer(stream, 0 - static_cast<u64>(value), true);
+    return write_integer(stream, value, false);
+}
+
 const LogStream& operator<<(const LogStream& stream, int value)
 {
-    char buffer[32];
-    sprintf(buffer, "%d", value);
-    return stream << buffer;
+    return write_signed_integer(stream, value);
 }
 
 const LogStream& operator<<(const LogStream& stream, long value)
 {
-    char buffer[32];
-    sprintf(buffer, "%ld", value);
-    return stream << buffer;
+    return write_signed_integer(stream, value);
 }
 
 const LogStream& operator<<(const LogStream& stream, long long value)
 {
-    char buffer[32];
-    sprintf(buffer, "%lld", value);
-    return stream << buffer;
+    return write_signed_integer(stream, value);
 }
 
 const LogStream& operator<<(const LogStream& stream, unsigned value)
 {
-    char buffer[32];
-    sprintf(buffer, "%u", value);
-    return stream << buffer;
+    return write_integer(stream, value, false);
 }
 
 const LogStream& operator<<(const LogStream& stream, unsigned long long value)
 {
-    char buffer[32];
-    sprintf(buffer, "%llu", value);
-    return stream << buffer;
+    return write_integer(stream, value, false);
 }
 
 const LogStream& operator<<(const LogStream& stream, unsigned long value)
 {
-    char buffer[32];
-    sprintf(buffer, "%lu", value);
-    return stream << buffer;
+    return write_integer(stream, value, false);
 }
 
 const LogStream& operator<<(const LogStream& stream, const void* value)
 {
-    char buffer[32];
-    sprintf(buffer, "%p", value);
-    return stream << buffer;
+    char buffer[2 + 2 * sizeof(void*)];
+    auto address = reinterpret_cast<FlatPtr>(value);
+    for (size_t i = sizeof(buffer); i > 2; --i) {
+        buffer[i - 1] = "0123456789abcdef"[address & 0xf];
+        address >>= 4;
+    }
+    buffer[0] = '0';
+    buffer[1] = 'x';
+    stream.write(buffer, sizeof(buffer));
+    return stream;
 }
 
 #if defined(__serenity__) && !defined(KERNEL)
@@ -155,6 +172,7 @@ KernelLogStream::~KernelLogStream()
 {
     char newline = '\n';
     write(&newline, 1);
+    flush();
 }
 #endif
 
@@ -162,6 +180,7 @@ DebugLogStream::~DebugLogStream()
 {
     char newline = '\n';
     write(&newline, 1);
+    flush();
 }
 
 #ifndef KERNEL
@@ -169,9 +188,10 @@ StdLogStream::~StdLogStream()
 {
     char newline = '\n';
     write(&newline, 1);
+    flush();
 }
 
-void StdLogStream::write(const char* characters, int length) const
+void StdLogStream::write_unbuffered(const char* characters, int length) const
 {
     if (::write(m_fd, characters, length) < 0) {
         perror("StdLogStream::write");
@@ -181,12 +201,15 @@ void StdLogStream::write(const char* characters, int length) const
 
 const LogStream& operator<<(const LogStream& stream, double value)
 {
-    return stream << String::format("%.4f", value);
+    char buffer[400];
+    int length = snprintf(buffer, sizeof(buffer), "%.4f", value);
+    stream.write(buffer, min((size_t)length, sizeof(buffer) - 1));
+    return stream;
 }
 
 const LogStream& operator<<(const LogStream& stream, float value)
 {
-    return stream << String::format("%.4f", value);
+    return stream << (double)value;
 }
 
 #endif
@@ -57,28 +57,67 @@ private:
 #endif
 };
 
-class DebugLogStream final : public LogStream {
+// Collects a message and hands it to write_unbuffered() in one piece, instead of
+// issuing a separate write for every operator<<. It never allocates, so it's safe
+// to log from anywhere; messages that don't fit are written out in parts.
+class BufferedLogStream : public LogStream {
+public:
+    virtual void write(const char* characters, int length) const override
+    {
+        if (m_size + length > sizeof(m_buffer)) {
+            flush();
+            if ((size_t)length > sizeof(m_buffer)) {
+                write_unbuffered(characters, length);
+                return;
+            }
+        }
+        __builtin_memcpy(m_buffer + m_size, characters, length);
+        m_size += length;
+        // Pass on complete lines right away, so they are neither lost nor reordered with other
+        // output if we crash before the stream goes away.
+        if (m_size == sizeof(m_buffer) || __builtin_memchr(characters, '\n', length))
+            flush();
+    }
+
+protected:
+    virtual void write_unbuffered(const char*, int) const = 0;
+
+    void flush() const
+    {
+        if (m_size)
+            write_unbuffered(m_buffer, m_size);
+        m_size = 0;
+    }
+
+private:
+    mutable size_t m_size { 0 };
+    mutable char m_buffer[256];
+};
+
+class DebugLogStream final : public BufferedLogStream {
 public:
     DebugLogStream() {}
     virtual ~DebugLogStream() override;
 
-    virtual void write(const char* characters, int length) const override
+private:
+    virtual void write_unbuffered(const char* characters, int length) const override
     {
         dbgputstr(characters, length);
     }
 };
 
 #if !defined(KERNEL)
-class StdLogStream final : public LogStream {
+class StdLogStream final : public BufferedLogStream {
 public:
     StdLogStream(int fd)
         : m_fd(fd)
     {
     }
     virtual ~StdLogStream() override;
-    virtual void write(const char* characters, int length) const override;
 
 private:
+    virtual void write_unbuffered(const char* characters, int length) const override;
+
     int m_fd { -1 };
 };
 
@@ -87,12 +126,13 @@ inline StdLogStream warn() { return StdLogStream(STDERR_FILENO); }
 #endif
 
 #ifdef KERNEL
-class KernelLogStream final : public LogStream {
+class KernelLogStream final : public BufferedLogStream {
 public:
     KernelLogStream() {}
     virtual ~KernelLogStream() override;
 
-    virtual void write(const char* characters, int length) const override
+private:
+    virtual void write_unbuffered(const char* characters, int length) const override
     {
         kernelputstr(characters, length);
     }
@@ -35,15 +35,12 @@
 #    include <string.h>
 #endif
 
-#if defined(__serenity__) && !defined(KERNEL)
-extern "C" void* mmx_memcpy(void* to, const void* from, size_t);
-#endif
-
 ALWAYS_INLINE void fast_u32_copy(u32* dest, const u32* src, size_t count)
 {
 #if defined(__serenity__) && !defined(KERNEL)
+    // LibC's memcpy picks the best available implementation for large copies.
     if (count >= 256) {
-        mmx_memcpy(dest, src, count * sizeof(count));
+        memcpy(dest, src, count * sizeof(u32));
         return;
     }
 #endif
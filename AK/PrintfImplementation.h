@@ -35,6 +35,10 @@
 static constexpr const char* printf_hex_digits_lower = "0123456789abcdef";
 static constexpr const char* printf_hex_digits_upper = "0123456789ABCDEF";
 
+#if !defined(KERNEL)
+#    include <AK/DoubleConversion.h>
+#endif
+
 #ifdef __serenity__
 extern "C" size_t strlen(const char*);
 #else
@@ -177,27 +181,114 @@ ALWAYS_INLINE int print_u64(PutChFunc putch, char*& bufptr, u64 number, bool lef
     return field_width;
 }
 
+#if !defined(KERNEL)
+// Prints a double in the style of %f, %e or %g (or their upper case versions),
+// correctly rounding its exact decimal expansion to the requested precision.
 template<typename PutChFunc>
-ALWAYS_INLINE int print_double(PutChFunc putch, char*& bufptr, double number, bool left_pad, bool zero_pad, u32 field_width, u32 fraction_length = 6)
+int print_double(PutChFunc putch, char*& bufptr, double number, bool left_pad, bool zero_pad, bool always_sign, bool alternate_form, u32 field_width, u32 precision, char format)
 {
-    int length = 0;
+    bool upper_case = format >= 'A' && format <= 'Z';
+    format |= 0x20;
+
+    char sign = 0;
+    if (__builtin_signbit(number)) {
+        sign = '-';
+        number = -number;
+    } else if (always_sign) {
+        sign = '+';
+    }
 
-    if (number < 0) {
-        putch(bufptr, '-');
-        length++;
-        number = 0 - number;
+    auto pad = [&](u32 length, char ch) {
+        for (u32 i = length; i < field_width; ++i)
+            putch(bufptr, ch);
+    };
+
+    if (__builtin_isnan(number) || __builtin_isinf(number)) {
+        const char* text = __builtin_isnan(number) ? (upper_case ? "NAN" : "nan") : (upper_case ? "INF" : "inf");
+        u32 length = 3 + (sign ? 1 : 0);
+        if (!left_pad)
+            pad(length, ' ');
+        if (sign)
+            putch(bufptr, sign);
+        for (int i = 0; i < 3; ++i)
+            putch(bufptr, text[i]);
+        if (left_pad)
+            pad(length, ' ');
+        return max(length, field_width);
     }
 
-    length = print_u64(putch, bufptr, (i64)number, left_pad, zero_pad, field_width);
-    putch(bufptr, '.');
-    length++;
-    double fraction = number - (i64)number;
+    ExactDecimal decimal(number);
+    bool exponential = format == 'e';
+    u32 fraction_length = precision;
+
+    if (format == 'g') {
+        // Use precision significant digits, picking %e or %f by the exponent,
+        // and drop trailing zeros unless asked not to.
+        int significant_digits = precision ? precision : 1;
+        decimal.round(significant_digits);
+        int exponent = decimal.is_zero() ? 0 : decimal.decimal_point() - 1;
+        if (exponent >= -4 && exponent < significant_digits) {
+            fraction_length = significant_digits - 1 - exponent;
+        } else {
+            exponential = true;
+            fraction_length = significant_digits - 1;
+        }
+        if (!alternate_form) {
+            int digits_after_point = exponential ? decimal.digit_count() - 1 : decimal.digit_count() - decimal.decimal_point();
+            fraction_length = min<u32>(fraction_length, max(digits_after_point, 0));
+        }
+    } else if (exponential) {
+        decimal.round(precision + 1);
+    } else {
+        decimal.round(decimal.decimal_point() + precision);
+    }
 
+    // Work out the length up front, for padding.
+    bool print_point = fraction_length > 0 || alternate_form;
+    u32 length = (sign ? 1 : 0) + (print_point ? 1 : 0) + fraction_length;
+
+    char exponent_buffer[8];
+    u32 exponent_length = 0;
+    u32 integer_digits = 1;
+    if (exponential) {
+        int exponent = decimal.is_zero() ? 0 : decimal.decimal_point() - 1;
+        exponent_buffer[exponent_length++] = upper_case ? 'E' : 'e';
+        exponent_buffer[exponent_length++] = exponent < 0 ? '-' : '+';
+        if (exponent < 0)
+            exponent = -exponent;
+        if (exponent >= 100)
+            exponent_buffer[exponent_length++] = '0' + exponent / 100;
+        exponent_buffer[exponent_length++] = '0' + exponent / 10 % 10;
+        exponent_buffer[exponent_length++] = '0' + exponent % 10;
+    } else if (decimal.decimal_point() > 1) {
+        integer_digits = decimal.decimal_point();
+    }
+    length += integer_digits + exponent_length;
+
+    if (!left_pad && !zero_pad)
+        pad(length, ' ');
+    if (sign)
+        putch(bufptr, sign);
+    if (!left_pad && zero_pad)
+        pad(length, '0');
+
+    // Digits before the point are decimal.digit(0) onwards when the point is
+    // to the right of the first digit; otherwise, there's just a zero.
+    int first_digit = exponential ? 0 : decimal.decimal_point() - static_cast<int>(integer_digits);
+    for (u32 i = 0; i < integer_digits; ++i)
+        putch(bufptr, decimal.digit(first_digit + i));
+    if (print_point)
+        putch(bufptr, '.');
     for (u32 i = 0; i < fraction_length; ++i)
-        fraction = fraction * 10;
+        putch(bufptr, decimal.digit(first_digit + integer_digits + i));
+    for (u32 i = 0; i < exponent_length; ++i)
+        putch(bufptr, exponent_buffer[i]);
 
-    return length + print_u64(putch, bufptr, (i64)fraction, false, true, fraction_length);
+    if (left_pad)
+        pad(length, ' ');
+    return max(length, field_width);
 }
+#endif
 
 template<typename PutChFunc>
 ALWAYS_INLINE int print_i64(PutChFunc putch, char*& bufptr, i64 number, bool left_pad, bool zero_pad, u32 field_width)
@@ -320,7 +411,7 @@ ALWAYS_INLINE int printf_internal(PutChFunc putch, char* buffer, const char*& fm
                 if (*(p + 1))
                     goto one_more;
             }
-            if (!zero_pad && !field_width && *p == '0') {
+            if (!dot && !zero_pad && !field_width && *p == '0') {
                 zero_pad = true;
                 if (*(p + 1))
                     goto one_more;
@@ -390,9 +481,13 @@ ALWAYS_INLINE int printf_internal(PutChFunc putch, char* buffer, const char*& fm
                 break;
 
 #if !defined(KERNEL)
-            case 'g':
+            case 'e':
+            case 'E':
             case 'f':
-                ret += print_double(putch, bufptr, va_arg(ap, double), left_pad, zero_pad, field_width, fraction_length);
+            case 'F':
+            case 'g':
+            case 'G':
+                ret += print_double(putch, bufptr, va_arg(ap, double), left_pad, zero_pad, always_sign, alternate_form, field_width, dot ? fraction_length : 6, *p);
                 break;
 #endif
 
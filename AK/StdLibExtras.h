@@ -98,6 +98,11 @@ struct EnableIf<true, T> {
     typedef T Type;
 };
 
+template<class T>
+struct IdentityType {
+    typedef T Type;
+};
+
 template<class T>
 struct RemoveConst {
     typedef T Type;
@@ -431,6 +436,7 @@ using AK::clamp;
 using AK::Conditional;
 using AK::exchange;
 using AK::forward;
+using AK::IdentityType;
 using AK::IsSame;
 using AK::MakeSigned;
 using AK::MakeUnsigned;
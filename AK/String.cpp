@@ -33,6 +33,7 @@
 #include <AK/Vector.h>
 
 #ifndef KERNEL
+#    include <AK/DoubleConversion.h>
 #    include <inttypes.h>
 #endif
 
@@ -127,9 +128,7 @@ String String::substring(size_t start, size_t length) const
     if (!length)
         return {};
     ASSERT(m_impl);
-    ASSERT(start + length <= m_impl->length());
-    // FIXME: This needs some input bounds checking.
-    return { characters() + start, length };
+    return m_impl->substring(start, length);
 }
 
 StringView String::substring_view(size_t start, size_t length) const
@@ -250,6 +249,22 @@ String String::number(int value)
     return String(buffer, size);
 }
 
+#ifndef KERNEL
+String String::number(double value)
+{
+    char buffer[max_shortest_double_length];
+    size_t size = format_shortest(value, buffer);
+    return String(buffer, size);
+}
+#endif
+
+String String::vformatted(const StringView& fmtstr, const TypeErasedFormatParams& params)
+{
+    StringBuilder builder;
+    vformat(builder, fmtstr, params);
+    return builder.to_string();
+}
+
 String String::format(const char* fmt, ...)
 {
     StringBuilder builder;
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <AK/Format.h>
 #include <AK/Forward.h>
 #include <AK/RefPtr.h>
 #include <AK/StringImpl.h>
@@ -43,11 +44,15 @@ namespace AK {
 // Copying a String is very efficient, since the internal StringImpl is
 // retainable and so copying only requires modifying the ref count.
 //
+// Single-character strings are shared, and long enough suffixes taken with
+// substring() point into the original StringImpl's buffer instead of
+// copying it, so neither of those allocate a new buffer.
+//
 // There are three main ways to construct a new String:
 //
 //     s = String("some literal");
 //
-//     s = String::format("%d little piggies", m_piggies);
+//     s = String::formatted("{} little piggies", m_piggies);
 //
 //     StringBuilder builder;
 //     builder.append("abc");
@@ -213,12 +218,24 @@ public:
     }
 
     static String format(const char*, ...);
+
+    template<typename... Parameters>
+    static String formatted(FormatString<Parameters...> fmtstr, const Parameters&... parameters)
+    {
+        return vformatted(fmtstr, VariadicFormatParams { parameters... });
+    }
+    static String vformatted(const StringView& fmtstr, const TypeErasedFormatParams&);
+
     static String number(unsigned);
     static String number(unsigned long);
     static String number(unsigned long long);
     static String number(int);
     static String number(long);
     static String number(long long);
+#ifndef KERNEL
+    // The shortest representation that converts back to the same value.
+    static String number(double);
+#endif
 
     StringView view() const;
 
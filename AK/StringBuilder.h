@@ -27,6 +27,7 @@
 #pragma once
 
 #include <AK/ByteBuffer.h>
+#include <AK/Format.h>
 #include <AK/Forward.h>
 #include <stdarg.h>
 
@@ -47,6 +48,12 @@ public:
     void appendf(const char*, ...);
     void appendvf(const char*, va_list);
 
+    template<typename... Parameters>
+    void appendff(const StringView& fmtstr, const Parameters&... parameters)
+    {
+        vformat(*this, fmtstr, VariadicFormatParams { parameters... });
+    }
+
     String build() const;
     String to_string() const;
     ByteBuffer to_byte_buffer() const;
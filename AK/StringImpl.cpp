@@ -24,6 +24,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <AK/Atomic.h>
 #include <AK/FlyString.h>
 #include <AK/HashTable.h>
 #include <AK/Memory.h>
@@ -50,6 +51,10 @@ void dump_all_stringimpls()
 namespace AK {
 
 static StringImpl* s_the_empty_stringimpl = nullptr;
+static StringImpl* s_single_character_stringimpls[256];
+
+// Substrings shorter than this are cheaper to copy than to share.
+static constexpr size_t minimum_length_for_shared_substring = 32;
 
 StringImpl& StringImpl::the_empty_stringimpl()
 {
@@ -60,9 +65,43 @@ StringImpl& StringImpl::the_empty_stringimpl()
     return *s_the_empty_stringimpl;
 }
 
+StringImpl& StringImpl::single_character_stringimpl(char ch)
+{
+    auto* slot = &s_single_character_stringimpls[(u8)ch];
+    if (auto* stringimpl = atomic_load(slot, memory_order_acquire))
+        return *stringimpl;
+
+    // Threads may race to create the same entry. The first one to install its impl wins,
+    // and everyone else throws theirs away.
+    char* buffer;
+    auto* new_stringimpl = &create_uninitialized(1, buffer).leak_ref();
+    buffer[0] = ch;
+    StringImpl* existing_stringimpl = nullptr;
+    if (atomic_compare_exchange_strong(slot, existing_stringimpl, new_stringimpl, memory_order_acq_rel))
+        return *new_stringimpl;
+    new_stringimpl->unref();
+    return *existing_stringimpl;
+}
+
 StringImpl::StringImpl(ConstructWithInlineBufferTag, size_t length)
     : m_length(length)
+    , m_characters(&m_inline_buffer[0])
+{
+#ifdef DEBUG_STRINGIMPL
+    if (!g_all_live_stringimpls)
+        g_all_live_stringimpls = new HashTable<StringImpl*>;
+    ++g_stringimpl_count;
+    g_all_live_stringimpls->set(this);
+#endif
+}
+
+StringImpl::StringImpl(ConstructSubstringTag, const StringImpl& parent, size_t start, size_t length)
+    : m_length(length)
+    , m_substring(true)
+    , m_characters(parent.characters() + start)
 {
+    parent.ref();
+    substring_parent() = &parent;
 #ifdef DEBUG_STRINGIMPL
     if (!g_all_live_stringimpls)
         g_all_live_stringimpls = new HashTable<StringImpl*>;
@@ -75,6 +114,8 @@ StringImpl::~StringImpl()
 {
     if (m_fly)
         FlyString::did_destroy_impl({}, *this);
+    if (m_substring)
+        substring_parent()->unref();
 #ifdef DEBUG_STRINGIMPL
     --g_stringimpl_count;
     g_all_live_stringimpls->remove(this);
@@ -118,6 +159,9 @@ RefPtr<StringImpl> StringImpl::create(const char* cstring, size_t length, Should
     if (!length)
         return the_empty_stringimpl();
 
+    if (length == 1)
+        return single_character_stringimpl(cstring[0]);
+
     char* buffer;
     auto new_stringimpl = create_uninitialized(length, buffer);
     memcpy(buffer, cstring, length * sizeof(char));
@@ -189,6 +233,30 @@ slow_path:
     return uppercased;
 }
 
+NonnullRefPtr<StringImpl> StringImpl::substring(size_t start, size_t length) const
+{
+    ASSERT(length);
+    ASSERT(start + length <= m_length);
+    if (start == 0 && length == m_length)
+        return const_cast<StringImpl&>(*this);
+
+    // Only suffixes can share the parent's buffer, since characters() must
+    // stay null-terminated. Always point at the impl that owns the buffer so
+    // that substrings of substrings don't form chains, and don't share when
+    // a short substring would keep a much larger buffer alive.
+    const StringImpl* owner = m_substring ? substring_parent() : this;
+    if (start + length == m_length
+        && length >= minimum_length_for_shared_substring
+        && length * 2 >= owner->length()) {
+        void* slot = kmalloc(sizeof(StringImpl) + sizeof(StringImpl*));
+        ASSERT(slot);
+        size_t start_in_owner = characters() + start - owner->characters();
+        return adopt(*new (slot) StringImpl(ConstructSubstring, *owner, start_in_owner, length));
+    }
+
+    return *create(characters() + start, length);
+}
+
 void StringImpl::compute_hash() const
 {
     if (!length())
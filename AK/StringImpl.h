@@ -46,6 +46,7 @@ public:
     static RefPtr<StringImpl> create(const char* cstring, size_t length, ShouldChomp = NoChomp);
     NonnullRefPtr<StringImpl> to_lowercase() const;
     NonnullRefPtr<StringImpl> to_uppercase() const;
+    NonnullRefPtr<StringImpl> substring(size_t start, size_t length) const;
 
     void operator delete(void* ptr)
     {
@@ -57,7 +58,7 @@ public:
     ~StringImpl();
 
     size_t length() const { return m_length; }
-    const char* characters() const { return &m_inline_buffer[0]; }
+    const char* characters() const { return m_characters; }
     const char& operator[](size_t i) const
     {
         ASSERT(i < m_length);
@@ -79,12 +80,15 @@ public:
     bool is_fly() const { return m_fly; }
     void set_fly(Badge<FlyString>, bool fly) const { m_fly = fly; }
 
+    bool is_substring() const { return m_substring; }
+
 private:
     enum ConstructTheEmptyStringImplTag {
         ConstructTheEmptyStringImpl
     };
     explicit StringImpl(ConstructTheEmptyStringImplTag)
         : m_fly(true)
+        , m_characters(&m_inline_buffer[0])
     {
         m_inline_buffer[0] = '\0';
     }
@@ -94,13 +98,27 @@ private:
     };
     StringImpl(ConstructWithInlineBufferTag, size_t length);
 
+    enum ConstructSubstringTag {
+        ConstructSubstring
+    };
+    StringImpl(ConstructSubstringTag, const StringImpl& parent, size_t start, size_t length);
+
+    static StringImpl& single_character_stringimpl(char);
+
+    // A substring impl doesn't own any characters, its inline buffer holds a
+    // reference to the impl whose buffer it points into instead.
+    const StringImpl*& substring_parent() { return *reinterpret_cast<const StringImpl**>(&m_inline_buffer[0]); }
+    const StringImpl* substring_parent() const { return *reinterpret_cast<const StringImpl* const*>(&m_inline_buffer[0]); }
+
     void compute_hash() const;
 
     size_t m_length { 0 };
     mutable unsigned m_hash { 0 };
     mutable bool m_has_hash { false };
     mutable bool m_fly { false };
-    char m_inline_buffer[0];
+    bool m_substring { false };
+    const char* m_characters { nullptr };
+    alignas(void*) char m_inline_buffer[0];
 };
 
 inline constexpr u32 string_hash(const char* characters, size_t length)
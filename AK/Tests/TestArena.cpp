@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/TestSuite.h>
+
+#include <AK/Arena.h>
+#include <AK/String.h>
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
+
+TEST_CASE(allocate)
+{
+    Arena arena;
+    EXPECT_EQ(arena.chunk_count(), 0u);
+
+    Vector<u8*> pointers;
+    for (size_t i = 0; i < 1000; ++i) {
+        auto* ptr = static_cast<u8*>(arena.allocate(24));
+        EXPECT_EQ((FlatPtr)ptr % Arena::default_alignment, 0u);
+        __builtin_memset(ptr, (u8)i, 24);
+        pointers.append(ptr);
+    }
+    for (size_t i = 0; i < pointers.size(); ++i) {
+        for (size_t j = 0; j < 24; ++j)
+            EXPECT_EQ(pointers[i][j], (u8)i);
+    }
+
+    // A handful of chunks, not one allocation per object.
+    EXPECT(arena.chunk_count() > 1);
+    EXPECT(arena.chunk_count() < 10);
+
+    arena.clear();
+    EXPECT_EQ(arena.chunk_count(), 0u);
+}
+
+TEST_CASE(alignment)
+{
+    Arena arena;
+    arena.allocate(1, 1);
+    EXPECT_EQ((FlatPtr)arena.allocate(8, 64) % 64, 0u);
+    arena.allocate(3, 1);
+    EXPECT_EQ((FlatPtr)arena.allocate(8, 8) % 8, 0u);
+}
+
+TEST_CASE(oversized_allocation)
+{
+    Arena arena;
+    auto* small = static_cast<u8*>(arena.allocate(16));
+    auto* big = static_cast<u8*>(arena.allocate(Arena::max_chunk_size * 2));
+    __builtin_memset(big, 0xaa, Arena::max_chunk_size * 2);
+    EXPECT_EQ(arena.chunk_count(), 2u);
+
+    // The next small allocation still goes into the first chunk.
+    auto* next = static_cast<u8*>(arena.allocate(16));
+    EXPECT_EQ(arena.chunk_count(), 2u);
+    EXPECT(next > small && next < small + Arena::default_chunk_size);
+}
+
+struct Counted {
+    Counted(Vector<int>& log, int id)
+        : log(log)
+        , id(id)
+    {
+    }
+    ~Counted() { log.append(id); }
+
+    Vector<int>& log;
+    int id;
+};
+
+TEST_CASE(make_destroys_on_clear)
+{
+    Vector<int> log;
+    {
+        Arena arena;
+        for (int i = 0; i < 3; ++i)
+            EXPECT_EQ(arena.make<Counted>(log, i).id, i);
+        EXPECT(log.is_empty());
+        arena.clear();
+        EXPECT_EQ(log.size(), 3u);
+        EXPECT_EQ(log[0], 2);
+        EXPECT_EQ(log[2], 0);
+
+        arena.make<Counted>(log, 3);
+        auto& string = arena.make<String>("hello friends");
+        EXPECT_EQ(string, "hello friends");
+    }
+    EXPECT_EQ(log.size(), 4u);
+    EXPECT_EQ(log[3], 3);
+}
+
+TEST_CASE(copy_string)
+{
+    Arena arena;
+    StringBuilder builder;
+    builder.append("well");
+    auto well = arena.copy(builder.string_view());
+    builder.append(" hello");
+    EXPECT_EQ(well, "well");
+    EXPECT(arena.copy(StringView()).is_null());
+    EXPECT(!arena.copy("").is_null());
+    EXPECT(arena.copy("").is_empty());
+}
+
+TEST_CASE(retained_outlives_arena)
+{
+    Vector<char*> retained;
+    {
+        Arena arena;
+        for (int i = 0; i < 500; ++i) {
+            arena.allocate(40);
+            auto* ptr = static_cast<char*>(arena.allocate_retained(32));
+            auto string = String::format("retained %d", i);
+            __builtin_memcpy(ptr, string.characters(), string.length() + 1);
+            retained.append(ptr);
+        }
+    }
+    for (int i = 0; i < 500; ++i)
+        EXPECT_EQ(String(retained[i]), String::format("retained %d", i));
+    for (auto* ptr : retained)
+        Arena::release_retained(ptr);
+}
+
+TEST_CASE(retained_without_arena)
+{
+    auto* ptr = static_cast<u8*>(Arena::allocate_retained_without_arena(100));
+    EXPECT_EQ((FlatPtr)ptr % sizeof(void*), 0u);
+    __builtin_memset(ptr, 1, 100);
+    Arena::release_retained(ptr);
+    Arena::release_retained(nullptr);
+}
+
+TEST_MAIN(Arena)
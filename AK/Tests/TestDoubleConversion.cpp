@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/TestSuite.h>
+
+#include <AK/DoubleConversion.h>
+#include <AK/String.h>
+
+static u64 bits_of(double value)
+{
+    u64 bits;
+    __builtin_memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static double double_of(u64 bits)
+{
+    double value;
+    __builtin_memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static double parse(const char* string)
+{
+    StringView view(string);
+    bool negative = view.starts_with('-');
+    if (negative)
+        view = view.substring_view(1, view.length() - 1);
+    int exponent = 0;
+    for (size_t i = 0; i < view.length(); ++i) {
+        if (view[i] == 'e') {
+            bool ok;
+            auto exponent_view = view.substring_view(i + 1, view.length() - i - 1);
+            if (exponent_view.starts_with('+'))
+                exponent_view = exponent_view.substring_view(1, exponent_view.length() - 1);
+            exponent = exponent_view.to_int(ok);
+            view = view.substring_view(0, i);
+            break;
+        }
+    }
+    return decimal_to_double(view, exponent, negative);
+}
+
+TEST_CASE(parse_simple)
+{
+    EXPECT_EQ(parse("0"), 0.0);
+    EXPECT_EQ(parse("1"), 1.0);
+    EXPECT_EQ(parse("1.5"), 1.5);
+    EXPECT_EQ(parse("-1.5"), -1.5);
+    EXPECT_EQ(parse(".25"), 0.25);
+    EXPECT_EQ(parse("100."), 100.0);
+    EXPECT_EQ(parse("0.000125"), 0.000125);
+    EXPECT_EQ(parse("1e3"), 1000.0);
+    EXPECT_EQ(parse("1.5e-3"), 0.0015);
+    EXPECT_EQ(bits_of(parse("-0")), bits_of(-0.0));
+}
+
+TEST_CASE(parse_correctly_rounded)
+{
+    EXPECT_EQ(bits_of(parse("0.1")), 0x3fb999999999999aull);
+    EXPECT_EQ(bits_of(parse("0.3")), 0x3fd3333333333333ull);
+    EXPECT_EQ(bits_of(parse("1e23")), 0x44b52d02c7e14af6ull);
+    EXPECT_EQ(bits_of(parse("9007199254740993")), 0x4340000000000000ull);
+    EXPECT_EQ(bits_of(parse("9007199254740995")), 0x4340000000000002ull);
+    EXPECT_EQ(bits_of(parse("1.7976931348623157e308")), 0x7fefffffffffffffull);
+    EXPECT_EQ(bits_of(parse("1.7976931348623159e308")), 0x7ff0000000000000ull);
+    EXPECT_EQ(bits_of(parse("2.2250738585072011e-308")), 0x000fffffffffffffull);
+    EXPECT_EQ(bits_of(parse("2.2250738585072014e-308")), 0x0010000000000000ull);
+    EXPECT_EQ(bits_of(parse("4.9406564584124654e-324")), 0x0000000000000001ull);
+    EXPECT_EQ(bits_of(parse("2.4703282292062327e-324")), 0x0000000000000000ull);
+    EXPECT_EQ(bits_of(parse("2.4703282292062328e-324")), 0x0000000000000001ull);
+    EXPECT_EQ(bits_of(parse("1e-400")), 0x0000000000000000ull);
+    EXPECT_EQ(bits_of(parse("1e400")), 0x7ff0000000000000ull);
+    // Long inputs whose first 19 digits don't settle the rounding.
+    EXPECT_EQ(bits_of(parse("1.00000000000000011102230246251565404236316680908203125")), 0x3ff0000000000000ull);
+    EXPECT_EQ(bits_of(parse("1.00000000000000011102230246251565404236316680908203126")), 0x3ff0000000000001ull);
+    EXPECT_EQ(bits_of(parse("9007199254740992.99999999999999999999999999")), 0x4340000000000000ull);
+    EXPECT_EQ(bits_of(parse("9007199254740993.00000000000000000000000001")), 0x4340000000000001ull);
+}
+
+static String shortest(double value)
+{
+    char buffer[max_shortest_double_length];
+    return String(buffer, format_shortest(value, buffer));
+}
+
+TEST_CASE(shortest_strings)
+{
+    EXPECT_EQ(shortest(0), "0");
+    EXPECT_EQ(shortest(-0.0), "0");
+    EXPECT_EQ(shortest(1), "1");
+    EXPECT_EQ(shortest(-1.5), "-1.5");
+    EXPECT_EQ(shortest(0.1), "0.1");
+    EXPECT_EQ(shortest(0.1 + 0.2), "0.30000000000000004");
+    EXPECT_EQ(shortest(1.0 / 3), "0.3333333333333333");
+    EXPECT_EQ(shortest(123.456), "123.456");
+    EXPECT_EQ(shortest(1e20), "100000000000000000000");
+    EXPECT_EQ(shortest(1e21), "1e+21");
+    EXPECT_EQ(shortest(1.5e300), "1.5e+300");
+    EXPECT_EQ(shortest(0.000001), "0.000001");
+    EXPECT_EQ(shortest(1e-7), "1e-7");
+    EXPECT_EQ(shortest(-1.25e-7), "-1.25e-7");
+    EXPECT_EQ(shortest(5e-324), "5e-324");
+    EXPECT_EQ(shortest(1.7976931348623157e308), "1.7976931348623157e+308");
+    EXPECT_EQ(shortest(9007199254740992.0), "9007199254740992");
+    EXPECT_EQ(shortest(__builtin_nan("")), "NaN");
+    EXPECT_EQ(shortest(__builtin_huge_val()), "Infinity");
+    EXPECT_EQ(shortest(-__builtin_huge_val()), "-Infinity");
+    EXPECT_EQ(String::number(2.5), "2.5");
+}
+
+TEST_CASE(shortest_significand_and_exponent)
+{
+    auto decimal = shortest_decimal(1.5e-10);
+    EXPECT_EQ(decimal.significand, 15u);
+    EXPECT_EQ(decimal.exponent, -11);
+
+    decimal = shortest_decimal(1000);
+    EXPECT_EQ(decimal.significand, 1u);
+    EXPECT_EQ(decimal.exponent, 3);
+
+    // The lower neighbour of a power of two is closer than the upper one.
+    decimal = shortest_decimal(double_of(0x0010000000000000ull));
+    EXPECT_EQ(decimal.significand, 22250738585072014ull);
+    EXPECT_EQ(decimal.exponent, -324);
+}
+
+TEST_CASE(round_trip)
+{
+    // Walk through doubles of all magnitudes with a simple LCG.
+    u64 state = 0x853c49e6748fea9bull;
+    for (int i = 0; i < 100000; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        double value = double_of(state & 0x7fffffffffffffffull);
+        if (__builtin_isnan(value) || __builtin_isinf(value))
+            continue;
+        auto string = shortest(value);
+        EXPECT_EQ(bits_of(parse(string.characters())), bits_of(value));
+    }
+}
+
+TEST_CASE(printf_rounding)
+{
+    EXPECT_EQ(String::format("%f", 1.5), "1.500000");
+    EXPECT_EQ(String::format("%.2f", 2.675), "2.67");
+    EXPECT_EQ(String::format("%.0f", 0.5), "0");
+    EXPECT_EQ(String::format("%.0f", 1.5), "2");
+    EXPECT_EQ(String::format("%.0f", 2.5), "2");
+    EXPECT_EQ(String::format("%.1f", 0.05), "0.1");
+    EXPECT_EQ(String::format("%.3f", 9.9999), "10.000");
+    EXPECT_EQ(String::format("%.20f", 0.1), "0.10000000000000000555");
+    EXPECT_EQ(String::format("%f", 1e20), "100000000000000000000.000000");
+    EXPECT_EQ(String::format("%8.3f|", -1.5), "  -1.500|");
+    EXPECT_EQ(String::format("%-8.2f|", 1.5), "1.50    |");
+    EXPECT_EQ(String::format("%08.2f", -1.5), "-0001.50");
+    EXPECT_EQ(String::format("%+.1f", 1.0), "+1.0");
+    EXPECT_EQ(String::format("%e", 12345.678), "1.234568e+04");
+    EXPECT_EQ(String::format("%.2E", 0.000123), "1.23E-04");
+    EXPECT_EQ(String::format("%e", 0.0), "0.000000e+00");
+    EXPECT_EQ(String::format("%g", 0.0001), "0.0001");
+    EXPECT_EQ(String::format("%g", 0.00001), "1e-05");
+    EXPECT_EQ(String::format("%g", 123456.0), "123456");
+    EXPECT_EQ(String::format("%g", 1234567.0), "1.23457e+06");
+    EXPECT_EQ(String::format("%.10g", 0.1), "0.1");
+    EXPECT_EQ(String::format("%#g", 1.0), "1.00000");
+    EXPECT_EQ(String::format("%f", __builtin_huge_val()), "inf");
+    EXPECT_EQ(String::format("%F", -__builtin_huge_val()), "-INF");
+}
+
+BENCHMARK_CASE(format_and_parse)
+{
+    u64 state = 1;
+    for (int i = 0; i < 1000000; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        double value = static_cast<double>(state >> 40) / 1000;
+        char buffer[max_shortest_double_length];
+        size_t length = format_shortest(value, buffer);
+        EXPECT_EQ(decimal_to_double(StringView(buffer, length)), value);
+    }
+}
+
+TEST_MAIN(DoubleConversion)
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/TestSuite.h>
+
+#include <AK/FlyString.h>
+#include <AK/IPv4Address.h>
+#include <AK/String.h>
+#include <AK/StringBuilder.h>
+
+TEST_CASE(plain_strings)
+{
+    EXPECT_EQ(String::formatted(""), "");
+    EXPECT_EQ(String::formatted("hello friends"), "hello friends");
+    EXPECT_EQ(String::formatted("{{}}"), "{}");
+    EXPECT_EQ(String::formatted("{{{}}}", 1), "{1}");
+}
+
+TEST_CASE(string_parameters)
+{
+    EXPECT_EQ(String::formatted("{} {}", "well", String("hello")), "well hello");
+    EXPECT_EQ(String::formatted("{}{}", StringView("friends"), FlyString("!")), "friends!");
+    EXPECT_EQ(String::formatted("[{:>6}]", "abc"), "[   abc]");
+    EXPECT_EQ(String::formatted("[{:6}]", "abc"), "[abc   ]");
+    EXPECT_EQ(String::formatted("[{:*^7}]", "abc"), "[**abc**]");
+    EXPECT_EQ(String::formatted("[{:.2}]", "abc"), "[ab]");
+    EXPECT_EQ(String::formatted("{}", String()), "");
+}
+
+TEST_CASE(positional_parameters)
+{
+    EXPECT_EQ(String::formatted("{1} {0} {1}", "a", "b"), "b a b");
+    EXPECT_EQ(String::formatted("{0}{0}{0}", 7), "777");
+}
+
+TEST_CASE(integers)
+{
+    EXPECT_EQ(String::formatted("{}", 0), "0");
+    EXPECT_EQ(String::formatted("{} {} {}", -1, 42u, (u8)255), "-1 42 255");
+    EXPECT_EQ(String::formatted("{}", NumericLimits<i64>::min()), "-9223372036854775808");
+    EXPECT_EQ(String::formatted("{}", NumericLimits<u64>::max()), "18446744073709551615");
+    EXPECT_EQ(String::formatted("{}", (short)-300), "-300");
+    EXPECT_EQ(String::formatted("{:+} {:+}", 5, -5), "+5 -5");
+    EXPECT_EQ(String::formatted("{:x} {:X} {:#x} {:o} {:b}", 255, 255, 255, 8, 5), "ff FF 0xff 10 101");
+    EXPECT_EQ(String::formatted("{:04} {:04} {:#06x}", 42, -42, 10), "0042 -042 0x000a");
+    EXPECT_EQ(String::formatted("[{:5}] [{:<5}] [{:^5}]", 42, 42, 42), "[   42] [42   ] [ 42  ]");
+    EXPECT_EQ(String::formatted("{:c}", 65), "A");
+}
+
+TEST_CASE(characters_and_booleans)
+{
+    EXPECT_EQ(String::formatted("{}{}", 'o', 'k'), "ok");
+    EXPECT_EQ(String::formatted("{:d} {:x}", 'A', 'A'), "65 41");
+    EXPECT_EQ(String::formatted("{} {}", true, false), "true false");
+    EXPECT_EQ(String::formatted("{:d}", true), "1");
+}
+
+TEST_CASE(pointers)
+{
+    EXPECT_EQ(String::formatted("{}", (const void*)nullptr), sizeof(void*) == 8 ? "0x0000000000000000" : "0x00000000");
+    EXPECT_EQ(String::formatted("{}", (const int*)0x1234), sizeof(void*) == 8 ? "0x0000000000001234" : "0x00001234");
+    EXPECT_EQ(String::formatted("{:x}", (const int*)0x1234), "1234");
+}
+
+TEST_CASE(doubles)
+{
+    EXPECT_EQ(String::formatted("{}", 0.1), "0.1");
+    EXPECT_EQ(String::formatted("{}", -2.5), "-2.5");
+    EXPECT_EQ(String::formatted("{}", 1e21), "1e+21");
+    EXPECT_EQ(String::formatted("{:.2}", 3.14159), "3.14");
+    EXPECT_EQ(String::formatted("{:.3e}", 1234.5), "1.234e+03");
+    EXPECT_EQ(String::formatted("{:08.3f}", -3.14159), "-003.142");
+    EXPECT_EQ(String::formatted("{:+}", 1.5), "+1.5");
+    EXPECT_EQ(String::formatted("[{:>6}]", 1.5f), "[   1.5]");
+    EXPECT_EQ(String::formatted("{}", __builtin_huge_val()), "inf");
+}
+
+TEST_CASE(string_builder)
+{
+    StringBuilder builder;
+    builder.append("x=");
+    builder.appendff("{}, y={:02}", 1, 2);
+    EXPECT_EQ(builder.to_string(), "x=1, y=02");
+}
+
+TEST_CASE(matches_printf_formatting)
+{
+    EXPECT_EQ(IPv4Address(192, 168, 0, 1).to_string(), "192.168.0.1");
+    for (int i = -1000; i <= 1000; i += 7) {
+        EXPECT_EQ(String::formatted("{}", i), String::format("%d", i));
+        EXPECT_EQ(String::formatted("{:08x}", (unsigned)i), String::format("%08x", i));
+    }
+}
+
+struct Point {
+    int x;
+    int y;
+};
+
+template<>
+struct AK::Formatter<Point> {
+    static void format(FormatBuilder& builder, const Point& point, const FormatSpecifier&)
+    {
+        AK::format_integer(builder, point.x, false, {});
+        builder.append(',');
+        AK::format_integer(builder, point.y, false, {});
+    }
+};
+
+TEST_CASE(custom_formatter)
+{
+    EXPECT_EQ(String::formatted("({})", Point { 1, 2 }), "(1,2)");
+}
+
+BENCHMARK_CASE(format_vs_printf)
+{
+    for (int i = 0; i < 100000; ++i) {
+        auto string = String::formatted("{} little piggies went to {} ({:x})", i, "market", i);
+        EXPECT(!string.is_empty());
+    }
+}
+
+TEST_MAIN(Format)
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/TestSuite.h>
+
+#include <AK/HashTable.h>
+#include <AK/String.h>
+
+TEST_CASE(construct)
+{
+    typedef HashTable<int> IntTable;
+    EXPECT(IntTable().is_empty());
+    EXPECT_EQ(IntTable().size(), 0u);
+}
+
+TEST_CASE(populate)
+{
+    HashTable<String> strings;
+    strings.set("One");
+    strings.set("Two");
+    strings.set("Three");
+
+    EXPECT_EQ(strings.is_empty(), false);
+    EXPECT_EQ(strings.size(), 3u);
+}
+
+TEST_CASE(range_loop)
+{
+    HashTable<String> strings;
+    strings.set("One");
+    strings.set("Two");
+    strings.set("Three");
+
+    int loop_counter = 0;
+    for (auto& it : strings) {
+        EXPECT_EQ(it.is_null(), false);
+        ++loop_counter;
+    }
+    EXPECT_EQ(loop_counter, 3);
+}
+
+TEST_CASE(table_remove)
+{
+    HashTable<String> strings;
+    strings.set("One");
+    strings.set("Two");
+    strings.set("Three");
+
+    strings.remove("One");
+    EXPECT_EQ(strings.size(), 2u);
+    EXPECT(strings.find("One") == strings.end());
+
+    strings.remove("Three");
+    EXPECT_EQ(strings.size(), 1u);
+    EXPECT(strings.find("Three") == strings.end());
+    EXPECT(strings.find("Two") != strings.end());
+}
+
+TEST_CASE(set_existing_value)
+{
+    HashTable<int> ints;
+    ints.set(42);
+    ints.set(42);
+    EXPECT_EQ(ints.size(), 1u);
+}
+
+TEST_CASE(many_values)
+{
+    HashTable<int> ints;
+    for (int i = 0; i < 10000; ++i)
+        ints.set(i);
+    EXPECT_EQ(ints.size(), 10000u);
+
+    for (int i = 0; i < 10000; ++i)
+        EXPECT(ints.contains(i));
+    EXPECT(!ints.contains(10000));
+
+    for (int i = 0; i < 10000; i += 2)
+        ints.remove(i);
+    EXPECT_EQ(ints.size(), 5000u);
+
+    for (int i = 0; i < 10000; ++i)
+        EXPECT_EQ(ints.contains(i), (i % 2) != 0);
+}
+
+TEST_CASE(remove_while_iterating)
+{
+    HashTable<int> ints;
+    for (int i = 0; i < 100; ++i)
+        ints.set(i);
+
+    for (auto it = ints.begin(); it != ints.end(); ++it) {
+        if (*it % 3 == 0)
+            ints.remove(it);
+    }
+    EXPECT_EQ(ints.size(), 66u);
+    for (auto& it : ints)
+        EXPECT(it % 3 != 0);
+}
+
+TEST_CASE(reuse_deleted_buckets)
+{
+    // Repeatedly inserting and removing must not grow the table without bound.
+    HashTable<int> ints;
+    for (int i = 0; i < 100000; ++i) {
+        ints.set(i);
+        ints.remove(i);
+    }
+    EXPECT(ints.is_empty());
+    EXPECT(ints.capacity() <= 16u);
+}
+
+TEST_CASE(copy_and_move)
+{
+    HashTable<String> strings;
+    strings.set("One");
+    strings.set("Two");
+
+    auto copy = strings;
+    EXPECT_EQ(copy.size(), 2u);
+    EXPECT(copy.contains("One"));
+    EXPECT(copy.contains("Two"));
+
+    auto moved = move(strings);
+    EXPECT_EQ(moved.size(), 2u);
+    EXPECT(strings.is_empty());
+    EXPECT(strings.begin() == strings.end());
+    EXPECT(moved.contains("One"));
+}
+
+TEST_CASE(ensure_capacity)
+{
+    HashTable<int> ints;
+    ints.ensure_capacity(1000);
+    size_t capacity = ints.capacity();
+    for (int i = 0; i < 1000; ++i)
+        ints.set(i);
+    EXPECT_EQ(ints.capacity(), capacity);
+}
+
+BENCHMARK_CASE(hashtable_insert_find_remove)
+{
+    HashTable<int> ints;
+    for (int i = 0; i < 1000000; ++i)
+        ints.set(i);
+    for (int round = 0; round < 4; ++round) {
+        for (int i = 0; i < 1000000; ++i)
+            EXPECT(ints.contains(i));
+    }
+    for (int i = 0; i < 1000000; i += 2)
+        ints.remove(i);
+    EXPECT_EQ(ints.size(), 500000u);
+}
+
+BENCHMARK_CASE(hashtable_iterate)
+{
+    HashTable<int> ints;
+    for (int i = 0; i < 100000; ++i)
+        ints.set(i);
+    for (int round = 0; round < 100; ++round) {
+        size_t count = 0;
+        for (auto& it : ints) {
+            (void)it;
+            ++count;
+        }
+        EXPECT_EQ(count, 100000u);
+    }
+}
+
+BENCHMARK_CASE(hashtable_string_keys)
+{
+    Vector<String> keys;
+    for (int i = 0; i < 100000; ++i)
+        keys.append(String::number(i));
+    HashTable<String> strings;
+    for (auto& key : keys)
+        strings.set(key);
+    for (auto& key : keys)
+        EXPECT(strings.contains(key));
+    for (auto& key : keys)
+        strings.remove(key);
+    EXPECT(strings.is_empty());
+}
+
+TEST_MAIN(HashTable)
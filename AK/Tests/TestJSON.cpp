@@ -29,6 +29,7 @@
 #include <AK/HashMap.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
+#include <AK/JsonPullParser.h>
 #include <AK/JsonValue.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
@@ -92,6 +93,165 @@ BENCHMARK_CASE(load_4chan_catalog)
     }
 }
 
+BENCHMARK_CASE(pull_4chan_catalog)
+{
+    FILE* fp = fopen("4chan_catalog.json", "r");
+    ASSERT(fp);
+
+    StringBuilder builder;
+    for (;;) {
+        char buffer[1024];
+        if (!fgets(buffer, sizeof(buffer), fp))
+            break;
+        builder.append(buffer);
+    }
+
+    fclose(fp);
+
+    auto json_string = builder.to_string();
+
+    for (int i = 0; i < 10; ++i) {
+        JsonPullParser parser(json_string);
+        size_t key_count = 0;
+        for (;;) {
+            auto token = parser.next();
+            if (token == JsonPullParser::Token::Key)
+                ++key_count;
+            if (token == JsonPullParser::Token::EndOfInput || token == JsonPullParser::Token::Error)
+                break;
+        }
+        EXPECT(!parser.has_error());
+        EXPECT(key_count > 0);
+    }
+}
+
+TEST_CASE(pull_parser_tokens)
+{
+    using Token = JsonPullParser::Token;
+    JsonPullParser parser(" { \"name\": \"Well \\\"hello\\\"\", \"list\": [1, -2, 3.5, true, false, null], \"empty\": {} } ");
+    EXPECT(parser.next() == Token::BeginObject);
+    EXPECT(parser.next() == Token::Key);
+    EXPECT_EQ(parser.string(), "name");
+    EXPECT(parser.next() == Token::String);
+    EXPECT_EQ(parser.string(), "Well \"hello\"");
+    EXPECT(parser.next() == Token::Key);
+    EXPECT_EQ(parser.string(), "list");
+    EXPECT(parser.next() == Token::BeginArray);
+    EXPECT(parser.next() == Token::Number);
+    EXPECT_EQ(parser.to_u32(), 1u);
+    EXPECT(parser.next() == Token::Number);
+    EXPECT_EQ(parser.to_i32(), -2);
+    EXPECT(parser.next() == Token::Number);
+    EXPECT_EQ(parser.number(), "3.5");
+    EXPECT_EQ(parser.to_i32(), 3);
+    EXPECT(parser.next() == Token::True);
+    EXPECT(parser.next() == Token::False);
+    EXPECT(parser.next() == Token::Null);
+    EXPECT(parser.next() == Token::EndArray);
+    EXPECT(parser.next() == Token::Key);
+    EXPECT(parser.next() == Token::BeginObject);
+    EXPECT(parser.next() == Token::EndObject);
+    EXPECT(parser.next() == Token::EndObject);
+    EXPECT(parser.next() == Token::EndOfInput);
+}
+
+TEST_CASE(pull_parser_unescaped_strings_are_not_copied)
+{
+    StringView input = "[\"abc\"]";
+    JsonPullParser parser(input);
+    parser.next();
+    EXPECT(parser.next() == JsonPullParser::Token::String);
+    EXPECT_EQ(parser.string().characters_without_null_termination(), input.characters_without_null_termination() + 2);
+}
+
+TEST_CASE(pull_parser_escaped_key_survives_escaped_value)
+{
+    JsonPullParser parser("{\"k\\u0065y\": \"v\\u0061lue\"}");
+    EXPECT(parser.next() == JsonPullParser::Token::BeginObject);
+    EXPECT(parser.next() == JsonPullParser::Token::Key);
+    auto key = parser.string();
+    EXPECT(parser.next() == JsonPullParser::Token::String);
+    EXPECT_EQ(parser.string(), "value");
+    EXPECT_EQ(key, "key");
+}
+
+TEST_CASE(pull_parser_skip_value)
+{
+    using Token = JsonPullParser::Token;
+    JsonPullParser parser("{\"skip\": {\"a\": [1, {\"b\": 2}]}, \"keep\": 42}");
+    EXPECT(parser.next() == Token::BeginObject);
+    EXPECT(parser.next() == Token::Key);
+    EXPECT(parser.next() == Token::BeginObject);
+    parser.skip_value();
+    EXPECT(parser.next() == Token::Key);
+    EXPECT_EQ(parser.string(), "keep");
+    EXPECT(parser.next() == Token::Number);
+    EXPECT_EQ(parser.to_u32(), 42u);
+}
+
+TEST_CASE(pull_parser_value)
+{
+    JsonPullParser parser("[{\"x\": 1, \"y\": [\"a\", \"b\"]}, 2]");
+    EXPECT(parser.next() == JsonPullParser::Token::BeginArray);
+    EXPECT(parser.next() == JsonPullParser::Token::BeginObject);
+    auto object = parser.value();
+    EXPECT(object.is_object());
+    EXPECT_EQ(object.as_object().get("x").to_u32(), 1u);
+    EXPECT_EQ(object.as_object().get("y").as_array().size(), 2);
+    EXPECT(parser.next() == JsonPullParser::Token::Number);
+    EXPECT(parser.next() == JsonPullParser::Token::EndArray);
+    EXPECT(parser.next() == JsonPullParser::Token::EndOfInput);
+}
+
+TEST_CASE(pull_parser_errors)
+{
+    using Token = JsonPullParser::Token;
+    auto ends_with_error = [](const StringView& input) {
+        JsonPullParser parser(input);
+        for (;;) {
+            auto token = parser.next();
+            if (token == Token::Error)
+                return true;
+            if (token == Token::EndOfInput)
+                return false;
+        }
+    };
+    EXPECT(!ends_with_error("[1, 2]"));
+    EXPECT(ends_with_error("[1, 2"));
+    EXPECT(ends_with_error("{\"a\" 1}"));
+    EXPECT(ends_with_error("{1: 2}"));
+    EXPECT(ends_with_error("\"unterminated"));
+    EXPECT(ends_with_error("[1] 2"));
+    EXPECT(ends_with_error("[tru]"));
+    EXPECT(ends_with_error("[1e]"));
+    EXPECT(ends_with_error("[1.]"));
+    EXPECT(ends_with_error("[-]"));
+    EXPECT(ends_with_error("[1-2]"));
+    EXPECT(ends_with_error("[1e+-2]"));
+}
+
+TEST_CASE(pull_parser_integer_exponents)
+{
+    auto to_i32 = [](const StringView& input) {
+        JsonPullParser parser(input);
+        EXPECT(parser.next() == JsonPullParser::Token::Number);
+        return parser.to_i32(7);
+    };
+    EXPECT_EQ(to_i32("1e5"), 100000);
+    EXPECT_EQ(to_i32("1E5"), 100000);
+    EXPECT_EQ(to_i32("-1E+2"), -100);
+    EXPECT_EQ(to_i32("12e-1"), 1);
+    EXPECT_EQ(to_i32("3.5"), 3);
+    EXPECT_EQ(to_i32("1e40"), 7);
+    EXPECT_EQ(to_i32("0e400"), 0);
+
+    JsonPullParser parser("[1e5, -2E+2]");
+    EXPECT(parser.next() == JsonPullParser::Token::BeginArray);
+    auto value = parser.value();
+    EXPECT_EQ(value.as_array().at(0).to_i32(), 100000);
+    EXPECT_EQ(value.as_array().at(1).to_i32(), -200);
+}
+
 TEST_CASE(json_empty_string)
 {
     auto json = JsonValue::from_string("\"\"");
@@ -108,4 +268,38 @@ TEST_CASE(json_utf8_character)
     EXPECT_EQ(json.as_string().length(), size_t { 2 });
 }
 
+TEST_CASE(json_doubles)
+{
+    auto json = JsonValue::from_string("[0.1, -2.5, 123456789.125, 0.30000000000000004]");
+    auto& array = json.as_array();
+    EXPECT_EQ(array.at(0).as_double(), 0.1);
+    EXPECT_EQ(array.at(1).as_double(), -2.5);
+    EXPECT_EQ(array.at(2).as_double(), 123456789.125);
+    EXPECT_EQ(array.at(3).as_double(), 0.1 + 0.2);
+    EXPECT_EQ(json.to_string(), "[0.1,-2.5,123456789.125,0.30000000000000004]");
+
+    JsonPullParser parser("-0.75");
+    EXPECT(parser.next() == JsonPullParser::Token::Number);
+    EXPECT_EQ(parser.value().as_double(), -0.75);
+}
+
+TEST_CASE(pull_parser_double_exponents)
+{
+    auto to_double = [](const StringView& input) {
+        JsonPullParser parser(input);
+        EXPECT(parser.next() == JsonPullParser::Token::Number);
+        auto value = parser.value();
+        EXPECT(value.is_double());
+        return value.as_double();
+    };
+    EXPECT_EQ(to_double("1.5e3"), 1500.0);
+    EXPECT_EQ(to_double("2.5E-2"), 0.025);
+    EXPECT_EQ(to_double("-1E+2"), -100.0);
+    EXPECT_EQ(to_double("1e5"), 100000.0);
+    EXPECT_EQ(to_double("6.02214076e23"), 6.02214076e23);
+    EXPECT_EQ(to_double("-0.5e-3"), -0.0005);
+    EXPECT_EQ(to_double("1e400"), __builtin_huge_val());
+    EXPECT_EQ(to_double("1e-99999999999"), 0.0);
+}
+
 TEST_MAIN(JSON)
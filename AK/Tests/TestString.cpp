@@ -210,4 +210,37 @@ TEST_CASE(builder_zero_initial_capacity)
    EXPECT_EQ(built.length(), 0u);
 }
 
+TEST_CASE(single_character_strings_are_shared)
+{
+    String a = "x";
+    String b = String("xyz").substring(0, 1);
+    EXPECT_EQ(a.impl(), b.impl());
+    EXPECT_EQ(a, "x");
+}
+
+TEST_CASE(substring)
+{
+    String test_string = "The quick brown fox jumps over the lazy dog, twice";
+    EXPECT_EQ(test_string.substring(4, 5), "quick");
+    EXPECT_EQ(test_string.substring(0, test_string.length()).impl(), test_string.impl());
+
+    // Long suffixes share the original buffer, and stay null-terminated.
+    auto suffix = test_string.substring(10, test_string.length() - 10);
+    EXPECT(suffix.impl()->is_substring());
+    EXPECT(!strcmp(suffix.characters(), "brown fox jumps over the lazy dog, twice"));
+    EXPECT_EQ(suffix.characters(), test_string.characters() + 10);
+    EXPECT_EQ(suffix.hash(), String("brown fox jumps over the lazy dog, twice").hash());
+
+    auto suffix_of_suffix = suffix.substring(2, suffix.length() - 2);
+    EXPECT(suffix_of_suffix.impl()->is_substring());
+    EXPECT_EQ(suffix_of_suffix, "own fox jumps over the lazy dog, twice");
+
+    // The suffix keeps the buffer alive after the original goes away.
+    test_string = {};
+    EXPECT_EQ(suffix, "brown fox jumps over the lazy dog, twice");
+
+    // Short suffixes are copied.
+    EXPECT(!suffix.substring(30, 10).impl()->is_substring());
+}
+
 TEST_MAIN(String)
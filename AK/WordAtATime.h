@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+// Word-at-a-time implementations of the simple C memory and string
+// functions, shared by LibC and the kernel.
+//
+// The string scanners read whole aligned words, which may extend past the
+// end of the string. An aligned word never straddles a page boundary, so
+// this can't fault as long as one of its bytes is part of the input.
+
+namespace AK {
+namespace WordAtATime {
+
+typedef FlatPtr __attribute__((may_alias)) Word;
+
+static constexpr Word ones = (Word)-1 / 0xff;
+static constexpr Word highs = ones * 0x80;
+
+ALWAYS_INLINE constexpr bool has_zero_byte(Word word)
+{
+    return (word - ones) & ~word & highs;
+}
+
+ALWAYS_INLINE constexpr Word repeat_byte(u8 byte)
+{
+    return ones * byte;
+}
+
+ALWAYS_INLINE bool is_word_aligned(const void* ptr)
+{
+    return !((FlatPtr)ptr & (sizeof(Word) - 1));
+}
+
+inline size_t strlen(const char* str)
+{
+    const char* ptr = str;
+    for (; !is_word_aligned(ptr); ++ptr) {
+        if (!*ptr)
+            return ptr - str;
+    }
+    auto* word = (const Word*)ptr;
+    while (!has_zero_byte(*word))
+        ++word;
+    for (ptr = (const char*)word; *ptr; ++ptr)
+        ;
+    return ptr - str;
+}
+
+inline const void* memchr(const void* buffer, int c, size_t size)
+{
+    auto* ptr = (const u8*)buffer;
+    u8 byte = c;
+    for (; size && !is_word_aligned(ptr); ++ptr, --size) {
+        if (*ptr == byte)
+            return ptr;
+    }
+    Word pattern = repeat_byte(byte);
+    for (; size >= sizeof(Word); ptr += sizeof(Word), size -= sizeof(Word)) {
+        if (has_zero_byte(*(const Word*)ptr ^ pattern))
+            break;
+    }
+    for (; size; ++ptr, --size) {
+        if (*ptr == byte)
+            return ptr;
+    }
+    return nullptr;
+}
+
+inline size_t strnlen(const char* str, size_t maxlen)
+{
+    auto* end = (const char*)memchr(str, 0, maxlen);
+    return end ? end - str : maxlen;
+}
+
+inline const char* strchr(const char* str, int c)
+{
+    char ch = c;
+    for (; !is_word_aligned(str); ++str) {
+        if (*str == ch)
+            return str;
+        if (!*str)
+            return nullptr;
+    }
+    Word pattern = repeat_byte(ch);
+    auto* word = (const Word*)str;
+    while (!has_zero_byte(*word) && !has_zero_byte(*word ^ pattern))
+        ++word;
+    for (str = (const char*)word;; ++str) {
+        if (*str == ch)
+            return str;
+        if (!*str)
+            return nullptr;
+    }
+}
+
+inline int memcmp(const void* v1, const void* v2, size_t n)
+{
+    auto* s1 = (const u8*)v1;
+    auto* s2 = (const u8*)v2;
+    // x86 handles unaligned word loads just fine, so only the tail needs bytewise treatment.
+    for (; n >= sizeof(Word); s1 += sizeof(Word), s2 += sizeof(Word), n -= sizeof(Word)) {
+        if (*(const Word*)s1 != *(const Word*)s2)
+            break;
+    }
+    for (; n; ++s1, ++s2, --n) {
+        if (*s1 != *s2)
+            return *s1 < *s2 ? -1 : 1;
+    }
+    return 0;
+}
+
+}
+}
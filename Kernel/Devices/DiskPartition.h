@@ -38,6 +38,7 @@ public:
 
     virtual bool read_blocks(unsigned index, u16 count, u8*) override;
     virtual bool write_blocks(unsigned index, u16 count, const u8*) override;
+    virtual u64 size_in_bytes() const override { return (u64)(m_block_limit - m_block_offset) * block_size(); }
 
     // ^BlockDevice
     virtual ssize_t read(FileDescription&, size_t, u8*, ssize_t) override;
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <Kernel/Devices/MemoryPressureDevice.h>
+#include <Kernel/FileSystem/FileDescription.h>
+#include <Kernel/VM/MemoryManager.h>
+
+namespace Kernel {
+
+MemoryPressureDevice::MemoryPressureDevice()
+    : CharacterDevice(1, 10)
+{
+}
+
+MemoryPressureDevice::~MemoryPressureDevice()
+{
+}
+
+KResultOr<NonnullRefPtr<FileDescription>> MemoryPressureDevice::open(int options)
+{
+    auto description = FileDescription::create(MemoryPressureWatcher::create());
+    description->set_rw_mode(options);
+    description->set_file_flags(options);
+    return description;
+}
+
+NonnullRefPtr<MemoryPressureWatcher> MemoryPressureWatcher::create()
+{
+    return adopt(*new MemoryPressureWatcher);
+}
+
+MemoryPressureWatcher::MemoryPressureWatcher()
+{
+}
+
+MemoryPressureWatcher::~MemoryPressureWatcher()
+{
+}
+
+bool MemoryPressureWatcher::can_read(const FileDescription&, size_t) const
+{
+    // The first read always reports the current level; after that, we wait for a change.
+    return !m_has_reported || m_last_seen_generation != MM.memory_pressure_generation();
+}
+
+ssize_t MemoryPressureWatcher::read(FileDescription&, size_t, u8* buffer, ssize_t buffer_size)
+{
+    if (buffer_size < 1)
+        return -EINVAL;
+    InterruptDisabler disabler;
+    m_last_seen_generation = MM.memory_pressure_generation();
+    m_has_reported = true;
+    buffer[0] = (u8)MM.memory_pressure();
+    return 1;
+}
+
+}
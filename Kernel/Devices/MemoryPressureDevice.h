@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <Kernel/Devices/CharacterDevice.h>
+
+namespace Kernel {
+
+// Opening /dev/mempressure vends a MemoryPressureWatcher. Each watcher becomes readable
+// whenever the system memory pressure level changes, and reading it yields a single byte
+// holding the current level (0 = none, 1 = low, 2 = critical).
+class MemoryPressureDevice final : public CharacterDevice {
+    AK_MAKE_ETERNAL
+public:
+    MemoryPressureDevice();
+    virtual ~MemoryPressureDevice() override;
+
+    // ^CharacterDevice
+    virtual KResultOr<NonnullRefPtr<FileDescription>> open(int options) override;
+    virtual ssize_t read(FileDescription&, size_t, u8*, ssize_t) override { return 0; }
+    virtual ssize_t write(FileDescription&, size_t, const u8*, ssize_t) override { return -EIO; }
+    virtual bool can_read(const FileDescription&, size_t) const override { return true; }
+    virtual bool can_write(const FileDescription&, size_t) const override { return true; }
+
+private:
+    // ^CharacterDevice
+    virtual const char* class_name() const override { return "MemoryPressureDevice"; }
+};
+
+class MemoryPressureWatcher final : public File {
+public:
+    static NonnullRefPtr<MemoryPressureWatcher> create();
+    virtual ~MemoryPressureWatcher() override;
+
+    virtual bool can_read(const FileDescription&, size_t) const override;
+    virtual bool can_write(const FileDescription&, size_t) const override { return true; }
+    virtual ssize_t read(FileDescription&, size_t, u8*, ssize_t) override;
+    virtual ssize_t write(FileDescription&, size_t, const u8*, ssize_t) override { return -EIO; }
+    virtual String absolute_path(const FileDescription&) const override { return "MemoryPressureWatcher"; }
+    virtual const char* class_name() const override { return "MemoryPressureWatcher"; }
+
+private:
+    MemoryPressureWatcher();
+
+    u32 m_last_seen_generation { 0 };
+    bool m_has_reported { false };
+};
+
+}
@@ -527,7 +527,7 @@ void Ext2FS::flush_block_group_descriptor_table()
     write_blocks(first_block_of_bgdt, blocks_to_write, (const u8*)block_group_descriptors());
 }
 
-void Ext2FS::flush_writes()
+void Ext2FS::flush_cached_metadata()
 {
     LOCKER(m_lock);
     if (m_super_block_dirty) {
@@ -547,9 +547,26 @@ void Ext2FS::flush_writes()
 #endif
         }
     }
+}
 
+void Ext2FS::flush_writes()
+{
+    LOCKER(m_lock);
+    flush_cached_metadata();
     FileBackedFS::flush_writes();
+    uncache_unused_inodes();
+}
+
+void Ext2FS::flush_expired_writes()
+{
+    LOCKER(m_lock);
+    flush_cached_metadata();
+    FileBackedFS::flush_expired_writes();
+    uncache_unused_inodes();
+}
 
+void Ext2FS::uncache_unused_inodes()
+{
     // Uncache Inodes that are only kept alive by the index-to-inode lookup cache.
     // We don't uncache Inodes that are being watched by at least one InodeWatcher.
 
@@ -606,6 +623,21 @@ InodeMetadata Ext2FSInode::metadata() const
     return metadata;
 }
 
+KResult Ext2FSInode::fsync()
+{
+    LOCKER(m_lock);
+    if (is_metadata_dirty())
+        flush_metadata();
+
+    auto blocks_to_flush = fs().block_list_for_inode(m_raw_inode, true);
+    unsigned block_containing_inode;
+    unsigned offset;
+    if (fs().find_block_containing_inode(index(), block_containing_inode, offset))
+        blocks_to_flush.append(block_containing_inode);
+    fs().flush_blocks(blocks_to_flush);
+    return KSuccess;
+}
+
 void Ext2FSInode::flush_metadata()
 {
     LOCKER(m_lock);
@@ -24,6 +24,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <AK/HashTable.h>
 #include <AK/StringView.h>
 #include <Kernel/Arch/i386/CPU.h>
 #include <Kernel/Devices/BlockDevice.h>
@@ -36,8 +37,12 @@
 
 namespace Kernel {
 
+// Dirty blocks older than this are written back by the SyncTask.
+static constexpr time_t dirty_expire_seconds = 5;
+
 struct CacheEntry {
     time_t timestamp { 0 };
+    time_t dirtied_at { 0 };
     u32 block_index { 0 };
     u8* data { nullptr };
     bool has_data { false };
@@ -58,8 +63,31 @@ public:
 
     ~DiskCache() { }
 
-    bool is_dirty() const { return m_dirty; }
-    void set_dirty(bool b) { m_dirty = b; }
+    bool is_dirty() const { return m_dirty_count; }
+    size_t dirty_count() const { return m_dirty_count; }
+
+    // Writers are made to flush some of their own dirty blocks once this many are pending,
+    // so that get() practically never runs out of clean entries on behalf of a reader.
+    size_t dirty_throttle_threshold() const { return m_entry_count / 2; }
+    size_t dirty_background_threshold() const { return m_entry_count / 4; }
+
+    void mark_dirty(CacheEntry& entry)
+    {
+        if (entry.is_dirty)
+            return;
+        entry.is_dirty = true;
+        entry.dirtied_at = kgettimeofday().tv_sec;
+        ++m_dirty_count;
+    }
+
+    void mark_clean(CacheEntry& entry)
+    {
+        if (!entry.is_dirty)
+            return;
+        entry.is_dirty = false;
+        ASSERT(m_dirty_count);
+        --m_dirty_count;
+    }
 
     CacheEntry& get(u32 block_index) const
     {
@@ -111,7 +139,7 @@ private:
     size_t m_entry_count { 10000 };
     KBuffer m_cached_block_data;
     KBuffer m_entries;
-    bool m_dirty { false };
+    size_t m_dirty_count { 0 };
 };
 
 FileBackedFS::FileBackedFS(FileDescription& file_description)
@@ -149,10 +177,11 @@ bool FileBackedFS::write_block(unsigned index, const u8* data, size_t count, siz
         read_block(index, nullptr, block_size());
     }
     memcpy(entry.data + offset, data, count);
-    entry.is_dirty = true;
     entry.has_data = true;
+    cache().mark_dirty(entry);
 
-    cache().set_dirty(true);
+    if (cache().dirty_count() > cache().dirty_throttle_threshold())
+        throttle_writes();
     return true;
 }
 
@@ -255,38 +284,65 @@ bool FileBackedFS::read_blocks(unsigned index, unsigned count, u8* buffer, bool
     return true;
 }
 
-void FileBackedFS::flush_specific_block_if_needed(unsigned index)
-{
-    LOCKER(m_lock);
-    if (!cache().is_dirty())
-        return;
-    cache().for_each_entry([&](CacheEntry& entry) {
-        if (entry.is_dirty && entry.block_index == index) {
-            u32 base_offset = static_cast<u32>(entry.block_index) * static_cast<u32>(block_size());
-            m_file_description->seek(base_offset, SEEK_SET);
-            m_file_description->write(entry.data, block_size());
-            entry.is_dirty = false;
-        }
-    });
-}
-
-void FileBackedFS::flush_writes_impl()
+template<typename Callback>
+size_t FileBackedFS::flush_dirty_entries(Callback callback)
 {
     LOCKER(m_lock);
     if (!cache().is_dirty())
-        return;
-    u32 count = 0;
+        return 0;
+    size_t count = 0;
     cache().for_each_entry([&](CacheEntry& entry) {
-        if (!entry.is_dirty)
+        if (!entry.is_dirty || !callback(entry))
             return;
         u32 base_offset = static_cast<u32>(entry.block_index) * static_cast<u32>(block_size());
         m_file_description->seek(base_offset, SEEK_SET);
         m_file_description->write(entry.data, block_size());
         ++count;
-        entry.is_dirty = false;
+        cache().mark_clean(entry);
+    });
+    return count;
+}
+
+void FileBackedFS::flush_specific_block_if_needed(unsigned index)
+{
+    flush_dirty_entries([&](auto& entry) {
+        return entry.block_index == index;
+    });
+}
+
+void FileBackedFS::flush_blocks(const Vector<unsigned>& indices)
+{
+    if (indices.is_empty())
+        return;
+    HashTable<unsigned> blocks_to_flush;
+    for (auto index : indices)
+        blocks_to_flush.set(index);
+    flush_dirty_entries([&](auto& entry) {
+        return blocks_to_flush.contains(entry.block_index);
+    });
+}
+
+void FileBackedFS::throttle_writes()
+{
+    auto background_threshold = cache().dirty_background_threshold();
+    flush_dirty_entries([&](auto&) {
+        return cache().dirty_count() > background_threshold;
+    });
+}
+
+void FileBackedFS::flush_writes_impl()
+{
+    auto count = flush_dirty_entries([](auto&) { return true; });
+    if (count)
+        dbg() << class_name() << ": Flushed " << count << " blocks to disk";
+}
+
+void FileBackedFS::flush_expired_writes()
+{
+    auto cutoff = kgettimeofday().tv_sec - dirty_expire_seconds;
+    flush_dirty_entries([&](auto& entry) {
+        return entry.dirtied_at <= cutoff;
     });
-    cache().set_dirty(false);
-    dbg() << class_name() << ": Flushed " << count << " blocks to disk";
 }
 
 void FileBackedFS::flush_writes()
@@ -42,6 +42,7 @@ public:
     const FileDescription& file_description() const { return *m_file_description; }
 
     virtual void flush_writes() override;
+    virtual void flush_expired_writes() override;
 
     void flush_writes_impl();
 
@@ -62,6 +63,8 @@ protected:
     bool write_block(unsigned index, const u8* buffer, size_t count, size_t offset = 0, bool allow_cache = true);
     bool write_blocks(unsigned index, unsigned count, const u8*, bool allow_cache = true);
 
+    void flush_blocks(const Vector<unsigned>& indices);
+
     size_t m_logical_block_size { 512 };
 
 private:
@@ -69,6 +72,10 @@ private:
 
     DiskCache& cache() const;
     void flush_specific_block_if_needed(unsigned index);
+    void throttle_writes();
+
+    template<typename Callback>
+    size_t flush_dirty_entries(Callback);
 
     mutable NonnullRefPtr<FileDescription> m_file_description;
     mutable OwnPtr<DiskCache> m_cache;
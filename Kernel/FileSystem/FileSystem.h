@@ -52,6 +52,7 @@ public:
     unsigned fsid() const { return m_fsid; }
     static FS* from_fsid(u32);
     static void sync();
+    static void writeback();
     static void lock_all();
 
     virtual bool initialize() = 0;
@@ -84,6 +85,7 @@ public:
     virtual RefPtr<Inode> get_inode(InodeIdentifier) const = 0;
 
     virtual void flush_writes() { }
+    virtual void flush_expired_writes() { flush_writes(); }
 
     size_t block_size() const { return m_block_size; }
 
@@ -32,6 +32,7 @@
 #include <Kernel/FileSystem/InodeWatcher.h>
 #include <Kernel/FileSystem/VirtualFileSystem.h>
 #include <Kernel/Net/LocalSocket.h>
+#include <Kernel/VM/PhysicalPage.h>
 #include <Kernel/VM/SharedInodeVMObject.h>
 
 namespace Kernel {
@@ -61,6 +62,18 @@ void Inode::sync()
     }
 }
 
+KResult Inode::fsync()
+{
+    if (is_metadata_dirty())
+        flush_metadata();
+    return KSuccess;
+}
+
+RefPtr<PhysicalPage> Inode::physical_page_for_mapping(size_t)
+{
+    return nullptr;
+}
+
 KResultOr<ByteBuffer> Inode::read_entire(FileDescription* descriptor) const
 {
     size_t initial_size = metadata().size ? metadata().size : 4096;
@@ -78,6 +78,9 @@ public:
     virtual KResult chmod(mode_t) = 0;
     virtual KResult chown(uid_t, gid_t) = 0;
     virtual KResult truncate(u64) { return KSuccess; }
+    // Inodes that keep their contents in physical pages (e.g TmpFS) can hand those out
+    // directly, so that mappings of the inode share its storage instead of copying it.
+    virtual RefPtr<PhysicalPage> physical_page_for_mapping(size_t page_index);
     virtual KResultOr<NonnullRefPtr<Custody>> resolve_as_link(Custody& base, RefPtr<Custody>* out_parent = nullptr, int options = 0, int symlink_recursion_level = 0) const;
 
     LocalSocket* socket() { return m_socket.ptr(); }
@@ -96,6 +99,7 @@ public:
     virtual KResult decrement_link_count();
 
     virtual void flush_metadata() = 0;
+    virtual KResult fsync();
 
     void will_be_destroyed();
 
@@ -56,6 +56,7 @@
 #include <Kernel/TTY/TTY.h>
 #include <Kernel/VM/MemoryManager.h>
 #include <Kernel/VM/PurgeableVMObject.h>
+#include <Kernel/VM/SwapSpace.h>
 #include <LibC/errno_numbers.h>
 
 namespace Kernel {
@@ -830,6 +831,12 @@ Optional<KBuffer> procfs$memstat(InodeIdentifier)
     json.add("user_physical_available", MM.user_physical_pages() - MM.user_physical_pages_used());
     json.add("super_physical_allocated", MM.super_physical_pages_used());
     json.add("super_physical_available", MM.super_physical_pages() - MM.super_physical_pages_used());
+    json.add("memory_pressure", (int)MM.memory_pressure());
+    auto* swap = SwapSpace::the();
+    json.add("swap_total", swap ? swap->slot_count() : 0);
+    json.add("swap_used", swap ? swap->used_slot_count() : 0);
+    json.add("swap_in_count", swap ? swap->swap_in_count() : 0);
+    json.add("swap_out_count", swap ? swap->swap_out_count() : 0);
     json.add("kmalloc_call_count", g_kmalloc_call_count);
     json.add("kfree_call_count", g_kfree_call_count);
     slab_alloc_stats([&json](size_t slab_size, size_t num_allocated, size_t num_free) {
@@ -27,6 +27,7 @@
 #include <Kernel/FileSystem/TmpFS.h>
 #include <Kernel/Process.h>
 #include <Kernel/Thread.h>
+#include <Kernel/VM/MemoryManager.h>
 
 namespace Kernel {
 
@@ -37,6 +38,8 @@ NonnullRefPtr<TmpFS> TmpFS::create()
 
 TmpFS::TmpFS()
 {
+    // FIXME: Allow choosing the size limit when mounting.
+    m_max_page_count = MM.user_physical_pages() / 2;
 }
 
 TmpFS::~TmpFS()
@@ -45,6 +48,7 @@ TmpFS::~TmpFS()
 
 bool TmpFS::initialize()
 {
+    set_block_size(PAGE_SIZE);
     m_root_inode = TmpFSInode::create_root(*this);
     return true;
 }
@@ -72,6 +76,22 @@ void TmpFS::unregister_inode(InodeIdentifier identifier)
     m_inodes.remove(identifier.index());
 }
 
+bool TmpFS::try_commit_pages(size_t count)
+{
+    LOCKER(m_lock);
+    if (m_committed_page_count + count > m_max_page_count)
+        return false;
+    m_committed_page_count += count;
+    return true;
+}
+
+void TmpFS::uncommit_pages(size_t count)
+{
+    LOCKER(m_lock);
+    ASSERT(count <= m_committed_page_count);
+    m_committed_page_count -= count;
+}
+
 unsigned TmpFS::next_inode_index()
 {
     LOCKER(m_lock);
@@ -143,6 +163,8 @@ TmpFSInode::TmpFSInode(TmpFS& fs, InodeMetadata metadata, InodeIdentifier parent
 
 TmpFSInode::~TmpFSInode()
 {
+    if (m_committed_page_count)
+        fs().uncommit_pages(m_committed_page_count);
 }
 
 NonnullRefPtr<TmpFSInode> TmpFSInode::create(TmpFS& fs, InodeMetadata metadata, InodeIdentifier parent)
@@ -188,7 +210,7 @@ ssize_t TmpFSInode::read_bytes(off_t offset, ssize_t size, u8* buffer, FileDescr
     ASSERT(size >= 0);
     ASSERT(offset >= 0);
 
-    if (!m_content.has_value())
+    if (!m_content_region)
         return 0;
 
     if (offset >= m_metadata.size)
@@ -197,7 +219,7 @@ ssize_t TmpFSInode::read_bytes(off_t offset, ssize_t size, u8* buffer, FileDescr
     if (static_cast<off_t>(size) > m_metadata.size - offset)
         size = m_metadata.size - offset;
 
-    memcpy(buffer, m_content.value().data() + offset, size);
+    memcpy(buffer, m_content_region->vaddr().offset(offset).as_ptr(), size);
     return size;
 }
 
@@ -211,40 +233,148 @@ ssize_t TmpFSInode::write_bytes(off_t offset, ssize_t size, const u8* buffer, Fi
     if (result.is_error())
         return result;
 
+    if (size == 0)
+        return 0;
+
     off_t old_size = m_metadata.size;
     off_t new_size = m_metadata.size;
     if ((offset + size) > new_size)
         new_size = offset + size;
 
+    result = ensure_content_capacity(new_size);
+    if (result.is_error())
+        return result;
+    result = commit_content_pages(offset, size);
+    if (result.is_error())
+        return result;
+
     if (new_size > old_size) {
-        if (m_content.has_value() && m_content.value().capacity() >= (size_t)new_size) {
-            m_content.value().set_size(new_size);
-        } else {
-            // Grow the content buffer 2x the new sizeto accomodate repeating write() calls.
-            // Note that we're not actually committing physical memory to the buffer
-            // until it's needed. We only grow VM here.
-
-            // FIXME: Fix this so that no memcpy() is necessary, and we can just grow the
-            //        KBuffer and it will add physical pages as needed while keeping the
-            //        existing ones.
-            auto tmp = KBuffer::create_with_size(new_size * 2);
-            tmp.set_size(new_size);
-            if (m_content.has_value())
-                memcpy(tmp.data(), m_content.value().data(), old_size);
-            m_content = move(tmp);
-        }
         m_metadata.size = new_size;
         set_metadata_dirty(true);
         set_metadata_dirty(false);
         inode_size_changed(old_size, new_size);
     }
 
-    memcpy(m_content.value().data() + offset, buffer, size);
+    memcpy(m_content_region->vaddr().offset(offset).as_ptr(), buffer, size);
     inode_contents_changed(offset, size, buffer);
 
     return size;
 }
 
+static bool is_committed(const RefPtr<PhysicalPage>& page)
+{
+    return !page.is_null() && !page->is_shared_zero_page();
+}
+
+KResult TmpFSInode::ensure_content_capacity(size_t size)
+{
+    size_t page_count = PAGE_ROUND_UP(size) / PAGE_SIZE;
+    if (m_content_vmobject && m_content_vmobject->page_count() >= page_count)
+        return KSuccess;
+
+    // Grow the content VMObject 2x the new size to accomodate repeating write() calls.
+    // Existing pages are carried over as they are, and the new ones stay backed by
+    // the shared zero page until they're written to.
+    size_t new_page_count = page_count * 2;
+    if (!m_content_vmobject) {
+        auto vmobject = AnonymousVMObject::create_with_size(new_page_count * PAGE_SIZE);
+        auto region = MM.allocate_kernel_region_with_vmobject(*vmobject, new_page_count * PAGE_SIZE, "TmpFS file", Region::Access::Read | Region::Access::Write);
+        if (!region)
+            return KResult(-ENOMEM);
+        m_content_vmobject = move(vmobject);
+        m_content_region = move(region);
+        return KSuccess;
+    }
+
+    // The current region stays in place until the new one is mapped, so failing
+    // here leaves the file exactly as it was.
+    size_t old_page_count = m_content_vmobject->page_count();
+    auto& pages = m_content_vmobject->physical_pages();
+    pages.resize(new_page_count);
+    for (size_t i = old_page_count; i < new_page_count; ++i)
+        pages[i] = MM.shared_zero_page();
+    auto region = MM.allocate_kernel_region_with_vmobject(*m_content_vmobject, new_page_count * PAGE_SIZE, "TmpFS file", Region::Access::Read | Region::Access::Write);
+    if (!region) {
+        pages.shrink(old_page_count);
+        return KResult(-ENOMEM);
+    }
+    m_content_region = move(region);
+    return KSuccess;
+}
+
+KResult TmpFSInode::commit_content_pages(size_t offset, size_t size)
+{
+    ASSERT(size);
+    ASSERT(m_content_region);
+    size_t first_page_index = offset / PAGE_SIZE;
+    size_t last_page_index = (offset + size - 1) / PAGE_SIZE;
+    auto& pages = m_content_vmobject->physical_pages();
+
+    size_t pages_to_commit = 0;
+    for (size_t i = first_page_index; i <= last_page_index; ++i) {
+        if (!is_committed(pages[i]))
+            ++pages_to_commit;
+    }
+    if (!pages_to_commit)
+        return KSuccess;
+    if (!fs().try_commit_pages(pages_to_commit))
+        return KResult(-ENOSPC);
+
+    // Allocate every page before touching the file, so running out of memory
+    // partway through doesn't leave a partial commit or a leaked reservation.
+    Vector<RefPtr<PhysicalPage>> new_pages;
+    new_pages.ensure_capacity(pages_to_commit);
+    for (size_t i = 0; i < pages_to_commit; ++i) {
+        auto page = MM.allocate_user_physical_page(MemoryManager::ShouldZeroFill::Yes);
+        if (!page) {
+            fs().uncommit_pages(pages_to_commit);
+            return KResult(-ENOMEM);
+        }
+        new_pages.unchecked_append(move(page));
+    }
+
+    InterruptDisabler disabler;
+    size_t next_page = 0;
+    for (size_t i = first_page_index; i <= last_page_index; ++i) {
+        if (is_committed(pages[i]))
+            continue;
+        pages[i] = move(new_pages[next_page++]);
+        m_content_region->remap_page(i);
+    }
+    m_committed_page_count += pages_to_commit;
+    return KSuccess;
+}
+
+void TmpFSInode::release_content_pages_from(size_t page_index)
+{
+    if (!m_content_vmobject)
+        return;
+    auto& pages = m_content_vmobject->physical_pages();
+    size_t released_page_count = 0;
+    for (size_t i = page_index; i < pages.size(); ++i) {
+        if (!is_committed(pages[i]))
+            continue;
+        pages[i] = MM.shared_zero_page();
+        ++released_page_count;
+    }
+    if (!released_page_count)
+        return;
+    m_content_region->remap();
+    ASSERT(released_page_count <= m_committed_page_count);
+    m_committed_page_count -= released_page_count;
+    fs().uncommit_pages(released_page_count);
+}
+
+RefPtr<PhysicalPage> TmpFSInode::physical_page_for_mapping(size_t page_index)
+{
+    LOCKER(m_lock);
+    if (page_index >= PAGE_ROUND_UP(m_metadata.size) / PAGE_SIZE)
+        return nullptr;
+    if (commit_content_pages(page_index * PAGE_SIZE, PAGE_SIZE).is_error())
+        return nullptr;
+    return m_content_vmobject->physical_pages()[page_index];
+}
+
 RefPtr<Inode> TmpFSInode::lookup(StringView name)
 {
     LOCKER(m_lock, Lock::Mode::Shared);
@@ -338,31 +468,32 @@ KResult TmpFSInode::truncate(u64 size)
     LOCKER(m_lock);
     ASSERT(!is_directory());
 
-    if (size == 0)
-        m_content.clear();
-    else if (!m_content.has_value()) {
-        m_content = KBuffer::create_with_size(size);
-    } else if (static_cast<size_t>(size) < m_content.value().capacity()) {
-        size_t prev_size = m_metadata.size;
-        m_content.value().set_size(size);
-        if (prev_size < static_cast<size_t>(size))
-            memset(m_content.value().data() + prev_size, 0, size - prev_size);
-    } else {
-        size_t prev_size = m_metadata.size;
-        KBuffer tmp = KBuffer::create_with_size(size);
-        memcpy(tmp.data(), m_content.value().data(), prev_size);
-        m_content = move(tmp);
+    size_t old_size = m_metadata.size;
+    if (size == 0) {
+        release_content_pages_from(0);
+        m_content_region = nullptr;
+        m_content_vmobject = nullptr;
+    } else if (static_cast<size_t>(size) > old_size) {
+        // Everything past the old end of the file is already zero.
+        auto result = ensure_content_capacity(size);
+        if (result.is_error())
+            return result;
+    } else if (static_cast<size_t>(size) < old_size) {
+        release_content_pages_from(PAGE_ROUND_UP(size) / PAGE_SIZE);
+        // Clear the tail of the new last page, so that growing the file again reads back zeroes.
+        size_t last_page_index = size / PAGE_SIZE;
+        if ((size % PAGE_SIZE) && is_committed(m_content_vmobject->physical_pages()[last_page_index]))
+            memset(m_content_region->vaddr().offset(size).as_ptr(), 0, PAGE_SIZE - (size % PAGE_SIZE));
     }
 
-    size_t old_size = m_metadata.size;
     m_metadata.size = size;
     set_metadata_dirty(true);
     set_metadata_dirty(false);
 
     if (old_size != (size_t)size) {
         inode_size_changed(old_size, size);
-        if (m_content.has_value())
-            inode_contents_changed(0, size, m_content.value().data());
+        if (m_content_region)
+            inode_contents_changed(0, size, m_content_region->vaddr().as_ptr());
     }
 
     return KSuccess;
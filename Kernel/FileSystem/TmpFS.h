@@ -30,7 +30,8 @@
 #include <AK/Optional.h>
 #include <Kernel/FileSystem/FileSystem.h>
 #include <Kernel/FileSystem/Inode.h>
-#include <Kernel/KBuffer.h>
+#include <Kernel/VM/AnonymousVMObject.h>
+#include <Kernel/VM/Region.h>
 
 namespace Kernel {
 
@@ -54,9 +55,18 @@ public:
     virtual KResultOr<NonnullRefPtr<Inode>> create_inode(InodeIdentifier parent_id, const String& name, mode_t, off_t size, dev_t, uid_t, gid_t) override;
     virtual KResult create_directory(InodeIdentifier parent_id, const String& name, mode_t, uid_t, gid_t) override;
 
+    virtual unsigned total_block_count() const override { return m_max_page_count; }
+    virtual unsigned free_block_count() const override { return m_max_page_count - m_committed_page_count; }
+
 private:
     TmpFS();
 
+    bool try_commit_pages(size_t);
+    void uncommit_pages(size_t);
+
+    size_t m_max_page_count { 0 };
+    size_t m_committed_page_count { 0 };
+
     RefPtr<TmpFSInode> m_root_inode;
 
     HashMap<unsigned, NonnullRefPtr<TmpFSInode>> m_inodes;
@@ -89,6 +99,7 @@ public:
     virtual KResult chmod(mode_t) override;
     virtual KResult chown(uid_t, gid_t) override;
     virtual KResult truncate(u64) override;
+    virtual RefPtr<PhysicalPage> physical_page_for_mapping(size_t page_index) override;
     virtual int set_atime(time_t) override;
     virtual int set_ctime(time_t) override;
     virtual int set_mtime(time_t) override;
@@ -99,10 +110,19 @@ private:
     static NonnullRefPtr<TmpFSInode> create(TmpFS&, InodeMetadata metadata, InodeIdentifier parent);
     static NonnullRefPtr<TmpFSInode> create_root(TmpFS&);
 
+    KResult ensure_content_capacity(size_t);
+    KResult commit_content_pages(size_t offset, size_t size);
+    void release_content_pages_from(size_t page_index);
+
     InodeMetadata m_metadata;
     InodeIdentifier m_parent;
 
-    Optional<KBuffer> m_content;
+    // File contents live in the pages of an anonymous VMObject, which is kept mapped into
+    // the kernel for read() and write(). Pages are only allocated once they are written to,
+    // and mmap() of the file maps these same pages.
+    RefPtr<AnonymousVMObject> m_content_vmobject;
+    OwnPtr<Region> m_content_region;
+    size_t m_committed_page_count { 0 };
     struct Child {
         FS::DirectoryEntry entry;
         NonnullRefPtr<TmpFSInode> inode;
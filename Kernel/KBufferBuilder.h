@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <AK/Format.h>
 #include <AK/String.h>
 #include <Kernel/KBuffer.h>
 #include <stdarg.h>
@@ -45,6 +46,13 @@ public:
     void appendf(const char*, ...);
     void appendvf(const char*, va_list);
 
+    template<typename... Parameters>
+    void appendff(const StringView& fmtstr, const Parameters&... parameters)
+    {
+        FormatBuilderFor<KBufferBuilder> builder(*this);
+        vformat(builder, fmtstr, VariadicFormatParams { parameters... });
+    }
+
     KBuffer build();
 
 private:
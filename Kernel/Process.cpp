@@ -75,6 +75,7 @@
 #include <Kernel/VM/ProcessPagingScope.h>
 #include <Kernel/VM/PurgeableVMObject.h>
 #include <Kernel/VM/SharedInodeVMObject.h>
+#include <Kernel/VM/SwapSpace.h>
 #include <LibC/errno_numbers.h>
 #include <LibC/limits.h>
 #include <LibC/signal_numbers.h>
@@ -913,6 +914,13 @@ int Process::do_exec(NonnullRefPtr<FileDescription> main_program_description, Ve
                 prot |= PROT_WRITE;
             if (is_executable)
                 prot |= PROT_EXEC;
+            if (is_writable) {
+                // Writable segments get their own copy-on-write view of the file's pages.
+                auto private_vmobject = PrivateInodeVMObject::create_with_inode(vmobject->inode());
+                if (auto* region = allocate_region_with_vmobject(vaddr.offset(totally_random_offset), size, move(private_vmobject), offset_in_image, String(name), prot))
+                    return region->vaddr().as_ptr();
+                return nullptr;
+            }
             if (auto* region = allocate_region_with_vmobject(vaddr.offset(totally_random_offset), size, *vmobject, offset_in_image, String(name), prot)) {
                 region->set_shared(true);
                 return region->vaddr().as_ptr();
@@ -927,7 +935,7 @@ int Process::do_exec(NonnullRefPtr<FileDescription> main_program_description, Ve
                 prot |= PROT_READ;
             if (is_writable)
                 prot |= PROT_WRITE;
-            if (auto* region = allocate_region(vaddr.offset(totally_random_offset), size, String(name), prot))
+            if (auto* region = allocate_region(vaddr.offset(totally_random_offset), size, String(name), prot, false))
                 return region->vaddr().as_ptr();
             return nullptr;
         };
@@ -4425,6 +4433,37 @@ int Process::sys$sync()
     return 0;
 }
 
+int Process::sys$fsync(int fd)
+{
+    REQUIRE_PROMISE(stdio);
+    auto description = file_description(fd);
+    if (!description)
+        return -EBADF;
+    auto* inode = description->inode();
+    if (!inode)
+        return -EINVAL;
+    return inode->fsync();
+}
+
+int Process::sys$swapon(const char* user_path, size_t path_length)
+{
+    if (!is_superuser())
+        return -EPERM;
+
+    REQUIRE_NO_PROMISES;
+
+    if (!validate_read(user_path, path_length))
+        return -EFAULT;
+    auto path = get_syscall_path_argument(user_path, path_length);
+    if (path.is_error())
+        return path.error();
+
+    auto description_or_error = VFS::the().open(path.value(), O_RDWR, 0, current_directory());
+    if (description_or_error.is_error())
+        return description_or_error.error();
+    return SwapSpace::enable(description_or_error.value());
+}
+
 int Process::sys$yield()
 {
     REQUIRE_PROMISE(stdio);
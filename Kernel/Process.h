@@ -171,6 +171,8 @@ public:
 
     int sys$yield();
     int sys$sync();
+    int sys$fsync(int fd);
+    int sys$swapon(const char* path, size_t path_length);
     int sys$beep();
     int sys$get_process_name(char* buffer, int buffer_size);
     int sys$watch_file(const char* path, size_t path_length);
@@ -27,6 +27,7 @@
 #include <AK/Assertions.h>
 #include <AK/String.h>
 #include <AK/Types.h>
+#include <AK/WordAtATime.h>
 #include <Kernel/Arch/i386/CPU.h>
 #include <Kernel/Heap/kmalloc.h>
 #include <Kernel/StdLib.h>
@@ -61,13 +62,17 @@ void* memcpy(void* dest_ptr, const void* src_ptr, size_t n)
 {
     size_t dest = (size_t)dest_ptr;
     size_t src = (size_t)src_ptr;
-    // FIXME: Support starting at an unaligned address.
-    if (!(dest & 0x3) && !(src & 0x3) && n >= 12) {
+    if (n >= 12) {
+        // Align the destination first, unaligned loads are cheap but unaligned stores are not.
+        size_t prologue = -dest & 0x3;
+        n -= prologue;
         size_t size_ts = n / sizeof(size_t);
         asm volatile(
+            "rep movsb\n"
+            "mov %%edx, %%ecx\n"
             "rep movsl\n"
-            : "=S"(src), "=D"(dest)
-            : "S"(src), "D"(dest), "c"(size_ts)
+            : "=S"(src), "=D"(dest), "=c"(prologue), "=d"(size_ts)
+            : "0"(src), "1"(dest), "2"(prologue), "3"(size_ts)
             : "memory");
         n -= size_ts * sizeof(size_t);
         if (n == 0)
@@ -120,16 +125,19 @@ void memset_user(void* dest_ptr, int c, size_t n)
 void* memset(void* dest_ptr, int c, size_t n)
 {
     size_t dest = (size_t)dest_ptr;
-    // FIXME: Support starting at an unaligned address.
-    if (!(dest & 0x3) && n >= 12) {
+    if (n >= 12) {
+        size_t prologue = -dest & 0x3;
+        n -= prologue;
         size_t size_ts = n / sizeof(size_t);
         size_t expanded_c = (u8)c;
         expanded_c |= expanded_c << 8;
         expanded_c |= expanded_c << 16;
         asm volatile(
+            "rep stosb\n"
+            "mov %%edx, %%ecx\n"
             "rep stosl\n"
-            : "=D"(dest)
-            : "D"(dest), "c"(size_ts), "a"(expanded_c)
+            : "=D"(dest), "=c"(prologue), "=d"(size_ts)
+            : "0"(dest), "1"(prologue), "2"(size_ts), "a"(expanded_c)
             : "memory");
         n -= size_ts * sizeof(size_t);
         if (n == 0)
@@ -156,18 +164,12 @@ char* strrchr(const char* str, int ch)
 
 size_t strlen(const char* str)
 {
-    size_t len = 0;
-    while (*(str++))
-        ++len;
-    return len;
+    return AK::WordAtATime::strlen(str);
 }
 
 size_t strnlen(const char* str, size_t maxlen)
 {
-    size_t len = 0;
-    for (; len < maxlen && *str; str++)
-        len++;
-    return len;
+    return AK::WordAtATime::strnlen(str, maxlen);
 }
 
 int strcmp(const char* s1, const char* s2)
@@ -189,13 +191,7 @@ char* strdup(const char* str)
 
 int memcmp(const void* v1, const void* v2, size_t n)
 {
-    auto* s1 = (const u8*)v1;
-    auto* s2 = (const u8*)v2;
-    while (n-- > 0) {
-        if (*s1++ != *s2++)
-            return s1[-1] < s2[-1] ? -1 : 1;
-    }
-    return 0;
+    return AK::WordAtATime::memcmp(v1, v2, n);
 }
 
 int strncmp(const char* s1, const char* s2, size_t n)
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <Kernel/Process.h>
+#include <Kernel/Tasks/MemoryPressureTask.h>
+#include <Kernel/VM/MemoryManager.h>
+#include <Kernel/VM/SwapSpace.h>
+#include <Kernel/WaitQueue.h>
+
+namespace Kernel {
+
+static WaitQueue* s_wait_queue;
+static bool s_has_work;
+
+void MemoryPressureTask::notify()
+{
+    InterruptDisabler disabler;
+    s_has_work = true;
+    if (s_wait_queue)
+        s_wait_queue->wake_all();
+}
+
+void MemoryPressureTask::spawn()
+{
+    s_wait_queue = new WaitQueue;
+
+    Thread* thread = nullptr;
+    Process::create_kernel_process(thread, "MemoryPressureTask", [] {
+        for (;;) {
+            {
+                InterruptDisabler disabler;
+                if (!s_has_work)
+                    Thread::current->wait_on(*s_wait_queue);
+                s_has_work = false;
+            }
+            MM.reclaim_volatile_memory();
+            if (auto* swap = SwapSpace::the()) {
+                while (MM.memory_pressure() != MemoryPressure::None) {
+                    if (!swap->swap_out_until_relieved())
+                        break;
+                }
+            }
+        }
+    });
+}
+
+}
@@ -24,9 +24,11 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <AK/Memory.h>
 #include <Kernel/VM/AnonymousVMObject.h>
 #include <Kernel/VM/MemoryManager.h>
 #include <Kernel/VM/PhysicalPage.h>
+#include <Kernel/VM/SwapSpace.h>
 
 namespace Kernel {
 
@@ -70,16 +72,165 @@ AnonymousVMObject::AnonymousVMObject(PhysicalAddress paddr, size_t size)
 
 AnonymousVMObject::AnonymousVMObject(const AnonymousVMObject& other)
     : VMObject(other)
+    , m_swap_slots(other.m_swap_slots)
 {
+    for (auto& it : m_swap_slots)
+        SwapSpace::the()->ref_slot(it.value);
 }
 
 AnonymousVMObject::~AnonymousVMObject()
 {
+    for (auto& it : m_swap_slots)
+        SwapSpace::the()->unref_slot(it.value);
 }
 
 NonnullRefPtr<VMObject> AnonymousVMObject::clone()
 {
+    // Don't copy the swap slots of pages that are still being written out, they might not make it.
+    LOCKER(m_paging_lock);
     return adopt(*new AnonymousVMObject(*this));
 }
 
+static bool is_zero_filled(const u8* data)
+{
+    auto* words = reinterpret_cast<const u32*>(data);
+    for (size_t i = 0; i < PAGE_SIZE / sizeof(u32); ++i) {
+        if (words[i])
+            return false;
+    }
+    return true;
+}
+
+KResult AnonymousVMObject::swap_in_page(size_t page_index)
+{
+    ASSERT_INTERRUPTS_DISABLED();
+    ASSERT(m_paging_lock.is_locked());
+    auto slot = m_swap_slots.get(page_index);
+    ASSERT(slot.has_value());
+    auto* swap = SwapSpace::the();
+
+    u8 page_buffer[PAGE_SIZE];
+    sti();
+    auto result = swap->read_page(slot.value(), page_buffer);
+    cli();
+    if (result.is_error())
+        return result;
+
+    auto page = MM.allocate_user_physical_page(MemoryManager::ShouldZeroFill::No);
+    if (!page)
+        return KResult(-ENOMEM);
+    u8* dest_ptr = MM.quickmap_page(*page);
+    memcpy(dest_ptr, page_buffer, PAGE_SIZE);
+    MM.unquickmap_page();
+
+    m_swap_slots.remove(page_index);
+    swap->unref_slot(slot.value());
+    m_physical_pages[page_index] = move(page);
+    return KSuccess;
+}
+
+void AnonymousVMObject::restore_page(size_t page_index, NonnullRefPtr<PhysicalPage>&& page)
+{
+    ASSERT_INTERRUPTS_DISABLED();
+    auto slot = m_swap_slots.get(page_index);
+    ASSERT(slot.has_value());
+    m_swap_slots.remove(page_index);
+    SwapSpace::the()->unref_slot(slot.value());
+    m_physical_pages[page_index] = move(page);
+    for_each_region([&](Region& region) {
+        if (page_index >= region.first_page_index() && page_index <= region.last_page_index())
+            region.remap_page(page_index - region.first_page_index());
+    });
+}
+
+size_t AnonymousVMObject::swap_out_cold_pages(SwapSpace& swap, size_t max_page_count)
+{
+    LOCKER(m_paging_lock);
+
+    struct Victim {
+        size_t page_index;
+        u32 slot;
+        NonnullRefPtr<PhysicalPage> page;
+    };
+    Vector<Victim> victims;
+
+    {
+        InterruptDisabler disabler;
+
+        // Only memory that is exclusively mapped into userspace gets swapped. The kernel expects its own
+        // memory to stay put, and can't take a fault on it anyway.
+        // Stacks stay resident as well: signal delivery pushes the signal frame onto the user stack from
+        // the scheduler with interrupts disabled, where we can't block waiting for a swap-in.
+        Vector<Region*, 4> regions;
+        bool swappable = true;
+        for_each_region([&](Region& region) {
+            if (region.is_kernel() || !region.is_mapped() || region.is_stack())
+                swappable = false;
+            regions.append(&region);
+        });
+        if (!swappable || regions.is_empty() || !page_count())
+            return 0;
+
+        for (size_t scanned = 0; scanned < page_count() && victims.size() < max_page_count; ++scanned) {
+            size_t page_index = m_swap_clock_hand;
+            m_swap_clock_hand = (m_swap_clock_hand + 1) % page_count();
+
+            auto& page_slot = m_physical_pages[page_index];
+            // Pages shared with a forked child (or physical ranges we don't own) stay resident.
+            if (!page_slot || page_slot->is_shared_zero_page() || !page_slot->may_return_to_freelist() || page_slot->ref_count() != 1)
+                continue;
+
+            bool was_accessed = false;
+            for (auto* region : regions) {
+                if (page_index >= region->first_page_index() && page_index <= region->last_page_index())
+                    was_accessed |= region->test_and_clear_accessed(page_index - region->first_page_index());
+            }
+            if (was_accessed)
+                continue;
+
+            auto slot = swap.allocate_slot();
+            if (!slot.has_value())
+                break;
+
+            // Unmap the page before writing it out so nobody can modify it behind our back.
+            // Anyone touching it from now on will block on m_paging_lock in Region::handle_swap_fault().
+            m_swap_slots.set(page_index, slot.value());
+            victims.append({ page_index, slot.value(), page_slot.release_nonnull() });
+            for (auto* region : regions) {
+                if (page_index >= region->first_page_index() && page_index <= region->last_page_index())
+                    region->remap_page(page_index - region->first_page_index());
+            }
+        }
+    }
+
+    size_t swapped_out_count = 0;
+    u8 page_buffer[PAGE_SIZE];
+    for (auto& victim : victims) {
+        {
+            InterruptDisabler disabler;
+            auto* src_ptr = MM.quickmap_page(victim.page);
+            memcpy(page_buffer, src_ptr, PAGE_SIZE);
+            MM.unquickmap_page();
+        }
+
+        // Pages that only hold zeroes don't need to hit the disk, the shared zero page will do.
+        if (is_zero_filled(page_buffer)) {
+            InterruptDisabler disabler;
+            restore_page(victim.page_index, MM.shared_zero_page());
+            ++swapped_out_count;
+            continue;
+        }
+
+        auto result = swap.write_page(victim.slot, page_buffer);
+        if (result.is_error()) {
+            klog() << "AnonymousVMObject: Failed to swap out page " << victim.page_index << ": " << result.error();
+            InterruptDisabler disabler;
+            restore_page(victim.page_index, move(victim.page));
+            continue;
+        }
+        ++swapped_out_count;
+    }
+    return swapped_out_count;
+}
+
 }
@@ -26,11 +26,15 @@
 
 #pragma once
 
-#include <Kernel/VM/VMObject.h>
+#include <AK/HashMap.h>
+#include <Kernel/KResult.h>
 #include <Kernel/PhysicalAddress.h>
+#include <Kernel/VM/VMObject.h>
 
 namespace Kernel {
 
+class SwapSpace;
+
 class AnonymousVMObject : public VMObject {
 public:
     virtual ~AnonymousVMObject() override;
@@ -40,6 +44,10 @@ public:
     static NonnullRefPtr<AnonymousVMObject> create_with_physical_page(PhysicalPage&);
     virtual NonnullRefPtr<VMObject> clone() override;
 
+    bool is_page_swapped_out(size_t page_index) const { return m_swap_slots.contains(page_index); }
+    KResult swap_in_page(size_t page_index);
+    size_t swap_out_cold_pages(SwapSpace&, size_t max_page_count);
+
 protected:
     explicit AnonymousVMObject(size_t);
     explicit AnonymousVMObject(const AnonymousVMObject&);
@@ -54,6 +62,12 @@ private:
     AnonymousVMObject(AnonymousVMObject&&) = delete;
 
     virtual bool is_anonymous() const override { return true; }
+
+    void restore_page(size_t page_index, NonnullRefPtr<PhysicalPage>&&);
+
+    // Swap slots of pages that have been evicted, keyed by page index. Guarded by m_paging_lock.
+    HashMap<size_t, u32> m_swap_slots;
+    size_t m_swap_clock_hand { 0 };
 };
 
 template<>
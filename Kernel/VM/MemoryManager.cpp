@@ -26,6 +26,7 @@
 
 #include <AK/Assertions.h>
 #include <AK/Memory.h>
+#include <AK/QuickSort.h>
 #include <AK/StringView.h>
 #include <Kernel/Arch/i386/CPU.h>
 #include <Kernel/CMOS.h>
@@ -40,6 +41,7 @@
 #include <Kernel/VM/PurgeableVMObject.h>
 #include <Kernel/VM/SharedInodeVMObject.h>
 #include <Kernel/StdLib.h>
+#include <Kernel/Tasks/MemoryPressureTask.h>
 
 //#define MM_DEBUG
 //#define PAGE_FAULT_DEBUG
@@ -365,6 +367,7 @@ void MemoryManager::deallocate_user_physical_page(PhysicalPage&& page)
 
         region.return_page(move(page));
         --m_user_physical_pages_used;
+        update_memory_pressure();
 
         return;
     }
@@ -420,9 +423,73 @@ RefPtr<PhysicalPage> MemoryManager::allocate_user_physical_page(ShouldZeroFill s
     }
 
     ++m_user_physical_pages_used;
+    update_memory_pressure();
     return page;
 }
 
+void MemoryManager::update_memory_pressure()
+{
+    InterruptDisabler disabler;
+
+    // Watermarks are in free user pages. Once we're under pressure, we stay there until
+    // we've climbed back above the high watermark, so we don't flap around the low one.
+    unsigned free_pages = m_user_physical_pages - m_user_physical_pages_used;
+    unsigned critical_watermark = m_user_physical_pages / 64;
+    unsigned low_watermark = m_user_physical_pages / 16;
+    unsigned high_watermark = m_user_physical_pages / 8;
+
+    MemoryPressure pressure;
+    if (free_pages < critical_watermark)
+        pressure = MemoryPressure::Critical;
+    else if (free_pages < low_watermark)
+        pressure = MemoryPressure::Low;
+    else if (free_pages < high_watermark && m_memory_pressure != MemoryPressure::None)
+        pressure = MemoryPressure::Low;
+    else
+        pressure = MemoryPressure::None;
+
+    if (pressure == m_memory_pressure)
+        return;
+
+    bool got_worse = pressure > m_memory_pressure;
+    m_memory_pressure = pressure;
+    ++m_memory_pressure_generation;
+
+#ifdef MM_DEBUG
+    dbg() << "MM: Memory pressure is now " << (int)pressure << " with " << free_pages << " free user pages";
+#endif
+
+    if (got_worse)
+        MemoryPressureTask::notify();
+}
+
+int MemoryManager::reclaim_volatile_memory()
+{
+    Vector<NonnullRefPtr<PurgeableVMObject>> candidates;
+    {
+        InterruptDisabler disabler;
+        for_each_vmobject_of_type<PurgeableVMObject>([&](auto& vmobject) {
+            if (vmobject.is_volatile())
+                candidates.append(vmobject);
+            return IterationDecision::Continue;
+        });
+    }
+
+    // Whatever has been volatile the longest is the least likely to be wanted back.
+    quick_sort(candidates, [](auto& a, auto& b) { return a->volatile_since() < b->volatile_since(); });
+
+    int purged_page_count = 0;
+    for (auto& vmobject : candidates) {
+        if (m_memory_pressure == MemoryPressure::None)
+            break;
+        purged_page_count += vmobject->purge();
+    }
+
+    if (purged_page_count)
+        klog() << "MM: Reclaimed " << purged_page_count << " pages from " << candidates.size() << " volatile VMObjects";
+    return purged_page_count;
+}
+
 void MemoryManager::deallocate_supervisor_physical_page(PhysicalPage&& page)
 {
     for (auto& region : m_super_physical_regions) {
@@ -66,8 +66,15 @@ class SynthFSInode;
 
 #define MM Kernel::MemoryManager::the()
 
+enum class MemoryPressure : u8 {
+    None = 0,
+    Low,
+    Critical,
+};
+
 class MemoryManager {
     AK_MAKE_ETERNAL
+    friend class AnonymousVMObject;
     friend class PageDirectory;
     friend class PhysicalPage;
     friend class PhysicalRegion;
@@ -117,6 +124,10 @@ public:
     unsigned super_physical_pages() const { return m_super_physical_pages; }
     unsigned super_physical_pages_used() const { return m_super_physical_pages_used; }
 
+    MemoryPressure memory_pressure() const { return m_memory_pressure; }
+    u32 memory_pressure_generation() const { return m_memory_pressure_generation; }
+    int reclaim_volatile_memory();
+
     template<typename Callback>
     static void for_each_vmobject(Callback callback)
     {
@@ -174,6 +185,7 @@ private:
     static Region* region_from_vaddr(VirtualAddress);
 
     RefPtr<PhysicalPage> find_free_user_physical_page();
+    void update_memory_pressure();
     u8* quickmap_page(PhysicalPage&);
     void unquickmap_page();
 
@@ -193,6 +205,9 @@ private:
     unsigned m_super_physical_pages { 0 };
     unsigned m_super_physical_pages_used { 0 };
 
+    MemoryPressure m_memory_pressure { MemoryPressure::None };
+    u32 m_memory_pressure_generation { 0 };
+
     NonnullRefPtrVector<PhysicalRegion> m_user_physical_regions;
     NonnullRefPtrVector<PhysicalRegion> m_super_physical_regions;
 
@@ -24,6 +24,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <Kernel/Scheduler.h>
 #include <Kernel/VM/MemoryManager.h>
 #include <Kernel/VM/PhysicalPage.h>
 #include <Kernel/VM/PurgeableVMObject.h>
@@ -54,6 +55,13 @@ NonnullRefPtr<VMObject> PurgeableVMObject::clone()
     return adopt(*new PurgeableVMObject(*this));
 }
 
+void PurgeableVMObject::set_volatile(bool is_volatile)
+{
+    if (is_volatile && !m_volatile)
+        m_volatile_since = g_uptime;
+    m_volatile = is_volatile;
+}
+
 int PurgeableVMObject::purge()
 {
     LOCKER(m_paging_lock);
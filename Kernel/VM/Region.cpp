@@ -251,10 +251,23 @@ void Region::remap_page(size_t page_index)
 {
     ASSERT(m_page_directory);
     InterruptDisabler disabler;
-    ASSERT(physical_page(page_index));
     map_individual_page_impl(page_index);
 }
 
+bool Region::test_and_clear_accessed(size_t page_index)
+{
+    ASSERT_INTERRUPTS_DISABLED();
+    if (!m_page_directory)
+        return false;
+    auto page_vaddr = vaddr().offset(page_index * PAGE_SIZE);
+    auto* pte = const_cast<PageTableEntry*>(MM.pte(*m_page_directory, page_vaddr));
+    if (!pte || !pte->is_present() || !pte->is_accessed())
+        return false;
+    pte->set_accessed(false);
+    MM.flush_tlb(page_vaddr);
+    return true;
+}
+
 void Region::unmap(ShouldDeallocateVirtualMemoryRange deallocate_range)
 {
     InterruptDisabler disabler;
@@ -319,6 +332,12 @@ PageFaultResponse Region::handle_fault(const PageFault& fault)
 #endif
             return handle_inode_fault(page_index_in_region);
         }
+        if (vmobject().is_anonymous() && static_cast<AnonymousVMObject&>(vmobject()).is_page_swapped_out(first_page_index() + page_index_in_region)) {
+#ifdef PAGE_FAULT_DEBUG
+            dbg() << "NP(swap) fault in Region{" << this << "}[" << page_index_in_region << "]";
+#endif
+            return handle_swap_fault(page_index_in_region);
+        }
 #ifdef MAP_SHARED_ZERO_PAGE_LAZILY
         if (fault.is_read()) {
             physical_page_slot(page_index_in_region) = MM.shared_zero_page();
@@ -384,6 +403,41 @@ PageFaultResponse Region::handle_zero_fault(size_t page_index_in_region)
     return PageFaultResponse::Continue;
 }
 
+PageFaultResponse Region::handle_swap_fault(size_t page_index_in_region)
+{
+    ASSERT_INTERRUPTS_DISABLED();
+    ASSERT(vmobject().is_anonymous());
+
+    sti();
+    LOCKER(vmobject().m_paging_lock);
+    cli();
+
+    auto& anonymous_vmobject = static_cast<AnonymousVMObject&>(vmobject());
+    size_t page_index_in_vmobject = first_page_index() + page_index_in_region;
+
+    // Someone else may have brought the page back in (or the swap out failed) while we waited for the lock.
+    if (!anonymous_vmobject.is_page_swapped_out(page_index_in_vmobject)) {
+        if (physical_page(page_index_in_region)) {
+            remap_page(page_index_in_region);
+            return PageFaultResponse::Continue;
+        }
+        dbg() << "BUG! Unexpected NP fault in Region{" << this << "}[" << page_index_in_region << "]";
+        return PageFaultResponse::ShouldCrash;
+    }
+
+    if (Thread::current)
+        Thread::current->did_inode_fault();
+
+    auto result = anonymous_vmobject.swap_in_page(page_index_in_vmobject);
+    if (result.is_error()) {
+        klog() << "MM: handle_swap_fault was unable to swap in page: " << result.error();
+        return result.error() == -ENOMEM ? PageFaultResponse::OutOfMemory : PageFaultResponse::ShouldCrash;
+    }
+
+    remap_page(page_index_in_region);
+    return PageFaultResponse::Continue;
+}
+
 PageFaultResponse Region::handle_cow_fault(size_t page_index_in_region)
 {
     ASSERT_INTERRUPTS_DISABLED();
@@ -422,29 +476,12 @@ PageFaultResponse Region::handle_cow_fault(size_t page_index_in_region)
     return PageFaultResponse::Continue;
 }
 
-PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region)
+static PageFaultResponse page_in_from_inode(InodeVMObject& inode_vmobject, size_t page_index_in_vmobject)
 {
     ASSERT_INTERRUPTS_DISABLED();
-    ASSERT(vmobject().is_inode());
-
-    sti();
-    LOCKER(vmobject().m_paging_lock);
-    cli();
-
-    auto& inode_vmobject = static_cast<InodeVMObject&>(vmobject());
-    auto& vmobject_physical_page_entry = inode_vmobject.physical_pages()[first_page_index() + page_index_in_region];
-
-#ifdef PAGE_FAULT_DEBUG
-    dbg() << "Inode fault in " << name() << " page index: " << page_index_in_region;
-#endif
-
-    if (!vmobject_physical_page_entry.is_null()) {
-#ifdef PAGE_FAULT_DEBUG
-        dbg() << ("MM: page_in_from_inode() but page already present. Fine with me!");
-#endif
-        remap_page(page_index_in_region);
+    auto& vmobject_physical_page_entry = inode_vmobject.physical_pages()[page_index_in_vmobject];
+    if (!vmobject_physical_page_entry.is_null())
         return PageFaultResponse::Continue;
-    }
 
     if (Thread::current)
         Thread::current->did_inode_fault();
@@ -453,9 +490,15 @@ PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region)
     dbg() << "MM: page_in_from_inode ready to read from inode";
 #endif
     sti();
-    u8 page_buffer[PAGE_SIZE];
     auto& inode = inode_vmobject.inode();
-    auto nread = inode.read_bytes((first_page_index() + page_index_in_region) * PAGE_SIZE, PAGE_SIZE, page_buffer, nullptr);
+    if (auto page = inode.physical_page_for_mapping(page_index_in_vmobject)) {
+        cli();
+        vmobject_physical_page_entry = move(page);
+        return PageFaultResponse::Continue;
+    }
+
+    u8 page_buffer[PAGE_SIZE];
+    auto nread = inode.read_bytes(page_index_in_vmobject * PAGE_SIZE, PAGE_SIZE, page_buffer, nullptr);
     if (nread < 0) {
         klog() << "MM: handle_inode_fault had error (" << nread << ") while reading!";
         return PageFaultResponse::ShouldCrash;
@@ -474,6 +517,59 @@ PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region)
     u8* dest_ptr = MM.quickmap_page(*vmobject_physical_page_entry);
     memcpy(dest_ptr, page_buffer, PAGE_SIZE);
     MM.unquickmap_page();
+    return PageFaultResponse::Continue;
+}
+
+PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region)
+{
+    ASSERT_INTERRUPTS_DISABLED();
+    ASSERT(vmobject().is_inode());
+
+    sti();
+    LOCKER(vmobject().m_paging_lock);
+    cli();
+
+    auto& inode_vmobject = static_cast<InodeVMObject&>(vmobject());
+    size_t page_index_in_vmobject = first_page_index() + page_index_in_region;
+    auto& vmobject_physical_page_entry = inode_vmobject.physical_pages()[page_index_in_vmobject];
+
+#ifdef PAGE_FAULT_DEBUG
+    dbg() << "Inode fault in " << name() << " page index: " << page_index_in_region;
+#endif
+
+    if (!vmobject_physical_page_entry.is_null()) {
+#ifdef PAGE_FAULT_DEBUG
+        dbg() << ("MM: page_in_from_inode() but page already present. Fine with me!");
+#endif
+        remap_page(page_index_in_region);
+        return PageFaultResponse::Continue;
+    }
+
+    // A private mapping of an inode that is also mapped shared (e.g the data segment of a running
+    // executable) borrows the clean page from the shared page cache and only copies it on write.
+    RefPtr<SharedInodeVMObject> shared_vmobject;
+    if (inode_vmobject.is_private_inode() && !m_shared)
+        shared_vmobject = inode_vmobject.inode().shared_vmobject();
+    if (shared_vmobject && page_index_in_vmobject < shared_vmobject->page_count()) {
+        sti();
+        LOCKER(shared_vmobject->m_paging_lock);
+        cli();
+        auto response = page_in_from_inode(*shared_vmobject, page_index_in_vmobject);
+        if (response != PageFaultResponse::Continue)
+            return response;
+        vmobject_physical_page_entry = shared_vmobject->physical_pages()[page_index_in_vmobject];
+        set_should_cow(page_index_in_region, true);
+        remap_page(page_index_in_region);
+        return PageFaultResponse::Continue;
+    }
+
+    auto response = page_in_from_inode(inode_vmobject, page_index_in_vmobject);
+    if (response != PageFaultResponse::Continue)
+        return response;
+
+    // The inode may have given us a page it still uses for storage, keep private writes out of it.
+    if (inode_vmobject.is_private_inode() && !m_shared && vmobject_physical_page_entry->ref_count() > 1)
+        set_should_cow(page_index_in_region, true);
 
     remap_page(page_index_in_region);
     return PageFaultResponse::Continue;
@@ -176,6 +176,11 @@ public:
     void remap();
     void remap_page(size_t index);
 
+    bool is_mapped() const { return m_page_directory; }
+
+    // Returns whether the CPU has touched the page since the last time we asked, and clears the accessed bit.
+    bool test_and_clear_accessed(size_t page_index);
+
     // For InlineLinkedListNode
     Region* m_next { nullptr };
     Region* m_prev { nullptr };
@@ -199,6 +204,7 @@ private:
     PageFaultResponse handle_cow_fault(size_t page_index);
     PageFaultResponse handle_inode_fault(size_t page_index);
     PageFaultResponse handle_zero_fault(size_t page_index);
+    PageFaultResponse handle_swap_fault(size_t page_index);
 
     void map_individual_page_impl(size_t page_index);
 
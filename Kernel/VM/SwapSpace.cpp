@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/NumericLimits.h>
+#include <Kernel/Devices/BlockDevice.h>
+#include <Kernel/FileSystem/FileDescription.h>
+#include <Kernel/FileSystem/Inode.h>
+#include <Kernel/VM/AnonymousVMObject.h>
+#include <Kernel/VM/MemoryManager.h>
+#include <Kernel/VM/SwapSpace.h>
+
+//#define SWAP_DEBUG
+
+namespace Kernel {
+
+static SwapSpace* s_the;
+
+SwapSpace* SwapSpace::the()
+{
+    return s_the;
+}
+
+KResult SwapSpace::enable(NonnullRefPtr<FileDescription> description)
+{
+    if (s_the)
+        return KResult(-EBUSY);
+
+    u64 size = 0;
+    if (description->file().is_block_device()) {
+        size = static_cast<const BlockDevice&>(description->file()).size_in_bytes();
+    } else if (auto* inode = description->inode()) {
+        if (!inode->metadata().is_regular_file())
+            return KResult(-EINVAL);
+        size = inode->size();
+    } else {
+        return KResult(-EINVAL);
+    }
+
+    // Slots are addressed by byte offset, so anything past what size_t can reach is unusable.
+    size_t slot_count = min(size / PAGE_SIZE, (u64)(NumericLimits<size_t>::max() / PAGE_SIZE));
+    if (!slot_count)
+        return KResult(-EINVAL);
+
+    if (!description->file().is_block_device()) {
+        auto result = fill_swap_file(*description, slot_count);
+        if (result.is_error())
+            return result;
+    }
+
+    s_the = new SwapSpace(move(description), slot_count);
+    klog() << "SwapSpace: Enabled with " << slot_count << " slots (" << (slot_count * PAGE_SIZE / KB) << " KB)";
+    return KSuccess;
+}
+
+KResult SwapSpace::fill_swap_file(FileDescription& description, size_t slot_count)
+{
+    // We only swap out once memory is already tight, so writing a page out must not be the first
+    // write to that part of the file: the file system could have to allocate blocks (and grow its
+    // block lists) right when there's nothing left to allocate from. Writing the whole file once
+    // now gets all of that done up front.
+    static u8 zero_page[PAGE_SIZE];
+    for (size_t slot = 0; slot < slot_count; ++slot) {
+        ssize_t nwritten = description.file().write(description, slot * PAGE_SIZE, zero_page, PAGE_SIZE);
+        if (nwritten < 0)
+            return KResult(nwritten);
+        if (nwritten != PAGE_SIZE)
+            return KResult(-EIO);
+    }
+    return KSuccess;
+}
+
+SwapSpace::SwapSpace(NonnullRefPtr<FileDescription> description, size_t slot_count)
+    : m_description(move(description))
+{
+    m_slot_ref_counts.resize(slot_count);
+    for (size_t i = 0; i < slot_count; ++i)
+        m_slot_ref_counts[i] = 0;
+}
+
+Optional<u32> SwapSpace::allocate_slot()
+{
+    InterruptDisabler disabler;
+    if (m_used_slot_count == slot_count())
+        return {};
+    for (size_t i = 0; i < slot_count(); ++i) {
+        size_t slot = (m_next_slot_hint + i) % slot_count();
+        if (m_slot_ref_counts[slot])
+            continue;
+        m_slot_ref_counts[slot] = 1;
+        ++m_used_slot_count;
+        m_next_slot_hint = slot + 1;
+        return slot;
+    }
+    ASSERT_NOT_REACHED();
+}
+
+void SwapSpace::ref_slot(u32 slot)
+{
+    InterruptDisabler disabler;
+    ASSERT(m_slot_ref_counts[slot]);
+    ASSERT(m_slot_ref_counts[slot] < NumericLimits<u16>::max());
+    ++m_slot_ref_counts[slot];
+}
+
+void SwapSpace::unref_slot(u32 slot)
+{
+    InterruptDisabler disabler;
+    ASSERT(m_slot_ref_counts[slot]);
+    if (--m_slot_ref_counts[slot])
+        return;
+    --m_used_slot_count;
+    if (slot < m_next_slot_hint)
+        m_next_slot_hint = slot;
+}
+
+KResult SwapSpace::write_page(u32 slot, const u8* data)
+{
+    ASSERT(slot < slot_count());
+    ssize_t nwritten = m_description->file().write(*m_description, (size_t)slot * PAGE_SIZE, data, PAGE_SIZE);
+    if (nwritten < 0)
+        return KResult(nwritten);
+    if (nwritten != PAGE_SIZE)
+        return KResult(-EIO);
+    ++m_swap_out_count;
+    return KSuccess;
+}
+
+KResult SwapSpace::read_page(u32 slot, u8* data)
+{
+    ASSERT(slot < slot_count());
+    ssize_t nread = m_description->file().read(*m_description, (size_t)slot * PAGE_SIZE, data, PAGE_SIZE);
+    if (nread < 0)
+        return KResult(nread);
+    if (nread != PAGE_SIZE)
+        return KResult(-EIO);
+    ++m_swap_in_count;
+    return KSuccess;
+}
+
+size_t SwapSpace::swap_out_until_relieved()
+{
+    static constexpr size_t batch_size = 32;
+
+    Vector<NonnullRefPtr<AnonymousVMObject>> candidates;
+    {
+        InterruptDisabler disabler;
+        MemoryManager::for_each_vmobject_of_type<AnonymousVMObject>([&](auto& vmobject) {
+            // Purgeable memory is reclaimed by purging it, not by swapping it out.
+            if (!vmobject.is_purgeable())
+                candidates.append(vmobject);
+            return IterationDecision::Continue;
+        });
+    }
+    if (candidates.is_empty())
+        return 0;
+
+    // This is a clock: every VMObject keeps its own hand, and we sweep across all of them at most
+    // twice. The first sweep clears the accessed bits of recently used pages, giving them a second
+    // chance, so that the second sweep only picks pages that nobody touched in between.
+    size_t swapped_out_count = 0;
+    size_t visited_count = 0;
+    while (visited_count < candidates.size() * 2) {
+        if (MM.memory_pressure() == MemoryPressure::None)
+            break;
+        if (m_used_slot_count == slot_count())
+            break;
+        auto& vmobject = candidates[(m_clock_hand + visited_count) % candidates.size()];
+        swapped_out_count += vmobject->swap_out_cold_pages(*this, batch_size);
+        ++visited_count;
+    }
+    m_clock_hand += visited_count;
+
+#ifdef SWAP_DEBUG
+    dbg() << "SwapSpace: Swapped out " << swapped_out_count << " pages, " << m_used_slot_count << "/" << slot_count() << " slots in use";
+#endif
+    return swapped_out_count;
+}
+
+}
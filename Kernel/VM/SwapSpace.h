@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <Kernel/KResult.h>
+
+namespace Kernel {
+
+class FileDescription;
+
+// A single swap area backed by a regular file or a disk partition, divided into page sized slots.
+// Slots are reference counted since a fork() shares swapped out pages between parent and child.
+class SwapSpace {
+    AK_MAKE_ETERNAL
+public:
+    static SwapSpace* the();
+    static KResult enable(NonnullRefPtr<FileDescription>);
+
+    size_t slot_count() const { return m_slot_ref_counts.size(); }
+    size_t used_slot_count() const { return m_used_slot_count; }
+    u32 swap_in_count() const { return m_swap_in_count; }
+    u32 swap_out_count() const { return m_swap_out_count; }
+
+    Optional<u32> allocate_slot();
+    void ref_slot(u32 slot);
+    void unref_slot(u32 slot);
+
+    KResult write_page(u32 slot, const u8* data);
+    KResult read_page(u32 slot, u8* data);
+
+    // Evict cold anonymous pages until the MemoryManager is no longer under memory pressure.
+    size_t swap_out_until_relieved();
+
+private:
+    SwapSpace(NonnullRefPtr<FileDescription>, size_t slot_count);
+
+    static KResult fill_swap_file(FileDescription&, size_t slot_count);
+
+    NonnullRefPtr<FileDescription> m_description;
+    Vector<u16> m_slot_ref_counts;
+    size_t m_used_slot_count { 0 };
+    size_t m_next_slot_hint { 0 };
+    size_t m_clock_hand { 0 };
+    u32 m_swap_in_count { 0 };
+    u32 m_swap_out_count { 0 };
+};
+
+}
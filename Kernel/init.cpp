@@ -40,6 +40,7 @@
 #include <Kernel/Devices/KeyboardDevice.h>
 #include <Kernel/Devices/MBRPartitionTable.h>
 #include <Kernel/Devices/MBVGADevice.h>
+#include <Kernel/Devices/MemoryPressureDevice.h>
 #include <Kernel/Devices/NullDevice.h>
 #include <Kernel/Devices/PATAChannel.h>
 #include <Kernel/Devices/PATADiskDevice.h>
@@ -71,6 +72,7 @@
 #include <Kernel/TTY/PTYMultiplexer.h>
 #include <Kernel/TTY/VirtualConsole.h>
 #include <Kernel/Tasks/FinalizerTask.h>
+#include <Kernel/Tasks/MemoryPressureTask.h>
 #include <Kernel/Tasks/SyncTask.h>
 #include <Kernel/Time/TimeManagement.h>
 #include <Kernel/VM/MemoryManager.h>
@@ -186,6 +188,7 @@ void init_stage2()
 {
     SyncTask::spawn();
     FinalizerTask::spawn();
+    MemoryPressureTask::spawn();
 
     PCI::initialize();
 
@@ -226,6 +229,7 @@ void init_stage2()
     new FullDevice;
     new RandomDevice;
     new PTYMultiplexer;
+    new MemoryPressureDevice;
     new SB16;
     VMWareBackdoor::initialize();
 
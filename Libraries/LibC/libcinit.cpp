@@ -26,6 +26,7 @@
 
 #include <AK/Types.h>
 #include <assert.h>
+#include <malloc.h>
 
 extern "C" {
 
@@ -35,7 +36,6 @@ bool __environ_is_malloced;
 
 void __libc_init()
 {
-    void __malloc_init();
     __malloc_init();
 
     void __stdio_init();
@@ -30,6 +30,7 @@
 #include <AK/Vector.h>
 #include <LibThread/Lock.h>
 #include <assert.h>
+#include <malloc.h>
 #include <mallocdefs.h>
 #include <serenity.h>
 #include <stdio.h>
@@ -37,8 +38,6 @@
 #include <string.h>
 #include <sys/mman.h>
 
-// FIXME: Thread safety.
-
 //#define MALLOC_DEBUG
 #define RECYCLE_BIG_ALLOCATIONS
 
@@ -46,6 +45,7 @@
 #define MAGIC_BIGALLOC_HEADER 0x42697267
 #define PAGE_ROUND_UP(x) ((((size_t)(x)) + PAGE_SIZE - 1) & (~(PAGE_SIZE - 1)))
 
+// Guards the big allocations. Chunked allocations are guarded by their size class' own lock.
 static LibThread::Lock& malloc_lock()
 {
     static u32 lock_storage[sizeof(LibThread::Lock) / sizeof(u32)];
@@ -55,12 +55,24 @@ static LibThread::Lock& malloc_lock()
 constexpr int number_of_chunked_blocks_to_keep_around_per_size_class = 4;
 constexpr int number_of_big_blocks_to_keep_around_per_size_class = 8;
 
+// Each thread keeps a small cache of free chunks for the smaller size classes, so most
+// malloc() and free() calls don't have to take any lock at all. The cache is refilled from,
+// and drained back into, the shared blocks in batches.
+constexpr size_t number_of_thread_cached_size_classes = 8;
+constexpr size_t thread_cache_batch_size = 32;
+constexpr size_t thread_cache_max_chunks_per_size_class = 2 * thread_cache_batch_size;
+
 static bool s_log_malloc = false;
 static bool s_scrub_malloc = true;
 static bool s_scrub_free = true;
 static bool s_profiling = false;
 static unsigned short size_classes[] = { 8, 16, 32, 64, 128, 252, 508, 1016, 2036, 4090, 8188, 16376, 32756, 0 };
 static constexpr size_t num_size_classes = sizeof(size_classes) / sizeof(unsigned short);
+static constexpr size_t largest_size_class = 32756;
+
+// Maps (size + 7) / 8 to the index of the smallest size class that fits the smallest size in that
+// bucket of 8 sizes. Filled in by __malloc_init.
+static u8 s_size_class_index_for_size[(largest_size_class + 7) / 8 + 1];
 
 constexpr size_t block_size = 64 * KB;
 constexpr size_t block_mask = ~(block_size - 1);
@@ -120,18 +132,33 @@ struct ChunkedBlock
 };
 
 struct Allocator {
+    LibThread::Lock lock;
     size_t size { 0 };
     size_t block_count { 0 };
     size_t empty_block_count { 0 };
     ChunkedBlock* empty_blocks[number_of_chunked_blocks_to_keep_around_per_size_class] { nullptr };
     InlineLinkedList<ChunkedBlock> usable_blocks;
     InlineLinkedList<ChunkedBlock> full_blocks;
+    size_t thread_cache_refill_count { 0 };
+    size_t thread_cache_drain_count { 0 };
+};
+
+struct ThreadCache {
+    FreelistEntry* freelists[number_of_thread_cached_size_classes];
+    u16 chunk_counts[number_of_thread_cached_size_classes];
 };
 
+// Zero-initialized, so it's valid before anyone touches it.
+static __thread ThreadCache t_thread_cache;
+
 struct BigAllocator {
     Vector<BigAllocationBlock*, number_of_big_blocks_to_keep_around_per_size_class> blocks;
 };
 
+// Live big allocations, guarded by malloc_lock().
+static size_t s_big_allocation_count;
+static size_t s_big_allocation_bytes;
+
 // Allocators will be initialized in __malloc_init.
 // We can not rely on global constructors to initialize them,
 // because they must be initialized before other global constructors
@@ -151,16 +178,25 @@ static inline BigAllocator (&big_allocators())[1]
     return reinterpret_cast<BigAllocator(&)[1]>(g_big_allocators_storage);
 }
 
+static inline size_t size_class_index_for_size(size_t size)
+{
+    ASSERT(size && size <= largest_size_class);
+    size_t index = s_size_class_index_for_size[(size + 7) / 8];
+    // Most size classes aren't multiples of 8, so a bucket may straddle two of them.
+    if (size > size_classes[index])
+        ++index;
+    return index;
+}
+
 static Allocator* allocator_for_size(size_t size, size_t& good_size)
 {
-    for (int i = 0; size_classes[i]; ++i) {
-        if (size <= size_classes[i]) {
-            good_size = size_classes[i];
-            return &allocators()[i];
-        }
+    if (size > largest_size_class) {
+        good_size = PAGE_ROUND_UP(size);
+        return nullptr;
     }
-    good_size = PAGE_ROUND_UP(size);
-    return nullptr;
+    auto& allocator = allocators()[size_class_index_for_size(size)];
+    good_size = allocator.size;
+    return &allocator;
 }
 
 static BigAllocator* big_allocator_for_size(size_t size)
@@ -174,11 +210,11 @@ extern "C" {
 
 size_t malloc_good_size(size_t size)
 {
-    for (int i = 0; size_classes[i]; ++i) {
-        if (size < size_classes[i])
-            return size_classes[i];
-    }
-    return PAGE_ROUND_UP(size);
+    if (!size)
+        return size_classes[0];
+    size_t good_size;
+    allocator_for_size(size, good_size);
+    return good_size;
 }
 
 static void* os_alloc(size_t size, const char* name)
@@ -194,55 +230,72 @@ static void os_free(void* ptr, size_t size)
     assert(rc == 0);
 }
 
-static void* malloc_impl(size_t size)
+static void* allocate_big(size_t size)
 {
     LOCKER(malloc_lock());
 
-    if (s_log_malloc)
-        dbgprintf("LibC: malloc(%zu)\n", size);
+    size_t real_size = round_up_to_power_of_two(sizeof(BigAllocationBlock) + size, block_size);
+    ++s_big_allocation_count;
+    s_big_allocation_bytes += real_size;
+#ifdef RECYCLE_BIG_ALLOCATIONS
+    if (auto* allocator = big_allocator_for_size(real_size)) {
+        if (!allocator->blocks.is_empty()) {
+            auto* block = allocator->blocks.take_last();
+            int rc = madvise(block, real_size, MADV_SET_NONVOLATILE);
+            bool this_block_was_purged = rc == 1;
+            if (rc < 0) {
+                perror("madvise");
+                ASSERT_NOT_REACHED();
+            }
+            if (mprotect(block, real_size, PROT_READ | PROT_WRITE) < 0) {
+                perror("mprotect");
+                ASSERT_NOT_REACHED();
+            }
+            if (this_block_was_purged)
+                new (block) BigAllocationBlock(real_size);
+            return &block->m_slot[0];
+        }
+    }
+#endif
+    auto* block = (BigAllocationBlock*)os_alloc(real_size, "malloc: BigAllocationBlock");
+    new (block) BigAllocationBlock(real_size);
+    return &block->m_slot[0];
+}
 
-    if (!size)
-        return nullptr;
+static void free_big(BigAllocationBlock* block)
+{
+    LOCKER(malloc_lock());
 
-    size_t good_size;
-    auto* allocator = allocator_for_size(size, good_size);
+    --s_big_allocation_count;
+    s_big_allocation_bytes -= block->m_size;
 
-    if (!allocator) {
-        size_t real_size = round_up_to_power_of_two(sizeof(BigAllocationBlock) + size, block_size);
 #ifdef RECYCLE_BIG_ALLOCATIONS
-        if (auto* allocator = big_allocator_for_size(real_size)) {
-            if (!allocator->blocks.is_empty()) {
-                auto* block = allocator->blocks.take_last();
-                int rc = madvise(block, real_size, MADV_SET_NONVOLATILE);
-                bool this_block_was_purged = rc == 1;
-                if (rc < 0) {
-                    perror("madvise");
-                    ASSERT_NOT_REACHED();
-                }
-                if (mprotect(block, real_size, PROT_READ | PROT_WRITE) < 0) {
-                    perror("mprotect");
-                    ASSERT_NOT_REACHED();
-                }
-                if (this_block_was_purged)
-                    new (block) BigAllocationBlock(real_size);
-                return &block->m_slot[0];
+    if (auto* allocator = big_allocator_for_size(block->m_size)) {
+        if (allocator->blocks.size() < number_of_big_blocks_to_keep_around_per_size_class) {
+            allocator->blocks.append(block);
+            size_t this_block_size = block->m_size;
+            if (mprotect(block, this_block_size, PROT_NONE) < 0) {
+                perror("mprotect");
+                ASSERT_NOT_REACHED();
+            }
+            if (madvise(block, this_block_size, MADV_SET_VOLATILE) != 0) {
+                perror("madvise");
+                ASSERT_NOT_REACHED();
             }
+            return;
         }
-#endif
-        auto* block = (BigAllocationBlock*)os_alloc(real_size, "malloc: BigAllocationBlock");
-        new (block) BigAllocationBlock(real_size);
-        return &block->m_slot[0];
     }
+#endif
+    os_free(block, block->m_size);
+}
 
-    ChunkedBlock* block = nullptr;
-
-    for (block = allocator->usable_blocks.head(); block; block = block->next()) {
-        if (block->free_chunks())
-            break;
-    }
+// Takes a chunk from the shared blocks of a size class. The allocator's lock must be held.
+static void* allocate_chunk(Allocator& allocator)
+{
+    ChunkedBlock* block = allocator.usable_blocks.head();
 
-    if (!block && allocator->empty_block_count) {
-        block = allocator->empty_blocks[--allocator->empty_block_count];
+    if (!block && allocator.empty_block_count) {
+        block = allocator.empty_blocks[--allocator.empty_block_count];
         int rc = madvise(block, block_size, MADV_SET_NONVOLATILE);
         bool this_block_was_purged = rc == 1;
         if (rc < 0) {
@@ -255,34 +308,139 @@ static void* malloc_impl(size_t size)
             ASSERT_NOT_REACHED();
         }
         if (this_block_was_purged)
-            new (block) ChunkedBlock(good_size);
-        allocator->usable_blocks.append(block);
+            new (block) ChunkedBlock(allocator.size);
+        allocator.usable_blocks.append(block);
     }
 
     if (!block) {
         char buffer[64];
-        snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
+        snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", allocator.size);
         block = (ChunkedBlock*)os_alloc(block_size, buffer);
-        new (block) ChunkedBlock(good_size);
-        allocator->usable_blocks.append(block);
-        ++allocator->block_count;
+        new (block) ChunkedBlock(allocator.size);
+        allocator.usable_blocks.append(block);
+        ++allocator.block_count;
     }
 
+    ASSERT(block->free_chunks());
     --block->m_free_chunks;
     void* ptr = block->m_freelist;
     block->m_freelist = block->m_freelist->next;
     if (block->is_full()) {
 #ifdef MALLOC_DEBUG
-        dbgprintf("Block %p is now full in size class %zu\n", block, good_size);
+        dbgprintf("Block %p is now full in size class %zu\n", block, allocator.size);
 #endif
-        allocator->usable_blocks.remove(block);
-        allocator->full_blocks.append(block);
+        allocator.usable_blocks.remove(block);
+        allocator.full_blocks.append(block);
     }
 #ifdef MALLOC_DEBUG
     dbgprintf("LibC: allocated %p (chunk in block %p, size %zu)\n", ptr, block, block->bytes_per_chunk());
 #endif
+    return ptr;
+}
+
+// Returns a chunk to the block it came from. The allocator's lock must be held.
+static void free_chunk(Allocator& allocator, void* ptr)
+{
+    auto* block = (ChunkedBlock*)((FlatPtr)ptr & block_mask);
+    ASSERT(block->m_magic == MAGIC_PAGE_HEADER);
+
+    auto* entry = (FreelistEntry*)ptr;
+    entry->next = block->m_freelist;
+    block->m_freelist = entry;
+
+    if (block->is_full()) {
+#ifdef MALLOC_DEBUG
+        dbgprintf("Block %p no longer full in size class %zu\n", block, allocator.size);
+#endif
+        allocator.full_blocks.remove(block);
+        allocator.usable_blocks.prepend(block);
+    }
+
+    ++block->m_free_chunks;
+
+    if (!block->used_chunks()) {
+        if (allocator.block_count < number_of_chunked_blocks_to_keep_around_per_size_class) {
+#ifdef MALLOC_DEBUG
+            dbgprintf("Keeping block %p around for size class %zu\n", block, allocator.size);
+#endif
+            allocator.usable_blocks.remove(block);
+            allocator.empty_blocks[allocator.empty_block_count++] = block;
+            mprotect(block, block_size, PROT_NONE);
+            madvise(block, block_size, MADV_SET_VOLATILE);
+            return;
+        }
+#ifdef MALLOC_DEBUG
+        dbgprintf("Releasing block %p for size class %zu\n", block, allocator.size);
+#endif
+        allocator.usable_blocks.remove(block);
+        --allocator.block_count;
+        os_free(block, block_size);
+    }
+}
+
+static void refill_thread_cache(size_t size_class_index)
+{
+    auto& allocator = allocators()[size_class_index];
+    auto& freelist = t_thread_cache.freelists[size_class_index];
+    auto& chunk_count = t_thread_cache.chunk_counts[size_class_index];
+
+    LOCKER(allocator.lock);
+    ++allocator.thread_cache_refill_count;
+    while (chunk_count < thread_cache_batch_size) {
+        auto* entry = (FreelistEntry*)allocate_chunk(allocator);
+        entry->next = freelist;
+        freelist = entry;
+        ++chunk_count;
+    }
+}
+
+static void drain_thread_cache(size_t size_class_index, size_t chunks_to_keep)
+{
+    auto& allocator = allocators()[size_class_index];
+    auto& freelist = t_thread_cache.freelists[size_class_index];
+    auto& chunk_count = t_thread_cache.chunk_counts[size_class_index];
+
+    // Chunks go back to whichever block they belong to, no matter which thread allocated them.
+    // That's what makes freeing memory that was allocated on another thread safe.
+    LOCKER(allocator.lock);
+    ++allocator.thread_cache_drain_count;
+    while (chunk_count > chunks_to_keep) {
+        auto* entry = freelist;
+        freelist = entry->next;
+        --chunk_count;
+        free_chunk(allocator, entry);
+    }
+}
+
+static void* malloc_impl(size_t size)
+{
+    if (s_log_malloc)
+        dbgprintf("LibC: malloc(%zu)\n", size);
+
+    if (!size)
+        return nullptr;
+
+    if (size > largest_size_class)
+        return allocate_big(size);
+
+    size_t size_class_index = size_class_index_for_size(size);
+    auto& allocator = allocators()[size_class_index];
+
+    void* ptr;
+    if (size_class_index < number_of_thread_cached_size_classes) {
+        if (!t_thread_cache.freelists[size_class_index])
+            refill_thread_cache(size_class_index);
+        auto* entry = t_thread_cache.freelists[size_class_index];
+        t_thread_cache.freelists[size_class_index] = entry->next;
+        --t_thread_cache.chunk_counts[size_class_index];
+        ptr = entry;
+    } else {
+        LOCKER(allocator.lock);
+        ptr = allocate_chunk(allocator);
+    }
+
     if (s_scrub_malloc)
-        memset(ptr, MALLOC_SCRUB_BYTE, block->m_size);
+        memset(ptr, MALLOC_SCRUB_BYTE, allocator.size);
     return ptr;
 }
 
@@ -293,31 +451,11 @@ static void free_impl(void* ptr)
     if (!ptr)
         return;
 
-    LOCKER(malloc_lock());
-
     void* block_base = (void*)((FlatPtr)ptr & block_mask);
     size_t magic = *(size_t*)block_base;
 
     if (magic == MAGIC_BIGALLOC_HEADER) {
-        auto* block = (BigAllocationBlock*)block_base;
-#ifdef RECYCLE_BIG_ALLOCATIONS
-        if (auto* allocator = big_allocator_for_size(block->m_size)) {
-            if (allocator->blocks.size() < number_of_big_blocks_to_keep_around_per_size_class) {
-                allocator->blocks.append(block);
-                size_t this_block_size = block->m_size;
-                if (mprotect(block, this_block_size, PROT_NONE) < 0) {
-                    perror("mprotect");
-                    ASSERT_NOT_REACHED();
-                }
-                if (madvise(block, this_block_size, MADV_SET_VOLATILE) != 0) {
-                    perror("madvise");
-                    ASSERT_NOT_REACHED();
-                }
-                return;
-            }
-        }
-#endif
-        os_free(block, block->m_size);
+        free_big((BigAllocationBlock*)block_base);
         return;
     }
 
@@ -325,48 +463,25 @@ static void free_impl(void* ptr)
     auto* block = (ChunkedBlock*)block_base;
 
 #ifdef MALLOC_DEBUG
-    dbgprintf("LibC: freeing %p in allocator %p (size=%u, used=%u)\n", ptr, block, block->bytes_per_chunk(), block->used_chunks());
+    dbgprintf("LibC: freeing %p in allocator %p (size=%zu, used=%zu)\n", ptr, block, block->bytes_per_chunk(), block->used_chunks());
 #endif
 
     if (s_scrub_free)
         memset(ptr, FREE_SCRUB_BYTE, block->bytes_per_chunk());
 
-    auto* entry = (FreelistEntry*)ptr;
-    entry->next = block->m_freelist;
-    block->m_freelist = entry;
-
-    if (block->is_full()) {
-        size_t good_size;
-        auto* allocator = allocator_for_size(block->m_size, good_size);
-#ifdef MALLOC_DEBUG
-        dbgprintf("Block %p no longer full in size class %u\n", block, good_size);
-#endif
-        allocator->full_blocks.remove(block);
-        allocator->usable_blocks.prepend(block);
+    size_t size_class_index = size_class_index_for_size(block->m_size);
+    if (size_class_index < number_of_thread_cached_size_classes) {
+        auto* entry = (FreelistEntry*)ptr;
+        entry->next = t_thread_cache.freelists[size_class_index];
+        t_thread_cache.freelists[size_class_index] = entry;
+        if (++t_thread_cache.chunk_counts[size_class_index] > thread_cache_max_chunks_per_size_class)
+            drain_thread_cache(size_class_index, thread_cache_batch_size);
+        return;
     }
 
-    ++block->m_free_chunks;
-
-    if (!block->used_chunks()) {
-        size_t good_size;
-        auto* allocator = allocator_for_size(block->m_size, good_size);
-        if (allocator->block_count < number_of_chunked_blocks_to_keep_around_per_size_class) {
-#ifdef MALLOC_DEBUG
-            dbgprintf("Keeping block %p around for size class %u\n", block, good_size);
-#endif
-            allocator->usable_blocks.remove(block);
-            allocator->empty_blocks[allocator->empty_block_count++] = block;
-            mprotect(block, block_size, PROT_NONE);
-            madvise(block, block_size, MADV_SET_VOLATILE);
-            return;
-        }
-#ifdef MALLOC_DEBUG
-        dbgprintf("Releasing block %p for size class %u\n", block, good_size);
-#endif
-        allocator->usable_blocks.remove(block);
-        --allocator->block_count;
-        os_free(block, block_size);
-    }
+    auto& allocator = allocators()[size_class_index];
+    LOCKER(allocator.lock);
+    free_chunk(allocator, ptr);
 }
 
 void* malloc(size_t size)
@@ -396,7 +511,6 @@ size_t malloc_size(void* ptr)
 {
     if (!ptr)
         return 0;
-    LOCKER(malloc_lock());
     void* page_base = (void*)((FlatPtr)ptr & block_mask);
     auto* header = (const CommonHeader*)page_base;
     auto size = header->m_size;
@@ -409,7 +523,6 @@ void* realloc(void* ptr, size_t size)
 {
     if (!ptr)
         return malloc(size);
-    LOCKER(malloc_lock());
     auto existing_allocation_size = malloc_size(ptr);
     if (size <= existing_allocation_size)
         return ptr;
@@ -419,6 +532,65 @@ void* realloc(void* ptr, size_t size)
     return new_ptr;
 }
 
+void __malloc_thread_exit()
+{
+    for (size_t i = 0; i < number_of_thread_cached_size_classes; ++i) {
+        if (t_thread_cache.chunk_counts[i])
+            drain_thread_cache(i, 0);
+    }
+}
+
+struct mallinfo mallinfo()
+{
+    struct mallinfo info;
+    memset(&info, 0, sizeof(info));
+    for (size_t i = 0; i < num_size_classes - 1; ++i) {
+        auto& allocator = allocators()[i];
+        LOCKER(allocator.lock);
+        size_t free_chunks = 0;
+        size_t used_chunks = 0;
+        for (auto* block = allocator.usable_blocks.head(); block; block = block->next()) {
+            used_chunks += block->used_chunks();
+            free_chunks += block->free_chunks();
+        }
+        for (auto* block = allocator.full_blocks.head(); block; block = block->next())
+            used_chunks += block->used_chunks();
+        info.arena += allocator.block_count * block_size;
+        info.ordblks += free_chunks;
+        info.uordblks += used_chunks * allocator.size;
+        info.fordblks += free_chunks * allocator.size;
+        info.keepcost += allocator.empty_block_count * block_size;
+    }
+    LOCKER(malloc_lock());
+    info.hblks = s_big_allocation_count;
+    info.hblkhd = s_big_allocation_bytes;
+    for (auto* block : big_allocators()[0].blocks)
+        info.keepcost += block->m_size;
+    return info;
+}
+
+void serenity_dump_malloc_stats()
+{
+    dbgprintf("# malloc stats for %d:%d\n", getpid(), gettid());
+    for (size_t i = 0; i < num_size_classes - 1; ++i) {
+        auto& allocator = allocators()[i];
+        LOCKER(allocator.lock);
+        size_t used_chunks = 0;
+        size_t free_chunks = 0;
+        for (auto* block = allocator.usable_blocks.head(); block; block = block->next()) {
+            used_chunks += block->used_chunks();
+            free_chunks += block->free_chunks();
+        }
+        for (auto* block = allocator.full_blocks.head(); block; block = block->next())
+            used_chunks += block->used_chunks();
+        dbgprintf("size %5zu: %3zu blocks (%zu empty), %6zu chunks used, %6zu free, %zu cache refills, %zu cache drains\n",
+            allocator.size, allocator.block_count, allocator.empty_block_count, used_chunks, free_chunks,
+            allocator.thread_cache_refill_count, allocator.thread_cache_drain_count);
+    }
+    LOCKER(malloc_lock());
+    dbgprintf("%zu recycled big blocks\n", big_allocators()[0].blocks.size());
+}
+
 void __malloc_init()
 {
     new (&malloc_lock()) LibThread::Lock();
@@ -430,12 +602,22 @@ void __malloc_init()
         s_log_malloc = true;
     if (getenv("LIBC_PROFILE_MALLOC"))
         s_profiling = true;
+    if (getenv("LIBC_DUMP_MALLOC_STATS"))
+        atexit(serenity_dump_malloc_stats);
 
     for (size_t i = 0; i < num_size_classes; ++i) {
         new (&allocators()[i]) Allocator();
         allocators()[i].size = size_classes[i];
     }
 
+    size_t size_class_index = 0;
+    for (size_t i = 1; i < sizeof(s_size_class_index_for_size); ++i) {
+        size_t smallest_size_in_bucket = (i - 1) * 8 + 1;
+        while (size_classes[size_class_index] < smallest_size_in_bucket)
+            ++size_class_index;
+        s_size_class_index_for_size[i] = size_class_index;
+    }
+
     new (&big_allocators()[0])(BigAllocator);
 }
 }
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <sys/cdefs.h>
+
+__BEGIN_DECLS
+
+// Allocator statistics for the calling process, laid out like glibc's mallinfo2.
+// Fields that don't apply to our allocator are always zero.
+struct mallinfo {
+    size_t arena;    // Bytes in chunked blocks, including empty blocks kept around for reuse.
+    size_t ordblks;  // Free chunks in chunked blocks.
+    size_t smblks;   // Unused.
+    size_t hblks;    // Live allocations too big for a size class, each mmap()ed on its own.
+    size_t hblkhd;   // Bytes in those big allocations.
+    size_t usmblks;  // Unused.
+    size_t fsmblks;  // Unused.
+    size_t uordblks; // Bytes in chunks handed out. Chunks in a thread's cache count as handed out.
+    size_t fordblks; // Bytes in free chunks.
+    size_t keepcost; // Bytes in empty chunked blocks and big blocks kept around for reuse.
+};
+
+struct mallinfo mallinfo(void);
+
+void __malloc_init(void);
+void __malloc_thread_exit(void);
+
+__END_DECLS
@@ -24,103 +24,216 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-/*-
- * Copyright (c) 1980, 1983, 1990 The Regents of the University of California.
- * All rights reserved.
- *
- * Redistribution and use in source and binary forms, with or without
- * modification, are permitted provided that the following conditions
- * are met:
- * 1. Redistributions of source code must retain the above copyright
- *    notice, this list of conditions and the following disclaimer.
- * 2. Redistributions in binary form must reproduce the above copyright
- *    notice, this list of conditions and the following disclaimer in the
- *    documentation and/or other materials provided with the distribution.
- * 3. All advertising materials mentioning features or use of this software
- *    must display the following acknowledgement:
- *	This product includes software developed by the University of
- *	California, Berkeley and its contributors.
- * 4. Neither the name of the University nor the names of its contributors
- *    may be used to endorse or promote products derived from this software
- *    without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
- * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
- * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
- * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
- * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
- * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
- * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
- * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
- * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
- * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
- * SUCH DAMAGE.
- */
-
-#if defined(LIBC_SCCS) && !defined(lint)
-static char sccsid[] = "@(#)qsort.c	5.9 (Berkeley) 2/23/91";
-#endif /* LIBC_SCCS and not lint */
-
+#include <AK/Types.h>
 #include <stdlib.h>
 #include <sys/types.h>
 
-static void insertion_sort(void* bot, size_t nmemb, size_t size, int (*compar)(const void*, const void*));
-static void insertion_sort_r(void* bot, size_t nmemb, size_t size, int (*compar)(const void*, const void*, void*), void* arg);
+// An introsort: quicksort with a median-of-three (or ninther) pivot, falling back to heapsort
+// when the recursion gets too deep, and to insertion sort for small partitions.
 
-void qsort(void* bot, size_t nmemb, size_t size, int (*compar)(const void*, const void*))
+static constexpr size_t insertion_sort_threshold = 16;
+static constexpr size_t ninther_threshold = 128;
+
+template<typename T>
+static void swap_elements(char* a, char* b, size_t)
 {
-    if (nmemb <= 1)
-        return;
+    T tmp = *reinterpret_cast<T*>(a);
+    *reinterpret_cast<T*>(a) = *reinterpret_cast<T*>(b);
+    *reinterpret_cast<T*>(b) = tmp;
+}
+
+static void swap_words(char* a, char* b, size_t size)
+{
+    auto* wa = reinterpret_cast<FlatPtr*>(a);
+    auto* wb = reinterpret_cast<FlatPtr*>(b);
+    for (size_t i = 0; i < size / sizeof(FlatPtr); ++i) {
+        FlatPtr tmp = wa[i];
+        wa[i] = wb[i];
+        wb[i] = tmp;
+    }
+}
 
-    insertion_sort(bot, nmemb, size, compar);
+static void swap_bytes(char* a, char* b, size_t size)
+{
+    for (size_t i = 0; i < size; ++i) {
+        char tmp = a[i];
+        a[i] = b[i];
+        b[i] = tmp;
+    }
 }
 
-void qsort_r(void* bot, size_t nmemb, size_t size, int (*compar)(const void*, const void*, void*), void* arg)
+template<typename Compare, typename Swap>
+class Sorter {
+public:
+    Sorter(size_t size, Compare compare, Swap swap)
+        : m_size(size)
+        , m_compare(compare)
+        , m_swap(swap)
+    {
+    }
+
+    void sort(char* base, size_t nmemb)
+    {
+        int depth_limit = 0;
+        for (size_t n = nmemb; n > 1; n >>= 1)
+            depth_limit += 2;
+        introsort(base, nmemb, depth_limit);
+    }
+
+private:
+    char* at(char* base, size_t index) const { return base + index * m_size; }
+    int compare(char* a, char* b) { return m_compare(a, b); }
+    void swap(char* a, char* b)
+    {
+        if (a != b)
+            m_swap(a, b, m_size);
+    }
+
+    void sort3(char* a, char* b, char* c)
+    {
+        if (compare(b, a) < 0)
+            swap(a, b);
+        if (compare(c, b) < 0) {
+            swap(b, c);
+            if (compare(b, a) < 0)
+                swap(a, b);
+        }
+    }
+
+    void insertion_sort(char* base, size_t nmemb)
+    {
+        for (size_t i = 1; i < nmemb; ++i) {
+            for (size_t j = i; j > 0; --j) {
+                char* current = at(base, j);
+                char* previous = current - m_size;
+                if (compare(previous, current) <= 0)
+                    break;
+                swap(previous, current);
+            }
+        }
+    }
+
+    void sift_down(char* base, size_t root, size_t nmemb)
+    {
+        for (;;) {
+            size_t child = 2 * root + 1;
+            if (child >= nmemb)
+                return;
+            if (child + 1 < nmemb && compare(at(base, child), at(base, child + 1)) < 0)
+                ++child;
+            if (compare(at(base, root), at(base, child)) >= 0)
+                return;
+            swap(at(base, root), at(base, child));
+            root = child;
+        }
+    }
+
+    void heapsort(char* base, size_t nmemb)
+    {
+        for (size_t i = nmemb / 2; i-- > 0;)
+            sift_down(base, i, nmemb);
+        for (size_t end = nmemb - 1; end > 0; --end) {
+            swap(base, at(base, end));
+            sift_down(base, 0, end);
+        }
+    }
+
+    // Moves the chosen pivot to base[0].
+    void choose_pivot(char* base, size_t nmemb)
+    {
+        size_t half = nmemb / 2;
+        char* first = base;
+        char* middle = at(base, half);
+        char* last = at(base, nmemb - 1);
+        if (nmemb > ninther_threshold) {
+            // Tukey's ninther: the median of three medians of three. Cheap, and much harder to fool.
+            sort3(first, middle, last);
+            sort3(first + m_size, middle - m_size, last - m_size);
+            sort3(first + 2 * m_size, middle + m_size, last - 2 * m_size);
+            sort3(middle - m_size, middle, middle + m_size);
+        } else {
+            sort3(first, middle, last);
+        }
+        swap(first, middle);
+    }
+
+    // Partitions around the pivot in base[0] and returns its final index. Both scans stop on
+    // elements equal to the pivot, which keeps the partitions balanced when there are lots of duplicates.
+    size_t partition(char* base, size_t nmemb)
+    {
+        char* pivot = base;
+        size_t i = 0;
+        size_t j = nmemb;
+        for (;;) {
+            while (compare(at(base, ++i), pivot) < 0) {
+                if (i == nmemb - 1)
+                    break;
+            }
+            while (compare(pivot, at(base, --j)) < 0) {
+            }
+            if (i >= j)
+                break;
+            swap(at(base, i), at(base, j));
+        }
+        swap(pivot, at(base, j));
+        return j;
+    }
+
+    void introsort(char* base, size_t nmemb, int depth_limit)
+    {
+        while (nmemb > insertion_sort_threshold) {
+            if (depth_limit-- == 0) {
+                heapsort(base, nmemb);
+                return;
+            }
+            choose_pivot(base, nmemb);
+            size_t pivot_index = partition(base, nmemb);
+            size_t left_count = pivot_index;
+            size_t right_count = nmemb - pivot_index - 1;
+            char* right = at(base, pivot_index + 1);
+            // Recurse into the smaller side and loop on the larger one to keep the stack shallow.
+            if (left_count < right_count) {
+                introsort(base, left_count, depth_limit);
+                base = right;
+                nmemb = right_count;
+            } else {
+                introsort(right, right_count, depth_limit);
+                nmemb = left_count;
+            }
+        }
+        insertion_sort(base, nmemb);
+    }
+
+    size_t m_size { 0 };
+    Compare m_compare;
+    Swap m_swap;
+};
+
+template<typename Compare>
+static void sort(void* bot, size_t nmemb, size_t size, Compare compare)
 {
-    if (nmemb <= 1)
+    if (nmemb <= 1 || !size)
         return;
 
-    insertion_sort_r(bot, nmemb, size, compar, arg);
+    auto* base = static_cast<char*>(bot);
+    auto address = reinterpret_cast<FlatPtr>(base);
+    if (size == sizeof(u32) && !(address % alignof(u32))) {
+        Sorter(size, compare, swap_elements<u32>).sort(base, nmemb);
+    } else if (size == sizeof(u64) && !(address % alignof(u64))) {
+        Sorter(size, compare, swap_elements<u64>).sort(base, nmemb);
+    } else if (!(size % sizeof(FlatPtr)) && !(address % alignof(FlatPtr))) {
+        Sorter(size, compare, swap_words).sort(base, nmemb);
+    } else {
+        Sorter(size, compare, swap_bytes).sort(base, nmemb);
+    }
 }
 
-void insertion_sort(void* bot, size_t nmemb, size_t size, int (*compar)(const void*, const void*))
+void qsort(void* bot, size_t nmemb, size_t size, int (*compar)(const void*, const void*))
 {
-    int cnt;
-    unsigned char ch;
-    char *s1, *s2, *t1, *t2, *top;
-    top = (char*)bot + nmemb * size;
-    for (t1 = (char*)bot + size; t1 < top;) {
-        for (t2 = t1; (t2 -= size) >= bot && compar(t1, t2) < 0;)
-            ;
-        if (t1 != (t2 += size)) {
-            for (cnt = size; cnt--; ++t1) {
-                ch = *t1;
-                for (s1 = s2 = t1; (s2 -= size) >= t2; s1 = s2)
-                    *s1 = *s2;
-                *s1 = ch;
-            }
-        } else
-            t1 += size;
-    }
+    sort(bot, nmemb, size, [compar](const void* a, const void* b) { return compar(a, b); });
 }
 
-void insertion_sort_r(void* bot, size_t nmemb, size_t size, int (*compar)(const void*, const void*, void*), void* arg)
+void qsort_r(void* bot, size_t nmemb, size_t size, int (*compar)(const void*, const void*, void*), void* arg)
 {
-    int cnt;
-    unsigned char ch;
-    char *s1, *s2, *t1, *t2, *top;
-    top = (char*)bot + nmemb * size;
-    for (t1 = (char*)bot + size; t1 < top;) {
-        for (t2 = t1; (t2 -= size) >= bot && compar(t1, t2, arg) < 0;)
-            ;
-        if (t1 != (t2 += size)) {
-            for (cnt = size; cnt--; ++t1) {
-                ch = *t1;
-                for (s1 = s2 = t1; (s2 -= size) >= t2; s1 = s2)
-                    *s1 = *s2;
-                *s1 = ch;
-            }
-        } else
-            t1 += size;
-    }
+    sort(bot, nmemb, size, [compar, arg](const void* a, const void* b) { return compar(a, b, arg); });
 }
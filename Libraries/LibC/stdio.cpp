@@ -38,10 +38,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
+// Regular files get a larger buffer than the default BUFSIZ.
+static constexpr size_t regular_file_buffer_size = 16 * 1024;
+
 struct FILE {
 public:
     FILE(int fd, int mode)
@@ -70,6 +74,12 @@ public:
     bool gets(u8*, size_t);
     bool ungetc(u8 byte) { return m_buffer.enqueue_front(byte); }
 
+    // Single-byte fast paths that go straight to the buffer whenever possible.
+    int getc();
+    int putc(u8);
+    // Reads up to and including the delimiter, growing the line buffer as needed.
+    ssize_t getdelim(char*& line, size_t& line_capacity, u8 delimiter);
+
     int seek(long offset, int whence);
     long tell();
 
@@ -83,11 +93,14 @@ private:
         ~Buffer();
 
         int mode() const { return m_mode; }
+        size_t capacity() const { return m_capacity; }
         void setbuf(u8* data, int mode, size_t size);
         // Make sure to call realize() before enqueuing any data.
         // Dequeuing can be attempted without it.
         void realize(int fd);
         void drop();
+        // Like drop(), but keeps the memory around for reuse.
+        void discard();
 
         bool may_use() const { return m_ungotten || m_mode != _IONBF; }
         bool is_not_empty() const { return m_ungotten || !m_empty; }
@@ -173,7 +186,7 @@ bool FILE::flush()
     if (m_mode & O_RDONLY) {
         // When open for reading, just drop the buffered data.
         size_t had_buffered = m_buffer.buffered_size();
-        m_buffer.drop();
+        m_buffer.discard();
         // Attempt to reset the underlying file position to what the user
         // expects.
         int rc = lseek(m_fd, -had_buffered, SEEK_CUR);
@@ -207,8 +220,13 @@ ssize_t FILE::do_write(const u8* data, size_t size)
 {
     int nwritten = ::write(m_fd, data, size);
 
-    if (nwritten < 0)
+    if (nwritten < 0) {
         m_error = errno;
+    } else if (nwritten == 0 && size) {
+        // A write that makes no progress would have our callers retry forever.
+        m_error = EIO;
+        return -1;
+    }
     return nwritten;
 }
 
@@ -257,7 +275,14 @@ size_t FILE::read(u8* data, size_t size)
             // Let's see if the buffer has something queued for us.
             size_t queued_size;
             const u8* queued_data = m_buffer.begin_dequeue(queued_size);
-            if (queued_size == 0) {
+            if (queued_size == 0 && size >= m_buffer.capacity()) {
+                // Nothing buffered, and the request wouldn't fit in the buffer
+                // anyway; read straight into the user buffer instead.
+                ssize_t nread = do_read(data, size);
+                if (nread <= 0)
+                    return total_read;
+                actual_size = nread;
+            } else if (queued_size == 0) {
                 // Nothing buffered; we're going to have to read some.
                 bool read_some_more = read_into_buffer();
                 if (read_some_more) {
@@ -265,10 +290,11 @@ size_t FILE::read(u8* data, size_t size)
                     continue;
                 }
                 return total_read;
+            } else {
+                actual_size = min(size, queued_size);
+                memcpy(data, queued_data, actual_size);
+                m_buffer.did_dequeue(actual_size);
             }
-            actual_size = min(size, queued_size);
-            memcpy(data, queued_data, actual_size);
-            m_buffer.did_dequeue(actual_size);
         } else {
             // Read directly into the user buffer.
             ssize_t nread = do_read(data, size);
@@ -292,7 +318,14 @@ size_t FILE::write(const u8* data, size_t size)
     while (size > 0) {
         size_t actual_size;
 
-        if (m_buffer.may_use()) {
+        if (m_buffer.may_use() && !m_buffer.is_not_empty() && size >= m_buffer.capacity()) {
+            // Nothing buffered, and the data wouldn't fit in the buffer anyway;
+            // write it out directly instead of copying it through the buffer.
+            ssize_t nwritten = do_write(data, size);
+            if (nwritten < 0)
+                return total_written;
+            actual_size = nwritten;
+        } else if (m_buffer.may_use()) {
             m_buffer.realize(m_fd);
             // Try writing into the buffer.
             size_t available_size;
@@ -389,6 +422,97 @@ bool FILE::gets(u8* data, size_t size)
     return total_read > 0;
 }
 
+int FILE::getc()
+{
+    size_t available_size;
+    const u8* data = m_buffer.begin_dequeue(available_size);
+    if (available_size) {
+        u8 byte = *data;
+        m_buffer.did_dequeue(1);
+        return byte;
+    }
+
+    u8 byte;
+    if (read(&byte, 1) == 1)
+        return byte;
+    return EOF;
+}
+
+int FILE::putc(u8 byte)
+{
+    // A newline has to flush a line-buffered stream, so leave that to write().
+    int mode = m_buffer.mode();
+    if (mode == _IOFBF || (mode == _IOLBF && byte != '\n')) {
+        m_buffer.realize(m_fd);
+        size_t available_size;
+        u8* data = m_buffer.begin_enqueue(available_size);
+        if (available_size) {
+            *data = byte;
+            m_buffer.did_enqueue(1);
+            return byte;
+        }
+    }
+
+    if (write(&byte, 1) == 1)
+        return byte;
+    return EOF;
+}
+
+ssize_t FILE::getdelim(char*& line, size_t& line_capacity, u8 delimiter)
+{
+    size_t length = 0;
+
+    for (;;) {
+        // Copy whole runs out of the buffer at a time, looking for the delimiter
+        // with memchr() instead of going through it byte by byte.
+        u8 byte;
+        const u8* data;
+        size_t available_size;
+        if (m_buffer.may_use()) {
+            data = m_buffer.begin_dequeue(available_size);
+            if (available_size == 0) {
+                if (read_into_buffer())
+                    continue;
+                break;
+            }
+        } else {
+            ssize_t nread = do_read(&byte, 1);
+            if (nread <= 0)
+                break;
+            data = &byte;
+            available_size = 1;
+        }
+
+        auto* found = static_cast<const u8*>(memchr(data, delimiter, available_size));
+        size_t chunk_size = found ? found - data + 1 : available_size;
+
+        if (length + chunk_size + 1 > line_capacity) {
+            size_t new_capacity = max(line_capacity * 2, length + chunk_size + 1);
+            auto* new_line = static_cast<char*>(realloc(line, new_capacity));
+            if (!new_line)
+                return -1;
+            line = new_line;
+            line_capacity = new_capacity;
+        }
+
+        memcpy(line + length, data, chunk_size);
+        length += chunk_size;
+        if (data != &byte)
+            m_buffer.did_dequeue(chunk_size);
+
+        if (found) {
+            line[length] = '\0';
+            return length;
+        }
+    }
+
+    // We've hit either the end of the file or an error.
+    if (!m_eof || length == 0)
+        return -1;
+    line[length] = '\0';
+    return length;
+}
+
 int FILE::seek(long offset, int whence)
 {
     bool ok = flush();
@@ -426,6 +550,11 @@ void FILE::Buffer::realize(int fd)
         m_mode = isatty(fd) ? _IOLBF : _IOFBF;
 
     if (m_mode != _IONBF && m_data == nullptr) {
+        // Regular files tend to be read and written in bulk, so give them a
+        // larger buffer. This is still small enough to not need its own mmap.
+        struct stat st;
+        if (m_capacity == BUFSIZ && fstat(fd, &st) == 0 && S_ISREG(st.st_mode))
+            m_capacity = regular_file_buffer_size;
         m_data = reinterpret_cast<u8*>(malloc(m_capacity));
         m_data_is_malloced = true;
     }
@@ -441,6 +570,13 @@ void FILE::Buffer::setbuf(u8* data, int mode, size_t size)
     }
 }
 
+void FILE::Buffer::discard()
+{
+    m_begin = m_end = 0;
+    m_empty = true;
+    m_ungotten = false;
+}
+
 void FILE::Buffer::drop()
 {
     if (m_data_is_malloced) {
@@ -619,11 +755,7 @@ char* fgets(char* buffer, int size, FILE* stream)
 int fgetc(FILE* stream)
 {
     ASSERT(stream);
-    char ch;
-    size_t nread = fread(&ch, sizeof(char), 1, stream);
-    if (nread == 1)
-        return ch;
-    return EOF;
+    return stream->getc();
 }
 
 int getc(FILE* stream)
@@ -641,9 +773,14 @@ int getchar()
     return getc(stdin);
 }
 
+int getchar_unlocked()
+{
+    return getc_unlocked(stdin);
+}
+
 ssize_t getdelim(char** lineptr, size_t* n, int delim, FILE* stream)
 {
-    char *ptr, *eptr;
+    ASSERT(stream);
     if (*lineptr == nullptr || *n == 0) {
         *n = BUFSIZ;
         if ((*lineptr = static_cast<char*>(malloc(*n))) == nullptr) {
@@ -651,34 +788,7 @@ ssize_t getdelim(char** lineptr, size_t* n, int delim, FILE* stream)
         }
     }
 
-    for (ptr = *lineptr, eptr = *lineptr + *n;;) {
-        int c = fgetc(stream);
-        if (c == -1) {
-            if (feof(stream)) {
-                *ptr = '\0';
-                return ptr == *lineptr ? -1 : ptr - *lineptr;
-            } else {
-                return -1;
-            }
-        }
-        *ptr++ = c;
-        if (c == delim) {
-            *ptr = '\0';
-            return ptr - *lineptr;
-        }
-        if (ptr + 2 >= eptr) {
-            char* nbuf;
-            size_t nbuf_sz = *n * 2;
-            ssize_t d = ptr - *lineptr;
-            if ((nbuf = static_cast<char*>(realloc(*lineptr, nbuf_sz))) == nullptr) {
-                return -1;
-            }
-            *lineptr = nbuf;
-            *n = nbuf_sz;
-            eptr = nbuf + nbuf_sz;
-            ptr = nbuf + d;
-        }
-    }
+    return stream->getdelim(*lineptr, *n, delim);
 }
 
 ssize_t getline(char** lineptr, size_t* n, FILE* stream)
@@ -696,12 +806,7 @@ int ungetc(int c, FILE* stream)
 int fputc(int ch, FILE* stream)
 {
     ASSERT(stream);
-    u8 byte = ch;
-    size_t nwritten = stream->write(&byte, 1);
-    if (nwritten == 0)
-        return EOF;
-    ASSERT(nwritten == 1);
-    return byte;
+    return stream->putc(ch);
 }
 
 int putc(int ch, FILE* stream)
@@ -709,11 +814,21 @@ int putc(int ch, FILE* stream)
     return fputc(ch, stream);
 }
 
+int putc_unlocked(int ch, FILE* stream)
+{
+    return fputc(ch, stream);
+}
+
 int putchar(int ch)
 {
     return putc(ch, stdout);
 }
 
+int putchar_unlocked(int ch)
+{
+    return putc_unlocked(ch, stdout);
+}
+
 int fputs(const char* s, FILE* stream)
 {
     ASSERT(stream);
@@ -25,6 +25,7 @@
  */
 
 #include <AK/Assertions.h>
+#include <AK/DoubleConversion.h>
 #include <AK/HashMap.h>
 #include <AK/Noncopyable.h>
 #include <AK/StdLibExtras.h>
@@ -348,6 +349,70 @@ int putenv(char* new_var)
     return 0;
 }
 
+// Decimal numbers are scanned here and converted with correct rounding by
+// AK::decimal_to_double(), which avoids the rounding errors that piling up
+// multiplications or divisions by 10 would introduce.
+static double strtod_decimal(const char* str, char* parse_ptr, Sign sign, char** endptr)
+{
+    const char* significand_start = parse_ptr;
+    bool any_digits = false;
+    bool seen_point = false;
+    for (;; ++parse_ptr) {
+        if (isdigit(*parse_ptr)) {
+            any_digits = true;
+            continue;
+        }
+        if (*parse_ptr == '.' && !seen_point) {
+            seen_point = true;
+            continue;
+        }
+        break;
+    }
+
+    if (!any_digits) {
+        // No actual number value available.
+        if (endptr)
+            *endptr = const_cast<char*>(str);
+        return 0.0;
+    }
+
+    StringView significand { significand_start, static_cast<size_t>(parse_ptr - significand_start) };
+
+    // Parse the exponent, if there is one. Exponents too large to matter
+    // are clamped, so that excessive ones don't overflow.
+    int exponent = 0;
+    if (*parse_ptr == 'e' || *parse_ptr == 'E') {
+        char* exponent_ptr = parse_ptr + 1;
+        Sign exponent_sign = strtosign(exponent_ptr, &exponent_ptr);
+        if (isdigit(*exponent_ptr)) {
+            for (; isdigit(*exponent_ptr); ++exponent_ptr) {
+                if (exponent < 100000)
+                    exponent = exponent * 10 + (*exponent_ptr - '0');
+            }
+            if (exponent_sign == Sign::Negative)
+                exponent = -exponent;
+            parse_ptr = exponent_ptr;
+        }
+    }
+
+    if (endptr)
+        *endptr = parse_ptr;
+
+    double value = decimal_to_double(significand, exponent, sign == Sign::Negative);
+    if (__builtin_isinf(value)) {
+        errno = ERANGE;
+    } else if (value == 0) {
+        // Only an underflow if there was a nonzero digit.
+        for (size_t i = 0; i < significand.length(); ++i) {
+            if (significand[i] >= '1' && significand[i] <= '9') {
+                errno = ERANGE;
+                break;
+            }
+        }
+    }
+    return value;
+}
+
 double strtod(const char* str, char** endptr)
 {
     // Parse spaces, sign, and base
@@ -401,8 +466,6 @@ double strtod(const char* str, char** endptr)
     }
 
     // Parse base
-    char exponent_lower;
-    char exponent_upper;
     int base = 10;
     if (*parse_ptr == '0') {
         const char base_ch = *(parse_ptr + 1);
@@ -412,13 +475,11 @@ double strtod(const char* str, char** endptr)
         }
     }
 
-    if (base == 10) {
-        exponent_lower = 'e';
-        exponent_upper = 'E';
-    } else {
-        exponent_lower = 'p';
-        exponent_upper = 'P';
-    }
+    if (base == 10)
+        return strtod_decimal(str, parse_ptr, sign, endptr);
+
+    const char exponent_lower = 'p';
+    const char exponent_upper = 'P';
 
     // Parse "digits", possibly keeping track of the exponent offset.
     // We parse the most significant digits and the position in the
@@ -27,6 +27,7 @@
 #include <AK/Platform.h>
 #include <AK/StdLibExtras.h>
 #include <AK/Types.h>
+#include <AK/WordAtATime.h>
 #include <assert.h>
 #include <ctype.h>
 #include <errno.h>
@@ -35,6 +36,143 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if ARCH(I386)
+static bool cpu_supports_sse2()
+{
+    static int s_supports_sse2 = -1;
+    if (s_supports_sse2 < 0) {
+        u32 eax = 1;
+        u32 ebx;
+        u32 ecx = 0;
+        u32 edx;
+        asm volatile("cpuid"
+                     : "+a"(eax), "=b"(ebx), "+c"(ecx), "=d"(edx));
+        s_supports_sse2 = (edx & (1 << 26)) != 0;
+    }
+    return s_supports_sse2;
+}
+
+// The SSE2 routines below are only ever called after checking cpu_supports_sse2(),
+// since LibC itself is built for CPUs without it.
+//
+// Like the word-at-a-time versions in AK, the scanners only ever load aligned
+// 16-byte blocks that contain at least one byte of the input, which can't
+// cross into an unmapped page.
+
+typedef char v16qi __attribute__((vector_size(16), may_alias));
+
+[[gnu::target("sse2")]] static inline u32 sse2_match_mask(const void* block, v16qi pattern)
+{
+    return __builtin_ia32_pmovmskb128(__builtin_ia32_pcmpeqb128(*(const v16qi*)block, pattern));
+}
+
+[[gnu::target("sse2")]] static inline v16qi sse2_broadcast(u8 byte)
+{
+    v16qi pattern = {};
+    return pattern + (char)byte;
+}
+
+[[gnu::target("sse2")]] static size_t sse2_strlen(const char* str)
+{
+    size_t offset = (FlatPtr)str & 15;
+    auto* block = str - offset;
+    v16qi zero = {};
+    u32 mask = sse2_match_mask(block, zero) >> offset;
+    if (mask)
+        return __builtin_ctz(mask);
+    for (;;) {
+        block += 16;
+        mask = sse2_match_mask(block, zero);
+        if (mask)
+            return block + __builtin_ctz(mask) - str;
+    }
+}
+
+[[gnu::target("sse2")]] static const char* sse2_strchr(const char* str, char ch)
+{
+    size_t offset = (FlatPtr)str & 15;
+    auto* block = str - offset;
+    v16qi zero = {};
+    v16qi pattern = sse2_broadcast(ch);
+    u32 mask = (sse2_match_mask(block, zero) | sse2_match_mask(block, pattern)) >> offset;
+    auto* match = str;
+    while (!mask) {
+        block += 16;
+        mask = sse2_match_mask(block, zero) | sse2_match_mask(block, pattern);
+        match = block;
+    }
+    match += __builtin_ctz(mask);
+    return *match == ch ? match : nullptr;
+}
+
+[[gnu::target("sse2")]] static const void* sse2_memchr(const void* ptr, u8 byte, size_t size)
+{
+    if (!size)
+        return nullptr;
+    auto* start = (const u8*)ptr;
+    size_t offset = (FlatPtr)start & 15;
+    auto* block = start - offset;
+    v16qi pattern = sse2_broadcast(byte);
+    u32 mask = sse2_match_mask(block, pattern) >> offset;
+    if (mask) {
+        size_t index = __builtin_ctz(mask);
+        return index < size ? start + index : nullptr;
+    }
+    for (size_t scanned = 16 - offset; scanned < size; scanned += 16) {
+        block += 16;
+        mask = sse2_match_mask(block, pattern);
+        if (mask) {
+            size_t index = scanned + __builtin_ctz(mask);
+            return index < size ? start + index : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+[[gnu::target("sse2")]] static int sse2_memcmp(const void* v1, const void* v2, size_t n)
+{
+    auto* s1 = (const u8*)v1;
+    auto* s2 = (const u8*)v2;
+    for (; n >= 16; s1 += 16, s2 += 16, n -= 16) {
+        auto a = __builtin_ia32_loaddqu((const char*)s1);
+        auto b = __builtin_ia32_loaddqu((const char*)s2);
+        u32 mask = __builtin_ia32_pmovmskb128(__builtin_ia32_pcmpeqb128(a, b));
+        if (mask != 0xffff) {
+            size_t index = __builtin_ctz(~mask);
+            return s1[index] < s2[index] ? -1 : 1;
+        }
+    }
+    return AK::WordAtATime::memcmp(s1, s2, n);
+}
+
+// Both of these expect n >= 16. The first and last 16 bytes are handled with
+// unaligned accesses, everything in between with aligned stores.
+
+[[gnu::target("sse2")]] static void sse2_memcpy(void* dest_ptr, const void* src_ptr, size_t n)
+{
+    auto* dest = (u8*)dest_ptr;
+    auto* src = (const u8*)src_ptr;
+    auto head = __builtin_ia32_loaddqu((const char*)src);
+    auto tail = __builtin_ia32_loaddqu((const char*)src + n - 16);
+    size_t offset = 16 - ((FlatPtr)dest & 15);
+    for (size_t i = offset; i + 16 <= n; i += 16)
+        *(v16qi*)(dest + i) = __builtin_ia32_loaddqu((const char*)src + i);
+    __builtin_ia32_storedqu((char*)dest, head);
+    __builtin_ia32_storedqu((char*)dest + n - 16, tail);
+}
+
+[[gnu::target("sse2")]] static void sse2_memset(void* dest_ptr, u8 byte, size_t n)
+{
+    auto* dest = (u8*)dest_ptr;
+    v16qi pattern = sse2_broadcast(byte);
+    __builtin_ia32_storedqu((char*)dest, pattern);
+    size_t offset = 16 - ((FlatPtr)dest & 15);
+    for (size_t i = offset; i + 16 <= n; i += 16)
+        *(v16qi*)(dest + i) = pattern;
+    __builtin_ia32_storedqu((char*)dest + n - 16, pattern);
+}
+#endif
+
 extern "C" {
 
 void bzero(void* dest, size_t n)
@@ -75,18 +213,17 @@ size_t strcspn(const char* s, const char* reject)
 
 size_t strlen(const char* str)
 {
-    size_t len = 0;
-    while (*(str++))
-        ++len;
-    return len;
+#if ARCH(I386)
+    if (cpu_supports_sse2())
+        return sse2_strlen(str);
+#endif
+    return AK::WordAtATime::strlen(str);
 }
 
 size_t strnlen(const char* str, size_t maxlen)
 {
-    size_t len = 0;
-    for (; len < maxlen && *str; str++)
-        len++;
-    return len;
+    auto* end = (const char*)memchr(str, 0, maxlen);
+    return end ? end - str : maxlen;
 }
 
 char* strdup(const char* str)
@@ -129,13 +266,11 @@ int strncmp(const char* s1, const char* s2, size_t n)
 
 int memcmp(const void* v1, const void* v2, size_t n)
 {
-    auto* s1 = (const uint8_t*)v1;
-    auto* s2 = (const uint8_t*)v2;
-    while (n-- > 0) {
-        if (*s1++ != *s2++)
-            return s1[-1] < s2[-1] ? -1 : 1;
-    }
-    return 0;
+#if ARCH(I386)
+    if (n >= 16 && cpu_supports_sse2())
+        return sse2_memcmp(v1, v2, n);
+#endif
+    return AK::WordAtATime::memcmp(v1, v2, n);
 }
 
 #if ARCH(I386)
@@ -189,18 +324,26 @@ void* mmx_memcpy(void* dest, const void* src, size_t len)
 
 void* memcpy(void* dest_ptr, const void* src_ptr, size_t n)
 {
+    if (n >= 64 && cpu_supports_sse2()) {
+        sse2_memcpy(dest_ptr, src_ptr, n);
+        return dest_ptr;
+    }
     if (n >= 1024)
         return mmx_memcpy(dest_ptr, src_ptr, n);
 
     u32 dest = (u32)dest_ptr;
     u32 src = (u32)src_ptr;
-    // FIXME: Support starting at an unaligned address.
-    if (!(dest & 0x3) && !(src & 0x3) && n >= 12) {
+    if (n >= 12) {
+        // Align the destination first, unaligned loads are cheap but unaligned stores are not.
+        u32 prologue = -dest & 0x3;
+        n -= prologue;
         size_t u32s = n / sizeof(u32);
         asm volatile(
+            "rep movsb\n"
+            "mov %%edx, %%ecx\n"
             "rep movsl\n"
-            : "=S"(src), "=D"(dest)
-            : "S"(src), "D"(dest), "c"(u32s)
+            : "=S"(src), "=D"(dest), "=c"(prologue), "=d"(u32s)
+            : "0"(src), "1"(dest), "2"(prologue), "3"(u32s)
             : "memory");
         n -= u32s * sizeof(u32);
         if (n == 0)
@@ -214,17 +357,25 @@ void* memcpy(void* dest_ptr, const void* src_ptr, size_t n)
 
 void* memset(void* dest_ptr, int c, size_t n)
 {
+    if (n >= 32 && cpu_supports_sse2()) {
+        sse2_memset(dest_ptr, c, n);
+        return dest_ptr;
+    }
+
     u32 dest = (u32)dest_ptr;
-    // FIXME: Support starting at an unaligned address.
-    if (!(dest & 0x3) && n >= 12) {
+    if (n >= 12) {
+        u32 prologue = -dest & 0x3;
+        n -= prologue;
         size_t u32s = n / sizeof(u32);
         u32 expanded_c = (u8)c;
         expanded_c |= expanded_c << 8;
         expanded_c |= expanded_c << 16;
         asm volatile(
+            "rep stosb\n"
+            "mov %%edx, %%ecx\n"
             "rep stosl\n"
-            : "=D"(dest)
-            : "D"(dest), "c"(u32s), "a"(expanded_c)
+            : "=D"(dest), "=c"(prologue), "=d"(u32s)
+            : "0"(dest), "1"(prologue), "2"(u32s), "a"(expanded_c)
             : "memory");
         n -= u32s * sizeof(u32);
         if (n == 0)
@@ -288,13 +439,11 @@ char* strncpy(char* dest, const char* src, size_t n)
 
 char* strchr(const char* str, int c)
 {
-    char ch = c;
-    for (;; ++str) {
-        if (*str == ch)
-            return const_cast<char*>(str);
-        if (!*str)
-            return nullptr;
-    }
+#if ARCH(I386)
+    if (cpu_supports_sse2())
+        return const_cast<char*>(sse2_strchr(str, c));
+#endif
+    return const_cast<char*>(AK::WordAtATime::strchr(str, c));
 }
 
 char* strchrnul(const char* str, int c)
@@ -308,13 +457,11 @@ char* strchrnul(const char* str, int c)
 
 void* memchr(const void* ptr, int c, size_t size)
 {
-    char ch = c;
-    auto* cptr = (const char*)ptr;
-    for (size_t i = 0; i < size; ++i) {
-        if (cptr[i] == ch)
-            return const_cast<char*>(cptr + i);
-    }
-    return nullptr;
+#if ARCH(I386)
+    if (size >= 16 && cpu_supports_sse2())
+        return const_cast<void*>(sse2_memchr(ptr, c, size));
+#endif
+    return const_cast<void*>(AK::WordAtATime::memchr(ptr, c, size));
 }
 
 char* strrchr(const char* str, int ch)
@@ -573,9 +573,8 @@ void sysbeep()
 
 int fsync(int fd)
 {
-    UNUSED_PARAM(fd);
-    dbgprintf("FIXME: Implement fsync()\n");
-    return 0;
+    int rc = syscall(SC_fsync, fd);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
 }
 
 int halt()
@@ -613,6 +612,12 @@ int umount(const char* mountpoint)
     __RETURN_WITH_ERRNO(rc, rc, -1);
 }
 
+int swapon(const char* path)
+{
+    int rc = syscall(SC_swapon, path, strlen(path));
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
 void dump_backtrace()
 {
     syscall(SC_dump_backtrace);
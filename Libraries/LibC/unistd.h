@@ -131,6 +131,7 @@ int halt();
 int reboot();
 int mount(int source_fd, const char* target, const char* fs_type, int flags);
 int umount(const char* mountpoint);
+int swapon(const char* path);
 int pledge(const char* promises, const char* execpromises);
 int unveil(const char* path, const char* permissions);
 char* getpass(const char* prompt);
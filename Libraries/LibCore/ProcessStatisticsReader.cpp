@@ -24,9 +24,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <AK/JsonArray.h>
-#include <AK/JsonObject.h>
-#include <AK/JsonValue.h>
+#include <AK/JsonPullParser.h>
 #include <LibCore/File.h>
 #include <LibCore/ProcessStatisticsReader.h>
 #include <pwd.h>
@@ -36,6 +34,54 @@ namespace Core {
 
 HashMap<uid_t, String> ProcessStatisticsReader::s_usernames;
 
+static void read_threads(JsonPullParser& parser, Core::ProcessStatistics& process)
+{
+    while (parser.next() == JsonPullParser::Token::BeginObject) {
+        Core::ThreadStatistics thread {};
+        while (parser.next() == JsonPullParser::Token::Key) {
+            auto key = parser.string();
+            parser.next();
+            if (key == "tid")
+                thread.tid = parser.to_u32();
+            else if (key == "times_scheduled")
+                thread.times_scheduled = parser.to_u32();
+            else if (key == "name")
+                thread.name = parser.to_string();
+            else if (key == "state")
+                thread.state = parser.to_string();
+            else if (key == "ticks")
+                thread.ticks = parser.to_u32();
+            else if (key == "priority")
+                thread.priority = parser.to_u32();
+            else if (key == "effective_priority")
+                thread.effective_priority = parser.to_u32();
+            else if (key == "syscall_count")
+                thread.syscall_count = parser.to_u32();
+            else if (key == "inode_faults")
+                thread.inode_faults = parser.to_u32();
+            else if (key == "zero_faults")
+                thread.zero_faults = parser.to_u32();
+            else if (key == "cow_faults")
+                thread.cow_faults = parser.to_u32();
+            else if (key == "unix_socket_read_bytes")
+                thread.unix_socket_read_bytes = parser.to_u32();
+            else if (key == "unix_socket_write_bytes")
+                thread.unix_socket_write_bytes = parser.to_u32();
+            else if (key == "ipv4_socket_read_bytes")
+                thread.ipv4_socket_read_bytes = parser.to_u32();
+            else if (key == "ipv4_socket_write_bytes")
+                thread.ipv4_socket_write_bytes = parser.to_u32();
+            else if (key == "file_read_bytes")
+                thread.file_read_bytes = parser.to_u32();
+            else if (key == "file_write_bytes")
+                thread.file_write_bytes = parser.to_u32();
+            else
+                parser.skip_value();
+        }
+        process.threads.append(move(thread));
+    }
+}
+
 HashMap<pid_t, Core::ProcessStatistics> ProcessStatisticsReader::get_all()
 {
     auto file = Core::File::construct("/proc/all");
@@ -47,62 +93,72 @@ HashMap<pid_t, Core::ProcessStatistics> ProcessStatisticsReader::get_all()
     HashMap<pid_t, Core::ProcessStatistics> map;
 
     auto file_contents = file->read_all();
-    auto json = JsonValue::from_string(file_contents);
-    json.as_array().for_each([&](auto& value) {
-        const JsonObject& process_object = value.as_object();
-        Core::ProcessStatistics process;
+    JsonPullParser parser(file_contents);
+    if (parser.next() != JsonPullParser::Token::BeginArray)
+        return {};
+
+    while (parser.next() == JsonPullParser::Token::BeginObject) {
+        Core::ProcessStatistics process {};
 
         // kernel data first
-        process.pid = process_object.get("pid").to_u32();
-        process.pgid = process_object.get("pgid").to_u32();
-        process.pgp = process_object.get("pgp").to_u32();
-        process.sid = process_object.get("sid").to_u32();
-        process.uid = process_object.get("uid").to_u32();
-        process.gid = process_object.get("gid").to_u32();
-        process.ppid = process_object.get("ppid").to_u32();
-        process.nfds = process_object.get("nfds").to_u32();
-        process.name = process_object.get("name").to_string();
-        process.tty = process_object.get("tty").to_string();
-        process.pledge = process_object.get("pledge").to_string();
-        process.veil = process_object.get("veil").to_string();
-        process.amount_virtual = process_object.get("amount_virtual").to_u32();
-        process.amount_resident = process_object.get("amount_resident").to_u32();
-        process.amount_shared = process_object.get("amount_shared").to_u32();
-        process.amount_dirty_private = process_object.get("amount_dirty_private").to_u32();
-        process.amount_clean_inode = process_object.get("amount_clean_inode").to_u32();
-        process.amount_purgeable_volatile = process_object.get("amount_purgeable_volatile").to_u32();
-        process.amount_purgeable_nonvolatile = process_object.get("amount_purgeable_nonvolatile").to_u32();
-        process.icon_id = process_object.get("icon_id").to_int();
+        while (parser.next() == JsonPullParser::Token::Key) {
+            auto key = parser.string();
+            parser.next();
+            if (key == "pid")
+                process.pid = parser.to_u32();
+            else if (key == "pgid")
+                process.pgid = parser.to_u32();
+            else if (key == "pgp")
+                process.pgp = parser.to_u32();
+            else if (key == "sid")
+                process.sid = parser.to_u32();
+            else if (key == "uid")
+                process.uid = parser.to_u32();
+            else if (key == "gid")
+                process.gid = parser.to_u32();
+            else if (key == "ppid")
+                process.ppid = parser.to_u32();
+            else if (key == "nfds")
+                process.nfds = parser.to_u32();
+            else if (key == "name")
+                process.name = parser.to_string();
+            else if (key == "tty")
+                process.tty = parser.to_string();
+            else if (key == "pledge")
+                process.pledge = parser.to_string();
+            else if (key == "veil")
+                process.veil = parser.to_string();
+            else if (key == "amount_virtual")
+                process.amount_virtual = parser.to_u32();
+            else if (key == "amount_resident")
+                process.amount_resident = parser.to_u32();
+            else if (key == "amount_shared")
+                process.amount_shared = parser.to_u32();
+            else if (key == "amount_dirty_private")
+                process.amount_dirty_private = parser.to_u32();
+            else if (key == "amount_clean_inode")
+                process.amount_clean_inode = parser.to_u32();
+            else if (key == "amount_purgeable_volatile")
+                process.amount_purgeable_volatile = parser.to_u32();
+            else if (key == "amount_purgeable_nonvolatile")
+                process.amount_purgeable_nonvolatile = parser.to_u32();
+            else if (key == "icon_id")
+                process.icon_id = parser.to_i32();
+            else if (key == "threads" && parser.token() == JsonPullParser::Token::BeginArray)
+                read_threads(parser, process);
+            else
+                parser.skip_value();
+        }
 
-        auto& thread_array = process_object.get_ptr("threads")->as_array();
-        process.threads.ensure_capacity(thread_array.size());
-        thread_array.for_each([&](auto& value) {
-            auto& thread_object = value.as_object();
-            Core::ThreadStatistics thread;
-            thread.tid = thread_object.get("tid").to_u32();
-            thread.times_scheduled = thread_object.get("times_scheduled").to_u32();
-            thread.name = thread_object.get("name").to_string();
-            thread.state = thread_object.get("state").to_string();
-            thread.ticks = thread_object.get("ticks").to_u32();
-            thread.priority = thread_object.get("priority").to_u32();
-            thread.effective_priority = thread_object.get("effective_priority").to_u32();
-            thread.syscall_count = thread_object.get("syscall_count").to_u32();
-            thread.inode_faults = thread_object.get("inode_faults").to_u32();
-            thread.zero_faults = thread_object.get("zero_faults").to_u32();
-            thread.cow_faults = thread_object.get("cow_faults").to_u32();
-            thread.unix_socket_read_bytes = thread_object.get("unix_socket_read_bytes").to_u32();
-            thread.unix_socket_write_bytes = thread_object.get("unix_socket_write_bytes").to_u32();
-            thread.ipv4_socket_read_bytes = thread_object.get("ipv4_socket_read_bytes").to_u32();
-            thread.ipv4_socket_write_bytes = thread_object.get("ipv4_socket_write_bytes").to_u32();
-            thread.file_read_bytes = thread_object.get("file_read_bytes").to_u32();
-            thread.file_write_bytes = thread_object.get("file_write_bytes").to_u32();
-            process.threads.append(move(thread));
-        });
+        if (parser.has_error()) {
+            fprintf(stderr, "ProcessStatisticsReader: Failed to parse /proc/all\n");
+            return {};
+        }
 
         // and synthetic data last
         process.username = username_from_uid(process.uid);
         map.set(process.pid, process);
-    });
+    }
 
     return map;
 }
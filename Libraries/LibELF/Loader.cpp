@@ -91,32 +91,61 @@ bool Loader::layout()
 #endif
 #ifdef KERNEL
         if (program_header.is_writable()) {
-            auto* allocated_section = alloc_section_hook(
-                program_header.vaddr(),
-                program_header.size_in_memory(),
-                program_header.alignment(),
-                program_header.is_readable(),
-                program_header.is_writable(),
-                String::format("elf-alloc-%s%s", program_header.is_readable() ? "r" : "", program_header.is_writable() ? "w" : ""));
-            if (!allocated_section) {
-                failed = true;
-                return;
-            }
             if (!m_image.is_within_image(program_header.raw_data(), program_header.size_in_image())) {
                 dbg() << "Shenanigans! Writable ELF PT_LOAD header sneaks outside of executable.";
                 failed = true;
                 return;
             }
             // It's not always the case with PIE executables (and very well shouldn't be) that the
-            // virtual address in the program header matches the one we end up giving the process.
-            // In order to copy the data image correctly into memory, we need to copy the data starting at
-            // the right initial page offset into the pages allocated for the elf_alloc-XX section.
+            // virtual address in the program header matches the one we end up giving the process,
+            // but the offset within the first page always matches the offset within the file.
+            size_t page_offset = program_header.vaddr().get() & ~PAGE_MASK;
+            if ((program_header.offset() & ~PAGE_MASK) != page_offset) {
+                dbg() << "Shenanigans! Writable ELF PT_LOAD header is not page-aligned with the file.";
+                failed = true;
+                return;
+            }
+            // The file-backed part of the segment is mapped privately, so its pages are shared with
+            // every other process running this executable until they're written to.
             // FIXME: There's an opportunity to munmap, or at least mprotect, the padding space between
             //     the .text and .data PT_LOAD sections of the executable.
             //     Accessing it would definitely be a bug.
-            auto page_offset = program_header.vaddr();
-            page_offset.mask(~PAGE_MASK);
-            do_memcpy((u8*)allocated_section + page_offset.get(), program_header.raw_data(), program_header.size_in_image());
+            size_t mapped_size = 0;
+            if (program_header.size_in_image()) {
+                auto* mapped_section = map_section_hook(
+                    program_header.vaddr(),
+                    page_offset + program_header.size_in_image(),
+                    program_header.alignment(),
+                    program_header.offset() - page_offset,
+                    program_header.is_readable(),
+                    program_header.is_writable(),
+                    program_header.is_executable(),
+                    String::format("elf-map-%s%s%s", program_header.is_readable() ? "r" : "", program_header.is_writable() ? "w" : "", program_header.is_executable() ? "x" : ""));
+                if (!mapped_section) {
+                    failed = true;
+                    return;
+                }
+                mapped_size = PAGE_ROUND_UP(page_offset + program_header.size_in_image());
+                // Whatever follows the segment in the file's last page is the start of .bss, clear it.
+                size_t end_of_image = page_offset + program_header.size_in_image();
+                if (end_of_image != mapped_size && program_header.size_in_memory() > program_header.size_in_image())
+                    memset_user((u8*)mapped_section + end_of_image, 0, mapped_size - end_of_image);
+            }
+            size_t total_size = PAGE_ROUND_UP(page_offset + program_header.size_in_memory());
+            if (total_size > mapped_size) {
+                // The rest of .bss is plain zero-filled memory, faulted in on first use.
+                auto* allocated_section = alloc_section_hook(
+                    program_header.vaddr().offset(mapped_size - page_offset),
+                    total_size - mapped_size,
+                    program_header.alignment(),
+                    program_header.is_readable(),
+                    program_header.is_writable(),
+                    String::format("elf-alloc-%s%s", program_header.is_readable() ? "r" : "", program_header.is_writable() ? "w" : ""));
+                if (!allocated_section) {
+                    failed = true;
+                    return;
+                }
+            }
         } else {
             auto* mapped_section = map_section_hook(
                 program_header.vaddr(),
@@ -25,6 +25,7 @@
  */
 
 #include <LibCore/EventLoop.h>
+#include <LibCore/MemoryPressureNotifier.h>
 #include <LibGUI/Action.h>
 #include <LibGUI/Application.h>
 #include <LibGUI/Clipboard.h>
@@ -34,6 +35,7 @@
 #include <LibGUI/Painter.h>
 #include <LibGUI/Window.h>
 #include <LibGUI/WindowServerConnection.h>
+#include <LibGfx/Emoji.h>
 #include <LibGfx/Font.h>
 #include <LibGfx/Palette.h>
 
@@ -54,6 +56,11 @@ Application::Application(int argc, char** argv)
     ASSERT(!s_the);
     s_the = this;
     m_event_loop = make<Core::EventLoop>();
+    m_memory_pressure_notifier = Core::MemoryPressureNotifier::construct();
+    m_memory_pressure_notifier->on_change = [](auto level) {
+        if (level != Core::MemoryPressureNotifier::Level::None)
+            Gfx::Emoji::purge_unused_emojis();
+    };
     WindowServerConnection::the();
     Clipboard::initialize({});
     if (argc > 0)
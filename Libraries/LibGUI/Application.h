@@ -72,6 +72,7 @@ public:
 
 private:
     OwnPtr<Core::EventLoop> m_event_loop;
+    RefPtr<Core::MemoryPressureNotifier> m_memory_pressure_notifier;
     RefPtr<MenuBar> m_menubar;
     RefPtr<Gfx::PaletteImpl> m_palette;
     RefPtr<Gfx::PaletteImpl> m_system_palette;
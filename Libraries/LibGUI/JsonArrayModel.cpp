@@ -25,6 +25,7 @@
  */
 
 #include <AK/JsonObject.h>
+#include <AK/JsonPullParser.h>
 #include <LibCore/File.h>
 #include <LibGUI/JsonArrayModel.h>
 
@@ -40,10 +41,22 @@ void JsonArrayModel::update()
         return;
     }
 
-    auto json = JsonValue::from_string(file->read_all());
-
-    ASSERT(json.is_array());
-    m_array = json.as_array();
+    // Build the array directly instead of parsing into a JsonValue and copying it out.
+    auto file_contents = file->read_all();
+    JsonPullParser parser(file_contents);
+    m_array.clear();
+    if (parser.next() == JsonPullParser::Token::BeginArray) {
+        while (parser.next() == JsonPullParser::Token::BeginObject) {
+            auto value = parser.value();
+            if (parser.has_error())
+                break;
+            m_array.append(move(value));
+        }
+    }
+    if (parser.token() != JsonPullParser::Token::EndArray) {
+        dbg() << "Unable to parse " << file->filename() << " as an array of objects";
+        m_array.clear();
+    }
 
     did_update();
 }
@@ -26,6 +26,7 @@
 
 #include <AK/HashMap.h>
 #include <AK/String.h>
+#include <AK/Vector.h>
 #include <LibGfx/Emoji.h>
 #include <LibGfx/Bitmap.h>
 
@@ -51,4 +52,16 @@ const Bitmap* Emoji::emoji_for_codepoint(u32 codepoint)
     return bitmap.ptr();
 }
 
+void Emoji::purge_unused_emojis()
+{
+    // Codepoints without an emoji stay cached, remembering that costs next to nothing.
+    Vector<u32> unused_codepoints;
+    for (auto& it : s_emojis) {
+        if (it.value && it.value->ref_count() == 1)
+            unused_codepoints.append(it.key);
+    }
+    for (auto codepoint : unused_codepoints)
+        s_emojis.remove(codepoint);
+}
+
 }
@@ -35,6 +35,9 @@ class Bitmap;
 class Emoji {
 public:
     static const Gfx::Bitmap* emoji_for_codepoint(u32 codepoint);
+
+    // Drops the decoded emoji that nobody else holds on to. They are loaded again on next use.
+    static void purge_unused_emojis();
 };
 
 }
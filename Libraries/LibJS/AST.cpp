@@ -31,6 +31,8 @@
 #include <AK/StringBuilder.h>
 #include <LibCrypto/BigInt/SignedBigInteger.h>
 #include <LibJS/AST.h>
+#include <LibJS/Bytecode/Block.h>
+#include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -49,7 +51,7 @@
 
 namespace JS {
 
-static void update_function_name(Value& value, const FlyString& name)
+void update_function_name(Value& value, const FlyString& name)
 {
     if (!value.is_object())
         return;
@@ -65,11 +67,48 @@ static void update_function_name(Value& value, const FlyString& name)
     }
 }
 
+ScopeNode::ScopeNode()
+{
+}
+
+ScopeNode::~ScopeNode()
+{
+}
+
 Value ScopeNode::execute(Interpreter& interpreter) const
 {
     return interpreter.run(*this);
 }
 
+const Bytecode::Block& ScopeNode::bytecode() const
+{
+    if (!m_bytecode)
+        m_bytecode = Bytecode::Generator::generate(*this);
+    return *m_bytecode;
+}
+
+const EnvironmentLayout& ScopeNode::environment_layout() const
+{
+    if (!m_environment_layout)
+        m_environment_layout = create_environment_layout();
+    return *m_environment_layout;
+}
+
+void ScopeNode::set_environment_layout(NonnullRefPtr<EnvironmentLayout> layout)
+{
+    m_environment_layout = move(layout);
+}
+
+NonnullRefPtr<EnvironmentLayout> ScopeNode::create_environment_layout() const
+{
+    auto layout = EnvironmentLayout::create();
+    for (auto& declaration : m_variables) {
+        for (auto& declarator : declaration.declarations())
+            layout->add(declarator.id().string(), declaration.declaration_kind());
+    }
+    return layout;
+}
+
 Value FunctionDeclaration::execute(Interpreter&) const
 {
     return js_undefined();
@@ -100,7 +139,9 @@ CallExpression::ThisAndCallee CallExpression::compute_this_and_callee(Interprete
         auto* this_value = object_value.to_object(interpreter);
         if (interpreter.exception())
             return {};
-        auto callee = this_value->get(member_expression.computed_property_name(interpreter)).value_or(js_undefined());
+        auto callee = member_expression.get_property(interpreter, *this_value);
+        if (interpreter.exception())
+            return {};
         return { this_value, callee };
     }
     return { &interpreter.global_object(), m_callee->execute(interpreter) };
@@ -976,7 +1017,7 @@ void ForOfStatement::dump(int indent) const
 
 Value Identifier::execute(Interpreter& interpreter) const
 {
-    auto value = interpreter.get_variable(string());
+    auto value = interpreter.get_variable(*this);
     if (value.is_empty())
         return interpreter.throw_exception<ReferenceError>(String::format("'%s' not known", string().characters()));
     return value;
@@ -985,7 +1026,10 @@ Value Identifier::execute(Interpreter& interpreter) const
 void Identifier::dump(int indent) const
 {
     print_indent(indent);
-    printf("Identifier \"%s\"\n", m_string.characters());
+    if (m_has_binding)
+        printf("Identifier \"%s\" (slot %u, %u up)\n", m_string.characters(), m_slot, m_environment_hops);
+    else
+        printf("Identifier \"%s\"\n", m_string.characters());
 }
 
 void SpreadExpression::dump(int indent) const
@@ -1095,6 +1139,31 @@ Value AssignmentExpression::execute(Interpreter& interpreter) const
     if (interpreter.exception())
         return {};
 
+    if (m_lhs->is_identifier() && static_cast<const Identifier&>(*m_lhs).has_binding()) {
+        auto& identifier = static_cast<const Identifier&>(*m_lhs);
+        update_function_name(rhs_result, identifier.string());
+        interpreter.set_variable(identifier, rhs_result);
+        if (interpreter.exception())
+            return {};
+        return rhs_result;
+    }
+
+    if (m_lhs->is_member_expression() && !static_cast<const MemberExpression&>(*m_lhs).is_computed()) {
+        auto& member_expression = static_cast<const MemberExpression&>(*m_lhs);
+        auto object_value = member_expression.object().execute(interpreter);
+        if (interpreter.exception())
+            return {};
+        auto& property_name = static_cast<const Identifier&>(member_expression.property()).string();
+        update_function_name(rhs_result, property_name);
+        if (object_value.is_object())
+            object_value.as_object().put_with_inline_cache(property_name, rhs_result, m_property_lookup_cache);
+        else
+            Reference(object_value, property_name).put(interpreter, rhs_result);
+        if (interpreter.exception())
+            return {};
+        return rhs_result;
+    }
+
     auto reference = m_lhs->to_reference(interpreter);
     if (interpreter.exception())
         return {};
@@ -1112,10 +1181,17 @@ Value AssignmentExpression::execute(Interpreter& interpreter) const
 
 Value UpdateExpression::execute(Interpreter& interpreter) const
 {
-    auto reference = m_argument->to_reference(interpreter);
-    if (interpreter.exception())
-        return {};
-    auto old_value = reference.get(interpreter);
+    const Identifier* identifier = nullptr;
+    if (m_argument->is_identifier() && static_cast<const Identifier&>(*m_argument).has_binding())
+        identifier = static_cast<const Identifier*>(m_argument.ptr());
+
+    Reference reference;
+    if (!identifier) {
+        reference = m_argument->to_reference(interpreter);
+        if (interpreter.exception())
+            return {};
+    }
+    auto old_value = identifier ? interpreter.get_variable(*identifier) : reference.get(interpreter);
     if (interpreter.exception())
         return {};
     old_value = old_value.to_numeric(interpreter);
@@ -1140,7 +1216,10 @@ Value UpdateExpression::execute(Interpreter& interpreter) const
         ASSERT_NOT_REACHED();
     }
 
-    reference.put(interpreter, new_value);
+    if (identifier)
+        interpreter.set_variable(*identifier, new_value);
+    else
+        reference.put(interpreter, new_value);
     if (interpreter.exception())
         return {};
     return m_prefixed ? new_value : old_value;
@@ -1228,9 +1307,8 @@ Value VariableDeclaration::execute(Interpreter& interpreter) const
             auto initalizer_result = init->execute(interpreter);
             if (interpreter.exception())
                 return {};
-            auto variable_name = declarator.id().string();
-            update_function_name(initalizer_result, variable_name);
-            interpreter.set_variable(variable_name, initalizer_result, true);
+            update_function_name(initalizer_result, declarator.id().string());
+            interpreter.set_variable(declarator.id(), initalizer_result, true);
         }
     }
     return js_undefined();
@@ -1397,6 +1475,9 @@ PropertyName MemberExpression::computed_property_name(Interpreter& interpreter)
     if (index.is_integer() && index.as_i32() >= 0)
         return index.as_i32();
 
+    if (index.is_string())
+        return index.as_string().fly_string();
+
     auto index_string = index.to_string(interpreter);
     if (interpreter.exception())
         return {};
@@ -1422,7 +1503,19 @@ Value MemberExpression::execute(Interpreter& interpreter) const
     auto* object_result = object_value.to_object(interpreter);
     if (interpreter.exception())
         return {};
-    return object_result->get(computed_property_name(interpreter)).value_or(js_undefined());
+    return get_property(interpreter, *object_result);
+}
+
+Value MemberExpression::get_property(Interpreter& interpreter, const Object& object) const
+{
+    if (!is_computed()) {
+        auto& property_name = static_cast<const Identifier&>(*m_property).string();
+        return object.get_with_inline_cache(property_name, m_property_lookup_cache).value_or(js_undefined());
+    }
+    auto property_name = computed_property_name(interpreter);
+    if (interpreter.exception())
+        return {};
+    return object.get(property_name).value_or(js_undefined());
 }
 
 Value StringLiteral::execute(Interpreter& interpreter) const
@@ -1458,7 +1551,10 @@ void RegExpLiteral::dump(int indent) const
 
 Value RegExpLiteral::execute(Interpreter& interpreter) const
 {
-    return RegExpObject::create(interpreter.global_object(), content(), flags());
+    auto* regexp_object = RegExpObject::create(interpreter.global_object(), content(), flags());
+    if (!regexp_object)
+        return {};
+    return regexp_object;
 }
 
 void ArrayExpression::dump(int indent) const
@@ -1628,19 +1724,35 @@ void ThrowStatement::dump(int indent) const
 
 Value TryStatement::execute(Interpreter& interpreter) const
 {
-    interpreter.run(block(), {}, ScopeType::Try);
+    auto result = interpreter.run(block(), {}, ScopeType::Try);
     if (auto* exception = interpreter.exception()) {
         if (m_handler) {
             interpreter.clear_exception();
             ArgumentVector arguments { { m_handler->parameter(), exception->value() } };
-            interpreter.run(m_handler->body(), move(arguments));
+            result = interpreter.run(m_handler->body(), move(arguments));
         }
     }
 
-    if (m_finalizer)
-        m_finalizer->execute(interpreter);
+    if (m_finalizer) {
+        // A break, continue or return that left the try block must not cut the finalizer short.
+        // Suspend it while the finalizer runs and resume it afterwards, unless the finalizer unwinds itself.
+        // Likewise, an exception that wasn't caught must not be visible to the finalizer, or everything in it
+        // would fail. It's rethrown afterwards unless the finalizer throws or unwinds on its own.
+        auto pending_unwind = interpreter.unwind_until();
+        auto pending_unwind_label = interpreter.unwind_until_label();
+        auto* pending_exception = interpreter.exception();
+        interpreter.stop_unwind();
+        interpreter.clear_exception();
+        auto finalizer_result = m_finalizer->execute(interpreter);
+        if (interpreter.should_unwind() || interpreter.exception())
+            return finalizer_result;
+        if (pending_exception)
+            interpreter.throw_exception(pending_exception);
+        else if (pending_unwind != ScopeType::None)
+            interpreter.unwind(pending_unwind, pending_unwind_label);
+    }
 
-    return js_undefined();
+    return result;
 }
 
 Value CatchClause::execute(Interpreter&) const
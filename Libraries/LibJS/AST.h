@@ -27,13 +27,18 @@
 
 #pragma once
 
+#include <AK/Arena.h>
 #include <AK/FlyString.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullRefPtrVector.h>
+#include <AK/Optional.h>
+#include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
+#include <LibJS/Bytecode/Register.h>
 #include <LibJS/Forward.h>
+#include <LibJS/Runtime/PropertyLookupCache.h>
 #include <LibJS/Runtime/PropertyName.h>
 #include <LibJS/Runtime/Value.h>
 
@@ -49,11 +54,20 @@ create_ast_node(Args&&... args)
     return adopt(*new T(forward<Args>(args)...));
 }
 
+void update_function_name(Value&, const FlyString&);
+
 class ASTNode : public RefCounted<ASTNode> {
 public:
+    // The parser allocates nodes out of its arena. Each node keeps its chunk of the arena
+    // alive while referenced, so nodes can outlive the Parser (e.g. function bodies.)
+    void* operator new(size_t size, Arena& arena) { return arena.allocate_retained(size); }
+    void* operator new(size_t size) { return Arena::allocate_retained_without_arena(size); }
+    void operator delete(void* ptr) { Arena::release_retained(ptr); }
+
     virtual ~ASTNode() { }
     virtual const char* class_name() const = 0;
     virtual Value execute(Interpreter&) const = 0;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const;
     virtual void dump(int indent) const;
     virtual bool is_identifier() const { return false; }
     virtual bool is_spread_expression() const { return false; }
@@ -75,6 +89,8 @@ public:
     const FlyString& label() const { return m_label; }
     void set_label(FlyString string) { m_label = string; }
 
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
+
 protected:
     FlyString m_label;
 };
@@ -99,6 +115,7 @@ public:
     }
 
     Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     const char* class_name() const override { return "ExpressionStatement"; }
     virtual void dump(int indent) const override;
 
@@ -120,6 +137,8 @@ public:
         m_children.append(move(child));
     }
 
+    virtual ~ScopeNode() override;
+
     const NonnullRefPtrVector<Statement>& children() const { return m_children; }
     virtual Value execute(Interpreter&) const override;
     virtual void dump(int indent) const override;
@@ -131,8 +150,17 @@ public:
     bool in_strict_mode() const { return m_strict_mode; }
     void set_strict_mode() { m_strict_mode = true; }
 
+    // Compiled lazily, the first time the scope is run by the bytecode interpreter.
+    const Bytecode::Block& bytecode() const;
+
+    // The environment created when entering this scope. Blocks derive it from their declarations;
+    // the parser sets it for function bodies (parameters + variables) and catch bodies (+ parameter).
+    const EnvironmentLayout& environment_layout() const;
+    void set_environment_layout(NonnullRefPtr<EnvironmentLayout>);
+    NonnullRefPtr<EnvironmentLayout> create_environment_layout() const;
+
 protected:
-    ScopeNode() { }
+    ScopeNode();
 
 private:
     virtual bool is_scope_node() const final { return true; }
@@ -140,6 +168,8 @@ private:
     NonnullRefPtrVector<VariableDeclaration> m_variables;
     NonnullRefPtrVector<FunctionDeclaration> m_functions;
     bool m_strict_mode { false };
+    mutable OwnPtr<Bytecode::Block> m_bytecode;
+    mutable RefPtr<EnvironmentLayout> m_environment_layout;
 };
 
 class Program : public ScopeNode {
@@ -154,6 +184,7 @@ private:
 class BlockStatement : public ScopeNode {
 public:
     BlockStatement() { }
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
 
 private:
     virtual const char* class_name() const override { return "BlockStatement"; }
@@ -214,6 +245,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -257,6 +289,7 @@ public:
     const Expression* argument() const { return m_argument; }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -279,6 +312,7 @@ public:
     const Statement* alternate() const { return m_alternate; }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -301,6 +335,7 @@ public:
     const Statement& body() const { return *m_body; }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -322,6 +357,7 @@ public:
     const Statement& body() const { return *m_body; }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -347,6 +383,7 @@ public:
     const Statement& body() const { return *m_body; }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -441,6 +478,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -467,6 +505,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -496,6 +535,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -514,6 +554,7 @@ public:
 
     virtual void dump(int indent) const override;
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
 
 private:
     virtual const char* class_name() const override { return "SequenceExpression"; }
@@ -534,6 +575,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -550,6 +592,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -582,6 +625,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -595,6 +639,7 @@ public:
     explicit NullLiteral() { }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -631,7 +676,21 @@ public:
 
     const FlyString& string() const { return m_string; }
 
+    // Set by the parser when the identifier is known to refer to a function or block scoped
+    // variable: the variable lives in the given slot of the environment `environment_hops`
+    // levels up from the current one. Other identifiers are looked up by name.
+    bool has_binding() const { return m_has_binding; }
+    size_t environment_hops() const { return m_environment_hops; }
+    size_t slot() const { return m_slot; }
+    void set_binding(size_t environment_hops, size_t slot)
+    {
+        m_has_binding = true;
+        m_environment_hops = environment_hops;
+        m_slot = slot;
+    }
+
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
     virtual bool is_identifier() const override { return true; }
     virtual Reference to_reference(Interpreter&) const override;
@@ -640,6 +699,9 @@ private:
     virtual const char* class_name() const override { return "Identifier"; }
 
     FlyString m_string;
+    bool m_has_binding { false };
+    u32 m_environment_hops { 0 };
+    u32 m_slot { 0 };
 };
 
 class SpreadExpression final : public Expression {
@@ -662,6 +724,7 @@ private:
 class ThisExpression final : public Expression {
 public:
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -682,6 +745,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -737,6 +801,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -745,6 +810,7 @@ private:
     AssignmentOp m_op;
     NonnullRefPtr<Expression> m_lhs;
     NonnullRefPtr<Expression> m_rhs;
+    mutable PropertyLookupCache m_property_lookup_cache;
 };
 
 enum class UpdateOp {
@@ -762,6 +828,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -816,6 +883,7 @@ public:
     DeclarationKind declaration_kind() const { return m_declaration_kind; }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
     const NonnullRefPtrVector<VariableDeclarator>& declarations() const { return m_declarations; }
@@ -951,6 +1019,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
     virtual Reference to_reference(Interpreter&) const override;
 
@@ -960,6 +1029,9 @@ public:
 
     PropertyName computed_property_name(Interpreter&) const;
 
+    // Looks up this expression's property on an already evaluated base object.
+    Value get_property(Interpreter&, const Object&) const;
+
     String to_string_approximation() const;
 
 private:
@@ -969,6 +1041,7 @@ private:
     NonnullRefPtr<Expression> m_object;
     NonnullRefPtr<Expression> m_property;
     bool m_computed { false };
+    mutable PropertyLookupCache m_property_lookup_cache;
 };
 
 class ConditionalExpression final : public Expression {
@@ -982,6 +1055,7 @@ public:
 
     virtual void dump(int indent) const override;
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
 
 private:
     virtual const char* class_name() const override { return "ConditionalExpression"; }
@@ -1101,6 +1175,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
 
     const FlyString& target_label() const { return m_target_label; }
 
@@ -1118,6 +1193,7 @@ public:
     }
 
     virtual Value execute(Interpreter&) const override;
+    virtual Optional<Bytecode::Register> generate_bytecode(Bytecode::Generator&) const override;
 
     const FlyString& target_label() const { return m_target_label; }
 
@@ -0,0 +1,547 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Register.h>
+
+namespace JS {
+
+Optional<Bytecode::Register> ASTNode::generate_bytecode(Bytecode::Generator& generator) const
+{
+    return generator.emit_evaluate_expression(*this);
+}
+
+Optional<Bytecode::Register> Statement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    return generator.emit_evaluate_statement(*this);
+}
+
+Optional<Bytecode::Register> ExpressionStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    return generator.generate_expression(*m_expression);
+}
+
+Optional<Bytecode::Register> BlockStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    // Breaks targeting a labelled block are left to the AST walker.
+    if (!label().is_null())
+        return Statement::generate_bytecode(generator);
+
+    generator.begin_scope(*this);
+    for (auto& child : children())
+        generator.generate_statement(child);
+    generator.end_scope(*this);
+    return {};
+}
+
+Optional<Bytecode::Register> FunctionDeclaration::generate_bytecode(Bytecode::Generator&) const
+{
+    // Function declarations are hoisted by Interpreter::enter_scope().
+    return {};
+}
+
+Optional<Bytecode::Register> VariableDeclaration::generate_bytecode(Bytecode::Generator& generator) const
+{
+    for (auto& declarator : m_declarations) {
+        if (auto* init = declarator.init()) {
+            auto value = generator.generate_expression(*init);
+            generator.emit<Bytecode::Op::SetVariable>(declarator.id(), value, true);
+        }
+    }
+    return {};
+}
+
+Optional<Bytecode::Register> ReturnStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    Optional<Bytecode::Register> argument;
+    if (m_argument)
+        argument = generator.generate_expression(*m_argument);
+    generator.emit<Bytecode::Op::Return>(argument);
+    return {};
+}
+
+Optional<Bytecode::Register> IfStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto predicate = generator.generate_expression(*m_predicate);
+    auto alternate_label = generator.make_label();
+    auto end_label = generator.make_label();
+
+    generator.emit_jump<Bytecode::Op::JumpIfFalse>(predicate, alternate_label);
+    generator.generate_statement(*m_consequent);
+    if (m_alternate)
+        generator.emit_jump<Bytecode::Op::Jump>(end_label);
+
+    generator.place_label(alternate_label);
+    if (m_alternate)
+        generator.generate_statement(*m_alternate);
+
+    generator.place_label(end_label);
+    return {};
+}
+
+Optional<Bytecode::Register> WhileStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto test_label = generator.make_label();
+    auto end_label = generator.make_label();
+
+    generator.place_label(test_label);
+    auto test = generator.generate_expression(*m_test);
+    generator.emit_jump<Bytecode::Op::JumpIfFalse>(test, end_label);
+
+    generator.begin_loop(label(), end_label, test_label);
+    generator.generate_statement(*m_body);
+    generator.end_loop();
+    generator.emit_jump<Bytecode::Op::Jump>(test_label);
+
+    generator.place_label(end_label);
+    return {};
+}
+
+Optional<Bytecode::Register> DoWhileStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto body_label = generator.make_label();
+    auto test_label = generator.make_label();
+    auto end_label = generator.make_label();
+
+    generator.place_label(body_label);
+    generator.begin_loop(label(), end_label, test_label);
+    generator.generate_statement(*m_body);
+    generator.end_loop();
+
+    generator.place_label(test_label);
+    auto test = generator.generate_expression(*m_test);
+    generator.emit_jump<Bytecode::Op::JumpIfTrue>(test, body_label);
+
+    generator.place_label(end_label);
+    return {};
+}
+
+Optional<Bytecode::Register> ForStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    // Same as ForStatement::execute(): let and const bindings in the initializer get a scope of their own.
+    RefPtr<BlockStatement> wrapper;
+    if (m_init && m_init->is_variable_declaration() && static_cast<const VariableDeclaration*>(m_init.ptr())->declaration_kind() != DeclarationKind::Var) {
+        wrapper = create_ast_node<BlockStatement>();
+        NonnullRefPtrVector<VariableDeclaration> decls;
+        decls.append(*static_cast<const VariableDeclaration*>(m_init.ptr()));
+        wrapper->add_variables(decls);
+        generator.retain(*wrapper);
+        generator.begin_scope(*wrapper);
+    }
+
+    if (m_init) {
+        if (m_init->is_variable_declaration())
+            generator.generate_statement(static_cast<const VariableDeclaration&>(*m_init));
+        else
+            generator.generate_expression(static_cast<const Expression&>(*m_init));
+    }
+
+    auto test_label = generator.make_label();
+    auto update_label = generator.make_label();
+    auto end_label = generator.make_label();
+
+    generator.place_label(test_label);
+    if (m_test) {
+        auto test = generator.generate_expression(*m_test);
+        generator.emit_jump<Bytecode::Op::JumpIfFalse>(test, end_label);
+    }
+
+    generator.begin_loop(label(), end_label, update_label);
+    generator.generate_statement(*m_body);
+    generator.end_loop();
+
+    generator.place_label(update_label);
+    if (m_update)
+        generator.generate_expression(*m_update);
+    generator.emit_jump<Bytecode::Op::Jump>(test_label);
+
+    generator.place_label(end_label);
+    if (wrapper)
+        generator.end_scope(*wrapper);
+    return {};
+}
+
+Optional<Bytecode::Register> BreakStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (generator.emit_break(m_target_label))
+        return {};
+    return Statement::generate_bytecode(generator);
+}
+
+Optional<Bytecode::Register> ContinueStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (generator.emit_continue(m_target_label))
+        return {};
+    return Statement::generate_bytecode(generator);
+}
+
+Optional<Bytecode::Register> BinaryExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto lhs = generator.generate_expression(*m_lhs);
+    auto rhs = generator.generate_expression(*m_rhs);
+    auto dst = lhs;
+
+    switch (m_op) {
+    case BinaryOp::Addition:
+        generator.emit<Bytecode::Op::Add>(dst, lhs, rhs);
+        break;
+    case BinaryOp::Subtraction:
+        generator.emit<Bytecode::Op::Sub>(dst, lhs, rhs);
+        break;
+    case BinaryOp::Multiplication:
+        generator.emit<Bytecode::Op::Mul>(dst, lhs, rhs);
+        break;
+    case BinaryOp::Division:
+        generator.emit<Bytecode::Op::Div>(dst, lhs, rhs);
+        break;
+    case BinaryOp::Modulo:
+        generator.emit<Bytecode::Op::Mod>(dst, lhs, rhs);
+        break;
+    case BinaryOp::Exponentiation:
+        generator.emit<Bytecode::Op::Exp>(dst, lhs, rhs);
+        break;
+    case BinaryOp::TypedEquals:
+        generator.emit<Bytecode::Op::TypedEquals>(dst, lhs, rhs);
+        break;
+    case BinaryOp::TypedInequals:
+        generator.emit<Bytecode::Op::TypedInequals>(dst, lhs, rhs);
+        break;
+    case BinaryOp::AbstractEquals:
+        generator.emit<Bytecode::Op::AbstractEquals>(dst, lhs, rhs);
+        break;
+    case BinaryOp::AbstractInequals:
+        generator.emit<Bytecode::Op::AbstractInequals>(dst, lhs, rhs);
+        break;
+    case BinaryOp::GreaterThan:
+        generator.emit<Bytecode::Op::GreaterThan>(dst, lhs, rhs);
+        break;
+    case BinaryOp::GreaterThanEquals:
+        generator.emit<Bytecode::Op::GreaterThanEquals>(dst, lhs, rhs);
+        break;
+    case BinaryOp::LessThan:
+        generator.emit<Bytecode::Op::LessThan>(dst, lhs, rhs);
+        break;
+    case BinaryOp::LessThanEquals:
+        generator.emit<Bytecode::Op::LessThanEquals>(dst, lhs, rhs);
+        break;
+    case BinaryOp::BitwiseAnd:
+        generator.emit<Bytecode::Op::BitwiseAnd>(dst, lhs, rhs);
+        break;
+    case BinaryOp::BitwiseOr:
+        generator.emit<Bytecode::Op::BitwiseOr>(dst, lhs, rhs);
+        break;
+    case BinaryOp::BitwiseXor:
+        generator.emit<Bytecode::Op::BitwiseXor>(dst, lhs, rhs);
+        break;
+    case BinaryOp::LeftShift:
+        generator.emit<Bytecode::Op::LeftShift>(dst, lhs, rhs);
+        break;
+    case BinaryOp::RightShift:
+        generator.emit<Bytecode::Op::RightShift>(dst, lhs, rhs);
+        break;
+    case BinaryOp::UnsignedRightShift:
+        generator.emit<Bytecode::Op::UnsignedRightShift>(dst, lhs, rhs);
+        break;
+    case BinaryOp::In:
+        generator.emit<Bytecode::Op::In>(dst, lhs, rhs);
+        break;
+    case BinaryOp::InstanceOf:
+        generator.emit<Bytecode::Op::InstanceOf>(dst, lhs, rhs);
+        break;
+    }
+    return dst;
+}
+
+Optional<Bytecode::Register> LogicalExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst = generator.generate_expression(*m_lhs);
+    auto end_label = generator.make_label();
+
+    switch (m_op) {
+    case LogicalOp::And:
+        generator.emit_jump<Bytecode::Op::JumpIfFalse>(dst, end_label);
+        break;
+    case LogicalOp::Or:
+        generator.emit_jump<Bytecode::Op::JumpIfTrue>(dst, end_label);
+        break;
+    case LogicalOp::NullishCoalescing:
+        generator.emit_jump<Bytecode::Op::JumpIfNotNullish>(dst, end_label);
+        break;
+    }
+
+    auto rhs = generator.generate_expression(*m_rhs);
+    generator.emit<Bytecode::Op::Move>(dst, rhs);
+    generator.place_label(end_label);
+    return dst;
+}
+
+Optional<Bytecode::Register> UnaryExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    // typeof and delete need to look at references rather than values.
+    if (m_op == UnaryOp::Typeof || m_op == UnaryOp::Delete)
+        return ASTNode::generate_bytecode(generator);
+
+    auto value = generator.generate_expression(*m_lhs);
+    switch (m_op) {
+    case UnaryOp::BitwiseNot:
+        generator.emit<Bytecode::Op::BitwiseNot>(value, value);
+        break;
+    case UnaryOp::Not:
+        generator.emit<Bytecode::Op::Not>(value, value);
+        break;
+    case UnaryOp::Plus:
+        generator.emit<Bytecode::Op::UnaryPlus>(value, value);
+        break;
+    case UnaryOp::Minus:
+        generator.emit<Bytecode::Op::UnaryMinus>(value, value);
+        break;
+    case UnaryOp::Void:
+        generator.emit<Bytecode::Op::Load>(value, js_undefined());
+        break;
+    default:
+        ASSERT_NOT_REACHED();
+    }
+    return value;
+}
+
+Optional<Bytecode::Register> SequenceExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    Optional<Bytecode::Register> last_value;
+    for (auto& expression : m_expressions)
+        last_value = generator.generate_expression(expression);
+    return last_value;
+}
+
+Optional<Bytecode::Register> BooleanLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst = generator.allocate_register();
+    generator.emit<Bytecode::Op::Load>(dst, Value(m_value));
+    return dst;
+}
+
+Optional<Bytecode::Register> NumericLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst = generator.allocate_register();
+    generator.emit<Bytecode::Op::Load>(dst, Value(m_value));
+    return dst;
+}
+
+Optional<Bytecode::Register> StringLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst = generator.allocate_register();
+    generator.emit<Bytecode::Op::NewString>(dst, m_value);
+    return dst;
+}
+
+Optional<Bytecode::Register> NullLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst = generator.allocate_register();
+    generator.emit<Bytecode::Op::Load>(dst, js_null());
+    return dst;
+}
+
+Optional<Bytecode::Register> Identifier::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst = generator.allocate_register();
+    generator.emit<Bytecode::Op::GetVariable>(dst, *this);
+    return dst;
+}
+
+Optional<Bytecode::Register> ThisExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst = generator.allocate_register();
+    generator.emit<Bytecode::Op::LoadThis>(dst);
+    return dst;
+}
+
+Optional<Bytecode::Register> MemberExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto object = generator.generate_expression(*m_object);
+    if (is_computed()) {
+        auto property = generator.generate_expression(*m_property);
+        generator.emit<Bytecode::Op::GetByValue>(object, object, property);
+    } else {
+        generator.emit<Bytecode::Op::GetById>(object, object, static_cast<const Identifier&>(*m_property).string());
+    }
+    return object;
+}
+
+Optional<Bytecode::Register> ConditionalExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto test = generator.generate_expression(*m_test);
+    auto dst = generator.allocate_register();
+    auto alternate_label = generator.make_label();
+    auto end_label = generator.make_label();
+
+    generator.emit_jump<Bytecode::Op::JumpIfFalse>(test, alternate_label);
+    auto consequent = generator.generate_expression(*m_consequent);
+    generator.emit<Bytecode::Op::Move>(dst, consequent);
+    generator.emit_jump<Bytecode::Op::Jump>(end_label);
+
+    generator.place_label(alternate_label);
+    auto alternate = generator.generate_expression(*m_alternate);
+    generator.emit<Bytecode::Op::Move>(dst, alternate);
+
+    generator.place_label(end_label);
+    return dst;
+}
+
+Optional<Bytecode::Register> CallExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (is_new_expression())
+        return ASTNode::generate_bytecode(generator);
+    for (auto& argument : m_arguments) {
+        if (argument.is_spread)
+            return ASTNode::generate_bytecode(generator);
+    }
+
+    Optional<Bytecode::Register> this_value;
+    Optional<Bytecode::Register> callee;
+    String callee_description;
+    if (m_callee->is_member_expression()) {
+        auto& member_expression = static_cast<const MemberExpression&>(*m_callee);
+        this_value = generator.generate_expression(member_expression.object());
+        callee = generator.allocate_register();
+        if (member_expression.is_computed()) {
+            auto property = generator.generate_expression(member_expression.property());
+            generator.emit<Bytecode::Op::GetByValue>(callee.value(), this_value.value(), property);
+        } else {
+            generator.emit<Bytecode::Op::GetById>(callee.value(), this_value.value(), static_cast<const Identifier&>(member_expression.property()).string());
+        }
+        callee_description = member_expression.to_string_approximation();
+    } else {
+        callee = generator.generate_expression(*m_callee);
+        if (m_callee->is_identifier())
+            callee_description = static_cast<const Identifier&>(*m_callee).string();
+    }
+
+    Vector<Bytecode::Register> arguments;
+    for (auto& argument : m_arguments)
+        arguments.append(generator.generate_expression(argument.value));
+
+    auto dst = generator.allocate_register();
+    generator.emit_with_length<Bytecode::Op::Call>(Bytecode::Op::Call::length_for(arguments.size()), dst, callee.value(), this_value, move(callee_description), arguments);
+    return dst;
+}
+
+static void emit_compound_assignment(Bytecode::Generator& generator, AssignmentOp op, Bytecode::Register dst, Bytecode::Register lhs, Bytecode::Register rhs)
+{
+    switch (op) {
+    case AssignmentOp::AdditionAssignment:
+        generator.emit<Bytecode::Op::Add>(dst, lhs, rhs);
+        break;
+    case AssignmentOp::SubtractionAssignment:
+        generator.emit<Bytecode::Op::Sub>(dst, lhs, rhs);
+        break;
+    case AssignmentOp::MultiplicationAssignment:
+        generator.emit<Bytecode::Op::Mul>(dst, lhs, rhs);
+        break;
+    case AssignmentOp::DivisionAssignment:
+        generator.emit<Bytecode::Op::Div>(dst, lhs, rhs);
+        break;
+    case AssignmentOp::ModuloAssignment:
+        generator.emit<Bytecode::Op::Mod>(dst, lhs, rhs);
+        break;
+    case AssignmentOp::ExponentiationAssignment:
+        generator.emit<Bytecode::Op::Exp>(dst, lhs, rhs);
+        break;
+    case AssignmentOp::BitwiseAndAssignment:
+        generator.emit<Bytecode::Op::BitwiseAnd>(dst, lhs, rhs);
+        break;
+    case AssignmentOp::BitwiseOrAssignment:
+        generator.emit<Bytecode::Op::BitwiseOr>(dst, lhs, rhs);
+        break;
+    case AssignmentOp::BitwiseXorAssignment:
+        generator.emit<Bytecode::Op::BitwiseXor>(dst, lhs, rhs);
+        break;
+    case AssignmentOp::LeftShiftAssignment:
+        generator.emit<Bytecode::Op::LeftShift>(dst, lhs, rhs);
+        break;
+    case AssignmentOp::RightShiftAssignment:
+        generator.emit<Bytecode::Op::RightShift>(dst, lhs, rhs);
+        break;
+    case AssignmentOp::UnsignedRightShiftAssignment:
+        generator.emit<Bytecode::Op::UnsignedRightShift>(dst, lhs, rhs);
+        break;
+    case AssignmentOp::Assignment:
+        ASSERT_NOT_REACHED();
+    }
+}
+
+Optional<Bytecode::Register> AssignmentExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    // Like AssignmentExpression::execute(), the right hand side is evaluated first.
+    if (m_lhs->is_identifier()) {
+        auto& identifier = static_cast<const Identifier&>(*m_lhs);
+        auto value = generator.generate_expression(*m_rhs);
+        if (m_op != AssignmentOp::Assignment) {
+            auto lhs = generator.allocate_register();
+            generator.emit<Bytecode::Op::GetVariable>(lhs, identifier);
+            emit_compound_assignment(generator, m_op, value, lhs, value);
+        }
+        generator.emit<Bytecode::Op::SetVariable>(identifier, value, false);
+        return value;
+    }
+
+    // Compound assignment to a member evaluates the member expression twice in the AST walker;
+    // leave that to it rather than trying to replicate it.
+    if (m_lhs->is_member_expression() && m_op == AssignmentOp::Assignment) {
+        auto& member_expression = static_cast<const MemberExpression&>(*m_lhs);
+        auto value = generator.generate_expression(*m_rhs);
+        auto object = generator.generate_expression(member_expression.object());
+        if (member_expression.is_computed()) {
+            auto property = generator.generate_expression(member_expression.property());
+            generator.emit<Bytecode::Op::PutByValue>(object, property, value);
+        } else {
+            generator.emit<Bytecode::Op::PutById>(object, static_cast<const Identifier&>(member_expression.property()).string(), value);
+        }
+        return value;
+    }
+
+    return ASTNode::generate_bytecode(generator);
+}
+
+Optional<Bytecode::Register> UpdateExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (!m_argument->is_identifier())
+        return ASTNode::generate_bytecode(generator);
+
+    auto& identifier = static_cast<const Identifier&>(*m_argument);
+    auto old_value = generator.allocate_register();
+    auto new_value = generator.allocate_register();
+    generator.emit<Bytecode::Op::GetVariable>(old_value, identifier);
+    generator.emit<Bytecode::Op::ToNumeric>(old_value, old_value);
+    if (m_op == UpdateOp::Increment)
+        generator.emit<Bytecode::Op::Increment>(new_value, old_value);
+    else
+        generator.emit<Bytecode::Op::Decrement>(new_value, old_value);
+    generator.emit<Bytecode::Op::SetVariable>(identifier, new_value, false);
+    return m_prefixed ? new_value : old_value;
+}
+
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Label.h>
+#include <LibJS/Forward.h>
+
+namespace JS {
+namespace Bytecode {
+
+// An enclosing compiled loop that a break or continue coming out of an AST fallback may
+// target. Innermost loops come last.
+struct UnwindTarget {
+    FlyString label;
+    Label break_target { 0 };
+    Label continue_target { 0 };
+    const ScopeNode* scope_to_exit { nullptr };
+};
+
+// The compiled form of a ScopeNode's children.
+class Block {
+    AK_MAKE_NONCOPYABLE(Block);
+    AK_MAKE_NONMOVABLE(Block);
+
+public:
+    Block();
+    ~Block();
+
+    const u8* data() const { return m_buffer.data(); }
+    size_t size() const { return m_buffer.size(); }
+
+    size_t register_count() const { return m_register_count; }
+
+    const Vector<UnwindTarget>& unwind_context(size_t index) const { return m_unwind_contexts[index]; }
+
+    template<typename Callback>
+    void for_each_instruction(Callback callback) const
+    {
+        for (size_t offset = 0; offset < m_buffer.size();) {
+            auto& instruction = *reinterpret_cast<const Instruction*>(m_buffer.data() + offset);
+            callback(offset, instruction);
+            offset += instruction.length();
+        }
+    }
+
+    void dump() const;
+
+private:
+    friend class Generator;
+
+    Vector<u8> m_buffer;
+    size_t m_register_count { 0 };
+    Vector<Vector<UnwindTarget>> m_unwind_contexts;
+
+    // Nodes synthesized by the generator, e.g. the scope wrapping a for loop's let binding.
+    NonnullRefPtrVector<ScopeNode> m_retained_nodes;
+};
+
+}
+}
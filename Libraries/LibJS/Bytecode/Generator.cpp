@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Generator.h>
+
+namespace JS {
+namespace Bytecode {
+
+Generator::Generator()
+    : m_block(make<Block>())
+{
+}
+
+NonnullOwnPtr<Block> Generator::generate(const ScopeNode& scope_node)
+{
+    Generator generator;
+    for (auto& child : scope_node.children()) {
+        auto completion = generator.generate_statement(child);
+        // The REPL prints the completion value of the last statement of a program.
+        if (scope_node.is_program())
+            generator.emit<Op::SetLastValue>(completion);
+    }
+    generator.finalize();
+    return move(generator.m_block);
+}
+
+Label Generator::make_label()
+{
+    m_label_addresses.append(unplaced_label);
+    return Label(m_label_addresses.size() - 1);
+}
+
+void Generator::place_label(Label label)
+{
+    ASSERT(m_label_addresses[label.value()] == unplaced_label);
+    m_label_addresses[label.value()] = m_block->m_buffer.size();
+}
+
+Optional<Register> Generator::generate_statement(const Statement& statement)
+{
+    auto first_temporary = m_next_register;
+    auto completion = statement.generate_bytecode(*this);
+    m_register_count = max(m_register_count, m_next_register);
+    m_next_register = first_temporary;
+    return completion;
+}
+
+Register Generator::generate_expression(const Expression& expression)
+{
+    auto result = expression.generate_bytecode(*this);
+    ASSERT(result.has_value());
+    return result.value();
+}
+
+Register Generator::emit_evaluate_expression(const ASTNode& node)
+{
+    auto dst = allocate_register();
+    emit<Op::EvaluateExpression>(dst, node);
+    return dst;
+}
+
+Register Generator::emit_evaluate_statement(const Statement& statement)
+{
+    auto dst = allocate_register();
+    emit<Op::EvaluateStatement>(dst, statement, make_unwind_context());
+    return dst;
+}
+
+void Generator::begin_scope(const ScopeNode& scope_node)
+{
+    emit<Op::EnterScope>(scope_node);
+    m_scope_stack.append(&scope_node);
+}
+
+void Generator::end_scope(const ScopeNode& scope_node)
+{
+    ASSERT(m_scope_stack.last() == &scope_node);
+    m_scope_stack.take_last();
+    emit<Op::ExitScope>(scope_node);
+}
+
+void Generator::retain(NonnullRefPtr<ScopeNode> scope_node)
+{
+    m_block->m_retained_nodes.append(move(scope_node));
+}
+
+void Generator::begin_loop(const FlyString& label, Label break_target, Label continue_target)
+{
+    m_loops.append({ label, break_target, continue_target, m_scope_stack.size() });
+}
+
+void Generator::end_loop()
+{
+    m_loops.take_last();
+}
+
+void Generator::emit_exit_scopes_for_loop(size_t loop_index)
+{
+    // Interpreter::exit_scope() pops every scope above the one it's given as well.
+    auto scope_depth = m_loops[loop_index].scope_depth;
+    if (m_scope_stack.size() > scope_depth)
+        emit<Op::ExitScope>(*m_scope_stack[scope_depth]);
+}
+
+bool Generator::emit_break(const FlyString& label)
+{
+    for (ssize_t i = m_loops.size() - 1; i >= 0; --i) {
+        if (!label.is_null() && m_loops[i].label != label)
+            continue;
+        emit_exit_scopes_for_loop(i);
+        emit_jump<Op::Jump>(m_loops[i].break_target);
+        return true;
+    }
+    return false;
+}
+
+bool Generator::emit_continue(const FlyString& label)
+{
+    for (ssize_t i = m_loops.size() - 1; i >= 0; --i) {
+        if (!label.is_null() && m_loops[i].label != label)
+            continue;
+        emit_exit_scopes_for_loop(i);
+        emit_jump<Op::Jump>(m_loops[i].continue_target);
+        return true;
+    }
+    return false;
+}
+
+Optional<size_t> Generator::make_unwind_context()
+{
+    if (m_loops.is_empty())
+        return {};
+    Vector<UnwindTarget> context;
+    for (auto& loop : m_loops) {
+        const ScopeNode* scope_to_exit = nullptr;
+        if (m_scope_stack.size() > loop.scope_depth)
+            scope_to_exit = m_scope_stack[loop.scope_depth];
+        context.append({ loop.label, loop.break_target, loop.continue_target, scope_to_exit });
+    }
+    m_block->m_unwind_contexts.append(move(context));
+    return m_block->m_unwind_contexts.size() - 1;
+}
+
+void Generator::finalize()
+{
+    auto address_of = [&](Label label) {
+        auto address = m_label_addresses[label.value()];
+        ASSERT(address != unplaced_label);
+        return address;
+    };
+
+    for (auto offset : m_label_fixups) {
+        auto& label = *reinterpret_cast<Label*>(m_block->m_buffer.data() + offset);
+        label.link(address_of(label));
+    }
+    for (auto& context : m_block->m_unwind_contexts) {
+        for (auto& target : context) {
+            target.break_target.link(address_of(target.break_target));
+            target.continue_target.link(address_of(target.continue_target));
+        }
+    }
+
+    m_block->m_register_count = max(m_register_count, m_next_register);
+}
+
+}
+}
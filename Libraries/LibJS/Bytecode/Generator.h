@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NumericLimits.h>
+#include <AK/Optional.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/Block.h>
+#include <LibJS/Bytecode/Label.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Register.h>
+#include <LibJS/Forward.h>
+
+namespace JS {
+namespace Bytecode {
+
+class Generator {
+public:
+    // Compiles the children of a scope node. Anything the generator doesn't understand is
+    // compiled into an instruction that hands the node to the AST walker, so this can't fail.
+    static NonnullOwnPtr<Block> generate(const ScopeNode&);
+
+    Register allocate_register() { return Register(m_next_register++); }
+
+    Label make_label();
+    void place_label(Label);
+
+    template<typename OpType, typename... Args>
+    OpType& emit(Args&&... args)
+    {
+        return emit_with_length<OpType>(sizeof(OpType), forward<Args>(args)...);
+    }
+
+    template<typename OpType, typename... Args>
+    OpType& emit_with_length(size_t length, Args&&... args)
+    {
+        auto offset = m_block->m_buffer.size();
+        m_block->m_buffer.resize(offset + round_up_to_power_of_two(length, alignof(void*)));
+        return *new (m_block->m_buffer.data() + offset) OpType(forward<Args>(args)...);
+    }
+
+    template<typename OpType, typename... Args>
+    void emit_jump(Args&&... args)
+    {
+        auto& op = emit<OpType>(forward<Args>(args)...);
+        m_label_fixups.append(reinterpret_cast<u8*>(&op.target()) - m_block->m_buffer.data());
+    }
+
+    // The registers used by a statement are free again once it has been generated, so the
+    // returned completion value has to be consumed before generating anything else.
+    Optional<Register> generate_statement(const Statement&);
+    Register generate_expression(const Expression&);
+
+    // Hand a node to the AST walker.
+    Register emit_evaluate_expression(const ASTNode&);
+    Register emit_evaluate_statement(const Statement&);
+
+    void begin_scope(const ScopeNode&);
+    void end_scope(const ScopeNode&);
+    void retain(NonnullRefPtr<ScopeNode>);
+
+    void begin_loop(const FlyString& label, Label break_target, Label continue_target);
+    void end_loop();
+
+    bool emit_break(const FlyString& label);
+    bool emit_continue(const FlyString& label);
+
+private:
+    Generator();
+
+    void finalize();
+    void emit_exit_scopes_for_loop(size_t loop_index);
+    Optional<size_t> make_unwind_context();
+
+    struct Loop {
+        FlyString label;
+        Label break_target;
+        Label continue_target;
+        size_t scope_depth { 0 };
+    };
+
+    NonnullOwnPtr<Block> m_block;
+    u32 m_next_register { 0 };
+    u32 m_register_count { 0 };
+
+    static constexpr size_t unplaced_label = NumericLimits<size_t>::max();
+    Vector<size_t> m_label_addresses;
+    Vector<size_t> m_label_fixups;
+
+    Vector<const ScopeNode*> m_scope_stack;
+    Vector<Loop> m_loops;
+};
+
+}
+}
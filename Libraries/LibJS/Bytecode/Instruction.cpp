@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/StdLibExtras.h>
+#include <AK/String.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
+
+namespace JS {
+namespace Bytecode {
+
+size_t Instruction::length() const
+{
+    size_t length = 0;
+    switch (type()) {
+    case Type::Call:
+        length = static_cast<const Op::Call&>(*this).length();
+        break;
+#define __BYTECODE_OP(op)     \
+    case Type::op:            \
+        length = sizeof(Op::op); \
+        break;
+        ENUMERATE_BYTECODE_FIXED_SIZE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    }
+    return round_up_to_power_of_two(length, alignof(void*));
+}
+
+String Instruction::to_string() const
+{
+#define __BYTECODE_OP(op) \
+    case Type::op:        \
+        return static_cast<const Op::op&>(*this).to_string();
+
+    switch (type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    }
+#undef __BYTECODE_OP
+    ASSERT_NOT_REACHED();
+}
+
+void Instruction::destroy(Instruction& instruction)
+{
+#define __BYTECODE_OP(op)                           \
+    case Type::op:                                  \
+        static_cast<Op::op&>(instruction).~op();    \
+        return;
+
+    switch (instruction.type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    }
+#undef __BYTECODE_OP
+    ASSERT_NOT_REACHED();
+}
+
+}
+}
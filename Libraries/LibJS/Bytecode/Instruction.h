@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/Forward.h>
+#include <LibJS/Forward.h>
+
+#define ENUMERATE_BYTECODE_FIXED_SIZE_OPS(O) \
+    O(Load)                       \
+    O(NewString)                  \
+    O(Move)                       \
+    O(LoadThis)                   \
+    O(Add)                        \
+    O(Sub)                        \
+    O(Mul)                        \
+    O(Div)                        \
+    O(Mod)                        \
+    O(Exp)                        \
+    O(GreaterThan)                \
+    O(GreaterThanEquals)          \
+    O(LessThan)                   \
+    O(LessThanEquals)             \
+    O(AbstractEquals)             \
+    O(AbstractInequals)           \
+    O(TypedEquals)                \
+    O(TypedInequals)              \
+    O(BitwiseAnd)                 \
+    O(BitwiseOr)                  \
+    O(BitwiseXor)                 \
+    O(LeftShift)                  \
+    O(RightShift)                 \
+    O(UnsignedRightShift)         \
+    O(In)                         \
+    O(InstanceOf)                 \
+    O(BitwiseNot)                 \
+    O(Not)                        \
+    O(UnaryPlus)                  \
+    O(UnaryMinus)                 \
+    O(ToNumeric)                  \
+    O(Increment)                  \
+    O(Decrement)                  \
+    O(GetVariable)                \
+    O(SetVariable)                \
+    O(GetById)                    \
+    O(GetByValue)                 \
+    O(PutById)                    \
+    O(PutByValue)                 \
+    O(Jump)                       \
+    O(JumpIfTrue)                 \
+    O(JumpIfFalse)                \
+    O(JumpIfNotNullish)           \
+    O(EnterScope)                 \
+    O(ExitScope)                  \
+    O(Return)                     \
+    O(SetLastValue)               \
+    O(EvaluateExpression)         \
+    O(EvaluateStatement)
+
+#define ENUMERATE_BYTECODE_OPS(O)        \
+    ENUMERATE_BYTECODE_FIXED_SIZE_OPS(O) \
+    O(Call)
+
+namespace JS {
+namespace Bytecode {
+
+// Instructions are stored back to back in a Block's byte buffer. They are not polymorphic;
+// the type tag is used to dispatch to the concrete op (see Op.h), which keeps the dispatch
+// loop free of virtual calls. Ops may only contain trivially relocatable members, since the
+// buffer is grown with a plain memcpy while generating.
+class Instruction {
+public:
+    enum class Type {
+#define __BYTECODE_OP(op) op,
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    };
+
+    Type type() const { return m_type; }
+    size_t length() const;
+    String to_string() const;
+
+    static void destroy(Instruction&);
+
+protected:
+    explicit Instruction(Type type)
+        : m_type(type)
+    {
+    }
+
+private:
+    Type m_type;
+};
+
+}
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/Badge.h>
+#include <AK/StdLibExtras.h>
+#include <LibJS/Bytecode/Block.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Interpreter.h>
+
+namespace JS {
+namespace Bytecode {
+
+Interpreter::Interpreter(JS::Interpreter& interpreter, const Block& block)
+    : m_interpreter(interpreter)
+    , m_block(block)
+{
+    m_registers.resize(block.register_count());
+    m_interpreter.push_register_window({}, m_registers);
+}
+
+Interpreter::~Interpreter()
+{
+    m_interpreter.pop_register_window({});
+}
+
+void Interpreter::set_last_value(Value value)
+{
+    m_interpreter.set_last_value({}, value);
+}
+
+// The dispatch loop switches on the type tag itself (instead of going through Instruction::length()
+// and an out-of-line execute()) so that the next offset is a constant for all fixed size ops.
+template<typename OpType>
+ALWAYS_INLINE static size_t length_of(const OpType&)
+{
+    return round_up_to_power_of_two(sizeof(OpType), alignof(void*));
+}
+
+ALWAYS_INLINE static size_t length_of(const Op::Call& call)
+{
+    return round_up_to_power_of_two(call.length(), alignof(void*));
+}
+
+void Interpreter::run()
+{
+    auto* data = m_block.data();
+    auto size = m_block.size();
+
+    for (size_t offset = 0; offset < size; offset = m_next_offset) {
+        auto& instruction = *reinterpret_cast<const Instruction*>(data + offset);
+        switch (instruction.type()) {
+#define __BYTECODE_OP(op)                                            \
+    case Instruction::Type::op: {                                    \
+        auto& concrete_op = static_cast<const Op::op&>(instruction); \
+        m_next_offset = offset + length_of(concrete_op);             \
+        concrete_op.execute(*this);                                  \
+        break;                                                       \
+    }
+            ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+        }
+        if (m_interpreter.should_unwind())
+            return;
+    }
+}
+
+}
+}
@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/String.h>
+#include <AK/StringBuilder.h>
+#include <LibCrypto/BigInt/SignedBigInteger.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Block.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/BigInt.h>
+#include <LibJS/Runtime/Error.h>
+#include <LibJS/Runtime/Function.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/MarkedValueList.h>
+#include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/Reference.h>
+
+namespace JS {
+namespace Bytecode {
+namespace Op {
+
+static Value abstract_equals(JS::Interpreter& interpreter, Value lhs, Value rhs)
+{
+    return Value(abstract_eq(interpreter, lhs, rhs));
+}
+
+static Value abstract_inequals(JS::Interpreter& interpreter, Value lhs, Value rhs)
+{
+    return Value(!abstract_eq(interpreter, lhs, rhs));
+}
+
+static Value typed_equals(JS::Interpreter& interpreter, Value lhs, Value rhs)
+{
+    return Value(strict_eq(interpreter, lhs, rhs));
+}
+
+static Value typed_inequals(JS::Interpreter& interpreter, Value lhs, Value rhs)
+{
+    return Value(!strict_eq(interpreter, lhs, rhs));
+}
+
+static Value logical_not(JS::Interpreter&, Value value)
+{
+    return Value(!value.to_boolean());
+}
+
+static Value to_numeric(JS::Interpreter& interpreter, Value value)
+{
+    return value.to_numeric(interpreter);
+}
+
+// Increment and Decrement expect their operand to have gone through ToNumeric already.
+static Value increment(JS::Interpreter& interpreter, Value value)
+{
+    if (value.is_number())
+        return Value(value.as_double() + 1);
+    return js_bigint(interpreter, value.as_bigint().big_integer().plus(Crypto::SignedBigInteger { 1 }));
+}
+
+static Value decrement(JS::Interpreter& interpreter, Value value)
+{
+    if (value.is_number())
+        return Value(value.as_double() - 1);
+    return js_bigint(interpreter, value.as_bigint().big_integer().minus(Crypto::SignedBigInteger { 1 }));
+}
+
+// Same conversion as MemberExpression::computed_property_name().
+static PropertyName property_name_from_value(JS::Interpreter& interpreter, Value value)
+{
+    ASSERT(!value.is_empty());
+    if (value.is_integer() && value.as_i32() >= 0)
+        return value.as_i32();
+    if (value.is_string())
+        return value.as_string().fly_string();
+    auto string = value.to_string(interpreter);
+    if (interpreter.exception())
+        return {};
+    return string;
+}
+
+void Load::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = m_value;
+}
+
+String Load::to_string() const
+{
+    return String::formatted("Load ${}, {}", m_dst.index(), m_value.to_string_without_side_effects());
+}
+
+void NewString::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = js_string(interpreter.interpreter(), m_string);
+}
+
+String NewString::to_string() const
+{
+    return String::formatted("NewString ${}, \"{}\"", m_dst.index(), m_string);
+}
+
+void Move::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = interpreter.reg(m_src);
+}
+
+String Move::to_string() const
+{
+    return String::formatted("Move ${}, ${}", m_dst.index(), m_src.index());
+}
+
+void LoadThis::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = interpreter.interpreter().this_value();
+}
+
+String LoadThis::to_string() const
+{
+    return String::formatted("LoadThis ${}", m_dst.index());
+}
+
+#define JS_DEFINE_BYTECODE_BINARY_OP(OpTitleCase, op_snake_case)                                                    \
+    void OpTitleCase::execute(Bytecode::Interpreter& interpreter) const                                            \
+    {                                                                                                               \
+        interpreter.reg(m_dst) = op_snake_case(interpreter.interpreter(), interpreter.reg(m_lhs), interpreter.reg(m_rhs)); \
+    }                                                                                                               \
+    String OpTitleCase::to_string() const                                                                           \
+    {                                                                                                               \
+        return String::formatted(#OpTitleCase " ${}, ${}, ${}", m_dst.index(), m_lhs.index(), m_rhs.index());      \
+    }
+
+JS_ENUMERATE_BYTECODE_BINARY_OPS(JS_DEFINE_BYTECODE_BINARY_OP)
+#undef JS_DEFINE_BYTECODE_BINARY_OP
+
+#define JS_DEFINE_BYTECODE_UNARY_OP(OpTitleCase, op_snake_case)                                 \
+    void OpTitleCase::execute(Bytecode::Interpreter& interpreter) const                        \
+    {                                                                                           \
+        interpreter.reg(m_dst) = op_snake_case(interpreter.interpreter(), interpreter.reg(m_src)); \
+    }                                                                                           \
+    String OpTitleCase::to_string() const                                                       \
+    {                                                                                           \
+        return String::formatted(#OpTitleCase " ${}, ${}", m_dst.index(), m_src.index());       \
+    }
+
+JS_ENUMERATE_BYTECODE_UNARY_OPS(JS_DEFINE_BYTECODE_UNARY_OP)
+#undef JS_DEFINE_BYTECODE_UNARY_OP
+
+void GetVariable::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto value = interpreter.interpreter().get_variable(m_identifier);
+    if (value.is_empty()) {
+        interpreter.interpreter().throw_exception<ReferenceError>(String::format("'%s' not known", m_identifier.string().characters()));
+        return;
+    }
+    interpreter.reg(m_dst) = value;
+}
+
+String GetVariable::to_string() const
+{
+    if (m_identifier.has_binding())
+        return String::formatted("GetVariable ${}, {} (slot {}, {} up)", m_dst.index(), m_identifier.string(), m_identifier.slot(), m_identifier.environment_hops());
+    return String::formatted("GetVariable ${}, {}", m_dst.index(), m_identifier.string());
+}
+
+void SetVariable::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto value = interpreter.reg(m_src);
+    update_function_name(value, m_identifier.string());
+    interpreter.interpreter().set_variable(m_identifier, value, m_first_assignment);
+}
+
+String SetVariable::to_string() const
+{
+    if (m_identifier.has_binding())
+        return String::formatted("SetVariable {} (slot {}, {} up), ${}{}", m_identifier.string(), m_identifier.slot(), m_identifier.environment_hops(), m_src.index(), m_first_assignment ? " (declaration)" : "");
+    return String::formatted("SetVariable {}, ${}{}", m_identifier.string(), m_src.index(), m_first_assignment ? " (declaration)" : "");
+}
+
+void GetById::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto* object = interpreter.reg(m_base).to_object(interpreter.interpreter());
+    if (!object)
+        return;
+    interpreter.reg(m_dst) = object->get_with_inline_cache(m_property, m_cache).value_or(js_undefined());
+}
+
+String GetById::to_string() const
+{
+    return String::formatted("GetById ${}, ${}, {}", m_dst.index(), m_base.index(), m_property);
+}
+
+void GetByValue::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto& js_interpreter = interpreter.interpreter();
+    auto* object = interpreter.reg(m_base).to_object(js_interpreter);
+    if (!object)
+        return;
+    auto property_name = property_name_from_value(js_interpreter, interpreter.reg(m_property));
+    if (js_interpreter.exception())
+        return;
+    interpreter.reg(m_dst) = object->get(property_name).value_or(js_undefined());
+}
+
+String GetByValue::to_string() const
+{
+    return String::formatted("GetByValue ${}, ${}, ${}", m_dst.index(), m_base.index(), m_property.index());
+}
+
+void PutById::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto value = interpreter.reg(m_src);
+    update_function_name(value, m_property);
+    auto base = interpreter.reg(m_base);
+    if (base.is_object())
+        base.as_object().put_with_inline_cache(m_property, value, m_cache);
+    else
+        Reference(base, m_property).put(interpreter.interpreter(), value);
+}
+
+String PutById::to_string() const
+{
+    return String::formatted("PutById ${}, {}, ${}", m_base.index(), m_property, m_src.index());
+}
+
+void PutByValue::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto& js_interpreter = interpreter.interpreter();
+    auto property_name = property_name_from_value(js_interpreter, interpreter.reg(m_property));
+    if (js_interpreter.exception())
+        return;
+    auto value = interpreter.reg(m_src);
+    update_function_name(value, property_name.as_string());
+    Reference(interpreter.reg(m_base), property_name).put(js_interpreter, value);
+}
+
+String PutByValue::to_string() const
+{
+    return String::formatted("PutByValue ${}, ${}, ${}", m_base.index(), m_property.index(), m_src.index());
+}
+
+void Jump::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.jump(m_target);
+}
+
+String Jump::to_string() const
+{
+    return String::formatted("Jump @{}", m_target.value());
+}
+
+void JumpIfTrue::execute(Bytecode::Interpreter& interpreter) const
+{
+    if (interpreter.reg(m_condition).to_boolean())
+        interpreter.jump(m_target);
+}
+
+String JumpIfTrue::to_string() const
+{
+    return String::formatted("JumpIfTrue ${}, @{}", m_condition.index(), m_target.value());
+}
+
+void JumpIfFalse::execute(Bytecode::Interpreter& interpreter) const
+{
+    if (!interpreter.reg(m_condition).to_boolean())
+        interpreter.jump(m_target);
+}
+
+String JumpIfFalse::to_string() const
+{
+    return String::formatted("JumpIfFalse ${}, @{}", m_condition.index(), m_target.value());
+}
+
+void JumpIfNotNullish::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto& condition = interpreter.reg(m_condition);
+    if (!condition.is_null() && !condition.is_undefined())
+        interpreter.jump(m_target);
+}
+
+String JumpIfNotNullish::to_string() const
+{
+    return String::formatted("JumpIfNotNullish ${}, @{}", m_condition.index(), m_target.value());
+}
+
+void EnterScope::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.interpreter().enter_scope(m_scope_node, {}, ScopeType::Block);
+}
+
+String EnterScope::to_string() const
+{
+    return String::formatted("EnterScope {}", &m_scope_node);
+}
+
+void ExitScope::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.interpreter().exit_scope(m_scope_node);
+}
+
+String ExitScope::to_string() const
+{
+    return String::formatted("ExitScope {}", &m_scope_node);
+}
+
+void Call::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto& js_interpreter = interpreter.interpreter();
+    auto callee = interpreter.reg(m_callee);
+
+    if (!callee.is_function()) {
+        String error_message;
+        if (!m_callee_description.is_null())
+            error_message = String::format("%s is not a function (evaluated from '%s')", callee.to_string_without_side_effects().characters(), m_callee_description.characters());
+        else
+            error_message = String::format("%s is not a function", callee.to_string_without_side_effects().characters());
+        js_interpreter.throw_exception<TypeError>(error_message);
+        return;
+    }
+
+    Value this_value = &js_interpreter.global_object();
+    if (m_this_value.has_value()) {
+        auto* this_object = interpreter.reg(m_this_value.value()).to_object(js_interpreter);
+        if (!this_object)
+            return;
+        this_value = this_object;
+    }
+
+    MarkedValueList arguments(js_interpreter.heap());
+    arguments.values().ensure_capacity(m_argument_count);
+    for (size_t i = 0; i < m_argument_count; ++i)
+        arguments.append(interpreter.reg(m_arguments[i]));
+
+    auto result = js_interpreter.call(callee.as_function(), this_value, move(arguments));
+    if (js_interpreter.exception())
+        return;
+    interpreter.reg(m_dst) = result;
+}
+
+String Call::to_string() const
+{
+    StringBuilder builder;
+    builder.appendff("Call ${}, ${}", m_dst.index(), m_callee.index());
+    if (m_this_value.has_value())
+        builder.appendff(", this=${}", m_this_value.value().index());
+    for (size_t i = 0; i < m_argument_count; ++i)
+        builder.appendff(", ${}", m_arguments[i].index());
+    return builder.build();
+}
+
+void Return::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto& js_interpreter = interpreter.interpreter();
+    interpreter.set_last_value(m_argument.has_value() ? interpreter.reg(m_argument.value()) : js_undefined());
+    js_interpreter.unwind(ScopeType::Function);
+}
+
+String Return::to_string() const
+{
+    if (m_argument.has_value())
+        return String::formatted("Return ${}", m_argument.value().index());
+    return "Return";
+}
+
+void SetLastValue::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.set_last_value(m_src.has_value() ? interpreter.reg(m_src.value()) : js_undefined());
+}
+
+String SetLastValue::to_string() const
+{
+    if (m_src.has_value())
+        return String::formatted("SetLastValue ${}", m_src.value().index());
+    return "SetLastValue undefined";
+}
+
+void EvaluateExpression::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = m_node.execute(interpreter.interpreter());
+}
+
+String EvaluateExpression::to_string() const
+{
+    return String::formatted("EvaluateExpression ${}, {}", m_dst.index(), m_node.class_name());
+}
+
+void EvaluateStatement::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto& js_interpreter = interpreter.interpreter();
+    auto value = m_node.execute(js_interpreter);
+    interpreter.reg(m_dst) = value;
+    // The AST walker does this after every statement; a return inside e.g. a try block relies on it.
+    interpreter.set_last_value(value);
+
+    if (!m_unwind_context.has_value() || !js_interpreter.should_unwind())
+        return;
+
+    auto& targets = interpreter.block().unwind_context(m_unwind_context.value());
+    for (ssize_t i = targets.size() - 1; i >= 0; --i) {
+        auto& target = targets[i];
+        Optional<Label> destination;
+        if (js_interpreter.should_unwind_until(ScopeType::Continuable, target.label))
+            destination = target.continue_target;
+        else if (js_interpreter.should_unwind_until(ScopeType::Breakable, target.label))
+            destination = target.break_target;
+        if (!destination.has_value())
+            continue;
+        js_interpreter.stop_unwind();
+        if (target.scope_to_exit)
+            js_interpreter.exit_scope(*target.scope_to_exit);
+        interpreter.jump(destination.value());
+        return;
+    }
+}
+
+String EvaluateStatement::to_string() const
+{
+    return String::formatted("EvaluateStatement ${}, {}", m_dst.index(), m_node.class_name());
+}
+
+}
+}
+}
@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Label.h>
+#include <LibJS/Bytecode/Register.h>
+#include <LibJS/Runtime/PropertyLookupCache.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS {
+namespace Bytecode {
+namespace Op {
+
+class Load final : public Instruction {
+public:
+    // Only non-cell values may be embedded in a block, as blocks are not visited by the GC.
+    Load(Register dst, Value value)
+        : Instruction(Type::Load)
+        , m_dst(dst)
+        , m_value(value)
+    {
+        ASSERT(!value.is_cell());
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_dst;
+    Value m_value;
+};
+
+class NewString final : public Instruction {
+public:
+    NewString(Register dst, String string)
+        : Instruction(Type::NewString)
+        , m_dst(dst)
+        , m_string(move(string))
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_dst;
+    String m_string;
+};
+
+class Move final : public Instruction {
+public:
+    Move(Register dst, Register src)
+        : Instruction(Type::Move)
+        , m_dst(dst)
+        , m_src(src)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_dst;
+    Register m_src;
+};
+
+class LoadThis final : public Instruction {
+public:
+    explicit LoadThis(Register dst)
+        : Instruction(Type::LoadThis)
+        , m_dst(dst)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_dst;
+};
+
+#define JS_ENUMERATE_BYTECODE_BINARY_OPS(O)     \
+    O(Add, add)                                 \
+    O(Sub, sub)                                 \
+    O(Mul, mul)                                 \
+    O(Div, div)                                 \
+    O(Mod, mod)                                 \
+    O(Exp, exp)                                 \
+    O(GreaterThan, greater_than)                \
+    O(GreaterThanEquals, greater_than_equals)   \
+    O(LessThan, less_than)                      \
+    O(LessThanEquals, less_than_equals)         \
+    O(AbstractEquals, abstract_equals)          \
+    O(AbstractInequals, abstract_inequals)      \
+    O(TypedEquals, typed_equals)                \
+    O(TypedInequals, typed_inequals)            \
+    O(BitwiseAnd, bitwise_and)                  \
+    O(BitwiseOr, bitwise_or)                    \
+    O(BitwiseXor, bitwise_xor)                  \
+    O(LeftShift, left_shift)                    \
+    O(RightShift, right_shift)                  \
+    O(UnsignedRightShift, unsigned_right_shift) \
+    O(In, in)                                   \
+    O(InstanceOf, instance_of)
+
+#define JS_DECLARE_BYTECODE_BINARY_OP(OpTitleCase, op_snake_case) \
+    class OpTitleCase final : public Instruction {                \
+    public:                                                       \
+        OpTitleCase(Register dst, Register lhs, Register rhs)     \
+            : Instruction(Type::OpTitleCase)                      \
+            , m_dst(dst)                                          \
+            , m_lhs(lhs)                                          \
+            , m_rhs(rhs)                                          \
+        {                                                         \
+        }                                                         \
+                                                                  \
+        void execute(Bytecode::Interpreter&) const;               \
+        String to_string() const;                                 \
+                                                                  \
+    private:                                                      \
+        Register m_dst;                                           \
+        Register m_lhs;                                           \
+        Register m_rhs;                                           \
+    };
+
+JS_ENUMERATE_BYTECODE_BINARY_OPS(JS_DECLARE_BYTECODE_BINARY_OP)
+#undef JS_DECLARE_BYTECODE_BINARY_OP
+
+#define JS_ENUMERATE_BYTECODE_UNARY_OPS(O) \
+    O(BitwiseNot, bitwise_not)             \
+    O(Not, logical_not)                    \
+    O(UnaryPlus, unary_plus)               \
+    O(UnaryMinus, unary_minus)             \
+    O(ToNumeric, to_numeric)               \
+    O(Increment, increment)                \
+    O(Decrement, decrement)
+
+#define JS_DECLARE_BYTECODE_UNARY_OP(OpTitleCase, op_snake_case) \
+    class OpTitleCase final : public Instruction {               \
+    public:                                                      \
+        OpTitleCase(Register dst, Register src)                  \
+            : Instruction(Type::OpTitleCase)                     \
+            , m_dst(dst)                                         \
+            , m_src(src)                                         \
+        {                                                        \
+        }                                                        \
+                                                                 \
+        void execute(Bytecode::Interpreter&) const;              \
+        String to_string() const;                                \
+                                                                 \
+    private:                                                     \
+        Register m_dst;                                          \
+        Register m_src;                                          \
+    };
+
+JS_ENUMERATE_BYTECODE_UNARY_OPS(JS_DECLARE_BYTECODE_UNARY_OP)
+#undef JS_DECLARE_BYTECODE_UNARY_OP
+
+class GetVariable final : public Instruction {
+public:
+    GetVariable(Register dst, const Identifier& identifier)
+        : Instruction(Type::GetVariable)
+        , m_dst(dst)
+        , m_identifier(identifier)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_dst;
+    const Identifier& m_identifier;
+};
+
+class SetVariable final : public Instruction {
+public:
+    SetVariable(const Identifier& identifier, Register src, bool first_assignment)
+        : Instruction(Type::SetVariable)
+        , m_identifier(identifier)
+        , m_src(src)
+        , m_first_assignment(first_assignment)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    const Identifier& m_identifier;
+    Register m_src;
+    bool m_first_assignment { false };
+};
+
+class GetById final : public Instruction {
+public:
+    GetById(Register dst, Register base, const FlyString& property)
+        : Instruction(Type::GetById)
+        , m_dst(dst)
+        , m_base(base)
+        , m_property(property)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_dst;
+    Register m_base;
+    FlyString m_property;
+    mutable PropertyLookupCache m_cache;
+};
+
+class GetByValue final : public Instruction {
+public:
+    GetByValue(Register dst, Register base, Register property)
+        : Instruction(Type::GetByValue)
+        , m_dst(dst)
+        , m_base(base)
+        , m_property(property)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_dst;
+    Register m_base;
+    Register m_property;
+};
+
+class PutById final : public Instruction {
+public:
+    PutById(Register base, const FlyString& property, Register src)
+        : Instruction(Type::PutById)
+        , m_base(base)
+        , m_property(property)
+        , m_src(src)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_base;
+    FlyString m_property;
+    Register m_src;
+    mutable PropertyLookupCache m_cache;
+};
+
+class PutByValue final : public Instruction {
+public:
+    PutByValue(Register base, Register property, Register src)
+        : Instruction(Type::PutByValue)
+        , m_base(base)
+        , m_property(property)
+        , m_src(src)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_base;
+    Register m_property;
+    Register m_src;
+};
+
+class Jump final : public Instruction {
+public:
+    explicit Jump(Label target)
+        : Instruction(Type::Jump)
+        , m_target(target)
+    {
+    }
+
+    Label& target() { return m_target; }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Label m_target;
+};
+
+#define JS_DECLARE_BYTECODE_CONDITIONAL_JUMP(OpTitleCase) \
+    class OpTitleCase final : public Instruction {        \
+    public:                                               \
+        OpTitleCase(Register condition, Label target)     \
+            : Instruction(Type::OpTitleCase)              \
+            , m_condition(condition)                      \
+            , m_target(target)                            \
+        {                                                 \
+        }                                                 \
+                                                          \
+        Label& target() { return m_target; }              \
+                                                          \
+        void execute(Bytecode::Interpreter&) const;       \
+        String to_string() const;                         \
+                                                          \
+    private:                                              \
+        Register m_condition;                             \
+        Label m_target;                                   \
+    };
+
+JS_DECLARE_BYTECODE_CONDITIONAL_JUMP(JumpIfTrue)
+JS_DECLARE_BYTECODE_CONDITIONAL_JUMP(JumpIfFalse)
+JS_DECLARE_BYTECODE_CONDITIONAL_JUMP(JumpIfNotNullish)
+#undef JS_DECLARE_BYTECODE_CONDITIONAL_JUMP
+
+class EnterScope final : public Instruction {
+public:
+    explicit EnterScope(const ScopeNode& scope_node)
+        : Instruction(Type::EnterScope)
+        , m_scope_node(scope_node)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    const ScopeNode& m_scope_node;
+};
+
+class ExitScope final : public Instruction {
+public:
+    explicit ExitScope(const ScopeNode& scope_node)
+        : Instruction(Type::ExitScope)
+        , m_scope_node(scope_node)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    const ScopeNode& m_scope_node;
+};
+
+// The argument registers are stored inline, right after the instruction.
+class Call final : public Instruction {
+public:
+    Call(Register dst, Register callee, Optional<Register> this_value, String callee_description, const Vector<Register>& arguments)
+        : Instruction(Type::Call)
+        , m_dst(dst)
+        , m_callee(callee)
+        , m_this_value(this_value)
+        , m_callee_description(move(callee_description))
+        , m_argument_count(arguments.size())
+    {
+        for (size_t i = 0; i < m_argument_count; ++i)
+            new (&m_arguments[i]) Register(arguments[i]);
+    }
+
+    size_t length() const { return sizeof(*this) + sizeof(Register) * m_argument_count; }
+    static size_t length_for(size_t argument_count) { return sizeof(Call) + sizeof(Register) * argument_count; }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_dst;
+    Register m_callee;
+    Optional<Register> m_this_value;
+    String m_callee_description;
+    size_t m_argument_count { 0 };
+    Register m_arguments[0];
+};
+
+class Return final : public Instruction {
+public:
+    explicit Return(Optional<Register> argument)
+        : Instruction(Type::Return)
+        , m_argument(argument)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Optional<Register> m_argument;
+};
+
+class SetLastValue final : public Instruction {
+public:
+    explicit SetLastValue(Optional<Register> src)
+        : Instruction(Type::SetLastValue)
+        , m_src(src)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Optional<Register> m_src;
+};
+
+// Fallback for expressions the generator doesn't know how to compile: runs the AST walker
+// for the node and puts the result in a register.
+class EvaluateExpression final : public Instruction {
+public:
+    EvaluateExpression(Register dst, const ASTNode& node)
+        : Instruction(Type::EvaluateExpression)
+        , m_dst(dst)
+        , m_node(node)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_dst;
+    const ASTNode& m_node;
+};
+
+// Fallback for statements. If the AST walker starts unwinding for a break or continue,
+// the unwind context tells us which of the enclosing compiled loops (if any) it targets.
+class EvaluateStatement final : public Instruction {
+public:
+    EvaluateStatement(Register dst, const Statement& node, Optional<size_t> unwind_context)
+        : Instruction(Type::EvaluateStatement)
+        , m_dst(dst)
+        , m_node(node)
+        , m_unwind_context(unwind_context)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_dst;
+    const Statement& m_node;
+    Optional<size_t> m_unwind_context;
+};
+
+}
+}
+}
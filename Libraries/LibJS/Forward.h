@@ -26,19 +26,22 @@
 
 #pragma once
 
-#define JS_ENUMERATE_NATIVE_OBJECTS                                              \
-    __JS_ENUMERATE(Array, array, ArrayPrototype, ArrayConstructor)               \
-    __JS_ENUMERATE(BigIntObject, bigint, BigIntPrototype, BigIntConstructor)     \
-    __JS_ENUMERATE(BooleanObject, boolean, BooleanPrototype, BooleanConstructor) \
-    __JS_ENUMERATE(Date, date, DatePrototype, DateConstructor)                   \
-    __JS_ENUMERATE(Error, error, ErrorPrototype, ErrorConstructor)               \
-    __JS_ENUMERATE(Function, function, FunctionPrototype, FunctionConstructor)   \
-    __JS_ENUMERATE(NumberObject, number, NumberPrototype, NumberConstructor)     \
-    __JS_ENUMERATE(Object, object, ObjectPrototype, ObjectConstructor)           \
-    __JS_ENUMERATE(ProxyObject, proxy, ProxyPrototype, ProxyConstructor)         \
-    __JS_ENUMERATE(RegExpObject, regexp, RegExpPrototype, RegExpConstructor)     \
-    __JS_ENUMERATE(StringObject, string, StringPrototype, StringConstructor)     \
-    __JS_ENUMERATE(SymbolObject, symbol, SymbolPrototype, SymbolConstructor)
+#define JS_ENUMERATE_NATIVE_OBJECTS                                                          \
+    __JS_ENUMERATE(Array, array, ArrayPrototype, ArrayConstructor)                           \
+    __JS_ENUMERATE(ArrayBuffer, array_buffer, ArrayBufferPrototype, ArrayBufferConstructor)  \
+    __JS_ENUMERATE(BigIntObject, bigint, BigIntPrototype, BigIntConstructor)                 \
+    __JS_ENUMERATE(BooleanObject, boolean, BooleanPrototype, BooleanConstructor)             \
+    __JS_ENUMERATE(DataView, data_view, DataViewPrototype, DataViewConstructor)              \
+    __JS_ENUMERATE(Date, date, DatePrototype, DateConstructor)                               \
+    __JS_ENUMERATE(Error, error, ErrorPrototype, ErrorConstructor)                           \
+    __JS_ENUMERATE(Function, function, FunctionPrototype, FunctionConstructor)               \
+    __JS_ENUMERATE(NumberObject, number, NumberPrototype, NumberConstructor)                 \
+    __JS_ENUMERATE(Object, object, ObjectPrototype, ObjectConstructor)                       \
+    __JS_ENUMERATE(ProxyObject, proxy, ProxyPrototype, ProxyConstructor)                     \
+    __JS_ENUMERATE(RegExpObject, regexp, RegExpPrototype, RegExpConstructor)                 \
+    __JS_ENUMERATE(StringObject, string, StringPrototype, StringConstructor)                 \
+    __JS_ENUMERATE(SymbolObject, symbol, SymbolPrototype, SymbolConstructor)                 \
+    __JS_ENUMERATE(TypedArrayBase, typed_array, TypedArrayPrototype, TypedArrayConstructor)
 
 #define JS_ENUMERATE_ERROR_SUBCLASSES                                                                   \
     __JS_ENUMERATE(EvalError, eval_error, EvalErrorPrototype, EvalErrorConstructor)                     \
@@ -53,13 +56,28 @@
     JS_ENUMERATE_NATIVE_OBJECTS    \
     JS_ENUMERATE_ERROR_SUBCLASSES
 
+// The concrete typed arrays carry their element type as an extra argument,
+// so they are enumerated separately from the other builtin types.
+#define JS_ENUMERATE_TYPED_ARRAYS                                                                                               \
+    __JS_ENUMERATE(Int8Array, int8_array, Int8ArrayPrototype, Int8ArrayConstructor, i8)                                         \
+    __JS_ENUMERATE(Uint8Array, uint8_array, Uint8ArrayPrototype, Uint8ArrayConstructor, u8)                                     \
+    __JS_ENUMERATE(Uint8ClampedArray, uint8_clamped_array, Uint8ClampedArrayPrototype, Uint8ClampedArrayConstructor, ClampedU8) \
+    __JS_ENUMERATE(Int16Array, int16_array, Int16ArrayPrototype, Int16ArrayConstructor, i16)                                    \
+    __JS_ENUMERATE(Uint16Array, uint16_array, Uint16ArrayPrototype, Uint16ArrayConstructor, u16)                                \
+    __JS_ENUMERATE(Int32Array, int32_array, Int32ArrayPrototype, Int32ArrayConstructor, i32)                                    \
+    __JS_ENUMERATE(Uint32Array, uint32_array, Uint32ArrayPrototype, Uint32ArrayConstructor, u32)                                \
+    __JS_ENUMERATE(Float32Array, float32_array, Float32ArrayPrototype, Float32ArrayConstructor, float)                          \
+    __JS_ENUMERATE(Float64Array, float64_array, Float64ArrayPrototype, Float64ArrayConstructor, double)
+
 namespace JS {
 
 class ASTNode;
 class BigInt;
 class BoundFunction;
 class Cell;
+class CellAllocator;
 class DeferGC;
+class EnvironmentLayout;
 class Error;
 class Exception;
 class Expression;
@@ -68,17 +86,18 @@ class GlobalObject;
 class HandleImpl;
 class Heap;
 class HeapBlock;
+class Identifier;
 class Interpreter;
 class LexicalEnvironment;
 class MarkedValueList;
 class PrimitiveString;
+class PropertyLookupCache;
 class Reference;
 class ScopeNode;
 class Shape;
 class Statement;
 class Symbol;
 class Token;
-class Uint8ClampedArray;
 class Value;
 enum class DeclarationKind;
 
@@ -89,9 +108,22 @@ enum class DeclarationKind;
 JS_ENUMERATE_BUILTIN_TYPES
 #undef __JS_ENUMERATE
 
+#define __JS_ENUMERATE(ClassName, snake_name, ConstructorName, PrototypeName, ArrayType) \
+    class ClassName;                                                                     \
+    class ConstructorName;                                                               \
+    class PrototypeName;
+JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+
 struct Argument;
 
 template<class T>
 class Handle;
 
+namespace Bytecode {
+class Block;
+class Generator;
+class Interpreter;
+}
+
 }
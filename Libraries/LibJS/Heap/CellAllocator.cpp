@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/Badge.h>
+#include <LibJS/Heap/CellAllocator.h>
+#include <LibJS/Heap/Heap.h>
+#include <LibJS/Heap/HeapBlock.h>
+
+namespace JS {
+
+CellAllocator::CellAllocator(Heap& heap, size_t cell_size)
+    : m_heap(heap)
+    , m_cell_size(cell_size)
+{
+}
+
+CellAllocator::~CellAllocator()
+{
+}
+
+Cell* CellAllocator::allocate_cell()
+{
+    while (m_next_block_index < m_blocks.size()) {
+        auto& block = *m_blocks[m_next_block_index];
+        if (block.needs_sweep()) {
+            block.sweep();
+            m_heap.did_sweep_block_lazily({});
+        }
+        if (auto* cell = block.allocate())
+            return cell;
+        ++m_next_block_index;
+    }
+
+    auto block = HeapBlock::create_with_cell_size(m_heap, m_cell_size);
+    m_heap.did_create_block({}, *block);
+    auto* cell = block->allocate();
+    m_blocks.append(move(block));
+    return cell;
+}
+
+void CellAllocator::schedule_sweep(bool young_cells_only)
+{
+    for (auto& block : m_blocks) {
+        if (!young_cells_only || block->has_young_cells())
+            block->set_needs_sweep(true);
+    }
+}
+
+void CellAllocator::clear_marks()
+{
+    for (auto& block : m_blocks)
+        block->clear_marks();
+}
+
+void CellAllocator::finish_sweep()
+{
+    m_blocks.remove_all_matching([this](auto& block) {
+        if (!block->needs_sweep() || block->sweep())
+            return false;
+        m_heap.will_destroy_block({}, *block);
+        return true;
+    });
+    m_next_block_index = 0;
+}
+
+}
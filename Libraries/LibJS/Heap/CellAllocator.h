@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+#include <LibJS/Heap/HeapBlock.h>
+
+namespace JS {
+
+// Hands out cells of a single size class from its own list of HeapBlocks.
+// After a collection, blocks are swept lazily as the allocator reaches them.
+class CellAllocator {
+    AK_MAKE_NONCOPYABLE(CellAllocator);
+    AK_MAKE_NONMOVABLE(CellAllocator);
+
+public:
+    CellAllocator(Heap&, size_t cell_size);
+    ~CellAllocator();
+
+    size_t cell_size() const { return m_cell_size; }
+    size_t block_count() const { return m_blocks.size(); }
+
+    Cell* allocate_cell();
+
+    // Called once a collection has marked the live cells: the blocks that may contain dead cells will be
+    // swept before they are allocated from again. After a young generation collection, that's only the
+    // blocks that had cells allocated in them since the previous collection.
+    void schedule_sweep(bool young_cells_only);
+
+    void clear_marks();
+
+    // Sweeps the blocks that haven't been swept yet and releases the ones that no longer contain live cells.
+    void finish_sweep();
+
+private:
+    Heap& m_heap;
+    size_t m_cell_size { 0 };
+    Vector<NonnullOwnPtr<HeapBlock>> m_blocks;
+
+    // The blocks before this one have no free cells left.
+    size_t m_next_block_index { 0 };
+};
+
+}
@@ -26,6 +26,8 @@
 
 #include <AK/Badge.h>
 #include <AK/HashTable.h>
+#include <AK/Vector.h>
+#include <LibJS/Heap/CellAllocator.h>
 #include <LibJS/Heap/Handle.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Heap/HeapBlock.h>
@@ -34,6 +36,7 @@
 #include <LibJS/Runtime/Object.h>
 #include <setjmp.h>
 #include <stdio.h>
+#include <time.h>
 
 #ifdef __serenity__
 #    include <serenity.h>
@@ -47,9 +50,21 @@
 
 namespace JS {
 
+// Cell sizes are rounded up to the nearest of these. The largest one has to fit the GlobalObject.
+static constexpr size_t s_cell_size_classes[] = { 16, 32, 48, 64, 96, 128, 192, 256, 512, 1024, 3072 };
+
+static u64 monotonic_time_in_microseconds()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (u64)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
 Heap::Heap(Interpreter& interpreter)
     : m_interpreter(interpreter)
 {
+    for (auto cell_size : s_cell_size_classes)
+        m_allocators.append(make<CellAllocator>(*this, cell_size));
 }
 
 Heap::~Heap()
@@ -57,43 +72,98 @@ Heap::~Heap()
     collect_garbage(CollectionType::CollectEverything);
 }
 
+CellAllocator& Heap::allocator_for_size(size_t size)
+{
+    for (auto& allocator : m_allocators) {
+        if (allocator->cell_size() >= size)
+            return *allocator;
+    }
+    ASSERT_NOT_REACHED();
+}
+
+Heap::CollectionType Heap::collection_type_for_allocation() const
+{
+    // Old cells are only reclaimed by full collections, so do one whenever the old generation has doubled.
+    if (m_old_cell_count >= max(m_old_cell_count_after_last_full_collection, m_max_allocations_between_gc) * 2)
+        return CollectionType::CollectGarbage;
+    return CollectionType::CollectYoungGeneration;
+}
+
 Cell* Heap::allocate_cell(size_t size)
 {
     if (should_collect_on_every_allocation()) {
-        collect_garbage();
+        collect_garbage(collection_type_for_allocation());
     } else if (m_allocations_since_last_gc > m_max_allocations_between_gc) {
         m_allocations_since_last_gc = 0;
-        collect_garbage();
+        collect_garbage(collection_type_for_allocation());
     } else {
         ++m_allocations_since_last_gc;
     }
 
-    for (auto& block : m_blocks) {
-        if (size > block->cell_size())
-            continue;
-        if (auto* cell = block->allocate())
-            return cell;
-    }
-
-    size_t cell_size = round_up_to_power_of_two(size, 16);
-    auto block = HeapBlock::create_with_cell_size(*this, cell_size);
-    auto* cell = block->allocate();
-    m_blocks.append(move(block));
-    return cell;
+    ++m_statistics.cells_allocated;
+    return allocator_for_size(size).allocate_cell();
 }
 
 void Heap::collect_garbage(CollectionType collection_type)
 {
-    if (collection_type == CollectionType::CollectGarbage) {
-        if (m_gc_deferrals) {
-            m_should_gc_when_deferral_ends = true;
-            return;
-        }
+    if (collection_type != CollectionType::CollectEverything && m_gc_deferrals) {
+        m_should_gc_when_deferral_ends = true;
+        if (collection_type == CollectionType::CollectGarbage)
+            m_deferred_collection_type = collection_type;
+        return;
+    }
+
+    auto start_time = monotonic_time_in_microseconds();
+
+    // Marking relies on every cell that is still live in the heap being reachable, so the
+    // blocks left over from the previous collection have to be swept before we start.
+    for (auto& allocator : m_allocators)
+        allocator->finish_sweep();
+
+    bool is_full_collection = collection_type != CollectionType::CollectYoungGeneration;
+    if (is_full_collection) {
+        for (auto& allocator : m_allocators)
+            allocator->clear_marks();
+    }
+
+    if (collection_type != CollectionType::CollectEverything) {
         HashTable<Cell*> roots;
         gather_roots(roots);
-        mark_live_cells(roots);
+        auto marked_cell_count = mark_live_cells(roots, collection_type);
+        if (is_full_collection) {
+            m_old_cell_count = marked_cell_count;
+            m_old_cell_count_after_last_full_collection = marked_cell_count;
+        } else {
+            m_old_cell_count += marked_cell_count;
+        }
     }
-    sweep_dead_cells();
+
+    for (auto* cell : m_remembered_cells)
+        cell->set_remembered(false);
+    m_remembered_cells.clear_with_capacity();
+
+    for (auto& allocator : m_allocators)
+        allocator->schedule_sweep(!is_full_collection);
+
+    if (collection_type == CollectionType::CollectEverything) {
+        for (auto& allocator : m_allocators)
+            allocator->finish_sweep();
+    }
+
+    auto collection_time = monotonic_time_in_microseconds() - start_time;
+    ++m_statistics.collections;
+    if (!is_full_collection)
+        ++m_statistics.young_generation_collections;
+    m_statistics.last_collection_time_in_microseconds = collection_time;
+    m_statistics.total_collection_time_in_microseconds += collection_time;
+}
+
+void Heap::remember_cell(Badge<Cell>, Cell& cell)
+{
+    ASSERT(cell.is_marked());
+    ASSERT(!cell.is_remembered());
+    cell.set_remembered(true);
+    m_remembered_cells.append(&cell);
 }
 
 void Heap::gather_roots(HashTable<Cell*>& roots)
@@ -120,7 +190,7 @@ void Heap::gather_roots(HashTable<Cell*>& roots)
 #endif
 }
 
-void Heap::gather_conservative_roots(HashTable<Cell*>& roots)
+__attribute__((no_sanitize_address)) void Heap::gather_conservative_roots(HashTable<Cell*>& roots)
 {
     FlatPtr dummy;
 
@@ -199,7 +269,7 @@ void Heap::gather_conservative_roots(HashTable<Cell*>& roots)
 Cell* Heap::cell_from_possible_pointer(FlatPtr pointer)
 {
     auto* possible_heap_block = HeapBlock::from_cell(reinterpret_cast<const Cell*>(pointer));
-    if (m_blocks.find([possible_heap_block](auto& block) { return block.ptr() == possible_heap_block; }) == m_blocks.end())
+    if (!m_blocks.contains(possible_heap_block))
         return nullptr;
     return possible_heap_block->cell_from_possible_pointer(pointer);
 }
@@ -216,11 +286,25 @@ public:
         dbg() << "  ! " << cell;
 #endif
         cell->set_marked(true);
-        cell->visit_children(*this);
+        ++m_marked_cell_count;
+        // Chains of cells (ropes, linked objects) can be arbitrarily long, so don't recurse into them here.
+        m_work_queue.append(cell);
     }
+
+    void mark_all_reachable_cells()
+    {
+        while (!m_work_queue.is_empty())
+            m_work_queue.take_last()->visit_children(*this);
+    }
+
+    size_t marked_cell_count() const { return m_marked_cell_count; }
+
+private:
+    size_t m_marked_cell_count { 0 };
+    Vector<Cell*> m_work_queue;
 };
 
-void Heap::mark_live_cells(const HashTable<Cell*>& roots)
+size_t Heap::mark_live_cells(const HashTable<Cell*>& roots, CollectionType collection_type)
 {
 #ifdef HEAP_DEBUG
     dbg() << "mark_live_cells:";
@@ -228,46 +312,31 @@ void Heap::mark_live_cells(const HashTable<Cell*>& roots)
     MarkingVisitor visitor;
     for (auto* root : roots)
         visitor.visit(root);
-}
 
-void Heap::sweep_dead_cells()
-{
-#ifdef HEAP_DEBUG
-    dbg() << "sweep_dead_cells:";
-#endif
-    Vector<HeapBlock*, 32> empty_blocks;
-
-    for (auto& block : m_blocks) {
-        bool block_has_live_cells = false;
-        block->for_each_cell([&](Cell* cell) {
-            if (cell->is_live()) {
-                if (!cell->is_marked()) {
-#ifdef HEAP_DEBUG
-                    dbg() << "  ~ " << cell;
-#endif
-                    block->deallocate(cell);
-                } else {
-                    cell->set_marked(false);
-                    block_has_live_cells = true;
-                }
-            }
-        });
-        if (!block_has_live_cells)
-            empty_blocks.append(block);
+    // Old cells are still marked from earlier collections, so the visitor won't look inside them.
+    // The ones that had references stored in them since then may be the only path to young cells.
+    if (collection_type == CollectionType::CollectYoungGeneration) {
+        for (auto* cell : m_remembered_cells)
+            cell->visit_children(visitor);
     }
 
-    for (auto* block : empty_blocks) {
-#ifdef HEAP_DEBUG
-        dbg() << " - Reclaim HeapBlock @ " << block << ": cell_size=" << block->cell_size();
-#endif
-        m_blocks.remove_first_matching([block](auto& entry) { return entry == block; });
-    }
+    visitor.mark_all_reachable_cells();
+    return visitor.marked_cell_count();
+}
+
+void Heap::did_create_block(Badge<CellAllocator>, HeapBlock& block)
+{
+    ASSERT(!m_blocks.contains(&block));
+    m_blocks.set(&block);
+}
 
+void Heap::will_destroy_block(Badge<CellAllocator>, HeapBlock& block)
+{
 #ifdef HEAP_DEBUG
-    for (auto& block : m_blocks) {
-        dbg() << " > Live HeapBlock @ " << block << ": cell_size=" << block->cell_size();
-    }
+    dbg() << " - Reclaim HeapBlock @ " << &block << ": cell_size=" << block.cell_size();
 #endif
+    ASSERT(m_blocks.contains(&block));
+    m_blocks.remove(&block);
 }
 
 void Heap::did_create_handle(Badge<HandleImpl>, HandleImpl& impl)
@@ -302,12 +371,16 @@ void Heap::defer_gc(Badge<DeferGC>)
 void Heap::undefer_gc(Badge<DeferGC>)
 {
     ASSERT(m_gc_deferrals > 0);
+    end_gc_deferral();
+}
+
+void Heap::end_gc_deferral()
+{
     --m_gc_deferrals;
 
-    if (!m_gc_deferrals) {
-        if (m_should_gc_when_deferral_ends)
-            collect_garbage();
+    if (!m_gc_deferrals && m_should_gc_when_deferral_ends) {
         m_should_gc_when_deferral_ends = false;
+        collect_garbage(exchange(m_deferred_collection_type, CollectionType::CollectYoungGeneration));
     }
 }
 
@@ -49,17 +49,37 @@ public:
     T* allocate(Args&&... args)
     {
         auto* memory = allocate_cell(sizeof(T));
+        // Constructors store references without going through the write barrier, so
+        // the cell must not be promoted to the old generation before it's done.
+        ++m_gc_deferrals;
         new (memory) T(forward<Args>(args)...);
+        end_gc_deferral();
         return static_cast<T*>(memory);
     }
 
     enum class CollectionType {
+        // Marks from the roots and sweeps the whole heap.
         CollectGarbage,
+        // Only marks and sweeps cells allocated since the last collection. Old cells are
+        // assumed to be live, and the remembered set stands in for their references.
+        CollectYoungGeneration,
         CollectEverything,
     };
 
     void collect_garbage(CollectionType = CollectionType::CollectGarbage);
 
+    struct Statistics {
+        u64 cells_allocated { 0 };
+        u64 collections { 0 };
+        u64 young_generation_collections { 0 };
+        u64 blocks_swept_lazily { 0 };
+        u64 last_collection_time_in_microseconds { 0 };
+        u64 total_collection_time_in_microseconds { 0 };
+    };
+
+    const Statistics& statistics() const { return m_statistics; }
+    size_t block_count() const { return m_blocks.size(); }
+
     Interpreter& interpreter() { return m_interpreter; }
 
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
@@ -74,13 +94,21 @@ public:
     void defer_gc(Badge<DeferGC>);
     void undefer_gc(Badge<DeferGC>);
 
+    void did_create_block(Badge<CellAllocator>, HeapBlock&);
+    void will_destroy_block(Badge<CellAllocator>, HeapBlock&);
+    void did_sweep_block_lazily(Badge<CellAllocator>) { ++m_statistics.blocks_swept_lazily; }
+
+    void remember_cell(Badge<Cell>, Cell&);
+
 private:
     Cell* allocate_cell(size_t);
+    CellAllocator& allocator_for_size(size_t);
+    CollectionType collection_type_for_allocation() const;
+    void end_gc_deferral();
 
     void gather_roots(HashTable<Cell*>&);
     void gather_conservative_roots(HashTable<Cell*>&);
-    void mark_live_cells(const HashTable<Cell*>& live_cells);
-    void sweep_dead_cells();
+    size_t mark_live_cells(const HashTable<Cell*>& live_cells, CollectionType);
 
     Cell* cell_from_possible_pointer(FlatPtr);
 
@@ -90,13 +118,23 @@ private:
     bool m_should_collect_on_every_allocation { false };
 
     Interpreter& m_interpreter;
-    Vector<NonnullOwnPtr<HeapBlock>> m_blocks;
+    Vector<NonnullOwnPtr<CellAllocator>> m_allocators;
+    HashTable<HeapBlock*> m_blocks;
     HashTable<HandleImpl*> m_handles;
 
     HashTable<MarkedValueList*> m_marked_value_lists;
 
+    Vector<Cell*> m_remembered_cells;
+
+    // Cells that survived a collection since the last full one, plus the ones that survived that.
+    size_t m_old_cell_count { 0 };
+    size_t m_old_cell_count_after_last_full_collection { 0 };
+
     size_t m_gc_deferrals { 0 };
     bool m_should_gc_when_deferral_ends { false };
+    CollectionType m_deferred_collection_type { CollectionType::CollectYoungGeneration };
+
+    Statistics m_statistics;
 };
 
 }
@@ -77,6 +77,7 @@ Cell* HeapBlock::allocate()
 {
     if (!m_freelist)
         return nullptr;
+    m_has_young_cells = true;
     return exchange(m_freelist, m_freelist->next);
 }
 
@@ -91,4 +92,28 @@ void HeapBlock::deallocate(Cell* cell)
     m_freelist = freelist_entry;
 }
 
+size_t HeapBlock::sweep()
+{
+    size_t live_cell_count = 0;
+    for_each_cell([&](Cell* cell) {
+        if (!cell->is_live())
+            return;
+        if (!cell->is_marked())
+            deallocate(cell);
+        else
+            ++live_cell_count;
+    });
+    m_needs_sweep = false;
+    m_has_young_cells = false;
+    return live_cell_count;
+}
+
+void HeapBlock::clear_marks()
+{
+    for_each_cell([&](Cell* cell) {
+        if (cell->is_live())
+            cell->set_marked(false);
+    });
+}
+
 }
@@ -45,6 +45,19 @@ public:
     Cell* allocate();
     void deallocate(Cell*);
 
+    // Set after a collection has marked the live cells, until this block has been swept.
+    bool needs_sweep() const { return m_needs_sweep; }
+    void set_needs_sweep(bool needs_sweep) { m_needs_sweep = needs_sweep; }
+
+    // Whether cells have been allocated here since the block was last swept.
+    bool has_young_cells() const { return m_has_young_cells; }
+
+    // Deallocates every live cell that wasn't marked. Marks are left alone, as the survivors are now old.
+    // Returns the number of cells that are still live afterwards.
+    size_t sweep();
+
+    void clear_marks();
+
     template<typename Callback>
     void for_each_cell(Callback callback)
     {
@@ -64,6 +77,8 @@ public:
         if (pointer < reinterpret_cast<FlatPtr>(m_storage))
             return nullptr;
         size_t cell_index = (pointer - reinterpret_cast<FlatPtr>(m_storage)) / m_cell_size;
+        if (cell_index >= cell_count())
+            return nullptr;
         return cell(cell_index);
     }
 
@@ -89,6 +104,8 @@ private:
     Heap& m_heap;
     size_t m_cell_size { 0 };
     FreelistEntry* m_freelist { nullptr };
+    bool m_needs_sweep { false };
+    bool m_has_young_cells { false };
     u8 m_storage[];
 };
 
@@ -27,6 +27,7 @@
 #include <AK/Badge.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/AST.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/GlobalObject.h>
@@ -71,12 +72,18 @@ Value Interpreter::run(const Statement& statement, ArgumentVector arguments, Sco
     enter_scope(block, move(arguments), scope_type);
 
     m_last_value = js_undefined();
-    for (auto& node : block.children()) {
-        m_last_value = node.execute(*this);
-        if (should_unwind()) {
-            if (should_unwind_until(ScopeType::Breakable, block.label()))
-                stop_unwind();
-            break;
+    if (m_bytecode_enabled) {
+        Bytecode::Interpreter(*this, block.bytecode()).run();
+        if (should_unwind_until(ScopeType::Breakable, block.label()))
+            stop_unwind();
+    } else {
+        for (auto& node : block.children()) {
+            m_last_value = node.execute(*this);
+            if (should_unwind()) {
+                if (should_unwind_until(ScopeType::Breakable, block.label()))
+                    stop_unwind();
+                break;
+            }
         }
     }
 
@@ -102,26 +109,19 @@ void Interpreter::enter_scope(const ScopeNode& scope_node, ArgumentVector argume
         return;
     }
 
-    HashMap<FlyString, Variable> scope_variables_with_declaration_kind;
-    scope_variables_with_declaration_kind.ensure_capacity(16);
-
-    for (auto& declaration : scope_node.variables()) {
-        for (auto& declarator : declaration.declarations()) {
-            if (scope_node.is_program())
+    if (scope_node.is_program()) {
+        for (auto& declaration : scope_node.variables()) {
+            for (auto& declarator : declaration.declarations())
                 global_object().put(declarator.id().string(), js_undefined());
-            else
-                scope_variables_with_declaration_kind.set(declarator.id().string(), { js_undefined(), declaration.declaration_kind() });
         }
     }
 
-    for (auto& argument : arguments) {
-        scope_variables_with_declaration_kind.set(argument.name, { argument.value, DeclarationKind::Var });
-    }
-
     bool pushed_lexical_environment = false;
 
-    if (!scope_variables_with_declaration_kind.is_empty()) {
-        auto* block_lexical_environment = heap().allocate<LexicalEnvironment>(move(scope_variables_with_declaration_kind), current_environment());
+    if (!scope_node.is_program() && !scope_node.environment_layout().is_empty()) {
+        auto* block_lexical_environment = heap().allocate<LexicalEnvironment>(scope_node.environment_layout(), current_environment());
+        for (auto& argument : arguments)
+            block_lexical_environment->set(argument.name, { argument.value, DeclarationKind::Var });
         m_call_stack.last().environment = block_lexical_environment;
         pushed_lexical_environment = true;
     }
@@ -176,6 +176,36 @@ Value Interpreter::get_variable(const FlyString& name)
     return global_object().get(name);
 }
 
+LexicalEnvironment& Interpreter::environment_for_binding(const Identifier& identifier)
+{
+    auto* environment = current_environment();
+    for (size_t i = 0; i < identifier.environment_hops(); ++i)
+        environment = environment->parent();
+    ASSERT(environment && environment->layout()->name_at(identifier.slot()) == identifier.string());
+    return *environment;
+}
+
+Value Interpreter::get_variable(const Identifier& identifier)
+{
+    if (!identifier.has_binding())
+        return get_variable(identifier.string());
+    return environment_for_binding(identifier).variable_at(identifier.slot()).value;
+}
+
+void Interpreter::set_variable(const Identifier& identifier, Value value, bool first_assignment)
+{
+    if (!identifier.has_binding()) {
+        set_variable(identifier.string(), value, first_assignment);
+        return;
+    }
+    auto& environment = environment_for_binding(identifier);
+    if (!first_assignment && environment.variable_at(identifier.slot()).declaration_kind == DeclarationKind::Const) {
+        throw_exception<TypeError>("Assignment to constant variable");
+        return;
+    }
+    environment.set_value_at(identifier.slot(), value);
+}
+
 Reference Interpreter::get_reference(const FlyString& name)
 {
     if (m_call_stack.size()) {
@@ -206,6 +236,13 @@ void Interpreter::gather_roots(Badge<Heap>, HashTable<Cell*>& roots)
         roots.set(call_frame.environment);
     }
 
+    for (auto* registers : m_register_windows) {
+        for (auto& value : *registers) {
+            if (value.is_cell())
+                roots.set(value.as_cell());
+        }
+    }
+
     SymbolObject::gather_symbol_roots(roots);
 }
 
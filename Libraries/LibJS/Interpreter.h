@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <AK/Badge.h>
 #include <AK/FlyString.h>
 #include <AK/HashMap.h>
 #include <AK/String.h>
@@ -34,6 +35,7 @@
 #include <LibJS/AST.h>
 #include <LibJS/Console.h>
 #include <LibJS/Forward.h>
+#include <LibJS/Heap/DeferGC.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Runtime/Exception.h>
 #include <LibJS/Runtime/LexicalEnvironment.h>
@@ -77,6 +79,8 @@ public:
     static NonnullOwnPtr<Interpreter> create(Args&&... args)
     {
         auto interpreter = adopt_own(*new Interpreter);
+        // initialize() fills in the global object's members without going through the write barrier.
+        DeferGC defer_gc(interpreter->heap());
         interpreter->m_global_object = interpreter->heap().allocate<GlobalObjectType>(forward<Args>(args)...);
         static_cast<GlobalObjectType*>(interpreter->m_global_object)->initialize();
         return interpreter;
@@ -104,10 +108,16 @@ public:
         return m_unwind_until == type && m_unwind_until_label == label;
     }
     bool should_unwind() const { return m_unwind_until != ScopeType::None; }
+    ScopeType unwind_until() const { return m_unwind_until; }
+    const FlyString& unwind_until_label() const { return m_unwind_until_label; }
 
     Value get_variable(const FlyString& name);
     void set_variable(const FlyString& name, Value, bool first_assignment = false);
 
+    // Identifiers the parser resolved to an environment slot skip the lookup by name.
+    Value get_variable(const Identifier&);
+    void set_variable(const Identifier&, Value, bool first_assignment = false);
+
     Reference get_reference(const FlyString& name);
 
     void gather_roots(Badge<Heap>, HashTable<Cell*>&);
@@ -176,6 +186,13 @@ public:
     }
 
     Value last_value() const { return m_last_value; }
+    void set_last_value(Badge<Bytecode::Interpreter>, Value value) { m_last_value = value; }
+
+    bool is_bytecode_enabled() const { return m_bytecode_enabled; }
+    void set_bytecode_enabled(bool enabled) { m_bytecode_enabled = enabled; }
+
+    void push_register_window(Badge<Bytecode::Interpreter>, Vector<Value>& registers) { m_register_windows.append(&registers); }
+    void pop_register_window(Badge<Bytecode::Interpreter>) { m_register_windows.take_last(); }
 
     Console& console() { return m_console; }
     const Console& console() const { return m_console; }
@@ -185,6 +202,8 @@ public:
 private:
     Interpreter();
 
+    LexicalEnvironment& environment_for_binding(const Identifier&);
+
     Heap m_heap;
 
     Value m_last_value;
@@ -200,6 +219,9 @@ private:
     FlyString m_unwind_until_label;
 
     Console m_console;
+
+    bool m_bytecode_enabled { false };
+    Vector<Vector<Value>*> m_register_windows;
 };
 
 }
@@ -25,125 +25,15 @@
  */
 
 #include "Lexer.h"
-#include <AK/HashMap.h>
-#include <AK/StringBuilder.h>
 #include <ctype.h>
 #include <stdio.h>
 
 namespace JS {
 
-HashMap<String, TokenType> Lexer::s_keywords;
-HashMap<String, TokenType> Lexer::s_three_char_tokens;
-HashMap<String, TokenType> Lexer::s_two_char_tokens;
-HashMap<char, TokenType> Lexer::s_single_char_tokens;
-
 Lexer::Lexer(StringView source)
     : m_source(source)
     , m_current_token(TokenType::Eof, StringView(nullptr), StringView(nullptr), 0, 0)
 {
-    if (s_keywords.is_empty()) {
-        s_keywords.set("await", TokenType::Await);
-        s_keywords.set("break", TokenType::Break);
-        s_keywords.set("case", TokenType::Case);
-        s_keywords.set("catch", TokenType::Catch);
-        s_keywords.set("class", TokenType::Class);
-        s_keywords.set("const", TokenType::Const);
-        s_keywords.set("continue", TokenType::Continue);
-        s_keywords.set("debugger", TokenType::Debugger);
-        s_keywords.set("default", TokenType::Default);
-        s_keywords.set("delete", TokenType::Delete);
-        s_keywords.set("do", TokenType::Do);
-        s_keywords.set("else", TokenType::Else);
-        s_keywords.set("enum", TokenType::Enum);
-        s_keywords.set("export", TokenType::Export);
-        s_keywords.set("extends", TokenType::Extends);
-        s_keywords.set("false", TokenType::BoolLiteral);
-        s_keywords.set("finally", TokenType::Finally);
-        s_keywords.set("for", TokenType::For);
-        s_keywords.set("function", TokenType::Function);
-        s_keywords.set("if", TokenType::If);
-        s_keywords.set("import", TokenType::Import);
-        s_keywords.set("in", TokenType::In);
-        s_keywords.set("instanceof", TokenType::Instanceof);
-        s_keywords.set("let", TokenType::Let);
-        s_keywords.set("new", TokenType::New);
-        s_keywords.set("null", TokenType::NullLiteral);
-        s_keywords.set("return", TokenType::Return);
-        s_keywords.set("super", TokenType::Super);
-        s_keywords.set("switch", TokenType::Switch);
-        s_keywords.set("this", TokenType::This);
-        s_keywords.set("throw", TokenType::Throw);
-        s_keywords.set("true", TokenType::BoolLiteral);
-        s_keywords.set("try", TokenType::Try);
-        s_keywords.set("typeof", TokenType::Typeof);
-        s_keywords.set("var", TokenType::Var);
-        s_keywords.set("void", TokenType::Void);
-        s_keywords.set("while", TokenType::While);
-        s_keywords.set("with", TokenType::With);
-        s_keywords.set("yield", TokenType::Yield);
-    }
-
-    if (s_three_char_tokens.is_empty()) {
-        s_three_char_tokens.set("===", TokenType::EqualsEqualsEquals);
-        s_three_char_tokens.set("!==", TokenType::ExclamationMarkEqualsEquals);
-        s_three_char_tokens.set("**=", TokenType::DoubleAsteriskEquals);
-        s_three_char_tokens.set("<<=", TokenType::ShiftLeftEquals);
-        s_three_char_tokens.set(">>=", TokenType::ShiftRightEquals);
-        s_three_char_tokens.set(">>>", TokenType::UnsignedShiftRight);
-        s_three_char_tokens.set("...", TokenType::TripleDot);
-    }
-
-    if (s_two_char_tokens.is_empty()) {
-        s_two_char_tokens.set("=>", TokenType::Arrow);
-        s_two_char_tokens.set("+=", TokenType::PlusEquals);
-        s_two_char_tokens.set("-=", TokenType::MinusEquals);
-        s_two_char_tokens.set("*=", TokenType::AsteriskEquals);
-        s_two_char_tokens.set("/=", TokenType::SlashEquals);
-        s_two_char_tokens.set("%=", TokenType::PercentEquals);
-        s_two_char_tokens.set("&=", TokenType::AmpersandEquals);
-        s_two_char_tokens.set("|=", TokenType::PipeEquals);
-        s_two_char_tokens.set("^=", TokenType::CaretEquals);
-        s_two_char_tokens.set("&&", TokenType::DoubleAmpersand);
-        s_two_char_tokens.set("||", TokenType::DoublePipe);
-        s_two_char_tokens.set("??", TokenType::DoubleQuestionMark);
-        s_two_char_tokens.set("**", TokenType::DoubleAsterisk);
-        s_two_char_tokens.set("==", TokenType::EqualsEquals);
-        s_two_char_tokens.set("<=", TokenType::LessThanEquals);
-        s_two_char_tokens.set(">=", TokenType::GreaterThanEquals);
-        s_two_char_tokens.set("!=", TokenType::ExclamationMarkEquals);
-        s_two_char_tokens.set("--", TokenType::MinusMinus);
-        s_two_char_tokens.set("++", TokenType::PlusPlus);
-        s_two_char_tokens.set("<<", TokenType::ShiftLeft);
-        s_two_char_tokens.set(">>", TokenType::ShiftRight);
-        s_two_char_tokens.set("?.", TokenType::QuestionMarkPeriod);
-    }
-
-    if (s_single_char_tokens.is_empty()) {
-        s_single_char_tokens.set('&', TokenType::Ampersand);
-        s_single_char_tokens.set('*', TokenType::Asterisk);
-        s_single_char_tokens.set('[', TokenType::BracketOpen);
-        s_single_char_tokens.set(']', TokenType::BracketClose);
-        s_single_char_tokens.set('^', TokenType::Caret);
-        s_single_char_tokens.set(':', TokenType::Colon);
-        s_single_char_tokens.set(',', TokenType::Comma);
-        s_single_char_tokens.set('{', TokenType::CurlyOpen);
-        s_single_char_tokens.set('}', TokenType::CurlyClose);
-        s_single_char_tokens.set('=', TokenType::Equals);
-        s_single_char_tokens.set('!', TokenType::ExclamationMark);
-        s_single_char_tokens.set('-', TokenType::Minus);
-        s_single_char_tokens.set('(', TokenType::ParenOpen);
-        s_single_char_tokens.set(')', TokenType::ParenClose);
-        s_single_char_tokens.set('%', TokenType::Percent);
-        s_single_char_tokens.set('.', TokenType::Period);
-        s_single_char_tokens.set('|', TokenType::Pipe);
-        s_single_char_tokens.set('+', TokenType::Plus);
-        s_single_char_tokens.set('?', TokenType::QuestionMark);
-        s_single_char_tokens.set(';', TokenType::Semicolon);
-        s_single_char_tokens.set('/', TokenType::Slash);
-        s_single_char_tokens.set('~', TokenType::Tilde);
-        s_single_char_tokens.set('<', TokenType::LessThan);
-        s_single_char_tokens.set('>', TokenType::GreaterThan);
-    }
     consume();
 }
 
@@ -181,34 +71,40 @@ void Lexer::consume_exponent()
 
 bool Lexer::match(char a, char b) const
 {
-    if (m_position >= m_source.length())
+    if (m_current_char != a || m_position >= m_source.length())
         return false;
 
-    return m_current_char == a
-        && m_source[m_position] == b;
+    return m_source[m_position] == b;
 }
 
 bool Lexer::match(char a, char b, char c) const
 {
-    if (m_position + 1 >= m_source.length())
+    if (m_current_char != a || m_position + 1 >= m_source.length())
         return false;
 
-    return m_current_char == a
-        && m_source[m_position] == b
+    return m_source[m_position] == b
         && m_source[m_position + 1] == c;
 }
 
 bool Lexer::match(char a, char b, char c, char d) const
 {
-    if (m_position + 2 >= m_source.length())
+    if (m_current_char != a || m_position + 2 >= m_source.length())
         return false;
 
-    return m_current_char == a
-        && m_source[m_position] == b
+    return m_source[m_position] == b
         && m_source[m_position + 1] == c
         && m_source[m_position + 2] == d;
 }
 
+// Returns the character offset characters after the current one, or 0 past the end of the source.
+// m_position is already one past the current character.
+char Lexer::peek(size_t offset) const
+{
+    if (m_position + offset - 1 >= m_source.length())
+        return 0;
+    return m_source[m_position + offset - 1];
+}
+
 bool Lexer::is_eof() const
 {
     return m_current_char == EOF;
@@ -261,6 +157,239 @@ bool Lexer::slash_means_division() const
            || type == TokenType::This;
 }
 
+// Classifies an identifier without building a String to look it up in a table: switching on the first
+// character leaves at most a handful of keywords to compare against.
+static TokenType keyword_or_identifier(const StringView& value)
+{
+    switch (value[0]) {
+    case 'a':
+        if (value == "await")
+            return TokenType::Await;
+        break;
+    case 'b':
+        if (value == "break")
+            return TokenType::Break;
+        break;
+    case 'c':
+        if (value == "case")
+            return TokenType::Case;
+        if (value == "catch")
+            return TokenType::Catch;
+        if (value == "class")
+            return TokenType::Class;
+        if (value == "const")
+            return TokenType::Const;
+        if (value == "continue")
+            return TokenType::Continue;
+        break;
+    case 'd':
+        if (value == "debugger")
+            return TokenType::Debugger;
+        if (value == "default")
+            return TokenType::Default;
+        if (value == "delete")
+            return TokenType::Delete;
+        if (value == "do")
+            return TokenType::Do;
+        break;
+    case 'e':
+        if (value == "else")
+            return TokenType::Else;
+        if (value == "enum")
+            return TokenType::Enum;
+        if (value == "export")
+            return TokenType::Export;
+        if (value == "extends")
+            return TokenType::Extends;
+        break;
+    case 'f':
+        if (value == "false")
+            return TokenType::BoolLiteral;
+        if (value == "finally")
+            return TokenType::Finally;
+        if (value == "for")
+            return TokenType::For;
+        if (value == "function")
+            return TokenType::Function;
+        break;
+    case 'i':
+        if (value == "if")
+            return TokenType::If;
+        if (value == "import")
+            return TokenType::Import;
+        if (value == "in")
+            return TokenType::In;
+        if (value == "instanceof")
+            return TokenType::Instanceof;
+        break;
+    case 'l':
+        if (value == "let")
+            return TokenType::Let;
+        break;
+    case 'n':
+        if (value == "new")
+            return TokenType::New;
+        if (value == "null")
+            return TokenType::NullLiteral;
+        break;
+    case 'r':
+        if (value == "return")
+            return TokenType::Return;
+        break;
+    case 's':
+        if (value == "super")
+            return TokenType::Super;
+        if (value == "switch")
+            return TokenType::Switch;
+        break;
+    case 't':
+        if (value == "this")
+            return TokenType::This;
+        if (value == "throw")
+            return TokenType::Throw;
+        if (value == "true")
+            return TokenType::BoolLiteral;
+        if (value == "try")
+            return TokenType::Try;
+        if (value == "typeof")
+            return TokenType::Typeof;
+        break;
+    case 'v':
+        if (value == "var")
+            return TokenType::Var;
+        if (value == "void")
+            return TokenType::Void;
+        break;
+    case 'w':
+        if (value == "while")
+            return TokenType::While;
+        if (value == "with")
+            return TokenType::With;
+        break;
+    case 'y':
+        if (value == "yield")
+            return TokenType::Yield;
+        break;
+    }
+    return TokenType::Identifier;
+}
+
+// Consumes the longest punctuator that starts at the current character.
+TokenType Lexer::consume_punctuator()
+{
+    auto consume_and_return = [this](size_t length, TokenType type) {
+        for (size_t i = 0; i < length; ++i)
+            consume();
+        return type;
+    };
+
+    auto second = peek(1);
+    switch (m_current_char) {
+    case '=':
+        if (second == '=')
+            return peek(2) == '=' ? consume_and_return(3, TokenType::EqualsEqualsEquals) : consume_and_return(2, TokenType::EqualsEquals);
+        if (second == '>')
+            return consume_and_return(2, TokenType::Arrow);
+        return consume_and_return(1, TokenType::Equals);
+    case '!':
+        if (second == '=')
+            return peek(2) == '=' ? consume_and_return(3, TokenType::ExclamationMarkEqualsEquals) : consume_and_return(2, TokenType::ExclamationMarkEquals);
+        return consume_and_return(1, TokenType::ExclamationMark);
+    case '*':
+        if (second == '*')
+            return peek(2) == '=' ? consume_and_return(3, TokenType::DoubleAsteriskEquals) : consume_and_return(2, TokenType::DoubleAsterisk);
+        if (second == '=')
+            return consume_and_return(2, TokenType::AsteriskEquals);
+        return consume_and_return(1, TokenType::Asterisk);
+    case '<':
+        if (second == '<')
+            return peek(2) == '=' ? consume_and_return(3, TokenType::ShiftLeftEquals) : consume_and_return(2, TokenType::ShiftLeft);
+        if (second == '=')
+            return consume_and_return(2, TokenType::LessThanEquals);
+        return consume_and_return(1, TokenType::LessThan);
+    case '>':
+        if (second == '>') {
+            auto third = peek(2);
+            if (third == '>')
+                return peek(3) == '=' ? consume_and_return(4, TokenType::UnsignedShiftRightEquals) : consume_and_return(3, TokenType::UnsignedShiftRight);
+            if (third == '=')
+                return consume_and_return(3, TokenType::ShiftRightEquals);
+            return consume_and_return(2, TokenType::ShiftRight);
+        }
+        if (second == '=')
+            return consume_and_return(2, TokenType::GreaterThanEquals);
+        return consume_and_return(1, TokenType::GreaterThan);
+    case '.':
+        if (second == '.' && peek(2) == '.')
+            return consume_and_return(3, TokenType::TripleDot);
+        return consume_and_return(1, TokenType::Period);
+    case '+':
+        if (second == '=')
+            return consume_and_return(2, TokenType::PlusEquals);
+        if (second == '+')
+            return consume_and_return(2, TokenType::PlusPlus);
+        return consume_and_return(1, TokenType::Plus);
+    case '-':
+        if (second == '=')
+            return consume_and_return(2, TokenType::MinusEquals);
+        if (second == '-')
+            return consume_and_return(2, TokenType::MinusMinus);
+        return consume_and_return(1, TokenType::Minus);
+    case '/':
+        if (second == '=')
+            return consume_and_return(2, TokenType::SlashEquals);
+        return consume_and_return(1, TokenType::Slash);
+    case '%':
+        if (second == '=')
+            return consume_and_return(2, TokenType::PercentEquals);
+        return consume_and_return(1, TokenType::Percent);
+    case '&':
+        if (second == '=')
+            return consume_and_return(2, TokenType::AmpersandEquals);
+        if (second == '&')
+            return consume_and_return(2, TokenType::DoubleAmpersand);
+        return consume_and_return(1, TokenType::Ampersand);
+    case '|':
+        if (second == '=')
+            return consume_and_return(2, TokenType::PipeEquals);
+        if (second == '|')
+            return consume_and_return(2, TokenType::DoublePipe);
+        return consume_and_return(1, TokenType::Pipe);
+    case '^':
+        if (second == '=')
+            return consume_and_return(2, TokenType::CaretEquals);
+        return consume_and_return(1, TokenType::Caret);
+    case '?':
+        if (second == '?')
+            return consume_and_return(2, TokenType::DoubleQuestionMark);
+        if (second == '.')
+            return consume_and_return(2, TokenType::QuestionMarkPeriod);
+        return consume_and_return(1, TokenType::QuestionMark);
+    case '[':
+        return consume_and_return(1, TokenType::BracketOpen);
+    case ']':
+        return consume_and_return(1, TokenType::BracketClose);
+    case '{':
+        return consume_and_return(1, TokenType::CurlyOpen);
+    case '}':
+        return consume_and_return(1, TokenType::CurlyClose);
+    case '(':
+        return consume_and_return(1, TokenType::ParenOpen);
+    case ')':
+        return consume_and_return(1, TokenType::ParenClose);
+    case ':':
+        return consume_and_return(1, TokenType::Colon);
+    case ';':
+        return consume_and_return(1, TokenType::Semicolon);
+    case ',':
+        return consume_and_return(1, TokenType::Comma);
+    case '~':
+        return consume_and_return(1, TokenType::Tilde);
+    default:
+        return consume_and_return(1, TokenType::Invalid);
+    }
+}
+
 Token Lexer::next()
 {
     size_t trivia_start = m_position;
@@ -342,12 +471,7 @@ Token Lexer::next()
         } while (is_identifier_middle());
 
         StringView value = m_source.substring_view(value_start - 1, m_position - value_start);
-        auto it = s_keywords.find(value);
-        if (it == s_keywords.end()) {
-            token_type = TokenType::Identifier;
-        } else {
-            token_type = it->value;
-        }
+        token_type = keyword_or_identifier(value);
     } else if (is_numeric_literal_start()) {
         token_type = TokenType::NumericLiteral;
         if (m_current_char == '0') {
@@ -444,59 +568,7 @@ Token Lexer::next()
     } else if (m_current_char == EOF) {
         token_type = TokenType::Eof;
     } else {
-        // There is only one four-char operator: >>>=
-        bool found_four_char_token = false;
-        if (match('>', '>', '>', '=')) {
-            found_four_char_token = true;
-            consume();
-            consume();
-            consume();
-            consume();
-            token_type = TokenType::UnsignedShiftRightEquals;
-        }
-
-        bool found_three_char_token = false;
-        if (!found_four_char_token && m_position + 1 < m_source.length()) {
-            char second_char = m_source[m_position];
-            char third_char = m_source[m_position + 1];
-            char three_chars[] { (char)m_current_char, second_char, third_char, 0 };
-            auto it = s_three_char_tokens.find(three_chars);
-            if (it != s_three_char_tokens.end()) {
-                found_three_char_token = true;
-                consume();
-                consume();
-                consume();
-                token_type = it->value;
-            }
-        }
-
-        bool found_two_char_token = false;
-        if (!found_four_char_token && !found_three_char_token && m_position < m_source.length()) {
-            char second_char = m_source[m_position];
-            char two_chars[] { (char)m_current_char, second_char, 0 };
-            auto it = s_two_char_tokens.find(two_chars);
-            if (it != s_two_char_tokens.end()) {
-                found_two_char_token = true;
-                consume();
-                consume();
-                token_type = it->value;
-            }
-        }
-
-        bool found_one_char_token = false;
-        if (!found_four_char_token && !found_three_char_token && !found_two_char_token) {
-            auto it = s_single_char_tokens.find(m_current_char);
-            if (it != s_single_char_tokens.end()) {
-                found_one_char_token = true;
-                consume();
-                token_type = it->value;
-            }
-        }
-
-        if (!found_four_char_token && !found_three_char_token && !found_two_char_token && !found_one_char_token) {
-            consume();
-            token_type = TokenType::Invalid;
-        }
+        token_type = consume_punctuator();
     }
 
     if (!m_template_states.is_empty() && m_template_states.last().in_expr) {
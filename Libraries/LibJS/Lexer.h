@@ -28,9 +28,9 @@
 
 #include "Token.h"
 
-#include <AK/HashMap.h>
 #include <AK/String.h>
 #include <AK/StringView.h>
+#include <AK/Vector.h>
 
 namespace JS {
 
@@ -54,6 +54,8 @@ private:
     bool match(char, char, char) const;
     bool match(char, char, char, char) const;
     bool slash_means_division() const;
+    char peek(size_t offset) const;
+    TokenType consume_punctuator();
 
     StringView m_source;
     size_t m_position { 0 };
@@ -68,12 +70,9 @@ private:
         bool in_expr;
         u8 open_bracket_count;
     };
-    Vector<TemplateState> m_template_states;
-
-    static HashMap<String, TokenType> s_keywords;
-    static HashMap<String, TokenType> s_three_char_tokens;
-    static HashMap<String, TokenType> s_two_char_tokens;
-    static HashMap<char, TokenType> s_single_char_tokens;
+    // The parser copies the whole lexer to save its position for lookahead, so this shouldn't allocate
+    // unless templates are nested more deeply than anyone writes them.
+    Vector<TemplateState, 4> m_template_states;
 };
 
 }
@@ -26,9 +26,9 @@
  */
 
 #include "Parser.h"
-#include <AK/HashMap.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StdLibExtras.h>
+#include <LibJS/Runtime/LexicalEnvironment.h>
 
 namespace JS {
 
@@ -66,7 +66,20 @@ public:
     unsigned m_mask { 0 };
 };
 
-static HashMap<TokenType, int> g_operator_precedence;
+// Mirrors what ScriptFunction::call() expects: the parameters followed by everything the body declares.
+// All of them are treated as var bindings, since for..in/of re-assigns its (possibly const) declaration.
+static NonnullRefPtr<EnvironmentLayout> function_environment_layout(const Vector<FunctionNode::Parameter>& parameters, const ScopeNode& body)
+{
+    auto layout = EnvironmentLayout::create();
+    for (auto& parameter : parameters)
+        layout->add(parameter.name, DeclarationKind::Var);
+    for (auto& declaration : body.variables()) {
+        for (auto& declarator : declaration.declarations())
+            layout->add(declarator.id().string(), DeclarationKind::Var);
+    }
+    return layout;
+}
+
 Parser::ParserState::ParserState(Lexer lexer)
     : m_lexer(move(lexer))
     , m_current_token(m_lexer.next())
@@ -76,94 +89,91 @@ Parser::ParserState::ParserState(Lexer lexer)
 Parser::Parser(Lexer lexer)
     : m_parser_state(move(lexer))
 {
-    if (g_operator_precedence.is_empty()) {
-        // https://developer.mozilla.org/en-US/docs/Web/JavaScript/Reference/Operators/Operator_Precedence
-        g_operator_precedence.set(TokenType::Period, 20);
-        g_operator_precedence.set(TokenType::BracketOpen, 20);
-        g_operator_precedence.set(TokenType::ParenOpen, 20);
-        g_operator_precedence.set(TokenType::QuestionMarkPeriod, 20);
-
-        g_operator_precedence.set(TokenType::New, 19);
-
-        g_operator_precedence.set(TokenType::PlusPlus, 18);
-        g_operator_precedence.set(TokenType::MinusMinus, 18);
-
-        g_operator_precedence.set(TokenType::ExclamationMark, 17);
-        g_operator_precedence.set(TokenType::Tilde, 17);
-        g_operator_precedence.set(TokenType::Typeof, 17);
-        g_operator_precedence.set(TokenType::Void, 17);
-        g_operator_precedence.set(TokenType::Delete, 17);
-        g_operator_precedence.set(TokenType::Await, 17);
-
-        g_operator_precedence.set(TokenType::DoubleAsterisk, 16);
-
-        g_operator_precedence.set(TokenType::Asterisk, 15);
-        g_operator_precedence.set(TokenType::Slash, 15);
-        g_operator_precedence.set(TokenType::Percent, 15);
-
-        g_operator_precedence.set(TokenType::Plus, 14);
-        g_operator_precedence.set(TokenType::Minus, 14);
-
-        g_operator_precedence.set(TokenType::ShiftLeft, 13);
-        g_operator_precedence.set(TokenType::ShiftRight, 13);
-        g_operator_precedence.set(TokenType::UnsignedShiftRight, 13);
-
-        g_operator_precedence.set(TokenType::LessThan, 12);
-        g_operator_precedence.set(TokenType::LessThanEquals, 12);
-        g_operator_precedence.set(TokenType::GreaterThan, 12);
-        g_operator_precedence.set(TokenType::GreaterThanEquals, 12);
-        g_operator_precedence.set(TokenType::In, 12);
-        g_operator_precedence.set(TokenType::Instanceof, 12);
-
-        g_operator_precedence.set(TokenType::EqualsEquals, 11);
-        g_operator_precedence.set(TokenType::ExclamationMarkEquals, 11);
-        g_operator_precedence.set(TokenType::EqualsEqualsEquals, 11);
-        g_operator_precedence.set(TokenType::ExclamationMarkEqualsEquals, 11);
-
-        g_operator_precedence.set(TokenType::Ampersand, 10);
-
-        g_operator_precedence.set(TokenType::Caret, 9);
-
-        g_operator_precedence.set(TokenType::Pipe, 8);
-
-        g_operator_precedence.set(TokenType::DoubleQuestionMark, 7);
-
-        g_operator_precedence.set(TokenType::DoubleAmpersand, 6);
-
-        g_operator_precedence.set(TokenType::DoublePipe, 5);
-
-        g_operator_precedence.set(TokenType::QuestionMark, 4);
-
-        g_operator_precedence.set(TokenType::Equals, 3);
-        g_operator_precedence.set(TokenType::PlusEquals, 3);
-        g_operator_precedence.set(TokenType::MinusEquals, 3);
-        g_operator_precedence.set(TokenType::DoubleAsteriskEquals, 3);
-        g_operator_precedence.set(TokenType::AsteriskEquals, 3);
-        g_operator_precedence.set(TokenType::SlashEquals, 3);
-        g_operator_precedence.set(TokenType::PercentEquals, 3);
-        g_operator_precedence.set(TokenType::ShiftLeftEquals, 3);
-        g_operator_precedence.set(TokenType::ShiftRightEquals, 3);
-        g_operator_precedence.set(TokenType::UnsignedShiftRightEquals, 3);
-        g_operator_precedence.set(TokenType::AmpersandEquals, 3);
-        g_operator_precedence.set(TokenType::PipeEquals, 3);
-        g_operator_precedence.set(TokenType::CaretEquals, 3);
-
-        g_operator_precedence.set(TokenType::Yield, 2);
-
-        g_operator_precedence.set(TokenType::Comma, 1);
-    }
 }
 
 int Parser::operator_precedence(TokenType type) const
 {
-    auto it = g_operator_precedence.find(type);
-    if (it == g_operator_precedence.end()) {
+    // https://developer.mozilla.org/en-US/docs/Web/JavaScript/Reference/Operators/Operator_Precedence
+    switch (type) {
+    case TokenType::Period:
+    case TokenType::BracketOpen:
+    case TokenType::ParenOpen:
+    case TokenType::QuestionMarkPeriod:
+        return 20;
+    case TokenType::New:
+        return 19;
+    case TokenType::PlusPlus:
+    case TokenType::MinusMinus:
+        return 18;
+    case TokenType::ExclamationMark:
+    case TokenType::Tilde:
+    case TokenType::Typeof:
+    case TokenType::Void:
+    case TokenType::Delete:
+    case TokenType::Await:
+        return 17;
+    case TokenType::DoubleAsterisk:
+        return 16;
+    case TokenType::Asterisk:
+    case TokenType::Slash:
+    case TokenType::Percent:
+        return 15;
+    case TokenType::Plus:
+    case TokenType::Minus:
+        return 14;
+    case TokenType::ShiftLeft:
+    case TokenType::ShiftRight:
+    case TokenType::UnsignedShiftRight:
+        return 13;
+    case TokenType::LessThan:
+    case TokenType::LessThanEquals:
+    case TokenType::GreaterThan:
+    case TokenType::GreaterThanEquals:
+    case TokenType::In:
+    case TokenType::Instanceof:
+        return 12;
+    case TokenType::EqualsEquals:
+    case TokenType::ExclamationMarkEquals:
+    case TokenType::EqualsEqualsEquals:
+    case TokenType::ExclamationMarkEqualsEquals:
+        return 11;
+    case TokenType::Ampersand:
+        return 10;
+    case TokenType::Caret:
+        return 9;
+    case TokenType::Pipe:
+        return 8;
+    case TokenType::DoubleQuestionMark:
+        return 7;
+    case TokenType::DoubleAmpersand:
+        return 6;
+    case TokenType::DoublePipe:
+        return 5;
+    case TokenType::QuestionMark:
+        return 4;
+    case TokenType::Equals:
+    case TokenType::PlusEquals:
+    case TokenType::MinusEquals:
+    case TokenType::DoubleAsteriskEquals:
+    case TokenType::AsteriskEquals:
+    case TokenType::SlashEquals:
+    case TokenType::PercentEquals:
+    case TokenType::ShiftLeftEquals:
+    case TokenType::ShiftRightEquals:
+    case TokenType::UnsignedShiftRightEquals:
+    case TokenType::AmpersandEquals:
+    case TokenType::PipeEquals:
+    case TokenType::CaretEquals:
+        return 3;
+    case TokenType::Yield:
+        return 2;
+    case TokenType::Comma:
+        return 1;
+    default:
         fprintf(stderr, "Internal Error: No precedence for operator %s\n", Token::name(type));
         ASSERT_NOT_REACHED();
         return -1;
     }
-
-    return it->value;
 }
 
 Associativity Parser::operator_associativity(TokenType type) const
@@ -210,6 +220,7 @@ Associativity Parser::operator_associativity(TokenType type) const
 NonnullRefPtr<Program> Parser::parse_program()
 {
     ScopePusher scope(*this, ScopePusher::Var | ScopePusher::Let | ScopePusher::Function);
+    push_identifier_scope();
     auto program = adopt(*new Program);
 
     bool first = true;
@@ -237,6 +248,8 @@ NonnullRefPtr<Program> Parser::parse_program()
     } else {
         syntax_error("Unclosed scope");
     }
+    // Top-level declarations live on the global object, so whatever is still unresolved is looked up by name.
+    pop_identifier_scope(nullptr);
     return program;
 }
 
@@ -303,6 +316,7 @@ RefPtr<FunctionExpression> Parser::try_parse_arrow_function_expression(bool expe
 {
     save_state();
     m_parser_state.m_var_scopes.append(NonnullRefPtrVector<VariableDeclaration>());
+    push_identifier_scope();
 
     ArmedScopeGuard state_rollback_guard = [&] {
         m_parser_state.m_var_scopes.take_last();
@@ -373,7 +387,7 @@ RefPtr<FunctionExpression> Parser::try_parse_arrow_function_expression(bool expe
     auto function_body_result = [this]() -> RefPtr<BlockStatement> {
         if (match(TokenType::CurlyOpen)) {
             // Parse a function body with statements
-            return parse_block_statement();
+            return parse_body_block_statement();
         }
         if (match_expression()) {
             // Parse a function body which returns a single expression
@@ -384,7 +398,7 @@ RefPtr<FunctionExpression> Parser::try_parse_arrow_function_expression(bool expe
             // with a "body" property.
             auto return_expression = parse_expression(2);
             auto return_block = create_ast_node<BlockStatement>();
-            return_block->append<ReturnStatement>(move(return_expression));
+            return_block->append(create_ast_node<ReturnStatement>(move(return_expression)));
             return return_block;
         }
         // Invalid arrow function body
@@ -393,7 +407,11 @@ RefPtr<FunctionExpression> Parser::try_parse_arrow_function_expression(bool expe
 
     if (!function_body_result.is_null()) {
         state_rollback_guard.disarm();
+        discard_saved_state();
         auto body = function_body_result.release_nonnull();
+        auto layout = function_environment_layout(parameters, body);
+        pop_identifier_scope(layout.ptr());
+        body->set_environment_layout(move(layout));
         return create_ast_node<FunctionExpression>("", move(body), move(parameters), function_length, m_parser_state.m_var_scopes.take_last(), true);
     }
 
@@ -418,6 +436,7 @@ RefPtr<Statement> Parser::try_parse_labelled_statement()
 
     statement->set_label(identifier);
     state_rollback_guard.disarm();
+    discard_saved_state();
     return statement;
 }
 
@@ -447,7 +466,7 @@ NonnullRefPtr<Expression> Parser::parse_primary_expression()
         if (!arrow_function_result.is_null()) {
             return arrow_function_result.release_nonnull();
         }
-        return create_ast_node<Identifier>(consume().value());
+        return create_identifier_reference(consume().value());
     }
     case TokenType::NumericLiteral:
         return create_ast_node<NumericLiteral>(consume().double_value());
@@ -603,7 +622,7 @@ NonnullRefPtr<ObjectExpression> Parser::parse_object_expression()
                 property_name = parse_property_key();
             } else {
                 property_name = create_ast_node<StringLiteral>(identifier);
-                property_value = create_ast_node<Identifier>(identifier);
+                property_value = create_identifier_reference(identifier);
             }
         } else {
             property_name = parse_property_key();
@@ -730,7 +749,7 @@ NonnullRefPtr<TemplateLiteral> Parser::parse_template_literal(bool is_tagged)
     NonnullRefPtrVector<Expression> expressions;
     NonnullRefPtrVector<Expression> raw_strings;
 
-    auto append_empty_string = [&expressions, &raw_strings, is_tagged]() {
+    auto append_empty_string = [this, &expressions, &raw_strings, is_tagged]() {
         auto string_literal = create_ast_node<StringLiteral>("");
         expressions.append(string_literal);
         if (is_tagged)
@@ -779,7 +798,7 @@ NonnullRefPtr<TemplateLiteral> Parser::parse_template_literal(bool is_tagged)
     return create_ast_node<TemplateLiteral>(expressions);
 }
 
-NonnullRefPtr<Expression> Parser::parse_expression(int min_precedence, Associativity associativity, Vector<TokenType> forbidden)
+NonnullRefPtr<Expression> Parser::parse_expression(int min_precedence, Associativity associativity, const Vector<TokenType>& forbidden)
 {
     auto expression = parse_primary_expression();
     while (match(TokenType::TemplateLiteralStart)) {
@@ -1001,7 +1020,7 @@ NonnullRefPtr<NewExpression> Parser::parse_new_expression()
 {
     consume(TokenType::New);
 
-    auto callee = parse_expression(g_operator_precedence.get(TokenType::New).value(), Associativity::Right, { TokenType::ParenOpen });
+    auto callee = parse_expression(operator_precedence(TokenType::New), Associativity::Right, { TokenType::ParenOpen });
 
     Vector<CallExpression::Argument> arguments;
 
@@ -1043,6 +1062,16 @@ NonnullRefPtr<ReturnStatement> Parser::parse_return_statement()
 }
 
 NonnullRefPtr<BlockStatement> Parser::parse_block_statement()
+{
+    push_identifier_scope();
+    auto block = parse_body_block_statement();
+    pop_identifier_scope(&block->environment_layout());
+    return block;
+}
+
+// Function and catch bodies are parsed without an identifier scope of their own: their
+// declarations end up in the environment set up by the caller, who resolves them.
+NonnullRefPtr<BlockStatement> Parser::parse_body_block_statement()
 {
     ScopePusher scope(*this, ScopePusher::Let);
     auto block = create_ast_node<BlockStatement>();
@@ -1088,6 +1117,7 @@ template<typename FunctionNodeType>
 NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(bool check_for_function_and_name)
 {
     ScopePusher scope(*this, ScopePusher::Var | ScopePusher::Function);
+    push_identifier_scope();
 
     if (check_for_function_and_name)
         consume(TokenType::Function);
@@ -1129,9 +1159,18 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(bool check_for_funct
     if (function_length == -1)
         function_length = parameters.size();
 
-    auto body = parse_block_statement();
+    auto body = parse_body_block_statement();
     body->add_variables(m_parser_state.m_var_scopes.last());
     body->add_functions(m_parser_state.m_function_scopes.last());
+
+    // Function declarations are instantiated when their enclosing scope is entered, which may be
+    // before that scope's own environment exists, so their free variables can't be resolved statically.
+    auto layout = function_environment_layout(parameters, body);
+    if (IsSame<FunctionNodeType, FunctionDeclaration>::value)
+        pop_identifier_scope(layout.ptr(), UnresolvedIdentifiers::LookUpByName);
+    else
+        pop_identifier_scope(layout.ptr());
+    body->set_environment_layout(move(layout));
     return create_ast_node<FunctionNodeType>(name, move(body), move(parameters), function_length, NonnullRefPtrVector<VariableDeclaration>());
 }
 
@@ -1164,7 +1203,7 @@ NonnullRefPtr<VariableDeclaration> Parser::parse_variable_declaration(bool with_
             consume();
             init = parse_expression(2);
         }
-        declarations.append(create_ast_node<VariableDeclarator>(create_ast_node<Identifier>(move(id)), move(init)));
+        declarations.append(create_ast_node<VariableDeclarator>(create_identifier_reference(move(id)), move(init)));
         if (match(TokenType::Comma)) {
             consume();
             continue;
@@ -1332,7 +1371,12 @@ NonnullRefPtr<CatchClause> Parser::parse_catch_clause()
         consume(TokenType::ParenClose);
     }
 
-    auto body = parse_block_statement();
+    push_identifier_scope();
+    auto body = parse_body_block_statement();
+    auto layout = body->create_environment_layout();
+    layout->add(parameter, DeclarationKind::Var);
+    pop_identifier_scope(layout.ptr());
+    body->set_environment_layout(move(layout));
     return create_ast_node<CatchClause>(parameter, move(body));
 }
 
@@ -1371,11 +1415,16 @@ NonnullRefPtr<Statement> Parser::parse_for_statement()
         } else if (match_variable_declaration()) {
             if (!match(TokenType::Var)) {
                 m_parser_state.m_let_scopes.append(NonnullRefPtrVector<VariableDeclaration>());
+                push_identifier_scope();
                 in_scope = true;
             }
             init = parse_variable_declaration(false);
-            if (match_for_in_of())
+            if (match_for_in_of()) {
+                // for..in/of doesn't create an environment for its declaration.
+                if (in_scope)
+                    pop_identifier_scope(nullptr);
                 return parse_for_in_of_statement(*init);
+            }
         } else {
             syntax_error("Unexpected token in for loop");
         }
@@ -1398,6 +1447,12 @@ NonnullRefPtr<Statement> Parser::parse_for_statement()
 
     if (in_scope) {
         m_parser_state.m_let_scopes.take_last();
+        // ForStatement::execute() wraps the loop in a block declaring just the init declaration.
+        auto layout = EnvironmentLayout::create();
+        auto& declaration = static_cast<const VariableDeclaration&>(*init);
+        for (auto& declarator : declaration.declarations())
+            layout->add(declarator.id().string(), declaration.declaration_kind());
+        pop_identifier_scope(layout.ptr());
     }
 
     return create_ast_node<ForStatement>(move(init), move(test), move(update), move(body));
@@ -1483,7 +1538,7 @@ bool Parser::match_unary_prefixed_expression() const
         || type == TokenType::Delete;
 }
 
-bool Parser::match_secondary_expression(Vector<TokenType> forbidden) const
+bool Parser::match_secondary_expression(const Vector<TokenType>& forbidden) const
 {
     auto type = m_parser_state.m_current_token.type();
     if (forbidden.contains_slow(type))
@@ -1619,15 +1674,93 @@ void Parser::syntax_error(const String& message, size_t line, size_t column)
     m_parser_state.m_errors.append({ message, line, column });
 }
 
+NonnullRefPtr<Identifier> Parser::create_identifier_reference(const FlyString& name)
+{
+    auto identifier = create_ast_node<Identifier>(name);
+    if (!m_identifier_scopes.is_empty())
+        m_identifier_scopes.last().append(IdentifierReference { identifier });
+    return identifier;
+}
+
+void Parser::push_identifier_scope()
+{
+    m_identifier_scopes.append(Vector<IdentifierReference>());
+}
+
+void Parser::pop_identifier_scope(const EnvironmentLayout* layout, UnresolvedIdentifiers unresolved_identifiers)
+{
+    // Scopes that don't declare anything don't get an environment at runtime, and don't count as a hop.
+    bool has_environment = layout && !layout->is_empty();
+    auto references = m_identifier_scopes.take_last();
+    for (auto& reference : references) {
+        if (has_environment) {
+            auto slot = layout->slot_of(reference.identifier->string());
+            if (slot.has_value()) {
+                reference.identifier->set_binding(reference.environment_hops, slot.value());
+                continue;
+            }
+            ++reference.environment_hops;
+        }
+        if (unresolved_identifiers == UnresolvedIdentifiers::LookUpByName || m_identifier_scopes.is_empty())
+            continue;
+        m_identifier_scopes.last().append(move(reference));
+    }
+}
+
+template<typename ScopeStack>
+static size_t innermost_scope_size(const ScopeStack& scopes)
+{
+    return scopes.is_empty() ? 0 : scopes.last().size();
+}
+
+template<typename ScopeStack>
+static void restore_innermost_scope(ScopeStack& scopes, size_t depth, size_t size)
+{
+    ASSERT(scopes.size() == depth);
+    if (!scopes.is_empty())
+        scopes.last().shrink(size);
+}
+
 void Parser::save_state()
 {
-    m_saved_state.append(m_parser_state);
+    m_saved_state.append({
+        m_parser_state.m_lexer,
+        m_parser_state.m_current_token,
+        m_parser_state.m_errors.size(),
+        m_parser_state.m_var_scopes.size(),
+        innermost_scope_size(m_parser_state.m_var_scopes),
+        m_parser_state.m_let_scopes.size(),
+        innermost_scope_size(m_parser_state.m_let_scopes),
+        m_parser_state.m_function_scopes.size(),
+        innermost_scope_size(m_parser_state.m_function_scopes),
+        m_identifier_scopes.size(),
+        innermost_scope_size(m_identifier_scopes),
+        m_parser_state.m_use_strict_directive,
+        m_parser_state.m_strict_mode,
+    });
 }
 
 void Parser::load_state()
 {
     ASSERT(!m_saved_state.is_empty());
-    m_parser_state = m_saved_state.take_last();
+    auto saved_state = m_saved_state.take_last();
+    m_parser_state.m_lexer = move(saved_state.m_lexer);
+    m_parser_state.m_current_token = saved_state.m_current_token;
+    m_parser_state.m_errors.shrink(saved_state.m_error_count);
+    restore_innermost_scope(m_parser_state.m_var_scopes, saved_state.m_var_scope_depth, saved_state.m_var_count);
+    restore_innermost_scope(m_parser_state.m_let_scopes, saved_state.m_let_scope_depth, saved_state.m_let_count);
+    restore_innermost_scope(m_parser_state.m_function_scopes, saved_state.m_function_scope_depth, saved_state.m_function_count);
+    // Arrow functions push their identifier scope before they know whether they are one.
+    m_identifier_scopes.shrink(saved_state.m_identifier_scope_depth);
+    restore_innermost_scope(m_identifier_scopes, saved_state.m_identifier_scope_depth, saved_state.m_identifier_count);
+    m_parser_state.m_use_strict_directive = saved_state.m_use_strict_directive;
+    m_parser_state.m_strict_mode = saved_state.m_strict_mode;
+}
+
+void Parser::discard_saved_state()
+{
+    ASSERT(!m_saved_state.is_empty());
+    m_saved_state.take_last();
 }
 
 }
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <AK/Arena.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/AST.h>
@@ -67,7 +68,7 @@ public:
     NonnullRefPtr<DebuggerStatement> parse_debugger_statement();
     NonnullRefPtr<ConditionalExpression> parse_conditional_expression(NonnullRefPtr<Expression> test);
 
-    NonnullRefPtr<Expression> parse_expression(int min_precedence, Associativity associate = Associativity::Right, Vector<TokenType> forbidden = {});
+    NonnullRefPtr<Expression> parse_expression(int min_precedence, Associativity associate = Associativity::Right, const Vector<TokenType>& forbidden = {});
     NonnullRefPtr<Expression> parse_primary_expression();
     NonnullRefPtr<Expression> parse_unary_prefixed_expression();
     NonnullRefPtr<RegExpLiteral> parse_regexp_literal();
@@ -118,11 +119,17 @@ public:
 private:
     friend class ScopePusher;
 
+    template<typename T, typename... Args>
+    NonnullRefPtr<T> create_ast_node(Args&&... args)
+    {
+        return adopt(*new (m_node_arena) T(forward<Args>(args)...));
+    }
+
     int operator_precedence(TokenType) const;
     Associativity operator_associativity(TokenType) const;
     bool match_expression() const;
     bool match_unary_prefixed_expression() const;
-    bool match_secondary_expression(Vector<TokenType> forbidden = {}) const;
+    bool match_secondary_expression(const Vector<TokenType>& forbidden = {}) const;
     bool match_statement() const;
     bool match_variable_declaration() const;
     bool match_identifier_name() const;
@@ -135,6 +142,19 @@ private:
     void consume_or_insert_semicolon();
     void save_state();
     void load_state();
+    void discard_saved_state();
+
+    NonnullRefPtr<BlockStatement> parse_body_block_statement();
+
+    // Identifier references are collected per scope while parsing and resolved to environment slots
+    // once the declaring scope is complete (declarations are hoisted, so that's the earliest point).
+    enum class UnresolvedIdentifiers {
+        PassToEnclosingScope,
+        LookUpByName,
+    };
+    NonnullRefPtr<Identifier> create_identifier_reference(const FlyString& name);
+    void push_identifier_scope();
+    void pop_identifier_scope(const EnvironmentLayout*, UnresolvedIdentifiers = UnresolvedIdentifiers::PassToEnclosingScope);
 
     enum class UseStrictDirectiveState {
         None,
@@ -155,7 +175,33 @@ private:
         explicit ParserState(Lexer);
     };
 
+    // What load_state() needs to rewind a failed speculative parse. Those only ever add errors and
+    // declarations to scopes they didn't push themselves, so remembering how many there were is
+    // enough to undo them, without copying the errors and scopes every time we look ahead.
+    struct SavedState {
+        Lexer m_lexer;
+        Token m_current_token;
+        size_t m_error_count { 0 };
+        size_t m_var_scope_depth { 0 };
+        size_t m_var_count { 0 };
+        size_t m_let_scope_depth { 0 };
+        size_t m_let_count { 0 };
+        size_t m_function_scope_depth { 0 };
+        size_t m_function_count { 0 };
+        size_t m_identifier_scope_depth { 0 };
+        size_t m_identifier_count { 0 };
+        UseStrictDirectiveState m_use_strict_directive { UseStrictDirectiveState::None };
+        bool m_strict_mode { false };
+    };
+
+    struct IdentifierReference {
+        NonnullRefPtr<Identifier> identifier;
+        size_t environment_hops { 0 };
+    };
+
     ParserState m_parser_state;
-    Vector<ParserState> m_saved_state;
+    Vector<SavedState> m_saved_state;
+    Vector<Vector<IdentifierReference>> m_identifier_scopes;
+    Arena m_node_arena;
 };
 }
@@ -24,60 +24,50 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <AK/Function.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/ArrayBuffer.h>
+#include <LibJS/Runtime/ArrayBufferConstructor.h>
 #include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/GlobalObject.h>
-#include <LibJS/Runtime/Uint8ClampedArray.h>
 
 namespace JS {
 
-Uint8ClampedArray* Uint8ClampedArray::create(GlobalObject& global_object, u32 length)
+ArrayBufferConstructor::ArrayBufferConstructor()
+    : NativeFunction("ArrayBuffer", *interpreter().global_object().function_prototype())
 {
-    auto& interpreter = global_object.interpreter();
-    return interpreter.heap().allocate<Uint8ClampedArray>(length, *global_object.array_prototype());
-}
+    define_property("prototype", interpreter().global_object().array_buffer_prototype(), 0);
+    define_property("length", Value(1), Attribute::Configurable);
 
-Uint8ClampedArray::Uint8ClampedArray(u32 length, Object& prototype)
-    : Object(&prototype)
-    , m_length(length)
-{
-    define_native_property("length", length_getter, nullptr);
-    m_data = new u8[m_length];
+    u8 attr = Attribute::Writable | Attribute::Configurable;
+    define_native_function("isView", is_view, 1, attr);
 }
 
-Uint8ClampedArray::~Uint8ClampedArray()
+ArrayBufferConstructor::~ArrayBufferConstructor()
 {
-    ASSERT(m_data);
-    delete[] m_data;
-    m_data = nullptr;
 }
 
-Value Uint8ClampedArray::length_getter(Interpreter& interpreter)
+Value ArrayBufferConstructor::call(Interpreter& interpreter)
 {
-    auto* this_object = interpreter.this_value().to_object(interpreter);
-    if (!this_object)
-        return {};
-    if (StringView(this_object->class_name()) != "Uint8ClampedArray")
-        return interpreter.throw_exception<TypeError>("Not a Uint8ClampedArray");
-    return Value(static_cast<const Uint8ClampedArray*>(this_object)->length());
+    return interpreter.throw_exception<TypeError>("ArrayBuffer must be called with the \"new\" operator");
 }
 
-bool Uint8ClampedArray::put_by_index(u32 property_index, Value value)
+Value ArrayBufferConstructor::construct(Interpreter& interpreter)
 {
-    // FIXME: Use attributes
-    ASSERT(property_index < m_length);
-    auto number = value.to_i32(interpreter());
-    if (interpreter().exception())
+    auto byte_length = interpreter.argument(0).to_index(interpreter);
+    if (interpreter.exception())
         return {};
-    m_data[property_index] = clamp(number, 0, 255);
-    return true;
+    if (byte_length > MAX_ARRAY_BUFFER_BYTE_LENGTH)
+        return interpreter.throw_exception<RangeError>("Invalid array buffer length");
+    return ArrayBuffer::create(interpreter.global_object(), byte_length);
 }
 
-Value Uint8ClampedArray::get_by_index(u32 property_index) const
+Value ArrayBufferConstructor::is_view(Interpreter& interpreter)
 {
-    ASSERT(property_index < m_length);
-    return Value((i32)m_data[property_index]);
+    auto argument = interpreter.argument(0);
+    if (!argument.is_object())
+        return Value(false);
+    auto& object = argument.as_object();
+    return Value(object.is_typed_array() || object.is_data_view());
 }
 
 }
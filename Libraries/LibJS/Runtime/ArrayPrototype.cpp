@@ -70,6 +70,7 @@ ArrayPrototype::ArrayPrototype()
     define_native_function("every", every, 1, attr);
     define_native_function("splice", splice, 2, attr);
     define_native_function("fill", fill, 1, attr);
+    define_native_function("sort", sort, 1, attr);
     define_property("length", Value(0), Attribute::Configurable);
 }
 
@@ -99,6 +100,22 @@ static size_t get_length(Interpreter& interpreter, Object& object)
     return length_property.to_size_t(interpreter);
 }
 
+// Returns the elements of the object if they're packed and cover the whole length, in which case they can be
+// read directly without looking for holes, accessors or indices in the prototype chain.
+static const Vector<Value>* packed_elements_of(Object& object, size_t length)
+{
+    auto& indexed_properties = object.indexed_properties();
+    if (!indexed_properties.is_packed() || length > indexed_properties.array_like_size())
+        return nullptr;
+    return &indexed_properties.packed_elements();
+}
+
+static bool contains_only_numbers(const Object& object)
+{
+    auto element_kind = object.indexed_properties().element_kind();
+    return element_kind == ElementKind::PackedInt32 || element_kind == ElementKind::PackedDouble;
+}
+
 static void for_each_item(Interpreter& interpreter, const String& name, AK::Function<IterationDecision(size_t index, Value value, Value callback_result)> callback, bool skip_empty = true)
 {
     auto* this_object = interpreter.this_value().to_object(interpreter);
@@ -167,11 +184,13 @@ Value ArrayPrototype::map(Interpreter& interpreter)
     if (interpreter.exception())
         return {};
     auto* new_array = Array::create(interpreter.global_object());
-    new_array->indexed_properties().set_array_like_size(initial_length);
+    // The results are put in index order, so the new array only ends up with holes if the original has them.
     for_each_item(interpreter, "map", [&](auto index, auto, auto callback_result) {
         new_array->put(index, callback_result);
         return IterationDecision::Continue;
     });
+    if (new_array->indexed_properties().array_like_size() < initial_length)
+        new_array->indexed_properties().set_array_like_size(initial_length);
     return Value(new_array);
 }
 
@@ -419,6 +438,23 @@ Value ArrayPrototype::index_of(Interpreter& interpreter)
             from_index = max(length + from_index, 0);
     }
     auto search_element = interpreter.argument(0);
+    if (auto* elements = packed_elements_of(*this_object, length)) {
+        if (contains_only_numbers(*this_object)) {
+            if (!search_element.is_number())
+                return Value(-1);
+            auto number = search_element.as_double();
+            for (i32 i = from_index; i < length; ++i) {
+                if (elements->at(i).as_double() == number)
+                    return Value(i);
+            }
+            return Value(-1);
+        }
+        for (i32 i = from_index; i < length; ++i) {
+            if (strict_eq(interpreter, elements->at(i), search_element))
+                return Value(i);
+        }
+        return Value(-1);
+    }
     for (i32 i = from_index; i < length; ++i) {
         auto element = this_object->get(i);
         if (interpreter.exception())
@@ -592,6 +628,23 @@ Value ArrayPrototype::last_index_of(Interpreter& interpreter)
             from_index = length + from_index;
     }
     auto search_element = interpreter.argument(0);
+    if (auto* elements = packed_elements_of(*this_object, length)) {
+        if (contains_only_numbers(*this_object)) {
+            if (!search_element.is_number())
+                return Value(-1);
+            auto number = search_element.as_double();
+            for (i32 i = from_index; i >= 0; --i) {
+                if (elements->at(i).as_double() == number)
+                    return Value(i);
+            }
+            return Value(-1);
+        }
+        for (i32 i = from_index; i >= 0; --i) {
+            if (strict_eq(interpreter, elements->at(i), search_element))
+                return Value(i);
+        }
+        return Value(-1);
+    }
     for (i32 i = from_index; i >= 0; --i) {
         auto element = this_object->get(i);
         if (interpreter.exception())
@@ -623,6 +676,15 @@ Value ArrayPrototype::includes(Interpreter& interpreter)
             from_index = max(length + from_index, 0);
     }
     auto value_to_find = interpreter.argument(0);
+    if (auto* elements = packed_elements_of(*this_object, length)) {
+        if (contains_only_numbers(*this_object) && !value_to_find.is_number())
+            return Value(false);
+        for (i32 i = from_index; i < length; ++i) {
+            if (same_value_zero(interpreter, elements->at(i), value_to_find))
+                return Value(true);
+        }
+        return Value(false);
+    }
     for (i32 i = from_index; i < length; ++i) {
         auto element = this_object->get(i).value_or(js_undefined());
         if (interpreter.exception())
@@ -835,4 +897,124 @@ Value ArrayPrototype::fill(Interpreter& interpreter)
     return this_object;
 }
 
+// Array.prototype.sort() has to be stable, and comparisons may call into JavaScript that can throw,
+// so this is a merge sort over indices into the items that stops as soon as an exception is pending.
+template<typename IsGreaterThan>
+static void merge_sort(Interpreter& interpreter, Vector<size_t>& indices, IsGreaterThan is_greater_than)
+{
+    Vector<size_t> buffer;
+    buffer.resize(indices.size());
+    for (size_t width = 1; width < indices.size(); width *= 2) {
+        for (size_t left = 0; left < indices.size(); left += 2 * width) {
+            size_t middle = min(left + width, indices.size());
+            size_t right = min(left + 2 * width, indices.size());
+            size_t i = left;
+            size_t j = middle;
+            size_t k = left;
+            while (i < middle && j < right) {
+                bool take_right = is_greater_than(indices[i], indices[j]);
+                if (interpreter.exception())
+                    return;
+                buffer[k++] = take_right ? indices[j++] : indices[i++];
+            }
+            while (i < middle)
+                buffer[k++] = indices[i++];
+            while (j < right)
+                buffer[k++] = indices[j++];
+        }
+        swap(indices, buffer);
+    }
+}
+
+Value ArrayPrototype::sort(Interpreter& interpreter)
+{
+    auto compare_function = interpreter.argument(0);
+    if (!compare_function.is_undefined() && !compare_function.is_function())
+        return interpreter.throw_exception<TypeError>(String::format("%s is not a function", compare_function.to_string_without_side_effects().characters()));
+
+    auto* this_object = interpreter.this_value().to_object(interpreter);
+    if (!this_object)
+        return {};
+    auto length = get_length(interpreter, *this_object);
+    if (interpreter.exception())
+        return {};
+
+    MarkedValueList items(interpreter.heap());
+    size_t undefined_count = 0;
+    auto add_item = [&](Value value) {
+        if (value.is_undefined())
+            ++undefined_count;
+        else
+            items.append(value);
+    };
+    if (auto* elements = packed_elements_of(*this_object, length)) {
+        for (size_t i = 0; i < length; ++i)
+            add_item(elements->at(i));
+    } else {
+        for (size_t i = 0; i < length; ++i) {
+            if (!this_object->has_property(i))
+                continue;
+            auto value = this_object->get(i).value_or(js_undefined());
+            if (interpreter.exception())
+                return {};
+            add_item(value);
+        }
+    }
+
+    Vector<size_t> indices;
+    indices.ensure_capacity(items.size());
+    for (size_t i = 0; i < items.size(); ++i)
+        indices.unchecked_append(i);
+
+    if (compare_function.is_undefined()) {
+        // Without a comparison function the items are compared as strings, so convert each of them only once.
+        Vector<String> strings;
+        strings.ensure_capacity(items.size());
+        for (auto& value : items.values()) {
+            strings.unchecked_append(value.to_string(interpreter));
+            if (interpreter.exception())
+                return {};
+        }
+        merge_sort(interpreter, indices, [&](size_t a, size_t b) {
+            return strings[b] < strings[a];
+        });
+    } else {
+        merge_sort(interpreter, indices, [&](size_t a, size_t b) {
+            MarkedValueList arguments(interpreter.heap());
+            arguments.append(items.values()[a]);
+            arguments.append(items.values()[b]);
+            auto result = interpreter.call(compare_function.as_function(), js_undefined(), move(arguments));
+            if (interpreter.exception())
+                return false;
+            auto number = result.to_number(interpreter);
+            if (interpreter.exception())
+                return false;
+            return number.as_double() > 0;
+        });
+    }
+    if (interpreter.exception())
+        return {};
+
+    size_t index = 0;
+    auto put_item = [&](Value value) {
+        this_object->put(index++, value);
+        return !interpreter.exception();
+    };
+    for (auto item_index : indices) {
+        if (!put_item(items.values()[item_index]))
+            return {};
+    }
+    for (size_t i = 0; i < undefined_count; ++i) {
+        if (!put_item(js_undefined()))
+            return {};
+    }
+    for (; index < length; ++index) {
+        this_object->delete_property(index);
+        if (interpreter.exception())
+            return {};
+    }
+
+    return this_object;
+}
+
 }
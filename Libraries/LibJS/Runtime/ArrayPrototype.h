@@ -63,6 +63,7 @@ private:
     static Value every(Interpreter&);
     static Value splice(Interpreter&);
     static Value fill(Interpreter&);
+    static Value sort(Interpreter&);
 };
 
 }
@@ -46,6 +46,11 @@ void Cell::Visitor::visit(Value value)
         visit_impl(value.as_cell());
 }
 
+void Cell::remember()
+{
+    heap().remember_cell({}, *this);
+}
+
 Heap& Cell::heap() const
 {
     return HeapBlock::from_cell(this)->heap();
@@ -39,12 +39,33 @@ class Cell {
 public:
     virtual ~Cell() {}
 
+    // Marks are sticky: a cell that survived a collection stays marked, which makes it part of the old generation.
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
     bool is_live() const { return m_live; }
     void set_live(bool b) { m_live = b; }
 
+    bool is_remembered() const { return m_remembered; }
+    void set_remembered(bool b) { m_remembered = b; }
+
+    // Write barrier: must be called after storing a reference to another cell in this one once it has
+    // been constructed. Minor collections don't trace through old cells, so an old cell pointing to a
+    // young one has to be put in the remembered set.
+    void did_store_reference(const Cell* cell)
+    {
+        if (m_mark && !m_remembered && cell && !cell->m_mark)
+            remember();
+    }
+    void did_store_reference(Value);
+
+    // Same as above, for mutations where the stored references aren't known.
+    void did_store_references()
+    {
+        if (m_mark && !m_remembered)
+            remember();
+    }
+
     virtual const char* class_name() const = 0;
 
     class Visitor {
@@ -66,8 +87,11 @@ protected:
     Cell() {}
 
 private:
+    void remember();
+
     bool m_mark { false };
     bool m_live { true };
+    bool m_remembered { false };
 };
 
 const LogStream& operator<<(const LogStream&, const Cell*);
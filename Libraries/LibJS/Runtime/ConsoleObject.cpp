@@ -29,6 +29,8 @@
 #include <AK/FlyString.h>
 #include <AK/Function.h>
 #include <LibJS/Console.h>
+#include <LibJS/Heap/Heap.h>
+#include <LibJS/Heap/HeapBlock.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibJS/Runtime/GlobalObject.h>
@@ -47,6 +49,7 @@ ConsoleObject::ConsoleObject()
     define_native_function("count", count);
     define_native_function("countReset", count_reset);
     define_native_function("clear", clear);
+    define_native_property("memory", memory_getter, nullptr);
 }
 
 ConsoleObject::~ConsoleObject()
@@ -98,4 +101,20 @@ Value ConsoleObject::clear(Interpreter& interpreter)
     return interpreter.console().clear();
 }
 
+Value ConsoleObject::memory_getter(Interpreter& interpreter)
+{
+    auto& heap = interpreter.heap();
+    auto& statistics = heap.statistics();
+    auto* memory = Object::create_empty(interpreter, interpreter.global_object());
+    memory->define_property("heapBlocks", Value(static_cast<double>(heap.block_count())));
+    memory->define_property("heapSize", Value(static_cast<double>(heap.block_count() * HeapBlock::block_size)));
+    memory->define_property("cellsAllocated", Value(static_cast<double>(statistics.cells_allocated)));
+    memory->define_property("collections", Value(static_cast<double>(statistics.collections)));
+    memory->define_property("youngGenerationCollections", Value(static_cast<double>(statistics.young_generation_collections)));
+    memory->define_property("blocksSweptLazily", Value(static_cast<double>(statistics.blocks_swept_lazily)));
+    memory->define_property("lastCollectionTime", Value(statistics.last_collection_time_in_microseconds / 1000.0));
+    memory->define_property("totalCollectionTime", Value(statistics.total_collection_time_in_microseconds / 1000.0));
+    return memory;
+}
+
 }
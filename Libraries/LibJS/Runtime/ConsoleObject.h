@@ -47,6 +47,8 @@ private:
     static Value count(Interpreter&);
     static Value count_reset(Interpreter&);
     static Value clear(Interpreter&);
+
+    static Value memory_getter(Interpreter&);
 };
 
 }
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/Function.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/DataView.h>
+#include <LibJS/Runtime/DataViewPrototype.h>
+#include <LibJS/Runtime/Error.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/TypedArray.h>
+#include <string.h>
+
+namespace JS {
+
+DataViewPrototype::DataViewPrototype()
+    : Object(interpreter().global_object().object_prototype())
+{
+    u8 attr = Attribute::Writable | Attribute::Configurable;
+    define_native_property("buffer", buffer_getter, nullptr, Attribute::Configurable);
+    define_native_property("byteLength", byte_length_getter, nullptr, Attribute::Configurable);
+    define_native_property("byteOffset", byte_offset_getter, nullptr, Attribute::Configurable);
+
+    define_native_function("getInt8", get_view_value<i8>, 1, attr);
+    define_native_function("getUint8", get_view_value<u8>, 1, attr);
+    define_native_function("getInt16", get_view_value<i16>, 1, attr);
+    define_native_function("getUint16", get_view_value<u16>, 1, attr);
+    define_native_function("getInt32", get_view_value<i32>, 1, attr);
+    define_native_function("getUint32", get_view_value<u32>, 1, attr);
+    define_native_function("getFloat32", get_view_value<float>, 1, attr);
+    define_native_function("getFloat64", get_view_value<double>, 1, attr);
+
+    define_native_function("setInt8", set_view_value<i8>, 2, attr);
+    define_native_function("setUint8", set_view_value<u8>, 2, attr);
+    define_native_function("setInt16", set_view_value<i16>, 2, attr);
+    define_native_function("setUint16", set_view_value<u16>, 2, attr);
+    define_native_function("setInt32", set_view_value<i32>, 2, attr);
+    define_native_function("setUint32", set_view_value<u32>, 2, attr);
+    define_native_function("setFloat32", set_view_value<float>, 2, attr);
+    define_native_function("setFloat64", set_view_value<double>, 2, attr);
+}
+
+DataViewPrototype::~DataViewPrototype()
+{
+}
+
+static DataView* data_view_from(Interpreter& interpreter)
+{
+    auto* this_object = interpreter.this_value().to_object(interpreter);
+    if (!this_object)
+        return nullptr;
+    if (!this_object->is_data_view()) {
+        interpreter.throw_exception<TypeError>("Not a DataView");
+        return nullptr;
+    }
+    return static_cast<DataView*>(this_object);
+}
+
+// DataView accesses are big-endian unless asked otherwise, so bytes get swapped whenever
+// the requested order differs from the host's.
+static void swap_bytes_if_needed(u8* bytes, size_t size, bool little_endian)
+{
+    constexpr bool host_is_little_endian = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+    if (little_endian == host_is_little_endian)
+        return;
+    for (size_t i = 0; i < size / 2; ++i)
+        swap(bytes[i], bytes[size - i - 1]);
+}
+
+Value DataViewPrototype::buffer_getter(Interpreter& interpreter)
+{
+    auto* data_view = data_view_from(interpreter);
+    if (!data_view)
+        return {};
+    return &data_view->viewed_array_buffer();
+}
+
+Value DataViewPrototype::byte_length_getter(Interpreter& interpreter)
+{
+    auto* data_view = data_view_from(interpreter);
+    if (!data_view)
+        return {};
+    return Value(data_view->byte_length());
+}
+
+Value DataViewPrototype::byte_offset_getter(Interpreter& interpreter)
+{
+    auto* data_view = data_view_from(interpreter);
+    if (!data_view)
+        return {};
+    return Value(data_view->byte_offset());
+}
+
+template<typename T>
+Value DataViewPrototype::get_view_value(Interpreter& interpreter)
+{
+    auto* data_view = data_view_from(interpreter);
+    if (!data_view)
+        return {};
+    auto index = interpreter.argument(0).to_index(interpreter);
+    if (interpreter.exception())
+        return {};
+    auto little_endian = interpreter.argument(1).to_boolean();
+    if (index + sizeof(T) > data_view->byte_length())
+        return interpreter.throw_exception<RangeError>("Offset is outside the bounds of the DataView");
+
+    u8 bytes[sizeof(T)];
+    memcpy(bytes, data_view->data() + index, sizeof(T));
+    swap_bytes_if_needed(bytes, sizeof(T), little_endian);
+    T element;
+    memcpy(&element, bytes, sizeof(T));
+    return TypedArrayElement<T>::to_value(element);
+}
+
+template<typename T>
+Value DataViewPrototype::set_view_value(Interpreter& interpreter)
+{
+    auto* data_view = data_view_from(interpreter);
+    if (!data_view)
+        return {};
+    auto index = interpreter.argument(0).to_index(interpreter);
+    if (interpreter.exception())
+        return {};
+    auto number = interpreter.argument(1).to_double(interpreter);
+    if (interpreter.exception())
+        return {};
+    auto little_endian = interpreter.argument(2).to_boolean();
+    if (index + sizeof(T) > data_view->byte_length())
+        return interpreter.throw_exception<RangeError>("Offset is outside the bounds of the DataView");
+
+    auto element = TypedArrayElement<T>::from_double(number);
+    u8 bytes[sizeof(T)];
+    memcpy(bytes, &element, sizeof(T));
+    swap_bytes_if_needed(bytes, sizeof(T), little_endian);
+    memcpy(data_view->data() + index, bytes, sizeof(T));
+    return js_undefined();
+}
+
+}
@@ -30,29 +30,22 @@
 
 namespace JS {
 
-class Uint8ClampedArray final : public Object {
+class DataViewPrototype final : public Object {
 public:
-    static Uint8ClampedArray* create(GlobalObject&, u32 length);
-
-    Uint8ClampedArray(u32 length, Object& prototype);
-    virtual ~Uint8ClampedArray() override;
-
-    i32 length() const { return m_length; }
-
-    virtual bool put_by_index(u32 property_index, Value value) override;
-    virtual Value get_by_index(u32 property_index) const override;
-
-    u8* data() { return m_data; }
-    const u8* data() const { return m_data; }
+    DataViewPrototype();
+    virtual ~DataViewPrototype() override;
 
 private:
-    virtual const char* class_name() const override { return "Uint8ClampedArray"; }
-    virtual bool is_array() const override { return true; }
+    virtual const char* class_name() const override { return "DataViewPrototype"; }
 
-    static Value length_getter(Interpreter&);
+    static Value buffer_getter(Interpreter&);
+    static Value byte_length_getter(Interpreter&);
+    static Value byte_offset_getter(Interpreter&);
 
-    u8* m_data { nullptr };
-    u32 m_length { 0 };
+    template<typename T>
+    static Value get_view_value(Interpreter&);
+    template<typename T>
+    static Value set_view_value(Interpreter&);
 };
 
 }
@@ -27,6 +27,8 @@
 
 #include <AK/LogStream.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/ArrayBufferConstructor.h>
+#include <LibJS/Runtime/ArrayBufferPrototype.h>
 #include <LibJS/Runtime/ArrayConstructor.h>
 #include <LibJS/Runtime/ArrayPrototype.h>
 #include <LibJS/Runtime/BigIntConstructor.h>
@@ -34,6 +36,8 @@
 #include <LibJS/Runtime/BooleanConstructor.h>
 #include <LibJS/Runtime/BooleanPrototype.h>
 #include <LibJS/Runtime/ConsoleObject.h>
+#include <LibJS/Runtime/DataViewConstructor.h>
+#include <LibJS/Runtime/DataViewPrototype.h>
 #include <LibJS/Runtime/DateConstructor.h>
 #include <LibJS/Runtime/DatePrototype.h>
 #include <LibJS/Runtime/ErrorConstructor.h>
@@ -58,6 +62,8 @@
 #include <LibJS/Runtime/StringPrototype.h>
 #include <LibJS/Runtime/SymbolConstructor.h>
 #include <LibJS/Runtime/SymbolPrototype.h>
+#include <LibJS/Runtime/TypedArrayConstructor.h>
+#include <LibJS/Runtime/TypedArrayPrototype.h>
 #include <LibJS/Runtime/Value.h>
 
 namespace JS {
@@ -83,6 +89,11 @@ void GlobalObject::initialize()
     JS_ENUMERATE_BUILTIN_TYPES
 #undef __JS_ENUMERATE
 
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, ArrayType) \
+    m_##snake_name##_prototype = heap().allocate<PrototypeName>();
+    JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+
     u8 attr = Attribute::Writable | Attribute::Configurable;
     define_native_function("gc", gc, 0, attr);
     define_native_function("isNaN", is_nan, 1, attr);
@@ -99,8 +110,10 @@ void GlobalObject::initialize()
     define_property("Reflect", heap().allocate<ReflectObject>(), attr);
 
     add_constructor("Array", m_array_constructor, *m_array_prototype);
+    add_constructor("ArrayBuffer", m_array_buffer_constructor, *m_array_buffer_prototype);
     add_constructor("BigInt", m_bigint_constructor, *m_bigint_prototype);
     add_constructor("Boolean", m_boolean_constructor, *m_boolean_prototype);
+    add_constructor("DataView", m_data_view_constructor, *m_data_view_prototype);
     add_constructor("Date", m_date_constructor, *m_date_prototype);
     add_constructor("Error", m_error_constructor, *m_error_prototype);
     add_constructor("Function", m_function_constructor, *m_function_prototype);
@@ -115,6 +128,16 @@ void GlobalObject::initialize()
     add_constructor(#ClassName, m_##snake_name##_constructor, *m_##snake_name##_prototype);
     JS_ENUMERATE_ERROR_SUBCLASSES
 #undef __JS_ENUMERATE
+
+    // %TypedArray% is not a global, it is only reachable through the concrete typed array constructors.
+    m_typed_array_constructor = heap().allocate<TypedArrayConstructor>();
+    m_typed_array_constructor->define_property("name", js_string(heap(), "TypedArray"), Attribute::Configurable);
+    m_typed_array_prototype->define_property("constructor", m_typed_array_constructor, attr);
+
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, ArrayType) \
+    add_constructor(#ClassName, m_##snake_name##_constructor, *m_##snake_name##_prototype);
+    JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
 }
 
 GlobalObject::~GlobalObject()
@@ -128,8 +151,15 @@ void GlobalObject::visit_children(Visitor& visitor)
     visitor.visit(m_empty_object_shape);
 
 #define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName) \
-    visitor.visit(m_##snake_name##_constructor);
-    JS_ENUMERATE_ERROR_SUBCLASSES
+    visitor.visit(m_##snake_name##_constructor);                              \
+    visitor.visit(m_##snake_name##_prototype);
+    JS_ENUMERATE_BUILTIN_TYPES
+#undef __JS_ENUMERATE
+
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, ArrayType) \
+    visitor.visit(m_##snake_name##_constructor);                                         \
+    visitor.visit(m_##snake_name##_prototype);
+    JS_ENUMERATE_TYPED_ARRAYS
 #undef __JS_ENUMERATE
 }
 
@@ -46,6 +46,12 @@ public:
     JS_ENUMERATE_BUILTIN_TYPES
 #undef __JS_ENUMERATE
 
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, ArrayType) \
+    ConstructorName* snake_name##_constructor() { return m_##snake_name##_constructor; }  \
+    Object* snake_name##_prototype() { return m_##snake_name##_prototype; }
+    JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+
 protected:
     virtual void visit_children(Visitor&) override;
 
@@ -67,6 +73,12 @@ private:
     Object* m_##snake_name##_prototype { nullptr };
     JS_ENUMERATE_BUILTIN_TYPES
 #undef __JS_ENUMERATE
+
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, ArrayType) \
+    ConstructorName* m_##snake_name##_constructor { nullptr };                           \
+    Object* m_##snake_name##_prototype { nullptr };
+    JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
 };
 
 template<typename ConstructorType>
@@ -29,20 +29,49 @@
 
 namespace JS {
 
+SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage()
+    : IndexedPropertyStorage(true)
+{
+}
+
 SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initial_values)
-    : m_array_size(initial_values.size())
+    : IndexedPropertyStorage(true)
     , m_packed_elements(move(initial_values))
 {
+    for (auto& value : m_packed_elements)
+        update_element_kind(value);
+}
+
+void SimpleIndexedPropertyStorage::update_element_kind(Value value)
+{
+    switch (m_element_kind) {
+    case ElementKind::PackedInt32:
+        if (value.is_number()) {
+            if (!value.is_integer() || value.is_negative_zero())
+                m_element_kind = ElementKind::PackedDouble;
+            return;
+        }
+        break;
+    case ElementKind::PackedDouble:
+        if (value.is_number())
+            return;
+        break;
+    case ElementKind::PackedElements:
+        break;
+    case ElementKind::HoleyElements:
+        return;
+    }
+    m_element_kind = value.is_empty() ? ElementKind::HoleyElements : ElementKind::PackedElements;
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
 {
-    return index < m_array_size && !m_packed_elements[index].is_empty();
+    return index < m_packed_elements.size() && !m_packed_elements[index].is_empty();
 }
 
 Optional<ValueAndAttributes> SimpleIndexedPropertyStorage::get(u32 index) const
 {
-    if (index >= m_array_size)
+    if (index >= m_packed_elements.size())
         return {};
     return ValueAndAttributes { m_packed_elements[index], default_attributes };
 }
@@ -50,57 +79,68 @@ Optional<ValueAndAttributes> SimpleIndexedPropertyStorage::get(u32 index) const
 void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttributes attributes)
 {
     ASSERT(attributes == default_attributes);
-    ASSERT(index < SPARSE_ARRAY_THRESHOLD);
 
-    if (index >= m_array_size) {
-        m_array_size = index + 1;
-        if (index >= m_packed_elements.size())
-            m_packed_elements.resize(index + MIN_PACKED_RESIZE_AMOUNT >= SPARSE_ARRAY_THRESHOLD ? SPARSE_ARRAY_THRESHOLD : index + MIN_PACKED_RESIZE_AMOUNT);
+    if (index >= m_packed_elements.size()) {
+        ASSERT(index - m_packed_elements.size() <= SPARSE_ARRAY_THRESHOLD);
+        if (index > m_packed_elements.size())
+            m_element_kind = ElementKind::HoleyElements;
+        m_packed_elements.grow_capacity(index + 1);
+        m_packed_elements.resize(index + 1);
     }
     m_packed_elements[index] = value;
+    update_element_kind(value);
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
 {
-    if (index < m_array_size)
+    if (index < m_packed_elements.size()) {
         m_packed_elements[index] = {};
+        m_element_kind = ElementKind::HoleyElements;
+    }
 }
 
 void SimpleIndexedPropertyStorage::insert(u32 index, Value value, PropertyAttributes attributes)
 {
     ASSERT(attributes == default_attributes);
-    ASSERT(index < SPARSE_ARRAY_THRESHOLD);
-    m_array_size++;
-    ASSERT(m_array_size <= SPARSE_ARRAY_THRESHOLD);
+    if (index >= m_packed_elements.size()) {
+        put(index, value, attributes);
+        return;
+    }
     m_packed_elements.insert(index, value);
+    update_element_kind(value);
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_first()
 {
-    m_array_size--;
     return { m_packed_elements.take_first(), default_attributes };
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 {
-    m_array_size--;
-    auto last_element = m_packed_elements[m_array_size];
-    m_packed_elements[m_array_size] = {};
-    return { last_element, default_attributes };
+    return { m_packed_elements.take_last(), default_attributes };
 }
 
 void SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
-    ASSERT(new_size <= SPARSE_ARRAY_THRESHOLD);
-    m_array_size = new_size;
+    ASSERT(new_size <= MAX_SIMPLE_STORAGE_PREALLOCATION || new_size <= m_packed_elements.size());
+    if (new_size == 0)
+        m_element_kind = ElementKind::PackedInt32;
+    else if (new_size > m_packed_elements.size())
+        m_element_kind = ElementKind::HoleyElements;
     m_packed_elements.resize(new_size);
 }
 
 GenericIndexedPropertyStorage::GenericIndexedPropertyStorage(SimpleIndexedPropertyStorage&& storage)
+    : IndexedPropertyStorage(false)
 {
     m_array_size = storage.array_like_size();
-    for (auto& element : move(storage.m_packed_elements))
-        m_packed_elements.append({ element, default_attributes });
+    for (size_t i = 0; i < storage.m_packed_elements.size(); ++i) {
+        auto& element = storage.m_packed_elements[i];
+        if (i < SPARSE_ARRAY_THRESHOLD)
+            m_packed_elements.append({ element, default_attributes });
+        else if (!element.is_empty())
+            m_sparse_elements.set(i, { element, default_attributes });
+    }
 }
 
 bool GenericIndexedPropertyStorage::has_index(u32 index) const
@@ -208,6 +248,7 @@ ValueAndAttributes GenericIndexedPropertyStorage::take_last()
 
 void GenericIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
+    m_array_size = new_size;
     if (new_size < SPARSE_ARRAY_THRESHOLD) {
         m_packed_elements.resize(new_size);
         m_sparse_elements.clear();
@@ -267,6 +308,10 @@ ValueAndAttributes IndexedPropertyIterator::value_and_attributes(Object* this_ob
 
 Optional<ValueAndAttributes> IndexedProperties::get(Object* this_object, u32 index, bool evaluate_accessors) const
 {
+    // Simple storage can't contain accessors.
+    if (m_storage->is_simple_storage())
+        return simple_storage().get(index);
+
     auto result = m_storage->get(index);
     if (!evaluate_accessors)
         return result;
@@ -283,10 +328,17 @@ Optional<ValueAndAttributes> IndexedProperties::get(Object* this_object, u32 ind
 
 void IndexedProperties::put(Object* this_object, u32 index, Value value, PropertyAttributes attributes, bool evaluate_accessors)
 {
-    if (m_storage->is_simple_storage() && (index >= SPARSE_ARRAY_THRESHOLD || attributes != default_attributes))
+    if (m_storage->is_simple_storage()) {
+        if (attributes == default_attributes && (index < array_like_size() || index - array_like_size() <= SPARSE_ARRAY_THRESHOLD)) {
+            simple_storage().put(index, value, attributes);
+            did_store(value);
+            return;
+        }
         switch_to_generic_storage();
-    if (m_storage->is_simple_storage() || !evaluate_accessors) {
+    }
+    if (!evaluate_accessors) {
         m_storage->put(index, value, attributes);
+        did_store(value);
         return;
     }
 
@@ -296,6 +348,7 @@ void IndexedProperties::put(Object* this_object, u32 index, Value value, Propert
         value_here.value().value.as_accessor().call_setter(this_object, value);
     } else {
         m_storage->put(index, value, attributes);
+        did_store(value);
     }
 }
 
@@ -312,9 +365,10 @@ bool IndexedProperties::remove(u32 index)
 
 void IndexedProperties::insert(u32 index, Value value, PropertyAttributes attributes)
 {
-    if (m_storage->is_simple_storage() && (index >= SPARSE_ARRAY_THRESHOLD || attributes != default_attributes || array_like_size() == SPARSE_ARRAY_THRESHOLD))
+    if (m_storage->is_simple_storage() && (attributes != default_attributes || (index > array_like_size() && index - array_like_size() > SPARSE_ARRAY_THRESHOLD)))
         switch_to_generic_storage();
     m_storage->insert(index, value, attributes);
+    did_store(value);
 }
 
 ValueAndAttributes IndexedProperties::take_first(Object *this_object)
@@ -333,30 +387,47 @@ ValueAndAttributes IndexedProperties::take_last(Object *this_object)
     return last;
 }
 
+void IndexedProperties::set_array_like_size(size_t new_size)
+{
+    if (m_storage->is_simple_storage() && new_size > array_like_size() && new_size > MAX_SIMPLE_STORAGE_PREALLOCATION)
+        switch_to_generic_storage();
+    m_storage->set_array_like_size(new_size);
+}
+
 void IndexedProperties::append_all(Object* this_object, const IndexedProperties& properties, bool evaluate_accessors)
 {
     if (m_storage->is_simple_storage() && !properties.m_storage->is_simple_storage())
         switch_to_generic_storage();
 
+    if (m_storage->is_simple_storage() && properties.is_packed()) {
+        auto& storage = simple_storage();
+        for (auto& value : properties.packed_elements()) {
+            storage.put(storage.array_like_size(), value);
+            did_store(value);
+        }
+        return;
+    }
+
     for (auto it = properties.begin(false); it != properties.end(); ++it) {
         auto element = it.value_and_attributes(this_object, evaluate_accessors);
         if (this_object && this_object->interpreter().exception())
             return;
         m_storage->put(m_storage->array_like_size(), element.value, element.attributes);
+        did_store(element.value);
     }
 }
 
 Vector<ValueAndAttributes> IndexedProperties::values_unordered() const
 {
     if (m_storage->is_simple_storage()) {
-        auto elements = static_cast<const SimpleIndexedPropertyStorage&>(*m_storage).elements();
+        auto& elements = simple_storage().elements();
         Vector<ValueAndAttributes> with_attributes;
         for (auto& value : elements)
             with_attributes.append({ value, default_attributes });
         return with_attributes;
     }
 
-    auto storage = static_cast<const GenericIndexedPropertyStorage&>(*m_storage);
+    auto& storage = static_cast<const GenericIndexedPropertyStorage&>(*m_storage);
     auto values = storage.packed_elements();
     values.ensure_capacity(values.size() + storage.sparse_elements().size());
     for (auto& entry : storage.sparse_elements())
@@ -366,8 +437,7 @@ Vector<ValueAndAttributes> IndexedProperties::values_unordered() const
 
 void IndexedProperties::switch_to_generic_storage()
 {
-    auto storage = static_cast<const SimpleIndexedPropertyStorage&>(*m_storage);
-    m_storage = make<GenericIndexedPropertyStorage>(move(storage));
+    m_storage = make<GenericIndexedPropertyStorage>(move(simple_storage()));
 }
 
 }
@@ -32,8 +32,22 @@
 
 namespace JS {
 
+// Simple storage is a plain vector, so a write that would leave more than this many holes in it
+// switches to generic storage instead.
 const u32 SPARSE_ARRAY_THRESHOLD = 200;
 const u32 MIN_PACKED_RESIZE_AMOUNT = 20;
+// Growing the array-like size (e.g. `new Array(n)`) keeps simple storage up to this size, holes and all.
+const u32 MAX_SIMPLE_STORAGE_PREALLOCATION = 64 * 1024;
+
+// What's known about the elements in simple storage. Kinds only ever get more general
+// (an array of int32s that once held a double stays a double array), so checking
+// the kind is all it takes to know that every element has a certain type.
+enum class ElementKind : u8 {
+    PackedInt32,
+    PackedDouble,
+    PackedElements,
+    HoleyElements,
+};
 
 struct ValueAndAttributes {
     Value value;
@@ -48,6 +62,8 @@ class IndexedPropertyStorage {
 public:
     virtual ~IndexedPropertyStorage() {};
 
+    bool is_simple_storage() const { return m_is_simple_storage; }
+
     virtual bool has_index(u32 index) const = 0;
     virtual Optional<ValueAndAttributes> get(u32 index) const = 0;
     virtual void put(u32 index, Value value, PropertyAttributes attributes = default_attributes) = 0;
@@ -61,12 +77,19 @@ public:
     virtual size_t array_like_size() const = 0;
     virtual void set_array_like_size(size_t new_size) = 0;
 
-    virtual bool is_simple_storage() const { return false; }
+protected:
+    explicit IndexedPropertyStorage(bool is_simple_storage)
+        : m_is_simple_storage(is_simple_storage)
+    {
+    }
+
+private:
+    bool m_is_simple_storage { false };
 };
 
 class SimpleIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
-    SimpleIndexedPropertyStorage() = default;
+    SimpleIndexedPropertyStorage();
     explicit SimpleIndexedPropertyStorage(Vector<Value>&& initial_values);
 
     virtual bool has_index(u32 index) const override;
@@ -79,16 +102,18 @@ public:
     virtual ValueAndAttributes take_last() override;
 
     virtual size_t size() const override { return m_packed_elements.size(); }
-    virtual size_t array_like_size() const override { return m_array_size; }
+    virtual size_t array_like_size() const override { return m_packed_elements.size(); }
     virtual void set_array_like_size(size_t new_size) override;
 
-    virtual bool is_simple_storage() const override { return true; }
-    Vector<Value> elements() const { return m_packed_elements; }
+    ElementKind element_kind() const { return m_element_kind; }
+    const Vector<Value>& elements() const { return m_packed_elements; }
 
 private:
     friend GenericIndexedPropertyStorage;
 
-    size_t m_array_size { 0 };
+    void update_element_kind(Value);
+
+    ElementKind m_element_kind { ElementKind::PackedInt32 };
     Vector<Value> m_packed_elements;
 };
 
@@ -109,8 +134,8 @@ public:
     virtual size_t array_like_size() const override { return m_array_size; }
     virtual void set_array_like_size(size_t new_size) override;
 
-    Vector<ValueAndAttributes> packed_elements() const { return m_packed_elements; }
-    HashMap<u32, ValueAndAttributes> sparse_elements() const { return m_sparse_elements; }
+    const Vector<ValueAndAttributes>& packed_elements() const { return m_packed_elements; }
+    const HashMap<u32, ValueAndAttributes>& sparse_elements() const { return m_sparse_elements; }
 
 private:
     size_t m_array_size { 0 };
@@ -139,8 +164,15 @@ class IndexedProperties {
 public:
     IndexedProperties() = default;
 
-    IndexedProperties(Vector<Value>&& values)
-        : m_storage(make<SimpleIndexedPropertyStorage>(move(values)))
+    // The owner gets a write barrier for every value stored in these properties.
+    explicit IndexedProperties(Cell& owner)
+        : m_owner(&owner)
+    {
+    }
+
+    IndexedProperties(Cell& owner, Vector<Value>&& values)
+        : m_owner(&owner)
+        , m_storage(make<SimpleIndexedPropertyStorage>(move(values)))
     {
     }
 
@@ -161,14 +193,44 @@ public:
 
     size_t size() const { return m_storage->size(); }
     bool is_empty() const { return size() == 0; }
-    size_t array_like_size() const { return m_storage->array_like_size(); }
-    void set_array_like_size(size_t new_size) { m_storage->set_array_like_size(new_size); };
+    size_t array_like_size() const
+    {
+        if (m_storage->is_simple_storage())
+            return simple_storage().array_like_size();
+        return m_storage->array_like_size();
+    }
+    void set_array_like_size(size_t new_size);
+
+    ElementKind element_kind() const
+    {
+        if (!m_storage->is_simple_storage())
+            return ElementKind::HoleyElements;
+        return simple_storage().element_kind();
+    }
+
+    // Packed elements are all in simple storage without holes, so they can be read straight from
+    // the vector: there are no accessors or attributes to worry about, and every index below the
+    // array-like size is present.
+    bool is_packed() const { return element_kind() != ElementKind::HoleyElements; }
+    const Vector<Value>& packed_elements() const
+    {
+        ASSERT(is_packed());
+        return simple_storage().elements();
+    }
 
     Vector<ValueAndAttributes> values_unordered() const;
 
 private:
+    const SimpleIndexedPropertyStorage& simple_storage() const { return static_cast<const SimpleIndexedPropertyStorage&>(*m_storage); }
+    SimpleIndexedPropertyStorage& simple_storage() { return static_cast<SimpleIndexedPropertyStorage&>(*m_storage); }
     void switch_to_generic_storage();
+    void did_store(Value value)
+    {
+        if (m_owner)
+            m_owner->did_store_reference(value);
+    }
 
+    Cell* m_owner { nullptr };
     NonnullOwnPtr<IndexedPropertyStorage> m_storage { make<SimpleIndexedPropertyStorage>() };
 };
 
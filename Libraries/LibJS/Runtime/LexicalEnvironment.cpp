@@ -24,18 +24,39 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <LibJS/AST.h>
 #include <LibJS/Runtime/LexicalEnvironment.h>
 
 namespace JS {
 
+void EnvironmentLayout::add(const FlyString& name, DeclarationKind declaration_kind)
+{
+    auto it = m_slots.find(name);
+    if (it != m_slots.end()) {
+        // Redeclarations share the slot of the first declaration, the last declaration kind wins.
+        m_bindings[it->value].declaration_kind = declaration_kind;
+        return;
+    }
+    m_slots.set(name, m_bindings.size());
+    m_bindings.append({ name, declaration_kind });
+}
+
+Optional<size_t> EnvironmentLayout::slot_of(const FlyString& name) const
+{
+    return m_slots.get(name);
+}
+
 LexicalEnvironment::LexicalEnvironment()
 {
 }
 
-LexicalEnvironment::LexicalEnvironment(HashMap<FlyString, Variable> variables, LexicalEnvironment* parent)
+LexicalEnvironment::LexicalEnvironment(const EnvironmentLayout& layout, LexicalEnvironment* parent)
     : m_parent(parent)
-    , m_variables(move(variables))
+    , m_layout(layout)
 {
+    m_variables.ensure_capacity(layout.size());
+    for (size_t slot = 0; slot < layout.size(); ++slot)
+        m_variables.unchecked_append({ js_undefined(), layout.declaration_kind_at(slot) });
 }
 
 LexicalEnvironment::~LexicalEnvironment()
@@ -46,18 +67,27 @@ void LexicalEnvironment::visit_children(Visitor& visitor)
 {
     Cell::visit_children(visitor);
     visitor.visit(m_parent);
-    for (auto& it : m_variables)
-        visitor.visit(it.value.value);
+    for (auto& variable : m_variables)
+        visitor.visit(variable.value);
 }
 
 Optional<Variable> LexicalEnvironment::get(const FlyString& name) const
 {
-    return m_variables.get(name);
+    if (!m_layout)
+        return {};
+    auto slot = m_layout->slot_of(name);
+    if (!slot.has_value())
+        return {};
+    return m_variables[slot.value()];
 }
 
 void LexicalEnvironment::set(const FlyString& name, Variable variable)
 {
-    m_variables.set(name, variable);
+    ASSERT(m_layout);
+    auto slot = m_layout->slot_of(name);
+    ASSERT(slot.has_value());
+    m_variables[slot.value()] = variable;
+    did_store_reference(variable.value);
 }
 
 }
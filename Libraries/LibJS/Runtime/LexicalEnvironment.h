@@ -28,6 +28,9 @@
 
 #include <AK/FlyString.h>
 #include <AK/HashMap.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
+#include <AK/Vector.h>
 #include <LibJS/Runtime/Cell.h>
 #include <LibJS/Runtime/Value.h>
 
@@ -38,10 +41,37 @@ struct Variable {
     DeclarationKind declaration_kind;
 };
 
+// The names declared in a scope, in slot order. A layout is computed once per scope (see
+// ScopeNode::environment_layout()) and shared by every environment created for that scope,
+// so entering a scope doesn't have to build a HashMap of its own.
+class EnvironmentLayout : public RefCounted<EnvironmentLayout> {
+public:
+    static NonnullRefPtr<EnvironmentLayout> create() { return adopt(*new EnvironmentLayout); }
+
+    void add(const FlyString& name, DeclarationKind);
+    Optional<size_t> slot_of(const FlyString& name) const;
+
+    bool is_empty() const { return m_bindings.is_empty(); }
+    size_t size() const { return m_bindings.size(); }
+    const FlyString& name_at(size_t slot) const { return m_bindings[slot].name; }
+    DeclarationKind declaration_kind_at(size_t slot) const { return m_bindings[slot].declaration_kind; }
+
+private:
+    EnvironmentLayout() { }
+
+    struct Binding {
+        FlyString name;
+        DeclarationKind declaration_kind;
+    };
+
+    Vector<Binding> m_bindings;
+    HashMap<FlyString, size_t> m_slots;
+};
+
 class LexicalEnvironment final : public Cell {
 public:
     LexicalEnvironment();
-    LexicalEnvironment(HashMap<FlyString, Variable> variables, LexicalEnvironment* parent);
+    LexicalEnvironment(const EnvironmentLayout&, LexicalEnvironment* parent);
     virtual ~LexicalEnvironment() override;
 
     LexicalEnvironment* parent() { return m_parent; }
@@ -49,16 +79,21 @@ public:
     Optional<Variable> get(const FlyString&) const;
     void set(const FlyString&, Variable);
 
-    void clear();
-
-    const HashMap<FlyString, Variable>& variables() const { return m_variables; }
+    const Variable& variable_at(size_t slot) const { return m_variables[slot]; }
+    void set_value_at(size_t slot, Value value)
+    {
+        m_variables[slot].value = value;
+        did_store_reference(value);
+    }
+    const EnvironmentLayout* layout() const { return m_layout.ptr(); }
 
 private:
     virtual const char* class_name() const override { return "LexicalEnvironment"; }
     virtual void visit_children(Visitor&) override;
 
     LexicalEnvironment* m_parent { nullptr };
-    HashMap<FlyString, Variable> m_variables;
+    RefPtr<const EnvironmentLayout> m_layout;
+    Vector<Variable> m_variables;
 };
 
 }
@@ -34,8 +34,10 @@
 #include <LibJS/Runtime/NativeFunction.h>
 #include <LibJS/Runtime/NativeProperty.h>
 #include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/PropertyLookupCache.h>
 #include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/StringObject.h>
+#include <LibJS/Runtime/TypedArray.h>
 #include <LibJS/Runtime/Value.h>
 
 namespace JS {
@@ -120,6 +122,7 @@ bool Object::set_prototype(Object* new_prototype)
         return true;
     }
     m_shape = m_shape->create_prototype_transition(new_prototype);
+    did_store_reference(m_shape);
     return true;
 }
 
@@ -188,6 +191,22 @@ Value Object::get_own_properties(const Object& this_object, GetOwnPropertyMode k
     }
 
     size_t property_index = 0;
+    if (this_object.is_typed_array()) {
+        auto array_length = static_cast<const TypedArrayBase&>(this_object).array_length();
+        for (; property_index < array_length; ++property_index) {
+            if (kind == GetOwnPropertyMode::Key) {
+                properties_array->define_property(property_index, js_string(interpreter(), String::number(property_index)));
+            } else if (kind == GetOwnPropertyMode::Value) {
+                properties_array->define_property(property_index, this_object.get_by_index(property_index));
+            } else {
+                auto* entry_array = Array::create(interpreter().global_object());
+                entry_array->define_property(0, js_string(interpreter(), String::number(property_index)));
+                entry_array->define_property(1, this_object.get_by_index(property_index));
+                properties_array->define_property(property_index, entry_array);
+            }
+        }
+    }
+
     for (auto& entry : m_indexed_properties) {
         auto value_and_attributes = entry.value_and_attributes(const_cast<Object*>(&this_object));
         if (only_enumerable_properties && !value_and_attributes.attributes.is_enumerable())
@@ -302,6 +321,7 @@ void Object::set_shape(Shape& new_shape)
 {
     m_storage.resize(new_shape.property_count());
     m_shape = &new_shape;
+    did_store_reference(m_shape);
 }
 
 bool Object::define_property(const FlyString& property_name, const Object& descriptor, bool throw_exceptions)
@@ -467,6 +487,7 @@ bool Object::put_own_property(Object& this_object, const FlyString& property_nam
         call_native_property_setter(const_cast<Object*>(&this_object), value_here, value);
     } else {
         m_storage[metadata.value().offset] = value;
+        did_store_reference(value);
     }
     return true;
 }
@@ -544,10 +565,14 @@ void Object::ensure_shape_is_unique()
         return;
 
     m_shape = m_shape->create_unique_clone();
+    did_store_reference(m_shape);
 }
 
 Value Object::get_by_index(u32 property_index) const
 {
+    if (m_indexed_properties.is_packed() && property_index < m_indexed_properties.array_like_size())
+        return m_indexed_properties.packed_elements()[property_index];
+
     const Object* object = this;
     while (object) {
         if (is_string_object()) {
@@ -594,6 +619,12 @@ bool Object::put_by_index(u32 property_index, Value value)
 {
     ASSERT(!value.is_empty());
 
+    // An existing packed element is a plain writable data property, so there's no setter to look for.
+    if (m_indexed_properties.is_packed() && property_index < m_indexed_properties.array_like_size()) {
+        m_indexed_properties.put(this, property_index, value);
+        return true;
+    }
+
     // If there's a setter in the prototype chain, we go to the setter.
     // Otherwise, it goes in the own property storage.
     Object* object = this;
@@ -643,12 +674,69 @@ bool Object::put(PropertyName property_name, Value value)
                 call_native_property_setter(const_cast<Object*>(this), value_here, value);
                 return true;
             }
+            // The nearest property with this name shadows any setters further up the chain.
+            break;
         }
         object = object->prototype();
     }
     return put_own_property(*this, property_string, value, default_attributes, PutOwnPropertyMode::Put);
 }
 
+static bool is_plain_data_property(Value value)
+{
+    return !value.is_accessor() && !(value.is_object() && value.as_object().is_native_property());
+}
+
+Value Object::get_with_inline_cache(const FlyString& property_name, PropertyLookupCache& cache) const
+{
+    if (auto* entry = cache.find(shape().id())) {
+        const Object* holder = this;
+        if (entry->in_prototype) {
+            holder = shape().prototype();
+            if (holder->shape().id() != entry->prototype_shape_id)
+                holder = nullptr;
+        }
+        if (holder) {
+            auto value = holder->m_storage[entry->offset];
+            if (is_plain_data_property(value))
+                return value.value_or(js_undefined());
+            return get(property_name);
+        }
+    }
+
+    if (!is_proxy_object()) {
+        if (auto metadata = shape().lookup(property_name); metadata.has_value()) {
+            cache.add({ shape().id(), 0, static_cast<u32>(metadata.value().offset), false });
+        } else if (auto* prototype = shape().prototype(); prototype && !prototype->is_proxy_object()) {
+            if (auto prototype_metadata = prototype->shape().lookup(property_name); prototype_metadata.has_value())
+                cache.add({ shape().id(), prototype->shape().id(), static_cast<u32>(prototype_metadata.value().offset), true });
+        }
+    }
+    return get(property_name);
+}
+
+bool Object::put_with_inline_cache(const FlyString& property_name, Value value, PropertyLookupCache& cache)
+{
+    ASSERT(!value.is_empty());
+
+    // Only existing, writable own data properties are cached, so a hit can store the value directly.
+    if (auto* entry = cache.find(shape().id()); entry && !entry->in_prototype && m_is_extensible) {
+        auto& value_here = m_storage[entry->offset];
+        if (is_plain_data_property(value_here)) {
+            value_here = value;
+            did_store_reference(value);
+            return true;
+        }
+        return put(property_name, value);
+    }
+
+    if (!is_proxy_object() && m_is_extensible) {
+        if (auto metadata = shape().lookup(property_name); metadata.has_value() && metadata.value().attributes.is_writable())
+            cache.add({ shape().id(), 0, static_cast<u32>(metadata.value().offset), false });
+    }
+    return put(property_name, value);
+}
+
 bool Object::define_native_function(const FlyString& property_name, AK::Function<Value(Interpreter&)> native_function, i32 length, PropertyAttributes attribute)
 {
     auto* function = NativeFunction::create(interpreter(), interpreter().global_object(), property_name, move(native_function));
@@ -689,7 +777,9 @@ bool Object::has_own_property(PropertyName property_name) const
 {
     auto has_indexed_property = [&](u32 index) -> bool {
         if (is_string_object())
-            return index < static_cast<const StringObject*>(this)->primitive_string().string().length();
+            return index < static_cast<const StringObject*>(this)->primitive_string().length();
+        if (is_typed_array())
+            return index < static_cast<const TypedArrayBase*>(this)->array_length();
         return m_indexed_properties.has_index(index);
     };
 
@@ -80,6 +80,11 @@ public:
 
     virtual bool put(PropertyName, Value);
 
+    // Named property access through an inline cache owned by the call site.
+    // The property name must not be an array index.
+    Value get_with_inline_cache(const FlyString& property_name, PropertyLookupCache&) const;
+    bool put_with_inline_cache(const FlyString& property_name, Value, PropertyLookupCache&);
+
     Value get_own_property(const Object& this_object, PropertyName) const;
     Value get_own_properties(const Object& this_object, GetOwnPropertyMode, bool only_enumerable_properties = false) const;
     virtual Optional<PropertyDescriptor> get_own_property_descriptor(PropertyName) const;
@@ -94,7 +99,9 @@ public:
     virtual Value delete_property(PropertyName);
 
     virtual bool is_array() const { return false; }
+    virtual bool is_array_buffer() const { return false; }
     virtual bool is_boolean() const { return false; }
+    virtual bool is_data_view() const { return false; }
     virtual bool is_date() const { return false; }
     virtual bool is_error() const { return false; }
     virtual bool is_function() const { return false; }
@@ -106,6 +113,7 @@ public:
     virtual bool is_string_object() const { return false; }
     virtual bool is_symbol_object() const { return false; }
     virtual bool is_bigint_object() const { return false; }
+    virtual bool is_typed_array() const { return false; }
 
     virtual const char* class_name() const override { return "Object"; }
     virtual void visit_children(Cell::Visitor&) override;
@@ -126,7 +134,11 @@ public:
 
     const IndexedProperties& indexed_properties() const { return m_indexed_properties; }
     IndexedProperties& indexed_properties() { return m_indexed_properties; }
-    void set_indexed_property_elements(Vector<Value>&& values) { m_indexed_properties = IndexedProperties(move(values)); }
+    void set_indexed_property_elements(Vector<Value>&& values)
+    {
+        m_indexed_properties = IndexedProperties(*this, move(values));
+        did_store_references();
+    }
 
     Value invoke(const FlyString& property_name, Optional<MarkedValueList> arguments = {});
 
@@ -145,7 +157,7 @@ private:
     bool m_is_extensible { true };
     Shape* m_shape { nullptr };
     Vector<Value> m_storage;
-    IndexedProperties m_indexed_properties;
+    IndexedProperties m_indexed_properties { *this };
 };
 
 }
@@ -24,6 +24,8 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/PrimitiveString.h>
@@ -31,7 +33,16 @@
 namespace JS {
 
 PrimitiveString::PrimitiveString(String string)
-    : m_string(move(string))
+    : m_length(string.length())
+    , m_string(move(string))
+{
+}
+
+PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
+    : m_is_rope(true)
+    , m_length(lhs.length() + rhs.length())
+    , m_lhs(&lhs)
+    , m_rhs(&rhs)
 {
 }
 
@@ -39,6 +50,49 @@ PrimitiveString::~PrimitiveString()
 {
 }
 
+void PrimitiveString::visit_children(Visitor& visitor)
+{
+    Cell::visit_children(visitor);
+    if (m_is_rope) {
+        visitor.visit(m_lhs);
+        visitor.visit(m_rhs);
+    }
+}
+
+const FlyString& PrimitiveString::fly_string() const
+{
+    if (!m_has_fly_string) {
+        m_fly_string = string();
+        m_has_fly_string = true;
+    }
+    return m_fly_string;
+}
+
+void PrimitiveString::flatten() const
+{
+    ASSERT(m_is_rope);
+
+    // Ropes built in a loop are as deep as the loop is long, so walk them with an explicit stack.
+    StringBuilder builder(m_length);
+    Vector<const PrimitiveString*, 32> stack;
+    stack.append(m_rhs);
+    stack.append(m_lhs);
+    while (!stack.is_empty()) {
+        auto* current = stack.take_last();
+        if (current->m_is_rope) {
+            stack.append(current->m_rhs);
+            stack.append(current->m_lhs);
+            continue;
+        }
+        builder.append(current->m_string);
+    }
+
+    m_string = builder.to_string();
+    m_is_rope = false;
+    m_lhs = nullptr;
+    m_rhs = nullptr;
+}
+
 PrimitiveString* js_string(Heap& heap, String string)
 {
     return heap.allocate<PrimitiveString>(move(string));
@@ -46,7 +100,22 @@ PrimitiveString* js_string(Heap& heap, String string)
 
 PrimitiveString* js_string(Interpreter& interpreter, String string)
 {
-    return js_string(interpreter.heap(), string);
+    return js_string(interpreter.heap(), move(string));
+}
+
+PrimitiveString* js_rope_string(Interpreter& interpreter, PrimitiveString& lhs, PrimitiveString& rhs)
+{
+    if (lhs.length() == 0)
+        return &rhs;
+    if (rhs.length() == 0)
+        return &lhs;
+    if (lhs.length() + rhs.length() < MIN_ROPE_LENGTH) {
+        StringBuilder builder(lhs.length() + rhs.length());
+        builder.append(lhs.string());
+        builder.append(rhs.string());
+        return js_string(interpreter, builder.to_string());
+    }
+    return interpreter.heap().allocate<PrimitiveString>(lhs, rhs);
 }
 
 }
@@ -26,25 +26,52 @@
 
 #pragma once
 
+#include <AK/FlyString.h>
 #include <AK/String.h>
 #include <LibJS/Runtime/Cell.h>
 
 namespace JS {
 
+// Concatenations shorter than this are copied right away, since a rope node would cost more than the copy.
+static constexpr size_t MIN_ROPE_LENGTH = 64;
+
 class PrimitiveString final : public Cell {
 public:
     explicit PrimitiveString(String);
+    PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs);
     virtual ~PrimitiveString();
 
-    const String& string() const { return m_string; }
+    // A rope only records its two halves, the characters are copied once somebody asks for them.
+    const String& string() const
+    {
+        if (m_is_rope)
+            flatten();
+        return m_string;
+    }
+
+    size_t length() const { return m_length; }
+    bool is_rope() const { return m_is_rope; }
+
+    // Interned once, so strings used as computed property names don't hit the FlyString table on every access.
+    const FlyString& fly_string() const;
 
 private:
     virtual const char* class_name() const override { return "PrimitiveString"; }
+    virtual void visit_children(Visitor&) override;
+
+    void flatten() const;
 
-    String m_string;
+    mutable bool m_is_rope { false };
+    mutable bool m_has_fly_string { false };
+    size_t m_length { 0 };
+    mutable String m_string;
+    mutable FlyString m_fly_string;
+    mutable PrimitiveString* m_lhs { nullptr };
+    mutable PrimitiveString* m_rhs { nullptr };
 };
 
 PrimitiveString* js_string(Heap&, String);
 PrimitiveString* js_string(Interpreter&, String);
+PrimitiveString* js_rope_string(Interpreter&, PrimitiveString& lhs, PrimitiveString& rhs);
 
 }
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+namespace JS {
+
+// A small polymorphic inline cache for named property lookups, owned by the
+// AST node or bytecode instruction that performs the lookup.
+// Entries are keyed on Shape::id() rather than on Shape pointers, since the GC
+// may hand out the address of a dead shape to a new one.
+class PropertyLookupCache {
+public:
+    static constexpr size_t entry_count = 4;
+
+    struct Entry {
+        u64 shape_id { 0 };
+        // Only used for hits on the receiver's direct prototype.
+        u64 prototype_shape_id { 0 };
+        u32 offset { 0 };
+        bool in_prototype { false };
+    };
+
+    const Entry* find(u64 shape_id) const
+    {
+        for (auto& entry : m_entries) {
+            if (entry.shape_id == shape_id)
+                return &entry;
+        }
+        return nullptr;
+    }
+
+    void add(const Entry& entry)
+    {
+        // An entry for the same shape can only be stale (e.g. its prototype changed), so replace it.
+        for (auto& existing_entry : m_entries) {
+            if (existing_entry.shape_id == entry.shape_id) {
+                existing_entry = entry;
+                return;
+            }
+        }
+        m_entries[m_next_entry] = entry;
+        m_next_entry = (m_next_entry + 1) % entry_count;
+    }
+
+private:
+    Entry m_entries[entry_count];
+    u8 m_next_entry { 0 };
+};
+
+}
@@ -58,7 +58,10 @@ Value RegExpConstructor::construct(Interpreter& interpreter)
     auto flags = interpreter.argument_count() > 1 ? interpreter.argument(1).to_string(interpreter) : "";
     if (interpreter.exception())
         return {};
-    return RegExpObject::create(interpreter.global_object(), contents, flags);
+    auto* regexp_object = RegExpObject::create(interpreter.global_object(), contents, flags);
+    if (!regexp_object)
+        return {};
+    return regexp_object;
 }
 
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Matthew Olsson <matthewcolsson@gmail.com>
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -27,30 +27,117 @@
 #include <AK/StringBuilder.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/Array.h>
+#include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/PrimitiveString.h>
 #include <LibJS/Runtime/RegExpObject.h>
 #include <LibJS/Runtime/Value.h>
 
-
 namespace JS {
 
+static Optional<char> find_invalid_flag(const String& flags)
+{
+    for (size_t i = 0; i < flags.length(); ++i) {
+        auto flag = flags[i];
+        if (!strchr("gimsuy", flag))
+            return flag;
+        for (size_t j = 0; j < i; ++j) {
+            if (flags[j] == flag)
+                return flag;
+        }
+    }
+    return {};
+}
+
+static Regex::Options options_from_flags(const String& flags)
+{
+    Regex::Options options;
+    options.ignore_case = flags.contains("i");
+    options.multiline = flags.contains("m");
+    options.dot_all = flags.contains("s");
+    return options;
+}
+
 RegExpObject* RegExpObject::create(GlobalObject& global_object, String content, String flags)
 {
-    return global_object.heap().allocate<RegExpObject>(content, flags, *global_object.regexp_prototype());
+    auto& interpreter = global_object.interpreter();
+    auto invalid_flag = find_invalid_flag(flags);
+    if (invalid_flag.has_value()) {
+        interpreter.throw_exception<SyntaxError>(String::format("Invalid regular expression flag '%c'", invalid_flag.value()));
+        return nullptr;
+    }
+    auto* regexp_object = global_object.heap().allocate<RegExpObject>(content, flags, *global_object.regexp_prototype());
+    if (regexp_object->pattern().has_error()) {
+        interpreter.throw_exception<SyntaxError>(String::format("Invalid regular expression /%s/: %s", content.characters(), regexp_object->pattern().error().characters()));
+        return nullptr;
+    }
+    return regexp_object;
 }
 
 RegExpObject::RegExpObject(String content, String flags, Object& prototype)
     : Object(&prototype)
     , m_content(content)
     , m_flags(flags)
+    , m_global(flags.contains("g"))
+    , m_ignore_case(flags.contains("i"))
+    , m_multiline(flags.contains("m"))
+    , m_dot_all(flags.contains("s"))
+    , m_unicode(flags.contains("u"))
+    , m_sticky(flags.contains("y"))
+    , m_pattern(content, options_from_flags(flags))
 {
+    define_property("lastIndex", Value(0), Attribute::Writable);
 }
 
 RegExpObject::~RegExpObject()
 {
 }
 
+Optional<Regex::Match> RegExpObject::execute(Interpreter& interpreter, const String& input)
+{
+    bool uses_last_index = m_global || m_sticky;
+    size_t last_index = 0;
+    if (uses_last_index) {
+        auto last_index_value = get("lastIndex").value_or(js_undefined()).to_number(interpreter);
+        if (interpreter.exception())
+            return {};
+        if (!last_index_value.is_nan() && last_index_value.as_double() > 0)
+            last_index = last_index_value.to_size_t(interpreter);
+        if (last_index > input.length()) {
+            put("lastIndex", Value(0));
+            return {};
+        }
+    }
+
+    auto match = m_sticky ? m_pattern.match_at(input, last_index) : m_pattern.search(input, last_index);
+    if (uses_last_index)
+        put("lastIndex", Value(match.has_value() ? static_cast<i32>(match.value().range().end) : 0));
+    return match;
+}
+
+Array* RegExpObject::create_match_array(const String& input, const Regex::Match& match) const
+{
+    auto& interpreter = this->interpreter();
+    auto* array = Array::create(interpreter.global_object());
+    for (auto& capture : match.captures) {
+        if (capture.has_value())
+            array->indexed_properties().append(js_string(interpreter, substring(input, capture.value())));
+        else
+            array->indexed_properties().append(js_undefined());
+    }
+    array->put("index", Value(static_cast<i32>(match.range().start)));
+    array->put("input", js_string(interpreter, input));
+    return array;
+}
+
+String RegExpObject::substring(const String& input, const Regex::Range& range)
+{
+    if (!range.length())
+        return String::empty();
+    return input.substring(range.start, range.length());
+}
+
 Value RegExpObject::to_string() const
 {
     return js_string(interpreter(), String::format("/%s/%s", content().characters(), flags().characters()));
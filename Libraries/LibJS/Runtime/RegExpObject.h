@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Matthew Olsson <matthewcolsson@gmail.com>
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -28,11 +28,13 @@
 
 #include <LibJS/AST.h>
 #include <LibJS/Runtime/Object.h>
+#include <LibRegex/Pattern.h>
 
 namespace JS {
 
 class RegExpObject : public Object {
 public:
+    // Throws a SyntaxError and returns nullptr if the flags or the pattern are invalid.
     static RegExpObject* create(GlobalObject&, String content, String flags);
 
     RegExpObject(String content, String flags, Object& prototype);
@@ -40,6 +42,24 @@ public:
 
     const String& content() const { return m_content; }
     const String& flags() const { return m_flags; }
+    const Regex::Pattern& pattern() const { return m_pattern; }
+
+    bool global() const { return m_global; }
+    bool ignore_case() const { return m_ignore_case; }
+    bool multiline() const { return m_multiline; }
+    bool dot_all() const { return m_dot_all; }
+    bool unicode() const { return m_unicode; }
+    bool sticky() const { return m_sticky; }
+
+    // Matches against input the way RegExp.prototype.exec does: global and sticky regexps start at,
+    // and update, lastIndex. Sticky regexps only match at lastIndex.
+    Optional<Regex::Match> execute(Interpreter&, const String& input);
+
+    // Builds the array exec() returns for a match: the matched strings, plus index and input.
+    Array* create_match_array(const String& input, const Regex::Match&) const;
+
+    // Unlike String::substring(), this returns an empty string rather than a null one for empty ranges.
+    static String substring(const String& input, const Regex::Range&);
 
     Value to_string() const override;
 
@@ -49,6 +69,13 @@ private:
 
     String m_content;
     String m_flags;
+    bool m_global { false };
+    bool m_ignore_case { false };
+    bool m_multiline { false };
+    bool m_dot_all { false };
+    bool m_unicode { false };
+    bool m_sticky { false };
+    Regex::Pattern m_pattern;
 };
 
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Matthew Olsson <matthewcolsson@gmail.com>
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -28,6 +28,8 @@
 #include <AK/StringBuilder.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/Array.h>
+#include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/PrimitiveString.h>
 #include <LibJS/Runtime/RegExpObject.h>
@@ -38,10 +40,125 @@ namespace JS {
 RegExpPrototype::RegExpPrototype()
     : RegExpObject({}, {}, *interpreter().global_object().object_prototype())
 {
+    u8 attr = Attribute::Writable | Attribute::Configurable;
+    define_native_property("source", source_getter, nullptr, Attribute::Configurable);
+    define_native_property("flags", flags_getter, nullptr, Attribute::Configurable);
+    define_native_property("global", global_getter, nullptr, Attribute::Configurable);
+    define_native_property("ignoreCase", ignore_case_getter, nullptr, Attribute::Configurable);
+    define_native_property("multiline", multiline_getter, nullptr, Attribute::Configurable);
+    define_native_property("dotAll", dot_all_getter, nullptr, Attribute::Configurable);
+    define_native_property("unicode", unicode_getter, nullptr, Attribute::Configurable);
+    define_native_property("sticky", sticky_getter, nullptr, Attribute::Configurable);
+
+    define_native_function("exec", exec, 1, attr);
+    define_native_function("test", test, 1, attr);
+    define_native_function("toString", to_string, 0, attr);
 }
 
 RegExpPrototype::~RegExpPrototype()
 {
 }
 
+static RegExpObject* regexp_object_from(Interpreter& interpreter)
+{
+    auto* this_object = interpreter.this_value().to_object(interpreter);
+    if (!this_object)
+        return nullptr;
+    if (!this_object->is_regexp_object()) {
+        interpreter.throw_exception<TypeError>("Not a RegExp object");
+        return nullptr;
+    }
+    return static_cast<RegExpObject*>(this_object);
+}
+
+Value RegExpPrototype::source_getter(Interpreter& interpreter)
+{
+    auto* regexp_object = regexp_object_from(interpreter);
+    if (!regexp_object)
+        return {};
+    if (regexp_object->content().is_empty())
+        return js_string(interpreter, "(?:)");
+    return js_string(interpreter, regexp_object->content());
+}
+
+Value RegExpPrototype::flags_getter(Interpreter& interpreter)
+{
+    auto* regexp_object = regexp_object_from(interpreter);
+    if (!regexp_object)
+        return {};
+    StringBuilder builder;
+    if (regexp_object->global())
+        builder.append('g');
+    if (regexp_object->ignore_case())
+        builder.append('i');
+    if (regexp_object->multiline())
+        builder.append('m');
+    if (regexp_object->dot_all())
+        builder.append('s');
+    if (regexp_object->unicode())
+        builder.append('u');
+    if (regexp_object->sticky())
+        builder.append('y');
+    return js_string(interpreter, builder.to_string());
+}
+
+#define DEFINE_FLAG_GETTER(getter_name, flag_name)                          \
+    Value RegExpPrototype::getter_name(Interpreter& interpreter)            \
+    {                                                                       \
+        auto* regexp_object = regexp_object_from(interpreter);              \
+        if (!regexp_object)                                                 \
+            return {};                                                      \
+        return Value(regexp_object->flag_name());                           \
+    }
+
+DEFINE_FLAG_GETTER(global_getter, global)
+DEFINE_FLAG_GETTER(ignore_case_getter, ignore_case)
+DEFINE_FLAG_GETTER(multiline_getter, multiline)
+DEFINE_FLAG_GETTER(dot_all_getter, dot_all)
+DEFINE_FLAG_GETTER(unicode_getter, unicode)
+DEFINE_FLAG_GETTER(sticky_getter, sticky)
+
+#undef DEFINE_FLAG_GETTER
+
+Value RegExpPrototype::exec(Interpreter& interpreter)
+{
+    auto* regexp_object = regexp_object_from(interpreter);
+    if (!regexp_object)
+        return {};
+    auto input = interpreter.argument(0).to_string(interpreter);
+    if (interpreter.exception())
+        return {};
+    auto match = regexp_object->execute(interpreter, input);
+    if (interpreter.exception())
+        return {};
+    if (!match.has_value())
+        return js_null();
+    return regexp_object->create_match_array(input, match.value());
+}
+
+Value RegExpPrototype::test(Interpreter& interpreter)
+{
+    auto* regexp_object = regexp_object_from(interpreter);
+    if (!regexp_object)
+        return {};
+    auto input = interpreter.argument(0).to_string(interpreter);
+    if (interpreter.exception())
+        return {};
+    // Without lastIndex to update, where the match is doesn't matter, so the cheaper DFA check is enough.
+    if (!regexp_object->global() && !regexp_object->sticky())
+        return Value(regexp_object->pattern().has_match(input));
+    auto match = regexp_object->execute(interpreter, input);
+    if (interpreter.exception())
+        return {};
+    return Value(match.has_value());
+}
+
+Value RegExpPrototype::to_string(Interpreter& interpreter)
+{
+    auto* regexp_object = regexp_object_from(interpreter);
+    if (!regexp_object)
+        return {};
+    return regexp_object->to_string();
+}
+
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Matthew Olsson <matthewcolsson@gmail.com>
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -37,6 +37,19 @@ public:
 
 private:
     virtual const char* class_name() const override { return "RegExpPrototype"; }
+
+    static Value source_getter(Interpreter&);
+    static Value flags_getter(Interpreter&);
+    static Value global_getter(Interpreter&);
+    static Value ignore_case_getter(Interpreter&);
+    static Value multiline_getter(Interpreter&);
+    static Value dot_all_getter(Interpreter&);
+    static Value unicode_getter(Interpreter&);
+    static Value sticky_getter(Interpreter&);
+
+    static Value exec(Interpreter&);
+    static Value test(Interpreter&);
+    static Value to_string(Interpreter&);
 };
 
 }
@@ -79,21 +79,12 @@ void ScriptFunction::visit_children(Visitor& visitor)
 
 LexicalEnvironment* ScriptFunction::create_environment()
 {
-    HashMap<FlyString, Variable> variables;
-    for (auto& parameter : m_parameters) {
-        variables.set(parameter.name, { js_undefined(), DeclarationKind::Var });
-    }
-
-    if (body().is_scope_node()) {
-        for (auto& declaration : static_cast<const ScopeNode&>(body()).variables()) {
-            for (auto& declarator : declaration.declarations()) {
-                variables.set(declarator.id().string(), { js_undefined(), DeclarationKind::Var });
-            }
-        }
-    }
-    if (variables.is_empty())
+    // The parser gives function bodies a layout covering both the parameters and the variables.
+    ASSERT(body().is_scope_node());
+    auto& layout = static_cast<const ScopeNode&>(body()).environment_layout();
+    if (layout.is_empty())
         return m_parent_environment;
-    return heap().allocate<LexicalEnvironment>(move(variables), m_parent_environment);
+    return heap().allocate<LexicalEnvironment>(layout, m_parent_environment);
 }
 
 Value ScriptFunction::call(Interpreter& interpreter)
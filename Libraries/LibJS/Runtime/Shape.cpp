@@ -29,6 +29,13 @@
 
 namespace JS {
 
+static u64 s_next_shape_id = 1;
+
+void Shape::assign_new_id()
+{
+    m_id = s_next_shape_id++;
+}
+
 Shape* Shape::create_unique_clone() const
 {
     auto* new_shape = heap().allocate<Shape>();
@@ -47,6 +54,7 @@ Shape* Shape::create_put_transition(const FlyString& property_name, PropertyAttr
         return existing_shape;
     auto* new_shape = heap().allocate<Shape>(this, property_name, attributes, TransitionType::Put);
     m_forward_transitions.set(key, new_shape);
+    did_store_reference(new_shape);
     return new_shape;
 }
 
@@ -57,6 +65,7 @@ Shape* Shape::create_configure_transition(const FlyString& property_name, Proper
         return existing_shape;
     auto* new_shape = heap().allocate<Shape>(this, property_name, attributes, TransitionType::Configure);
     m_forward_transitions.set(key, new_shape);
+    did_store_reference(new_shape);
     return new_shape;
 }
 
@@ -67,6 +76,7 @@ Shape* Shape::create_prototype_transition(Object* new_prototype)
 
 Shape::Shape()
 {
+    assign_new_id();
 }
 
 Shape::Shape(Shape* previous_shape, const FlyString& property_name, PropertyAttributes attributes, TransitionType transition_type)
@@ -76,6 +86,7 @@ Shape::Shape(Shape* previous_shape, const FlyString& property_name, PropertyAttr
     , m_prototype(previous_shape->m_prototype)
     , m_transition_type(transition_type)
 {
+    assign_new_id();
 }
 
 Shape::Shape(Shape* previous_shape, Object* new_prototype)
@@ -83,6 +94,7 @@ Shape::Shape(Shape* previous_shape, Object* new_prototype)
     , m_prototype(new_prototype)
     , m_transition_type(TransitionType::Prototype)
 {
+    assign_new_id();
 }
 
 Shape::~Shape()
@@ -160,20 +172,30 @@ void Shape::ensure_property_table() const
     }
 }
 
+void Shape::set_prototype_without_transition(Object* new_prototype)
+{
+    m_prototype = new_prototype;
+    did_store_reference(m_prototype);
+    assign_new_id();
+}
+
 void Shape::add_property_to_unique_shape(const FlyString& property_name, PropertyAttributes attributes)
 {
     ASSERT(is_unique());
     ASSERT(m_property_table);
     ASSERT(!m_property_table->contains(property_name));
     m_property_table->set(property_name, { m_property_table->size(), attributes });
+    assign_new_id();
 }
 
 void Shape::reconfigure_property_in_unique_shape(const FlyString& property_name, PropertyAttributes attributes)
 {
     ASSERT(is_unique());
     ASSERT(m_property_table);
-    ASSERT(m_property_table->contains(property_name));
-    m_property_table->set(property_name, { m_property_table->size(), attributes });
+    auto it = m_property_table->find(property_name);
+    ASSERT(it != m_property_table->end());
+    it->value.attributes = attributes;
+    assign_new_id();
 }
 
 void Shape::remove_property_from_unique_shape(const FlyString& property_name, size_t offset)
@@ -186,6 +208,7 @@ void Shape::remove_property_from_unique_shape(const FlyString& property_name, si
         if (it.value.offset > offset)
             --it.value.offset;
     }
+    assign_new_id();
 }
 
 }
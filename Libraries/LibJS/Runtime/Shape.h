@@ -70,6 +70,10 @@ public:
     Shape* create_configure_transition(const FlyString& name, PropertyAttributes attributes);
     Shape* create_prototype_transition(Object* new_prototype);
 
+    // Identifies this shape's layout and prototype. Unique shapes are mutated in place,
+    // so they get a fresh ID every time that happens.
+    u64 id() const { return m_id; }
+
     bool is_unique() const { return m_unique; }
     Shape* create_unique_clone() const;
 
@@ -87,7 +91,7 @@ public:
 
     Vector<Property> property_table_ordered() const;
 
-    void set_prototype_without_transition(Object* new_prototype) { m_prototype = new_prototype; }
+    void set_prototype_without_transition(Object* new_prototype);
 
     void remove_property_from_unique_shape(const FlyString&, size_t offset);
     void add_property_to_unique_shape(const FlyString&, PropertyAttributes attributes);
@@ -99,6 +103,8 @@ private:
 
     void ensure_property_table() const;
 
+    void assign_new_id();
+
     mutable OwnPtr<HashMap<FlyString, PropertyMetadata>> m_property_table;
 
     HashMap<TransitionKey, Shape*> m_forward_transitions;
@@ -108,6 +114,7 @@ private:
     bool m_unique { false };
     Object* m_prototype { nullptr };
     TransitionType m_transition_type { TransitionType::Invalid };
+    u64 m_id { 0 };
 };
 
 }
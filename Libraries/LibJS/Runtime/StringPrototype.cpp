@@ -29,12 +29,16 @@
 #include <AK/StringBuilder.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/MarkedValueList.h>
 #include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/RegExpObject.h>
 #include <LibJS/Runtime/StringObject.h>
 #include <LibJS/Runtime/StringPrototype.h>
 #include <LibJS/Runtime/Value.h>
+#include <ctype.h>
 #include <string.h>
 
 namespace JS {
@@ -82,6 +86,10 @@ StringPrototype::StringPrototype()
     define_native_function("includes", includes, 1, attr);
     define_native_function("slice", slice, 2, attr);
     define_native_function("lastIndexOf", last_index_of, 1, attr);
+    define_native_function("match", match, 1, attr);
+    define_native_function("replace", replace, 2, attr);
+    define_native_function("search", search, 1, attr);
+    define_native_function("split", split, 2, attr);
 }
 
 StringPrototype::~StringPrototype()
@@ -186,7 +194,7 @@ Value StringPrototype::length_getter(Interpreter& interpreter)
     auto* string_object = string_object_from(interpreter);
     if (!string_object)
         return {};
-    return Value((i32)string_object->primitive_string().string().length());
+    return Value((i32)string_object->primitive_string().length());
 }
 
 Value StringPrototype::to_string(Interpreter& interpreter)
@@ -423,4 +431,327 @@ Value StringPrototype::last_index_of(Interpreter& interpreter)
     return Value(-1);
 }
 
+static RegExpObject* regexp_from(Interpreter& interpreter, Value value)
+{
+    if (value.is_object() && value.as_object().is_regexp_object())
+        return static_cast<RegExpObject*>(&value.as_object());
+    String pattern;
+    if (!value.is_undefined()) {
+        pattern = value.to_string(interpreter);
+        if (interpreter.exception())
+            return nullptr;
+    }
+    return RegExpObject::create(interpreter.global_object(), pattern, {});
+}
+
+// Steps past the code point at index, so that looping over empty matches never stops in the middle of one.
+static size_t advance_string_index(const String& string, size_t index)
+{
+    ++index;
+    while (index < string.length() && (static_cast<u8>(string[index]) & 0xc0) == 0x80)
+        ++index;
+    return index;
+}
+
+// Finds the leftmost match at or after start, or exactly at start for sticky regexps.
+static Optional<Regex::Match> find_match(const RegExpObject& regexp_object, const String& string, size_t start)
+{
+    if (regexp_object.sticky())
+        return regexp_object.pattern().match_at(string, start);
+    return regexp_object.pattern().search(string, start);
+}
+
+Value StringPrototype::match(Interpreter& interpreter)
+{
+    auto string = string_from(interpreter);
+    if (string.is_null())
+        return {};
+    auto* regexp_object = regexp_from(interpreter, interpreter.argument(0));
+    if (!regexp_object)
+        return {};
+
+    if (!regexp_object->global()) {
+        auto match = regexp_object->execute(interpreter, string);
+        if (interpreter.exception())
+            return {};
+        if (!match.has_value())
+            return js_null();
+        return regexp_object->create_match_array(string, match.value());
+    }
+
+    regexp_object->put("lastIndex", Value(0));
+    auto* matches = Array::create(interpreter.global_object());
+    size_t position = 0;
+    while (position <= string.length()) {
+        auto match = find_match(*regexp_object, string, position);
+        if (!match.has_value())
+            break;
+        auto range = match.value().range();
+        matches->indexed_properties().append(js_string(interpreter, RegExpObject::substring(string, range)));
+        position = range.length() ? range.end : advance_string_index(string, range.end);
+    }
+    if (matches->indexed_properties().is_empty())
+        return js_null();
+    return matches;
+}
+
+struct ReplacementMatch {
+    size_t position { 0 };
+    // captures[0] is the matched substring, the others are the capture groups that took part in the match.
+    Vector<Optional<String>> captures;
+};
+
+static ReplacementMatch replacement_match_from(const String& string, const Regex::Match& match)
+{
+    ReplacementMatch replacement_match;
+    replacement_match.position = match.range().start;
+    for (auto& capture : match.captures) {
+        if (capture.has_value())
+            replacement_match.captures.append(RegExpObject::substring(string, capture.value()));
+        else
+            replacement_match.captures.append(Optional<String>());
+    }
+    return replacement_match;
+}
+
+// Expands the $$, $&, $`, $' and $n patterns in a replacement string.
+static String expand_replacement(const String& replacement, const String& string, const ReplacementMatch& match)
+{
+    auto& matched = match.captures[0].value();
+    auto capture_group_count = match.captures.size() - 1;
+    StringBuilder builder;
+    for (size_t i = 0; i < replacement.length(); ++i) {
+        auto ch = replacement[i];
+        if (ch != '$' || i + 1 == replacement.length()) {
+            builder.append(ch);
+            continue;
+        }
+        auto next = replacement[i + 1];
+        if (next == '$') {
+            builder.append('$');
+            ++i;
+        } else if (next == '&') {
+            builder.append(matched);
+            ++i;
+        } else if (next == '`') {
+            builder.append(string.substring_view(0, match.position));
+            ++i;
+        } else if (next == '\'') {
+            auto tail_start = match.position + matched.length();
+            builder.append(string.substring_view(tail_start, string.length() - tail_start));
+            ++i;
+        } else if (isdigit(next)) {
+            size_t group = next - '0';
+            size_t digits = 1;
+            if (i + 2 < replacement.length() && isdigit(replacement[i + 2])) {
+                size_t two_digit_group = group * 10 + (replacement[i + 2] - '0');
+                if (two_digit_group >= 1 && two_digit_group <= capture_group_count) {
+                    group = two_digit_group;
+                    digits = 2;
+                }
+            }
+            if (group < 1 || group > capture_group_count) {
+                builder.append(ch);
+                continue;
+            }
+            if (match.captures[group].has_value())
+                builder.append(match.captures[group].value());
+            i += digits;
+        } else {
+            builder.append(ch);
+        }
+    }
+    return builder.to_string();
+}
+
+static String replacement_for(Interpreter& interpreter, Value replace_value, const String& string, const ReplacementMatch& match)
+{
+    if (!replace_value.is_function())
+        return expand_replacement(replace_value.to_string(interpreter), string, match);
+
+    MarkedValueList arguments(interpreter.heap());
+    for (auto& capture : match.captures) {
+        if (capture.has_value())
+            arguments.append(js_string(interpreter, capture.value()));
+        else
+            arguments.append(js_undefined());
+    }
+    arguments.append(Value(static_cast<i32>(match.position)));
+    arguments.append(js_string(interpreter, string));
+    auto result = interpreter.call(replace_value.as_function(), js_undefined(), move(arguments));
+    if (interpreter.exception())
+        return {};
+    return result.to_string(interpreter);
+}
+
+Value StringPrototype::replace(Interpreter& interpreter)
+{
+    auto string = string_from(interpreter);
+    if (string.is_null())
+        return {};
+    auto search_value = interpreter.argument(0);
+    auto replace_value = interpreter.argument(1);
+    if (!replace_value.is_function()) {
+        replace_value = js_string(interpreter, replace_value.to_string(interpreter));
+        if (interpreter.exception())
+            return {};
+    }
+
+    Vector<ReplacementMatch> matches;
+    if (search_value.is_object() && search_value.as_object().is_regexp_object()) {
+        auto& regexp_object = static_cast<RegExpObject&>(search_value.as_object());
+        if (regexp_object.global()) {
+            regexp_object.put("lastIndex", Value(0));
+            size_t position = 0;
+            while (position <= string.length()) {
+                auto match = find_match(regexp_object, string, position);
+                if (!match.has_value())
+                    break;
+                auto range = match.value().range();
+                matches.append(replacement_match_from(string, match.value()));
+                position = range.length() ? range.end : advance_string_index(string, range.end);
+            }
+        } else {
+            auto match = regexp_object.execute(interpreter, string);
+            if (interpreter.exception())
+                return {};
+            if (match.has_value())
+                matches.append(replacement_match_from(string, match.value()));
+        }
+    } else {
+        auto search_string = search_value.to_string(interpreter);
+        if (interpreter.exception())
+            return {};
+        auto position = string.index_of(search_string);
+        if (position.has_value()) {
+            ReplacementMatch match;
+            match.position = position.value();
+            match.captures.append(search_string);
+            matches.append(move(match));
+        }
+    }
+
+    if (matches.is_empty())
+        return js_string(interpreter, string);
+
+    StringBuilder builder;
+    size_t position = 0;
+    for (auto& match : matches) {
+        builder.append(string.substring_view(position, match.position - position));
+        auto replacement = replacement_for(interpreter, replace_value, string, match);
+        if (interpreter.exception())
+            return {};
+        builder.append(replacement);
+        position = match.position + match.captures[0].value().length();
+    }
+    builder.append(string.substring_view(position, string.length() - position));
+    return js_string(interpreter, builder.to_string());
+}
+
+Value StringPrototype::search(Interpreter& interpreter)
+{
+    auto string = string_from(interpreter);
+    if (string.is_null())
+        return {};
+    auto* regexp_object = regexp_from(interpreter, interpreter.argument(0));
+    if (!regexp_object)
+        return {};
+    // search() always starts at the beginning, whatever lastIndex says.
+    auto match = find_match(*regexp_object, string, 0);
+    if (!match.has_value())
+        return Value(-1);
+    return Value(static_cast<i32>(match.value().range().start));
+}
+
+Value StringPrototype::split(Interpreter& interpreter)
+{
+    auto string = string_from(interpreter);
+    if (string.is_null())
+        return {};
+    auto separator = interpreter.argument(0);
+    size_t limit = NumericLimits<u32>::max();
+    if (!interpreter.argument(1).is_undefined()) {
+        auto limit_value = interpreter.argument(1).to_number(interpreter);
+        if (interpreter.exception())
+            return {};
+        limit = limit_value.is_nan() ? 0 : static_cast<u32>(limit_value.to_i32(interpreter));
+    }
+
+    auto* parts = Array::create(interpreter.global_object());
+    auto append_part = [&](size_t start, size_t end) {
+        parts->indexed_properties().append(js_string(interpreter, RegExpObject::substring(string, { start, end })));
+        return parts->indexed_properties().array_like_size() >= limit;
+    };
+
+    if (limit == 0)
+        return parts;
+    if (separator.is_undefined()) {
+        append_part(0, string.length());
+        return parts;
+    }
+
+    if (separator.is_object() && separator.as_object().is_regexp_object()) {
+        auto& regexp_object = static_cast<RegExpObject&>(separator.as_object());
+        if (string.is_empty()) {
+            if (!regexp_object.pattern().match_at(string, 0).has_value())
+                append_part(0, 0);
+            return parts;
+        }
+        size_t part_start = 0;
+        size_t position = 0;
+        while (position < string.length()) {
+            auto match = regexp_object.pattern().search(string, position);
+            if (!match.has_value())
+                break;
+            auto range = match.value().range();
+            // A match at the very end, or an empty match where the last one ended, doesn't separate anything.
+            if (range.start >= string.length() || range.end == part_start) {
+                position = advance_string_index(string, range.start);
+                continue;
+            }
+            if (append_part(part_start, range.start))
+                return parts;
+            for (size_t i = 1; i < match.value().captures.size(); ++i) {
+                auto& capture = match.value().captures[i];
+                if (capture.has_value())
+                    parts->indexed_properties().append(js_string(interpreter, RegExpObject::substring(string, capture.value())));
+                else
+                    parts->indexed_properties().append(js_undefined());
+                if (parts->indexed_properties().array_like_size() >= limit)
+                    return parts;
+            }
+            part_start = range.end;
+            position = range.end;
+        }
+        append_part(part_start, string.length());
+        return parts;
+    }
+
+    auto separator_string = separator.to_string(interpreter);
+    if (interpreter.exception())
+        return {};
+    if (separator_string.is_empty()) {
+        for (size_t i = 0; i < string.length();) {
+            auto next = advance_string_index(string, i);
+            if (append_part(i, next))
+                return parts;
+            i = next;
+        }
+        return parts;
+    }
+    if (string.is_empty()) {
+        append_part(0, 0);
+        return parts;
+    }
+    size_t part_start = 0;
+    while (auto* found = strstr(string.characters() + part_start, separator_string.characters())) {
+        auto separator_start = static_cast<size_t>(found - string.characters());
+        if (append_part(part_start, separator_start))
+            return parts;
+        part_start = separator_start + separator_string.length();
+    }
+    append_part(part_start, string.length());
+    return parts;
+}
+
 }
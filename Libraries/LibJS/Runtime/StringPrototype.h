@@ -58,6 +58,10 @@ private:
     static Value includes(Interpreter&);
     static Value slice(Interpreter&);
     static Value last_index_of(Interpreter&);
+    static Value match(Interpreter&);
+    static Value replace(Interpreter&);
+    static Value search(Interpreter&);
+    static Value split(Interpreter&);
 };
 
 }
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/TypedArray.h>
+#include <stdlib.h>
+
+namespace JS {
+
+TypedArrayBase::TypedArrayBase(ArrayBuffer& array_buffer, u32 byte_offset, u32 array_length, Object& prototype)
+    : Object(&prototype)
+    , m_viewed_array_buffer(&array_buffer)
+    , m_byte_offset(byte_offset)
+    , m_array_length(array_length)
+{
+}
+
+TypedArrayBase::~TypedArrayBase()
+{
+}
+
+void TypedArrayBase::visit_children(Visitor& visitor)
+{
+    Object::visit_children(visitor);
+    visitor.visit(m_viewed_array_buffer);
+}
+
+// CanonicalNumericIndexString: the name is numeric if converting it to a number and back gives the same string.
+static Optional<double> canonical_numeric_index(const FlyString& name)
+{
+    if (name.is_empty())
+        return {};
+    char first = name.characters()[0];
+    if (!(first >= '0' && first <= '9') && first != '-' && first != 'I' && first != 'N')
+        return {};
+    if (name == "-0")
+        return -0.0;
+
+    char* end;
+    double number = strtod(name.characters(), &end);
+    if (*end)
+        return {};
+    String canonical;
+    if (number == trunc(number) && fabs(number) < 9e18)
+        canonical = String::number(static_cast<i64>(number));
+    else
+        canonical = Value(number).to_string_without_side_effects();
+    if (canonical != name)
+        return {};
+    return number;
+}
+
+Optional<i64> TypedArrayBase::numeric_index(const PropertyName& property_name) const
+{
+    if (property_name.is_number())
+        return static_cast<u32>(property_name.as_number()) < array_length() ? property_name.as_number() : -1;
+
+    auto number = canonical_numeric_index(property_name.as_string());
+    if (!number.has_value())
+        return {};
+    auto value = number.value();
+    if (value != trunc(value) || (value == 0 && signbit(value)) || value < 0 || value >= array_length())
+        return -1;
+    return static_cast<i64>(value);
+}
+
+Value TypedArrayBase::get(PropertyName property_name) const
+{
+    auto index = numeric_index(property_name);
+    if (!index.has_value())
+        return Object::get(property_name);
+    if (index.value() < 0)
+        return js_undefined();
+    return Object::get(static_cast<i32>(index.value()));
+}
+
+bool TypedArrayBase::put(PropertyName property_name, Value value)
+{
+    auto index = numeric_index(property_name);
+    if (!index.has_value())
+        return Object::put(property_name, value);
+    if (index.value() < 0) {
+        // The value is still converted, so any side effects of that happen even though it's dropped.
+        value.to_double(interpreter());
+        return !interpreter().exception();
+    }
+    return Object::put(static_cast<i32>(index.value()), value);
+}
+
+bool TypedArrayBase::has_property(PropertyName property_name) const
+{
+    auto index = numeric_index(property_name);
+    if (!index.has_value())
+        return Object::has_property(property_name);
+    return index.value() >= 0;
+}
+
+Optional<PropertyDescriptor> TypedArrayBase::get_own_property_descriptor(PropertyName property_name) const
+{
+    auto index = numeric_index(property_name);
+    if (!index.has_value())
+        return Object::get_own_property_descriptor(property_name);
+    if (index.value() < 0)
+        return {};
+    return PropertyDescriptor { default_attributes, Object::get(static_cast<i32>(index.value())), nullptr, nullptr };
+}
+
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, ArrayType)                                   \
+    ClassName* ClassName::create(GlobalObject& global_object, u32 array_length)                                            \
+    {                                                                                                                      \
+        auto* array_buffer = ArrayBuffer::create(global_object, array_length * sizeof(StorageType));                       \
+        return create(global_object, *array_buffer, 0, array_length);                                                      \
+    }                                                                                                                      \
+    ClassName* ClassName::create(GlobalObject& global_object, ArrayBuffer& array_buffer, u32 byte_offset, u32 array_length) \
+    {                                                                                                                      \
+        ASSERT(byte_offset % sizeof(StorageType) == 0);                                                                    \
+        ASSERT(byte_offset + array_length * sizeof(StorageType) <= array_buffer.byte_length());                            \
+        return global_object.heap().allocate<ClassName>(array_buffer, byte_offset, array_length, *global_object.snake_name##_prototype()); \
+    }                                                                                                                      \
+    ClassName::ClassName(ArrayBuffer& array_buffer, u32 byte_offset, u32 array_length, Object& prototype)                  \
+        : TypedArray(array_buffer, byte_offset, array_length, prototype)                                                   \
+    {                                                                                                                      \
+    }                                                                                                                      \
+    ClassName::~ClassName() { }                                                                                            \
+    TypedArrayBase* ClassName::create_view(GlobalObject& global_object, u32 byte_offset, u32 array_length)                 \
+    {                                                                                                                      \
+        return create(global_object, viewed_array_buffer(), byte_offset, array_length);                                    \
+    }
+
+JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+
+}
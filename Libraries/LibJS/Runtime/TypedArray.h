@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/StdLibExtras.h>
+#include <LibJS/Runtime/ArrayBuffer.h>
+#include <LibJS/Runtime/Object.h>
+#include <math.h>
+
+namespace JS {
+
+// Uint8ClampedArray elements are stored as plain bytes, but saturate instead of wrapping around.
+struct ClampedU8 {
+};
+
+template<typename T>
+struct TypedArrayElement {
+    using StorageType = T;
+
+    static constexpr bool is_floating_point = IsSame<T, float>::value || IsSame<T, double>::value;
+
+    static T from_double(double number)
+    {
+        if constexpr (is_floating_point) {
+            return static_cast<T>(number);
+        } else {
+            // Integer elements wrap around modulo 2^n, like ToInt8(), ToUint16() and friends.
+            if (!isfinite(number))
+                return 0;
+            auto modulo = fmod(trunc(number), 4294967296.0);
+            if (modulo < 0)
+                modulo += 4294967296.0;
+            return static_cast<T>(static_cast<u32>(modulo));
+        }
+    }
+
+    static Value to_value(T element)
+    {
+        if constexpr (is_floating_point || IsSame<T, u32>::value)
+            return Value(static_cast<double>(element));
+        else
+            return Value(static_cast<i32>(element));
+    }
+};
+
+template<>
+struct TypedArrayElement<ClampedU8> {
+    using StorageType = u8;
+
+    static u8 from_double(double number)
+    {
+        if (isnan(number) || number <= 0)
+            return 0;
+        if (number >= 255)
+            return 255;
+        // Ties round to even, so 0.5 becomes 0 and 1.5 becomes 2.
+        auto floored = floor(number);
+        if (number - floored > 0.5)
+            return floored + 1;
+        if (number - floored < 0.5)
+            return floored;
+        return static_cast<u8>(floored) % 2 ? floored + 1 : floored;
+    }
+
+    static Value to_value(u8 element) { return Value(static_cast<i32>(element)); }
+};
+
+class TypedArrayBase : public Object {
+public:
+    virtual ~TypedArrayBase() override;
+
+    ArrayBuffer& viewed_array_buffer() const { return *m_viewed_array_buffer; }
+    u32 byte_offset() const { return m_byte_offset; }
+    u32 array_length() const { return m_array_length; }
+    u32 byte_length() const { return m_array_length * element_size(); }
+
+    virtual size_t element_size() const = 0;
+
+    // Element accessors for in-bounds indices that skip the Value conversions, which may throw.
+    virtual double get_element(u32 index) const = 0;
+    virtual void set_element(u32 index, double) = 0;
+
+    // Creates another view of the same kind onto this view's buffer.
+    virtual TypedArrayBase* create_view(GlobalObject&, u32 byte_offset, u32 array_length) = 0;
+
+    // Property names that are the string form of some number, like "1.5" or "-0", address elements
+    // even when there can't be one there. Such accesses never reach ordinary properties.
+    virtual Value get(PropertyName) const override;
+    virtual bool put(PropertyName, Value) override;
+    virtual bool has_property(PropertyName) const override;
+    virtual Optional<PropertyDescriptor> get_own_property_descriptor(PropertyName) const override;
+
+protected:
+    TypedArrayBase(ArrayBuffer&, u32 byte_offset, u32 array_length, Object& prototype);
+
+private:
+    virtual bool is_typed_array() const override { return true; }
+
+    // Returns nothing for ordinary property names, and -1 for numeric ones that don't address an element.
+    Optional<i64> numeric_index(const PropertyName&) const;
+    virtual void visit_children(Visitor&) override;
+
+    ArrayBuffer* m_viewed_array_buffer { nullptr };
+    u32 m_byte_offset { 0 };
+    u32 m_array_length { 0 };
+};
+
+template<typename T>
+class TypedArray : public TypedArrayBase {
+public:
+    using Element = TypedArrayElement<T>;
+    using StorageType = typename Element::StorageType;
+
+    StorageType* data() { return reinterpret_cast<StorageType*>(viewed_array_buffer().buffer().data() + byte_offset()); }
+    const StorageType* data() const { return reinterpret_cast<const StorageType*>(viewed_array_buffer().buffer().data() + byte_offset()); }
+
+    virtual size_t element_size() const override { return sizeof(StorageType); }
+
+    virtual Value get_by_index(u32 property_index) const override
+    {
+        if (property_index >= array_length())
+            return js_undefined();
+        return Element::to_value(data()[property_index]);
+    }
+
+    virtual bool put_by_index(u32 property_index, Value value) override
+    {
+        auto number = value.to_double(interpreter());
+        if (interpreter().exception())
+            return false;
+        // Out of bounds writes are silently dropped, typed arrays never grow.
+        if (property_index < array_length())
+            data()[property_index] = Element::from_double(number);
+        return true;
+    }
+
+    virtual double get_element(u32 index) const override
+    {
+        ASSERT(index < array_length());
+        return data()[index];
+    }
+
+    virtual void set_element(u32 index, double number) override
+    {
+        ASSERT(index < array_length());
+        data()[index] = Element::from_double(number);
+    }
+
+protected:
+    TypedArray(ArrayBuffer& array_buffer, u32 byte_offset, u32 array_length, Object& prototype)
+        : TypedArrayBase(array_buffer, byte_offset, array_length, prototype)
+    {
+    }
+};
+
+#define JS_DECLARE_TYPED_ARRAY(ClassName, snake_name, PrototypeName, ConstructorName, ArrayType)        \
+    class ClassName final : public TypedArray<ArrayType> {                                              \
+    public:                                                                                             \
+        static ClassName* create(GlobalObject&, u32 array_length);                                      \
+        static ClassName* create(GlobalObject&, ArrayBuffer&, u32 byte_offset, u32 array_length);       \
+                                                                                                        \
+        ClassName(ArrayBuffer&, u32 byte_offset, u32 array_length, Object& prototype);                  \
+        virtual ~ClassName() override;                                                                  \
+                                                                                                        \
+        virtual TypedArrayBase* create_view(GlobalObject&, u32 byte_offset, u32 array_length) override; \
+                                                                                                        \
+    private:                                                                                            \
+        virtual const char* class_name() const override { return #ClassName; }                          \
+    };
+
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, ArrayType) \
+    JS_DECLARE_TYPED_ARRAY(ClassName, snake_name, PrototypeName, ConstructorName, ArrayType)
+JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+
+}
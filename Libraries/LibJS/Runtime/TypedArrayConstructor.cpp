@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/ArrayBuffer.h>
+#include <LibJS/Runtime/Error.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/TypedArray.h>
+#include <LibJS/Runtime/TypedArrayConstructor.h>
+
+namespace JS {
+
+TypedArrayConstructor::TypedArrayConstructor()
+    : NativeFunction("TypedArray", *interpreter().global_object().function_prototype())
+{
+    define_property("prototype", interpreter().global_object().typed_array_prototype(), 0);
+    define_property("length", Value(0), Attribute::Configurable);
+}
+
+TypedArrayConstructor::~TypedArrayConstructor()
+{
+}
+
+Value TypedArrayConstructor::call(Interpreter& interpreter)
+{
+    return construct(interpreter);
+}
+
+Value TypedArrayConstructor::construct(Interpreter& interpreter)
+{
+    return interpreter.throw_exception<TypeError>("Abstract class TypedArray not directly constructable");
+}
+
+template<typename ArrayType>
+static Value construct_typed_array(Interpreter& interpreter, const char* name)
+{
+    using StorageType = typename ArrayType::StorageType;
+    auto& global_object = interpreter.global_object();
+    auto first_argument = interpreter.argument(0);
+
+    if (!first_argument.is_object()) {
+        auto array_length = first_argument.to_index(interpreter);
+        if (interpreter.exception())
+            return {};
+        if (array_length > MAX_ARRAY_BUFFER_BYTE_LENGTH / sizeof(StorageType))
+            return interpreter.throw_exception<RangeError>("Invalid typed array length");
+        return ArrayType::create(global_object, array_length);
+    }
+
+    auto& object = first_argument.as_object();
+
+    if (object.is_array_buffer()) {
+        // A view onto an existing buffer, nothing is copied.
+        auto& array_buffer = static_cast<ArrayBuffer&>(object);
+        auto byte_offset = interpreter.argument(1).to_index(interpreter);
+        if (interpreter.exception())
+            return {};
+        if (byte_offset % sizeof(StorageType))
+            return interpreter.throw_exception<RangeError>(String::format("Start offset of %s should be a multiple of %zu", name, sizeof(StorageType)));
+        auto buffer_byte_length = array_buffer.byte_length();
+        if (byte_offset > buffer_byte_length)
+            return interpreter.throw_exception<RangeError>("Start offset is outside the bounds of the buffer");
+        size_t array_length;
+        if (interpreter.argument(2).is_undefined()) {
+            if (buffer_byte_length % sizeof(StorageType))
+                return interpreter.throw_exception<RangeError>(String::format("Byte length of %s should be a multiple of %zu", name, sizeof(StorageType)));
+            array_length = (buffer_byte_length - byte_offset) / sizeof(StorageType);
+        } else {
+            array_length = interpreter.argument(2).to_index(interpreter);
+            if (interpreter.exception())
+                return {};
+            if (array_length > (buffer_byte_length - byte_offset) / sizeof(StorageType))
+                return interpreter.throw_exception<RangeError>("Invalid typed array length");
+        }
+        return ArrayType::create(global_object, array_buffer, byte_offset, array_length);
+    }
+
+    if (object.is_typed_array()) {
+        auto& source = static_cast<TypedArrayBase&>(object);
+        auto array_length = source.array_length();
+        if (array_length > MAX_ARRAY_BUFFER_BYTE_LENGTH / sizeof(StorageType))
+            return interpreter.throw_exception<RangeError>("Invalid typed array length");
+        auto* typed_array = ArrayType::create(global_object, array_length);
+        for (u32 i = 0; i < array_length; ++i)
+            typed_array->set_element(i, source.get_element(i));
+        return typed_array;
+    }
+
+    // Anything else is treated as an array-like object.
+    auto length_property = object.get("length");
+    if (interpreter.exception())
+        return {};
+    auto array_length = length_property.to_size_t(interpreter);
+    if (interpreter.exception())
+        return {};
+    if (array_length > MAX_ARRAY_BUFFER_BYTE_LENGTH / sizeof(StorageType))
+        return interpreter.throw_exception<RangeError>("Invalid typed array length");
+    auto* typed_array = ArrayType::create(global_object, array_length);
+    for (size_t i = 0; i < array_length; ++i) {
+        auto value = object.get(i);
+        if (interpreter.exception())
+            return {};
+        auto number = value.to_double(interpreter);
+        if (interpreter.exception())
+            return {};
+        typed_array->set_element(i, number);
+    }
+    return typed_array;
+}
+
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, ArrayType)                                      \
+    ConstructorName::ConstructorName()                                                                                         \
+        : NativeFunction(static_cast<Object&>(*interpreter().global_object().typed_array_constructor()))                        \
+    {                                                                                                                          \
+        define_property("prototype", interpreter().global_object().snake_name##_prototype(), 0);                               \
+        define_property("length", Value(3), Attribute::Configurable);                                                          \
+        define_property("BYTES_PER_ELEMENT", Value(static_cast<i32>(sizeof(ClassName::StorageType))), 0);                      \
+    }                                                                                                                          \
+    ConstructorName::~ConstructorName() { }                                                                                    \
+    Value ConstructorName::call(Interpreter& interpreter)                                                                      \
+    {                                                                                                                          \
+        return interpreter.throw_exception<TypeError>(#ClassName " must be called with the \"new\" operator");                 \
+    }                                                                                                                          \
+    Value ConstructorName::construct(Interpreter& interpreter)                                                                 \
+    {                                                                                                                          \
+        return construct_typed_array<ClassName>(interpreter, #ClassName);                                                      \
+    }
+
+JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/Function.h>
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/Error.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/TypedArray.h>
+#include <LibJS/Runtime/TypedArrayPrototype.h>
+
+namespace JS {
+
+TypedArrayPrototype::TypedArrayPrototype()
+    : Object(interpreter().global_object().object_prototype())
+{
+    u8 attr = Attribute::Writable | Attribute::Configurable;
+    define_native_property("buffer", buffer_getter, nullptr, Attribute::Configurable);
+    define_native_property("byteLength", byte_length_getter, nullptr, Attribute::Configurable);
+    define_native_property("byteOffset", byte_offset_getter, nullptr, Attribute::Configurable);
+    define_native_property("length", length_getter, nullptr, Attribute::Configurable);
+
+    define_native_function("fill", fill, 1, attr);
+    define_native_function("join", join, 1, attr);
+    define_native_function("set", set, 1, attr);
+    define_native_function("subarray", subarray, 2, attr);
+}
+
+TypedArrayPrototype::~TypedArrayPrototype()
+{
+}
+
+static TypedArrayBase* typed_array_from(Interpreter& interpreter)
+{
+    auto* this_object = interpreter.this_value().to_object(interpreter);
+    if (!this_object)
+        return nullptr;
+    if (!this_object->is_typed_array()) {
+        interpreter.throw_exception<TypeError>("Not a TypedArray");
+        return nullptr;
+    }
+    return static_cast<TypedArrayBase*>(this_object);
+}
+
+Value TypedArrayPrototype::buffer_getter(Interpreter& interpreter)
+{
+    auto* typed_array = typed_array_from(interpreter);
+    if (!typed_array)
+        return {};
+    return &typed_array->viewed_array_buffer();
+}
+
+Value TypedArrayPrototype::byte_length_getter(Interpreter& interpreter)
+{
+    auto* typed_array = typed_array_from(interpreter);
+    if (!typed_array)
+        return {};
+    return Value(typed_array->byte_length());
+}
+
+Value TypedArrayPrototype::byte_offset_getter(Interpreter& interpreter)
+{
+    auto* typed_array = typed_array_from(interpreter);
+    if (!typed_array)
+        return {};
+    return Value(typed_array->byte_offset());
+}
+
+Value TypedArrayPrototype::length_getter(Interpreter& interpreter)
+{
+    auto* typed_array = typed_array_from(interpreter);
+    if (!typed_array)
+        return {};
+    return Value(typed_array->array_length());
+}
+
+Value TypedArrayPrototype::fill(Interpreter& interpreter)
+{
+    auto* typed_array = typed_array_from(interpreter);
+    if (!typed_array)
+        return {};
+
+    auto number = interpreter.argument(0).to_double(interpreter);
+    if (interpreter.exception())
+        return {};
+    auto array_length = typed_array->array_length();
+    auto start = resolve_relative_index(interpreter, interpreter.argument(1), array_length, 0);
+    if (interpreter.exception())
+        return {};
+    auto end = resolve_relative_index(interpreter, interpreter.argument(2), array_length, array_length);
+    if (interpreter.exception())
+        return {};
+
+    for (size_t i = start; i < end; ++i)
+        typed_array->set_element(i, number);
+    return typed_array;
+}
+
+Value TypedArrayPrototype::join(Interpreter& interpreter)
+{
+    auto* typed_array = typed_array_from(interpreter);
+    if (!typed_array)
+        return {};
+
+    String separator = ",";
+    if (!interpreter.argument(0).is_undefined()) {
+        separator = interpreter.argument(0).to_string(interpreter);
+        if (interpreter.exception())
+            return {};
+    }
+
+    StringBuilder builder;
+    for (u32 i = 0; i < typed_array->array_length(); ++i) {
+        if (i > 0)
+            builder.append(separator);
+        builder.append(Value(typed_array->get_element(i)).to_string_without_side_effects());
+    }
+    return js_string(interpreter, builder.to_string());
+}
+
+Value TypedArrayPrototype::set(Interpreter& interpreter)
+{
+    auto* typed_array = typed_array_from(interpreter);
+    if (!typed_array)
+        return {};
+
+    auto* source = interpreter.argument(0).to_object(interpreter);
+    if (!source)
+        return {};
+    auto offset = interpreter.argument(1).to_index(interpreter);
+    if (interpreter.exception())
+        return {};
+
+    if (source->is_typed_array()) {
+        auto& source_array = static_cast<TypedArrayBase&>(*source);
+        auto source_length = source_array.array_length();
+        if (offset + source_length > typed_array->array_length())
+            return interpreter.throw_exception<RangeError>("Source is too large");
+        // The source may be another view onto the same buffer, so read everything before writing anything.
+        Vector<double> numbers;
+        numbers.ensure_capacity(source_length);
+        for (u32 i = 0; i < source_length; ++i)
+            numbers.unchecked_append(source_array.get_element(i));
+        for (u32 i = 0; i < source_length; ++i)
+            typed_array->set_element(offset + i, numbers[i]);
+        return js_undefined();
+    }
+
+    auto length_property = source->get("length");
+    if (interpreter.exception())
+        return {};
+    auto source_length = length_property.to_size_t(interpreter);
+    if (interpreter.exception())
+        return {};
+    if (offset + source_length > typed_array->array_length())
+        return interpreter.throw_exception<RangeError>("Source is too large");
+    for (size_t i = 0; i < source_length; ++i) {
+        auto value = source->get(i);
+        if (interpreter.exception())
+            return {};
+        auto number = value.to_double(interpreter);
+        if (interpreter.exception())
+            return {};
+        typed_array->set_element(offset + i, number);
+    }
+    return js_undefined();
+}
+
+Value TypedArrayPrototype::subarray(Interpreter& interpreter)
+{
+    auto* typed_array = typed_array_from(interpreter);
+    if (!typed_array)
+        return {};
+
+    auto array_length = typed_array->array_length();
+    auto begin = resolve_relative_index(interpreter, interpreter.argument(0), array_length, 0);
+    if (interpreter.exception())
+        return {};
+    auto end = resolve_relative_index(interpreter, interpreter.argument(1), array_length, array_length);
+    if (interpreter.exception())
+        return {};
+
+    auto new_length = end > begin ? end - begin : 0;
+    auto byte_offset = typed_array->byte_offset() + begin * typed_array->element_size();
+    return typed_array->create_view(interpreter.global_object(), byte_offset, new_length);
+}
+
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, ArrayType)                   \
+    PrototypeName::PrototypeName()                                                                          \
+        : Object(interpreter().global_object().typed_array_prototype())                                     \
+    {                                                                                                       \
+        define_property("BYTES_PER_ELEMENT", Value(static_cast<i32>(sizeof(ClassName::StorageType))), 0);   \
+    }                                                                                                       \
+    PrototypeName::~PrototypeName() { }
+
+JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+
+}
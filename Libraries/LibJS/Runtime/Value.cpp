@@ -27,7 +27,6 @@
 
 #include <AK/FlyString.h>
 #include <AK/String.h>
-#include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
 #include <LibCrypto/BigInt/SignedBigInteger.h>
 #include <LibCrypto/NumberTheory/ModularFunctions.h>
@@ -108,7 +107,7 @@ String Value::to_string_without_side_effects() const
             return is_negative_infinity() ? "-Infinity" : "Infinity";
         if (is_integer())
             return String::number(as_i32());
-        return String::format("%.4f", m_value.as_double);
+        return String::number(m_value.as_double);
     case Type::String:
         return m_value.as_string->string();
     case Type::Symbol:
@@ -150,7 +149,7 @@ String Value::to_string(Interpreter& interpreter) const
             return is_negative_infinity() ? "-Infinity" : "Infinity";
         if (is_integer())
             return String::number(as_i32());
-        return String::format("%.4f", m_value.as_double);
+        return String::number(m_value.as_double);
     case Type::String:
         return m_value.as_string->string();
     case Type::Symbol:
@@ -360,6 +359,23 @@ size_t Value::to_size_t(Interpreter& interpreter) const
     return number.as_size_t();
 }
 
+size_t Value::to_index(Interpreter& interpreter) const
+{
+    if (is_undefined())
+        return 0;
+    auto number = to_number(interpreter);
+    if (interpreter.exception())
+        return 0;
+    if (number.is_nan())
+        return 0;
+    auto integer = trunc(number.as_double());
+    if (integer < 0 || integer > MAX_ARRAY_LIKE_INDEX) {
+        interpreter.throw_exception<RangeError>("Index must be a positive integer");
+        return 0;
+    }
+    return integer;
+}
+
 Value greater_than(Interpreter& interpreter, Value lhs, Value rhs)
 {
     TriState relation = abstract_relation(interpreter, false, lhs, rhs);
@@ -543,6 +559,16 @@ Value unsigned_right_shift(Interpreter& interpreter, Value lhs, Value rhs)
     return {};
 }
 
+static PrimitiveString* to_primitive_string(Interpreter& interpreter, Value value)
+{
+    if (value.is_string())
+        return &value.as_string();
+    auto string = value.to_string(interpreter);
+    if (interpreter.exception())
+        return nullptr;
+    return js_string(interpreter, string);
+}
+
 Value add(Interpreter& interpreter, Value lhs, Value rhs)
 {
     auto lhs_primitive = lhs.to_primitive(interpreter);
@@ -553,16 +579,13 @@ Value add(Interpreter& interpreter, Value lhs, Value rhs)
         return {};
 
     if (lhs_primitive.is_string() || rhs_primitive.is_string()) {
-        auto lhs_string = lhs_primitive.to_string(interpreter);
-        if (interpreter.exception())
+        auto* lhs_string = to_primitive_string(interpreter, lhs_primitive);
+        if (!lhs_string)
             return {};
-        auto rhs_string = rhs_primitive.to_string(interpreter);
-        if (interpreter.exception())
+        auto* rhs_string = to_primitive_string(interpreter, rhs_primitive);
+        if (!rhs_string)
             return {};
-        StringBuilder builder(lhs_string.length() + rhs_string.length());
-        builder.append(lhs_string);
-        builder.append(rhs_string);
-        return js_string(interpreter, builder.to_string());
+        return js_rope_string(interpreter, *lhs_string, *rhs_string);
     }
 
     auto lhs_numeric = lhs_primitive.to_numeric(interpreter);
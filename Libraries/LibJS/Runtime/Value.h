@@ -31,6 +31,7 @@
 #include <AK/LogStream.h>
 #include <AK/Types.h>
 #include <LibJS/Forward.h>
+#include <LibJS/Runtime/Cell.h>
 #include <math.h>
 
 // 2 ** 53 - 1
@@ -69,7 +70,7 @@ public:
     bool is_symbol() const { return m_type == Type::Symbol; }
     bool is_accessor() const { return m_type == Type::Accessor; };
     bool is_bigint() const { return m_type == Type::BigInt; };
-    bool is_cell() const { return is_string() || is_accessor() || is_object(); }
+    bool is_cell() const { return is_string() || is_accessor() || is_object() || is_bigint() || is_symbol(); }
     bool is_array() const;
     bool is_function() const;
 
@@ -235,6 +236,7 @@ public:
     double to_double(Interpreter&) const;
     i32 to_i32(Interpreter&) const;
     size_t to_size_t(Interpreter&) const;
+    size_t to_index(Interpreter&) const;
     bool to_boolean() const;
 
     String to_string_without_side_effects() const;
@@ -317,4 +319,10 @@ TriState abstract_relation(Interpreter& interpreter, bool left_first, Value lhs,
 
 const LogStream& operator<<(const LogStream&, const Value&);
 
+inline void Cell::did_store_reference(Value value)
+{
+    if (value.is_cell())
+        did_store_reference(value.as_cell());
+}
+
 }
@@ -0,0 +1,58 @@
+load("test-common.js");
+
+try {
+    assert(Array.prototype.sort.length === 1);
+
+    var numbers = [10, 9, 1, 100, 2];
+    assert(numbers.sort() === numbers);
+    assert(numbers.join() === "1,10,100,2,9");
+    numbers.sort(function (a, b) { return a - b; });
+    assert(numbers.join() === "1,2,9,10,100");
+    numbers.sort(function (a, b) { return b - a; });
+    assert(numbers.join() === "100,10,9,2,1");
+
+    assert(["b", "c", "a"].sort().join() === "a,b,c");
+    assert([2.5, -1, 0.5].sort(function (a, b) { return a - b; }).join() === "-1,0.5,2.5");
+    assert([].sort().length === 0);
+
+    var withUndefined = [3, undefined, 1, undefined, 2];
+    withUndefined.sort();
+    assert(withUndefined.length === 5);
+    assert(withUndefined.join() === "1,2,3,,");
+    assert(withUndefined[3] === undefined && withUndefined[4] === undefined);
+
+    var holey = [3, 1];
+    holey[4] = 2;
+    holey.sort();
+    assert(holey.length === 5);
+    assert(holey[0] === 1 && holey[1] === 2 && holey[2] === 3);
+    assert(!holey.hasOwnProperty(3) && !holey.hasOwnProperty(4));
+
+    var objects = [];
+    for (var i = 0; i < 300; ++i)
+        objects.push({ key: i % 3, order: i });
+    objects.sort(function (a, b) { return a.key - b.key; });
+    for (var i = 1; i < objects.length; ++i) {
+        assert(objects[i - 1].key <= objects[i].key);
+        if (objects[i - 1].key === objects[i].key)
+            assert(objects[i - 1].order < objects[i].order);
+    }
+
+    assertThrowsError(() => {
+        [1, 2].sort(42);
+    }, {
+        error: TypeError,
+        message: "42 is not a function"
+    });
+
+    assertThrowsError(() => {
+        [2, 1].sort(function () { throw new Error("comparison failed"); });
+    }, {
+        error: Error,
+        message: "comparison failed"
+    });
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
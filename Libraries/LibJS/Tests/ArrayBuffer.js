@@ -0,0 +1,42 @@
+load("test-common.js");
+
+try {
+    assert(ArrayBuffer.length === 1);
+    assert(ArrayBuffer.name === "ArrayBuffer");
+
+    var buffer = new ArrayBuffer(8);
+    assert(buffer.byteLength === 8);
+    assert(new ArrayBuffer().byteLength === 0);
+    assert(new Uint8Array(buffer)[7] === 0);
+
+    var bytes = new Uint8Array(buffer);
+    for (var i = 0; i < 8; ++i)
+        bytes[i] = i;
+    var sliced = buffer.slice(2, -2);
+    assert(sliced.byteLength === 4);
+    assert(new Uint8Array(sliced).join() === "2,3,4,5");
+    bytes[2] = 42;
+    assert(new Uint8Array(sliced)[0] === 2);
+    assert(buffer.slice(6, 2).byteLength === 0);
+
+    assert(ArrayBuffer.isView(bytes) === true);
+    assert(ArrayBuffer.isView(new DataView(buffer)) === true);
+    assert(ArrayBuffer.isView(buffer) === false);
+    assert(ArrayBuffer.isView([]) === false);
+
+    assertThrowsError(() => {
+        ArrayBuffer(8);
+    }, {
+        error: TypeError,
+        message: "ArrayBuffer must be called with the \"new\" operator",
+    });
+    assertThrowsError(() => {
+        new ArrayBuffer(-1);
+    }, {
+        error: RangeError,
+    });
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
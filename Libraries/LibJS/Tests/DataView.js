@@ -0,0 +1,57 @@
+load("test-common.js");
+
+try {
+    assert(DataView.length === 1);
+
+    var buffer = new ArrayBuffer(16);
+    var view = new DataView(buffer);
+    assert(view.buffer === buffer);
+    assert(view.byteLength === 16 && view.byteOffset === 0);
+
+    view.setUint16(0, 0x0102);
+    var bytes = new Uint8Array(buffer);
+    assert(bytes[0] === 0x01 && bytes[1] === 0x02);
+    assert(view.getUint16(0) === 0x0102);
+    assert(view.getUint16(0, true) === 0x0201);
+
+    view.setInt32(4, -2, true);
+    assert(bytes[4] === 0xfe && bytes[7] === 0xff);
+    assert(view.getInt32(4, true) === -2);
+    assert(view.getUint32(4, true) === 4294967294);
+    assert(view.getInt8(4) === -2 && view.getUint8(4) === 254);
+
+    view.setFloat64(8, Math.PI);
+    assert(view.getFloat64(8) === Math.PI);
+    assert(view.getFloat64(8, true) !== Math.PI);
+    view.setFloat32(0, 1.5, true);
+    assert(view.getFloat32(0, true) === 1.5);
+
+    var offsetView = new DataView(buffer, 4, 4);
+    assert(offsetView.byteOffset === 4 && offsetView.byteLength === 4);
+    assert(offsetView.getInt32(0, true) === -2);
+
+    assertThrowsError(() => {
+        offsetView.getInt32(1);
+    }, {
+        error: RangeError,
+    });
+    assertThrowsError(() => {
+        new DataView(buffer, 17);
+    }, {
+        error: RangeError,
+    });
+    assertThrowsError(() => {
+        new DataView(buffer, 8, 9);
+    }, {
+        error: RangeError,
+    });
+    assertThrowsError(() => {
+        new DataView([]);
+    }, {
+        error: TypeError,
+    });
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
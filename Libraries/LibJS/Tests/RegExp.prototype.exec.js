@@ -0,0 +1,89 @@
+load("test-common.js");
+
+try {
+    assert(RegExp.prototype.exec.length === 1);
+
+    var match = /b(c+)(x)?/.exec("abccd");
+    assert(match.length === 3);
+    assert(match[0] === "bcc");
+    assert(match[1] === "cc");
+    assert(match[2] === undefined);
+    assert(match.index === 1);
+    assert(match.input === "abccd");
+    assert(/z/.exec("abc") === null);
+
+    assert(/a+?/.exec("aaa")[0] === "a");
+    assert(/a{2,3}/.exec("aaaa")[0] === "aaa");
+    assert(/(a|ab)(c|bcd)(d*)/.exec("abcd")[0] === "abcd");
+    assert(/^abc$/.exec("abc")[0] === "abc");
+    assert(/^b/m.exec("a\nb").index === 2);
+    assert(/^b/.exec("a\nb") === null);
+    assert(/a.c/.exec("a\nc") === null);
+    assert(/a.c/s.exec("a\nc")[0] === "a\nc");
+    assert(/\bfoo\b/.exec("a foo b").index === 2);
+    assert(/[^a-c]+/.exec("abcdef")[0] === "def");
+    assert(/\d+/.exec("abc123")[0] === "123");
+    assert(/HELLO/i.exec("say hello")[0] === "hello");
+    assert(/(?:ab)+/.exec("ababab")[0] === "ababab");
+    assert(/(?<year>\d{4})/.exec("in 2020")[1] === "2020");
+    assert(/(\w+) \1/.exec("a bye bye")[0] === "bye bye");
+    assert(/(?<quote>['"]).*?\k<quote>/.exec("say 'hi'")[0] === "'hi'");
+    assert(/foo(?=bar)/.exec("foobaz foobar").index === 7);
+    assert(/foo(?!bar)/.exec("foobar foobaz").index === 7);
+    assert(/(?<=(\d+))x/.exec("123x")[1] === "123");
+    assert(/(?<!\$)\b\d+/.exec("$42 17")[0] === "17");
+    assert(/\u{1F600}/u.exec("x\u{1F600}").index === 1);
+
+    var global = /o/g;
+    assert(global.lastIndex === 0);
+    assert(global.exec("foo").index === 1);
+    assert(global.lastIndex === 2);
+    assert(global.exec("foo").index === 2);
+    assert(global.lastIndex === 3);
+    assert(global.exec("foo") === null);
+    assert(global.lastIndex === 0);
+
+    var sticky = /o/y;
+    assert(sticky.exec("foo") === null);
+    sticky.lastIndex = 1;
+    assert(sticky.exec("foo").index === 1);
+    assert(sticky.lastIndex === 2);
+
+    var regexp = /a/gimsuy;
+    assert(regexp.flags === "gimsuy");
+    assert(regexp.global && regexp.ignoreCase && regexp.multiline && regexp.dotAll && regexp.unicode && regexp.sticky);
+    assert(/a/.global === false);
+    assert(/a\/b/.source === "a\\/b");
+    assert(new RegExp().source === "(?:)");
+    assert(new RegExp("a+", "g").toString() === "/a+/g");
+
+    assertThrowsError(() => {
+        new RegExp("(");
+    }, {
+        error: SyntaxError,
+    });
+    assertThrowsError(() => {
+        new RegExp("a", "gg");
+    }, {
+        error: SyntaxError,
+    });
+    assertThrowsError(() => {
+        new RegExp("a", "x");
+    }, {
+        error: SyntaxError,
+    });
+    assertThrowsError(() => {
+        new RegExp("(?<a>x)\\k<b>");
+    }, {
+        error: SyntaxError,
+    });
+    assertThrowsError(() => {
+        RegExp.prototype.exec.call({}, "a");
+    }, {
+        error: TypeError,
+    });
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
@@ -0,0 +1,31 @@
+load("test-common.js");
+
+try {
+    assert(RegExp.prototype.test.length === 1);
+
+    assert(/abc/.test("xabcx") === true);
+    assert(/abc/.test("xabx") === false);
+    assert(/^\s*$/.test("  \t ") === true);
+    assert(/[a-z]+@[a-z]+\.com/.test("mail me@example.com now") === true);
+    assert(/colou?r/i.test("COLOR") === true);
+    assert(/a$/.test("ba\n") === false);
+    assert(/a$/m.test("ba\nc") === true);
+
+    var global = /a/g;
+    assert(global.test("aa") === true);
+    assert(global.lastIndex === 1);
+    assert(global.test("aa") === true);
+    assert(global.test("aa") === false);
+    assert(global.lastIndex === 0);
+
+    // Patterns that make backtracking matchers take exponential time still match in linear time.
+    var input = "a".repeat(5000);
+    assert(/(a*)*b/.test(input) === false);
+    assert(/^(a|aa)+$/.test(input) === true);
+    assert(/(a+)+b/.exec(input) === null);
+    assert(/(x+x+)+y/.test("x".repeat(5000)) === false);
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
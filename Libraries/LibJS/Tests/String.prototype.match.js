@@ -0,0 +1,29 @@
+load("test-common.js");
+
+try {
+    assert(String.prototype.match.length === 1);
+
+    var match = "abc123def".match(/(\d)(\d+)/);
+    assert(match[0] === "123");
+    assert(match[1] === "1");
+    assert(match[2] === "23");
+    assert(match.index === 3);
+    assert("abc".match(/\d/) === null);
+    assert("a.c".match(".")[0] === "a");
+    assert("abc".match()[0] === "");
+
+    var matches = "a1b22c333".match(/\d+/g);
+    assert(matches.length === 3);
+    assert(matches[0] === "1");
+    assert(matches[1] === "22");
+    assert(matches[2] === "333");
+    assert("abc".match(/\d/g) === null);
+
+    var empty = "abc".match(/x*/g);
+    assert(empty.length === 4);
+    assert(empty[3] === "");
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
@@ -0,0 +1,35 @@
+load("test-common.js");
+
+try {
+    assert(String.prototype.replace.length === 2);
+
+    assert("hello world".replace("o", "0") === "hell0 world");
+    assert("hello world".replace(/o/g, "0") === "hell0 w0rld");
+    assert("hello world".replace(/x/g, "0") === "hello world");
+    assert("aaa".replace(/a/, "b") === "baa");
+    assert("abc".replace(/b/, "[$&]") === "a[b]c");
+    assert("abc".replace(/b/, "[$`]") === "a[a]c");
+    assert("abc".replace(/b/, "[$']") === "a[c]c");
+    assert("abc".replace(/b/, "$$") === "a$c");
+    assert("abc".replace(/b/, "$") === "a$c");
+    assert("john smith".replace(/(\w+)\s(\w+)/, "$2, $1") === "smith, john");
+    assert("abc".replace(/(b)/, "$2") === "a$2c");
+    assert("abc".replace(/(b)(x)?/, "[$2]") === "a[]c");
+    assert("abc".replace(/x*/g, "-") === "-a-b-c-");
+
+    var calls = [];
+    var result = "a1b2".replace(/(\d)/g, function (match, digit, position, string) {
+        calls.push(position);
+        assert(string === "a1b2");
+        return "<" + digit * 2 + ">";
+    });
+    assert(result === "a<2>b<4>");
+    assert(calls.length === 2);
+    assert(calls[0] === 1);
+    assert(calls[1] === 3);
+    assert("abc".replace("b", () => "$&") === "a$&c");
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
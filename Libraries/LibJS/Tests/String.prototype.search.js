@@ -0,0 +1,17 @@
+load("test-common.js");
+
+try {
+    assert(String.prototype.search.length === 1);
+
+    assert("hello world".search(/o/) === 4);
+    assert("hello world".search(/x/) === -1);
+    assert("hello world".search("w.r") === 6);
+
+    var global = /o/g;
+    global.lastIndex = 5;
+    assert("hello world".search(global) === 4);
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
@@ -0,0 +1,41 @@
+load("test-common.js");
+
+try {
+    assert(String.prototype.split.length === 2);
+
+    var parts = "a,b,,c".split(",");
+    assert(parts.length === 4);
+    assert(parts[0] === "a");
+    assert(parts[2] === "");
+    assert(parts[3] === "c");
+
+    assert("abc".split().length === 1);
+    assert("abc".split()[0] === "abc");
+    assert("abc".split("").length === 3);
+    assert("".split(",").length === 1);
+    assert("".split("").length === 0);
+    assert("a,b,c".split(",", 2).length === 2);
+    assert("a,b,c".split(",", 0).length === 0);
+    assert("a::b".split("::")[1] === "b");
+
+    parts = "a1b22c".split(/\d+/);
+    assert(parts.length === 3);
+    assert(parts[1] === "b");
+    assert(parts[2] === "c");
+
+    parts = "a1b2c".split(/(\d)/);
+    assert(parts.length === 5);
+    assert(parts[1] === "1");
+    assert(parts[3] === "2");
+
+    parts = "abc".split(/(?:)/);
+    assert(parts.length === 3);
+    assert(parts[2] === "c");
+    assert("".split(/x/).length === 1);
+    assert("".split(/x*/).length === 0);
+    assert("one  two three".split(/\s+/).length === 3);
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
@@ -0,0 +1,68 @@
+load("test-common.js");
+
+try {
+    var numbers = [];
+    for (var i = 0; i < 1000; ++i)
+        numbers.push(i);
+    assert(numbers.length === 1000);
+    assert(numbers[999] === 999);
+    assert(numbers.indexOf(500) === 500);
+    assert(numbers.lastIndexOf(500) === 500);
+    assert(numbers.indexOf("500") === -1);
+    assert(numbers.includes(999));
+    assert(!numbers.includes(1000));
+
+    numbers[10] = 0.5;
+    assert(numbers.indexOf(0.5) === 10);
+    numbers[20] = -0;
+    assert(numbers.indexOf(0) === 0);
+    assert(numbers.lastIndexOf(0) === 20);
+    numbers[30] = NaN;
+    assert(numbers.indexOf(NaN) === -1);
+    assert(numbers.includes(NaN));
+    numbers[40] = "forty";
+    assert(numbers.indexOf("forty") === 40);
+    assert(numbers.indexOf(41) === 41);
+
+    var doubled = numbers.map(function (x) { return x * 2; });
+    assert(doubled.length === 1000);
+    assert(doubled[999] === 1998);
+
+    var sum = 0;
+    numbers.slice(100).forEach(function (x) { sum += x; });
+    assert(sum === (999 * 1000) / 2 - (99 * 100) / 2);
+
+    delete numbers[500];
+    assert(numbers.length === 1000);
+    assert(!numbers.hasOwnProperty(500));
+    assert(numbers.indexOf(500) === -1);
+    assert(numbers.indexOf(501) === 501);
+    var visited = 0;
+    numbers.forEach(function () { ++visited; });
+    assert(visited === 999);
+
+    var sparse = [1, 2, 3];
+    sparse[100000] = 4;
+    assert(sparse.length === 100001);
+    assert(sparse[100000] === 4);
+    assert(sparse[2] === 3);
+    assert(sparse[50000] === undefined);
+    assert(sparse.indexOf(4) === 100000);
+
+    var preallocated = new Array(5000);
+    assert(preallocated.length === 5000);
+    for (var i = 0; i < preallocated.length; ++i)
+        preallocated[i] = i;
+    assert(preallocated.indexOf(4999) === 4999);
+    var mapped = preallocated.map(function (x) { return x + 1; });
+    assert(mapped[4999] === 5000);
+
+    var shrinking = [1, 2, 3, 4];
+    shrinking.length = 0;
+    shrinking.push(1.5);
+    assert(shrinking.indexOf(1.5) === 0);
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
@@ -113,6 +113,13 @@ try {
         assert(!isStrictMode());
     })();
 
+    // An arrow function nested inside a parenthesized expression that turns out not to be one.
+    var c = 5;
+    var x = (a = (b) => 1, c + 1);
+    assert(x === 6);
+    assert(typeof a === "function");
+    assert(a() === 1);
+
     console.log("PASS");
 } catch {
     console.log("FAIL");
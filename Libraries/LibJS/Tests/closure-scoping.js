@@ -0,0 +1,76 @@
+load("test-common.js");
+
+try {
+    function makeCounter(start) {
+        var count = start;
+        return () => {
+            let step = 1;
+            {
+                let step = 10;
+                count += step;
+            }
+            count -= step;
+            return count;
+        };
+    }
+    var counter = makeCounter(5);
+    assert(counter() === 14);
+    assert(counter() === 23);
+
+    function outer(a) {
+        var b = 2;
+        function inner() {
+            return typeof a;
+        }
+        var nested = function (c) {
+            return a + b + c;
+        };
+        {
+            let b = 100;
+            assert(nested(3) === 6);
+            assert(b === 100);
+        }
+        return inner();
+    }
+    assert(outer(1) === "number");
+
+    function shadowing(x) {
+        let result = [];
+        for (let x = 0; x < 2; ++x) {
+            result.push(x);
+        }
+        result.push(x);
+        try {
+            throw "caught";
+        } catch (x) {
+            result.push(x);
+        }
+        result.push(x);
+        return result.join();
+    }
+    assert(shadowing(7) === "0,1,7,caught,7");
+
+    function defaults(a, b = a * 2) {
+        const c = a + b;
+        return c;
+    }
+    assert(defaults(3) === 9);
+
+    function assignToConst() {
+        {
+            const value = 1;
+            {
+                let other = 2;
+                value = other;
+            }
+        }
+    }
+    assertThrowsError(assignToConst, {
+        error: TypeError,
+        message: "Assignment to constant variable",
+    });
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
@@ -0,0 +1,33 @@
+load("test-common.js");
+
+try {
+    var before = console.memory;
+    assert(typeof before.cellsAllocated === "number");
+    assert(before.heapSize === before.heapBlocks * 16 * 1024);
+
+    var objects = [];
+    for (var i = 0; i < 25000; ++i)
+        objects.push({ i: i, name: "object " + i });
+    for (var i = 0; i < 25000; ++i)
+        ({ garbage: i });
+
+    var after = console.memory;
+    assert(after.cellsAllocated >= before.cellsAllocated + 50000);
+    assert(after.collections > before.collections);
+    assert(after.heapBlocks > before.heapBlocks);
+    assert(after.totalCollectionTime >= after.lastCollectionTime);
+
+    gc();
+    assert(console.memory.collections > after.collections);
+
+    var sum = 0;
+    for (var i = 0; i < objects.length; ++i) {
+        assert(objects[i].name === "object " + i);
+        sum += objects[i].i;
+    }
+    assert(sum === (25000 * 24999) / 2);
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
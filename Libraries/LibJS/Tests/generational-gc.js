@@ -0,0 +1,33 @@
+load("test-common.js");
+
+try {
+    var old = { items: [], child: null };
+    var oldArray = [];
+    function store(i) {
+        old.child = { value: "child " + i };
+        old.items[i % 10] = { value: "item " + i };
+        oldArray.push(["element " + i]);
+    }
+
+    gc();
+    var before = console.memory;
+    for (var i = 0; i < 5000; ++i) {
+        store(i);
+        for (var j = 0; j < 20; ++j)
+            ({ garbage: j });
+    }
+    var after = console.memory;
+    assert(after.youngGenerationCollections > before.youngGenerationCollections);
+    assert(after.collections >= after.youngGenerationCollections);
+
+    assert(old.child.value === "child 4999");
+    for (var i = 0; i < 10; ++i)
+        assert(old.items[i].value === "item " + (4990 + i));
+    assert(oldArray.length === 5000);
+    for (var i = 0; i < oldArray.length; ++i)
+        assert(oldArray[i][0] === "element " + i);
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
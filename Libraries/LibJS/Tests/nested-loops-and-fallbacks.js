@@ -0,0 +1,53 @@
+load("test-common.js");
+
+try {
+    var count = 0;
+    outer: for (var i = 0; i < 5; ++i) {
+        for (var j = 0; j < 5; ++j) {
+            if (j == 2)
+                continue outer;
+            ++count;
+        }
+    }
+    assert(count === 10);
+
+    count = 0;
+    for (var i = 0; i < 4; ++i) {
+        try {
+            if (i % 2)
+                continue;
+        } finally {
+            count += 10;
+        }
+        count++;
+    }
+    assert(count === 42);
+
+    var k = 0;
+    do {
+        k += 3;
+    } while (k < 10);
+    assert(k === 12);
+
+    var o = { value: 1, twice() { return this.value * 2; } };
+    o.value += 4;
+    o["value"] *= 2;
+    assert(o.twice() === 20);
+    assert((o.missing || "fallback") === "fallback");
+    assert((o.value && "set") === "set");
+
+    let total = 0;
+    for (let n = 0; n < 3; n++) {
+        const doubled = n * 2;
+        total = total + doubled;
+    }
+    assert(total === 6);
+
+    var x = 5;
+    assert(x++ === 5 && x === 6);
+    assert(--x === 5);
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
@@ -0,0 +1,86 @@
+load("test-common.js");
+
+try {
+    function getX(o) {
+        return o.x;
+    }
+    function setX(o, value) {
+        o.x = value;
+    }
+
+    var objects = [{ x: 1 }, { a: 0, x: 2 }, { b: 0, c: 0, x: 3 }, { d: 0, x: 4 }, { e: 0, f: 0, g: 0, x: 5 }, {}];
+    for (var round = 0; round < 3; ++round) {
+        for (var i = 0; i < objects.length - 1; ++i) {
+            assert(getX(objects[i]) === i + 1);
+            setX(objects[i], getX(objects[i]));
+        }
+        assert(getX(objects[objects.length - 1]) === undefined);
+    }
+
+    function Point(x) {
+        this.x = x;
+    }
+    Point.prototype.describe = function () {
+        return "point " + this.x;
+    };
+    var p = new Point(7);
+    for (var i = 0; i < 3; ++i)
+        assert(p.describe() === "point 7");
+    Point.prototype.describe = function () {
+        return "moved " + this.x;
+    };
+    assert(p.describe() === "moved 7");
+    p.describe = function () {
+        return "own";
+    };
+    assert(p.describe() === "own");
+    delete p.describe;
+    assert(p.describe() === "moved 7");
+
+    var o = { x: 1 };
+    for (var i = 0; i < 3; ++i)
+        assert(getX(o) === 1);
+    Object.defineProperty(o, "x", { get: () => 42, configurable: true });
+    assert(getX(o) === 42);
+
+    var readOnly = { x: 1 };
+    setX(readOnly, 2);
+    Object.defineProperty(readOnly, "x", { writable: false });
+    setX(readOnly, 3);
+    assert(readOnly.x === 2);
+
+    var parent = {};
+    var setterCalls = 0;
+    Object.defineProperty(parent, "x", { set: () => ++setterCalls, configurable: true });
+    var child = Object.setPrototypeOf({}, parent);
+    Object.defineProperty(child, "x", { value: 1, writable: true });
+    setX(child, 5);
+    assert(child.x === 5);
+    assert(setterCalls === 0);
+
+    var first = { y: "first" };
+    var second = { y: "second" };
+    var derived = Object.setPrototypeOf({}, first);
+    for (var i = 0; i < 3; ++i)
+        assert(derived.y === "first");
+    Object.setPrototypeOf(derived, second);
+    assert(derived.y === "second");
+
+    var big = {};
+    for (var i = 0; i < 150; ++i)
+        big["p" + i] = i;
+    for (var i = 0; i < 3; ++i)
+        assert(big.p149 === 149);
+    delete big.p0;
+    assert(big.p149 === 149);
+    big.p149 = "changed";
+    assert(big.p149 === "changed");
+
+    var proxy = new Proxy({ x: 1 }, { get: () => "trapped" });
+    assert(getX({ x: 1 }) === 1);
+    assert(getX(proxy) === "trapped");
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
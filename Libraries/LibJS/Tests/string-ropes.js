@@ -0,0 +1,64 @@
+load("test-common.js");
+
+try {
+    var s = "";
+    for (var i = 0; i < 10000; ++i)
+        s += "ab";
+    assert(s.length === 20000);
+    assert(s.charAt(0) === "a" && s.charAt(19999) === "b");
+    assert(s.indexOf("ba") === 1);
+
+    var parts = "";
+    for (var i = 0; i < 100; ++i)
+        parts = parts + i + ",";
+    gc();
+    assert(parts.length === 290);
+    assert(parts.startsWith("0,1,2,3,"));
+    assert(parts.substring(284) === "98,99,");
+
+    var left = "x".repeat(100);
+    var right = "y".repeat(100);
+    var both = left + right;
+    gc();
+    assert(both.length === 200);
+    assert(both === "x".repeat(100) + "y".repeat(100));
+    assert(both + "" === both);
+    assert("" + both === both);
+    assert((both + both).length === 400);
+
+    var prepended = "";
+    for (var i = 0; i < 1000; ++i)
+        prepended = i % 10 + prepended;
+    assert(prepended.length === 1000);
+    assert(prepended.substring(0, 10) === "9876543210");
+
+    // Ropes built in a loop are as deep as the loop is long; marking and flattening must not recurse.
+    var deep = "";
+    for (var i = 0; i < 300000; i++)
+        deep = deep + "ab";
+    gc();
+    assert(deep.length === 600000);
+    assert(deep.charAt(599999) === "b");
+
+    deep = "";
+    for (var i = 0; i < 2000000; i++)
+        deep = deep + "ab";
+    assert(deep.length === 4000000);
+    deep = "";
+
+    var object = {};
+    var longKey = "property".repeat(10);
+    object[longKey + "A"] = 1;
+    object["property".repeat(10) + "A"] += 1;
+    assert(object[longKey + "A"] === 2);
+    assert(Object.getOwnPropertyNames(object)[0] === longKey + "A");
+
+    var key = "k" + "ey";
+    object[key] = 3;
+    assert(object.key === 3);
+    assert(object[key] === 3);
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
@@ -0,0 +1,30 @@
+load("test-common.js");
+
+try {
+    assert(String(0) === "0");
+    assert(String(-0) === "0");
+    assert(String(42) === "42");
+    assert(String(-1.5) === "-1.5");
+    assert(String(0.1) === "0.1");
+    assert(String(0.1 + 0.2) === "0.30000000000000004");
+    assert(String(1 / 3) === "0.3333333333333333");
+    assert(String(123.456) === "123.456");
+    assert(String(2147483648) === "2147483648");
+    assert(String(1e20) === "100000000000000000000");
+    assert(String(1e21) === "1e+21");
+    assert(String(1.5e300) === "1.5e+300");
+    assert(String(0.000001) === "0.000001");
+    assert(String(1e-7) === "1e-7");
+    assert(String(-1.25e-7) === "-1.25e-7");
+    assert(String(5e-324) === "5e-324");
+    assert(String(1.7976931348623157e308) === "1.7976931348623157e+308");
+    assert(String(NaN) === "NaN");
+    assert(String(Infinity) === "Infinity");
+    assert(String(-Infinity) === "-Infinity");
+    assert(2.5 + "" === "2.5");
+    assert(`${0.5}` === "0.5");
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
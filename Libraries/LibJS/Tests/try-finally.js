@@ -0,0 +1,63 @@
+load("test-common.js");
+
+try {
+    var log = [];
+    try {
+        try {
+            throw 1;
+        } finally {
+            log.push([1, 2].join("-"));
+        }
+    } catch (e) {
+        log.push(e);
+    }
+    assert(log.length === 2);
+    assert(log[0] === "1-2");
+    assert(log[1] === 1);
+
+    try {
+        try {
+            throw 1;
+        } finally {
+            throw 2;
+        }
+    } catch (e) {
+        assert(e === 2);
+    }
+
+    try {
+        try {
+            throw 1;
+        } catch (e) {
+            throw e + 1;
+        } finally {
+            log.push("finally after rethrow");
+        }
+    } catch (e) {
+        assert(e === 2);
+    }
+    assert(log[2] === "finally after rethrow");
+
+    function returnFromFinally() {
+        try {
+            throw 1;
+        } finally {
+            return "finally";
+        }
+    }
+    assert(returnFromFinally() === "finally");
+
+    function returnThroughFinally() {
+        try {
+            return "try";
+        } finally {
+            log.push("ran");
+        }
+    }
+    assert(returnThroughFinally() === "try");
+    assert(log[3] === "ran");
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
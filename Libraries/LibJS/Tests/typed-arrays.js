@@ -0,0 +1,156 @@
+load("test-common.js");
+
+try {
+    var constructors = [
+        [Int8Array, 1], [Uint8Array, 1], [Uint8ClampedArray, 1],
+        [Int16Array, 2], [Uint16Array, 2], [Int32Array, 4], [Uint32Array, 4],
+        [Float32Array, 4], [Float64Array, 8],
+    ];
+    constructors.forEach(function (entry) {
+        var T = entry[0];
+        assert(T.BYTES_PER_ELEMENT === entry[1]);
+        assert(T.prototype.BYTES_PER_ELEMENT === entry[1]);
+        assert(T.length === 3);
+        var array = new T(4);
+        assert(array.length === 4);
+        assert(array.byteLength === 4 * entry[1]);
+        assert(array.byteOffset === 0);
+        assert(array.buffer.byteLength === 4 * entry[1]);
+        assert(array[0] === 0 && array[3] === 0);
+        assert(array[4] === undefined);
+        array[4] = 1;
+        assert(array.length === 4 && array[4] === undefined);
+        assertThrowsError(() => {
+            T(1);
+        }, {
+            error: TypeError,
+        });
+    });
+
+    var TypedArray = Object.getPrototypeOf(Int8Array);
+    assert(TypedArray.name === "TypedArray");
+    assert(Object.getPrototypeOf(Int8Array.prototype) === TypedArray.prototype);
+    assertThrowsError(() => {
+        new TypedArray();
+    }, {
+        error: TypeError,
+    });
+
+    var int8 = new Int8Array(3);
+    int8[0] = 127;
+    int8[1] = 128;
+    int8[2] = -129;
+    assert(int8[0] === 127 && int8[1] === -128 && int8[2] === 127);
+    assert(int8.join() === "127,-128,127");
+    assert(new Float64Array([1.5, 2]).join(" - ") === "1.5 - 2");
+
+    var uint8 = new Uint8Array([256, -1, 3.9]);
+    assert(uint8[0] === 0 && uint8[1] === 255 && uint8[2] === 3);
+
+    var clamped = new Uint8ClampedArray([300, -5, 1.5, 2.5, 0.5, NaN]);
+    assert(clamped[0] === 255 && clamped[1] === 0);
+    assert(clamped[2] === 2 && clamped[3] === 2 && clamped[4] === 0 && clamped[5] === 0);
+
+    var uint32 = new Uint32Array([-1]);
+    assert(uint32[0] === 4294967295);
+
+    var float32 = new Float32Array([0.1]);
+    assert(float32[0] !== 0.1 && Math.abs(float32[0] - 0.1) < 1e-7);
+    var float64 = new Float64Array([0.1, NaN]);
+    assert(float64[0] === 0.1 && isNaN(float64[1]));
+
+    // Views share their buffer.
+    var buffer = new ArrayBuffer(8);
+    var bytes = new Uint8Array(buffer);
+    var words = new Uint16Array(buffer, 2, 2);
+    assert(words.length === 2 && words.byteOffset === 2 && words.byteLength === 4);
+    assert(words.buffer === buffer);
+    words[0] = 0x0102;
+    assert(bytes[2] === 0x02 && bytes[3] === 0x01);
+    assert(new Uint32Array(buffer, 4).length === 1);
+    assertThrowsError(() => {
+        new Uint16Array(buffer, 1);
+    }, {
+        error: RangeError,
+    });
+    assertThrowsError(() => {
+        new Uint16Array(buffer, 2, 4);
+    }, {
+        error: RangeError,
+    });
+    assertThrowsError(() => {
+        new Uint16Array(new ArrayBuffer(3));
+    }, {
+        error: RangeError,
+    });
+
+    // Copying from another typed array converts each element.
+    var copy = new Int16Array(new Float64Array([1.5, -2.5, 70000]));
+    assert(copy[0] === 1 && copy[1] === -2 && copy[2] === 4464);
+
+    var sub = bytes.subarray(2, -2);
+    assert(sub.length === 4 && sub.byteOffset === 2);
+    sub[0] = 7;
+    assert(bytes[2] === 7);
+    assert(bytes.subarray(-1).length === 1);
+
+    var filled = new Int32Array(5).fill(9, 1, -1);
+    assert(filled[0] === 0 && filled[1] === 9 && filled[3] === 9 && filled[4] === 0);
+
+    var target = new Uint8Array(6);
+    target.set([1, 2, 3], 1);
+    assert(target[0] === 0 && target[1] === 1 && target[3] === 3);
+    target.set(new Float32Array([4.5, 300]), 4);
+    assert(target[4] === 4 && target[5] === 44);
+    // Overlapping views onto the same buffer.
+    target.set(target.subarray(0, 4), 2);
+    assert(target[2] === 0 && target[3] === 1 && target[4] === 2 && target[5] === 3);
+    assertThrowsError(() => {
+        target.set([1, 2], 5);
+    }, {
+        error: RangeError,
+    });
+
+    var large = new Float64Array(100000);
+    for (var i = 0; i < large.length; ++i)
+        large[i] = i;
+    var sum = 0;
+    for (var i = 0; i < large.length; ++i)
+        sum += large[i];
+    assert(sum === 4999950000);
+
+    // Elements are enumerable own properties, listed before any named ones.
+    var keyed = new Uint8Array([7, 8, 9]);
+    keyed.foo = 1;
+    assertArrayEquals(Object.keys(keyed), ["0", "1", "2", "foo"]);
+    assertArrayEquals(Object.values(keyed), [7, 8, 9, 1]);
+    assert(Object.entries(keyed)[1].join() === "1,8");
+    var forInKeys = [];
+    for (var key in keyed)
+        forInKeys.push(key);
+    assertArrayEquals(forInKeys, ["0", "1", "2", "foo"]);
+    assert(Object.keys(new Float32Array(0)).length === 0);
+    assert(keyed.hasOwnProperty(2) && !keyed.hasOwnProperty(3));
+    assert(2 in keyed && !(3 in keyed));
+    var descriptor = Object.getOwnPropertyDescriptor(keyed, 1);
+    assert(descriptor.value === 8 && descriptor.writable && descriptor.enumerable && descriptor.configurable);
+    assert(Object.getOwnPropertyDescriptor(keyed, 3) === undefined);
+
+    // Numeric keys that aren't valid indices never become ordinary properties.
+    keyed[1.5] = 3;
+    keyed[-1] = 3;
+    keyed["-0"] = 3;
+    keyed[3] = 3;
+    assert(keyed[1.5] === undefined && keyed[-1] === undefined && keyed["-0"] === undefined && keyed[3] === undefined);
+    assert(!("1.5" in keyed) && !("-0" in keyed));
+    assertArrayEquals(Object.keys(keyed), ["0", "1", "2", "foo"]);
+    keyed[-0] = 4;
+    assert(keyed[0] === 4);
+    // "1.0" isn't what 1 converts to, so it's an ordinary property name.
+    keyed["1.0"] = 5;
+    assert(keyed["1.0"] === 5 && keyed[1] === 8);
+
+    console.log("PASS");
+} catch (e) {
+    console.log("FAIL: " + e);
+}
@@ -29,6 +29,7 @@
 #include <AK/StdLibExtras.h>
 #include <Kernel/Syscall.h>
 #include <limits.h>
+#include <malloc.h>
 #include <pthread.h>
 #include <serenity.h>
 #include <signal.h>
@@ -85,6 +86,7 @@ static int create_thread(void* (*entry)(void*), void* argument, PthreadAttrImpl*
 
 static void exit_thread(void* code)
 {
+    __malloc_thread_exit();
     syscall(SC_exit_thread, code);
     ASSERT_NOT_REACHED();
 }
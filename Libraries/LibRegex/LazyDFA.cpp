@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/QuickSort.h>
+#include <LibRegex/LazyDFA.h>
+
+namespace Regex {
+
+bool LazyDFA::can_handle(const Program& program)
+{
+    return !program.multiline && !program.has_word_boundaries && !program.needs_backtracking;
+}
+
+LazyDFA::LazyDFA(const Program& program)
+    : m_program(program)
+{
+    ASSERT(can_handle(program));
+    m_marks.ensure_capacity(program.instructions.size());
+    for (size_t i = 0; i < program.instructions.size(); ++i)
+        m_marks.unchecked_append(0);
+}
+
+void LazyDFA::add_closure(Vector<u32>& kernel, u32 start_pc, bool at_begin, bool at_end)
+{
+    m_stack.append(start_pc);
+    while (!m_stack.is_empty()) {
+        auto pc = m_stack.take_last();
+        if (m_marks[pc] == m_generation)
+            continue;
+        m_marks[pc] = m_generation;
+
+        auto& instruction = m_program.instructions[pc];
+        switch (instruction.op) {
+        case OpCode::Jump:
+            m_stack.append(pc + instruction.argument);
+            break;
+        case OpCode::Split:
+            m_stack.append(pc + instruction.alternative);
+            m_stack.append(pc + instruction.argument);
+            break;
+        case OpCode::Save:
+        case OpCode::ClearCaptures:
+            m_stack.append(pc + 1);
+            break;
+        case OpCode::Fail:
+            break;
+        case OpCode::AssertBegin:
+            if (at_begin)
+                m_stack.append(pc + 1);
+            break;
+        case OpCode::AssertEnd:
+            // Whether we're at the end is only known once we run out of input, so keep it around until then.
+            if (at_end)
+                m_stack.append(pc + 1);
+            else
+                kernel.append(pc);
+            break;
+        case OpCode::Class:
+        case OpCode::Match:
+            kernel.append(pc);
+            break;
+        default:
+            ASSERT_NOT_REACHED();
+        }
+    }
+}
+
+i32 LazyDFA::state_for(const Vector<u32>& seeds, bool at_begin)
+{
+    ++m_generation;
+    Vector<u32> kernel;
+    for (auto seed : seeds)
+        add_closure(kernel, seed, at_begin, false);
+    quick_sort(kernel);
+
+    String key(reinterpret_cast<const char*>(kernel.data()), kernel.size() * sizeof(u32));
+    auto it = m_state_indices.find(key);
+    if (it != m_state_indices.end())
+        return it->value;
+
+    if (m_states.size() >= MAX_STATES)
+        return GAVE_UP;
+
+    auto state = make<State>();
+    for (auto pc : kernel) {
+        if (m_program.instructions[pc].op == OpCode::Match)
+            state->is_match = true;
+    }
+    state->pcs = move(kernel);
+    for (auto& next : state->next)
+        next = NOT_COMPUTED;
+
+    i32 index = m_states.size();
+    m_states.append(move(state));
+    m_state_indices.set(key, index);
+    return index;
+}
+
+i32 LazyDFA::transition(i32 state_index, u32 code_point)
+{
+    auto& state = m_states[state_index];
+    if (code_point < 128 && state.next[code_point] != NOT_COMPUTED)
+        return state.next[code_point];
+
+    m_seeds.clear_with_capacity();
+    for (auto pc : state.pcs) {
+        auto& instruction = m_program.instructions[pc];
+        if (instruction.op == OpCode::Class && m_program.classes[instruction.argument].matches(code_point))
+            m_seeds.append(pc + instruction.alternative);
+    }
+    // The search is unanchored, so a new attempt starts at every position.
+    m_seeds.append(0);
+
+    auto next = state_for(m_seeds, false);
+    if (code_point < 128 && next != GAVE_UP)
+        state.next[code_point] = next;
+    return next;
+}
+
+bool LazyDFA::accepts_at_end(i32 state_index, bool at_begin)
+{
+    auto& state = m_states[state_index];
+    if (!at_begin && state.accepts_at_end.has_value())
+        return state.accepts_at_end.value();
+
+    ++m_generation;
+    Vector<u32> kernel;
+    for (auto pc : state.pcs) {
+        if (m_program.instructions[pc].op == OpCode::AssertEnd)
+            add_closure(kernel, pc + 1, at_begin, true);
+    }
+    bool accepts = false;
+    for (auto pc : kernel) {
+        if (m_program.instructions[pc].op == OpCode::Match)
+            accepts = true;
+    }
+    if (!at_begin)
+        state.accepts_at_end = accepts;
+    return accepts;
+}
+
+Optional<bool> LazyDFA::has_match(const StringView& input, size_t start)
+{
+    m_seeds.clear_with_capacity();
+    m_seeds.append(0);
+    auto state_index = state_for(m_seeds, start == 0);
+    if (state_index == GAVE_UP)
+        return {};
+
+    auto* bytes = reinterpret_cast<const u8*>(input.characters_without_null_termination());
+    size_t position = start;
+    for (;;) {
+        if (m_states[state_index].is_match)
+            return true;
+        if (position >= input.length())
+            return accepts_at_end(state_index, position == 0);
+
+        u32 code_point = bytes[position];
+        size_t length = 1;
+        if (code_point >= 128)
+            code_point = decode_code_point(input, position, length);
+        state_index = transition(state_index, code_point);
+        if (state_index == GAVE_UP)
+            return {};
+        position += length;
+    }
+}
+
+}
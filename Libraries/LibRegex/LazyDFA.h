@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtrVector.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibRegex/Program.h>
+
+namespace Regex {
+
+// Answers "does this match anywhere?" by simulating the NFA with sets of states, and caching each set
+// it runs into as a DFA state along with its transitions for ASCII input. Only the states the input
+// actually reaches are ever built. Word boundaries and multiline anchors depend on both neighbouring
+// characters, so programs using them are left to the Pike VM, as are those that need backtracking.
+class LazyDFA {
+public:
+    static bool can_handle(const Program&);
+
+    explicit LazyDFA(const Program&);
+
+    // Returns an empty Optional if the DFA grew too large and the caller should fall back to the NFA.
+    Optional<bool> has_match(const StringView& input, size_t start);
+
+private:
+    static constexpr size_t MAX_STATES = 4096;
+    static constexpr i32 NOT_COMPUTED = -1;
+    static constexpr i32 GAVE_UP = -2;
+
+    struct State {
+        Vector<u32> pcs;
+        bool is_match { false };
+        Optional<bool> accepts_at_end;
+        i32 next[128];
+    };
+
+    i32 state_for(const Vector<u32>& seeds, bool at_begin);
+    i32 transition(i32 state_index, u32 code_point);
+    bool accepts_at_end(i32 state_index, bool at_begin);
+    void add_closure(Vector<u32>& kernel, u32 pc, bool at_begin, bool at_end);
+
+    const Program& m_program;
+    NonnullOwnPtrVector<State> m_states;
+    HashMap<String, i32> m_state_indices;
+    Vector<u32> m_marks;
+    u32 m_generation { 0 };
+    Vector<u32> m_stack;
+    Vector<u32> m_seeds;
+};
+
+}
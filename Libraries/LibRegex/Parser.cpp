@@ -0,0 +1,808 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <LibRegex/Parser.h>
+
+namespace Regex {
+
+// Counted repetition copies the atom, so these keep patterns like (a{1000}){1000} from exhausting memory.
+static constexpr size_t MAX_REPETITION_COUNT = 1000;
+static constexpr size_t MAX_PROGRAM_SIZE = 100000;
+
+static const CodePointRange s_digit_ranges[] = { { '0', '9' } };
+static const CodePointRange s_word_ranges[] = { { '0', '9' }, { 'A', 'Z' }, { '_', '_' }, { 'a', 'z' } };
+static const CodePointRange s_whitespace_ranges[] = {
+    { '\t', '\r' }, { ' ', ' ' }, { 0xa0, 0xa0 }, { 0x1680, 0x1680 }, { 0x2000, 0x200a },
+    { 0x2028, 0x2029 }, { 0x202f, 0x202f }, { 0x205f, 0x205f }, { 0x3000, 0x3000 }, { 0xfeff, 0xfeff }
+};
+static const CodePointRange s_line_terminator_ranges[] = { { '\n', '\n' }, { '\r', '\r' }, { 0x2028, 0x2029 } };
+
+template<size_t size>
+static void add_ranges(CharClass& char_class, const CodePointRange (&ranges)[size], bool negated)
+{
+    char_class.add_ranges(ranges, size, negated);
+}
+
+static void append(Vector<Instruction>& out, const Vector<Instruction>& fragment)
+{
+    out.append(fragment.data(), fragment.size());
+}
+
+static Vector<Instruction> alternation(const Vector<Instruction>& left, const Vector<Instruction>& right)
+{
+    Vector<Instruction> result;
+    result.append({ OpCode::Split, 1, static_cast<i32>(left.size()) + 2 });
+    append(result, left);
+    result.append({ OpCode::Jump, static_cast<i32>(right.size()) + 1 });
+    append(result, right);
+    return result;
+}
+
+static Vector<Instruction> star(const Vector<Instruction>& atom, bool greedy)
+{
+    Vector<Instruction> result;
+    i32 exit = atom.size() + 2;
+    if (greedy)
+        result.append({ OpCode::Split, 1, exit });
+    else
+        result.append({ OpCode::Split, exit, 1 });
+    append(result, atom);
+    result.append({ OpCode::Jump, -static_cast<i32>(atom.size() + 1) });
+    return result;
+}
+
+static Vector<Instruction> plus(const Vector<Instruction>& atom, bool greedy)
+{
+    Vector<Instruction> result;
+    append(result, atom);
+    i32 back = -static_cast<i32>(atom.size());
+    if (greedy)
+        result.append({ OpCode::Split, back, 1 });
+    else
+        result.append({ OpCode::Split, 1, back });
+    return result;
+}
+
+static Vector<Instruction> optional(const Vector<Instruction>& atom, bool greedy)
+{
+    Vector<Instruction> result;
+    i32 exit = atom.size() + 1;
+    if (greedy)
+        result.append({ OpCode::Split, 1, exit });
+    else
+        result.append({ OpCode::Split, exit, 1 });
+    append(result, atom);
+    return result;
+}
+
+static bool is_lookaround(OpCode op)
+{
+    return op == OpCode::Lookahead || op == OpCode::NegativeLookahead || op == OpCode::Lookbehind || op == OpCode::NegativeLookbehind;
+}
+
+// Whether the fragment can be passed through without consuming anything. Assertions are assumed to hold.
+static bool can_match_empty(const Vector<Instruction>& fragment)
+{
+    Vector<bool> visited;
+    visited.ensure_capacity(fragment.size());
+    for (size_t i = 0; i < fragment.size(); ++i)
+        visited.unchecked_append(false);
+    Vector<size_t> stack;
+    stack.append(0);
+    while (!stack.is_empty()) {
+        auto pc = stack.take_last();
+        if (pc == fragment.size())
+            return true;
+        if (visited[pc])
+            continue;
+        visited[pc] = true;
+        auto& instruction = fragment[pc];
+        switch (instruction.op) {
+        case OpCode::Class:
+        case OpCode::BackwardClass:
+        case OpCode::Fail:
+        case OpCode::Match:
+            break;
+        case OpCode::Jump:
+            stack.append(pc + instruction.argument);
+            break;
+        case OpCode::Split:
+            stack.append(pc + instruction.argument);
+            stack.append(pc + instruction.alternative);
+            break;
+        default:
+            stack.append(pc + (is_lookaround(instruction.op) ? instruction.argument : 1));
+            break;
+        }
+    }
+    return false;
+}
+
+// ECMAScript rejects an iteration beyond the minimum count that matches the empty string, and backtracks
+// into the atom instead. That's done statically: paths through the first copy of the atom lead to a Fail,
+// but every Class in it continues in the second copy, which is exited normally.
+static Vector<Instruction> non_empty(const Vector<Instruction>& atom)
+{
+    if (!can_match_empty(atom))
+        return atom;
+    Vector<Instruction> result;
+    i32 offset = atom.size() + 1;
+    // Lookaround bodies consume nothing as far as the atom is concerned, so they stay as they are.
+    size_t lookaround_end = 0;
+    for (size_t pc = 0; pc < atom.size(); ++pc) {
+        auto instruction = atom[pc];
+        if (pc >= lookaround_end) {
+            if (instruction.op == OpCode::Class || instruction.op == OpCode::BackwardClass || instruction.op == OpCode::Backreference || instruction.op == OpCode::BackwardBackreference)
+                instruction.alternative += offset;
+            else if (is_lookaround(instruction.op))
+                lookaround_end = pc + instruction.argument;
+        }
+        result.append(instruction);
+    }
+    result.append({ OpCode::Fail });
+    append(result, atom);
+    return result;
+}
+
+// Each iteration of a quantified atom starts without the captures of the previous one.
+static Vector<Instruction> iteration(const Vector<Instruction>& atom)
+{
+    Optional<i32> first_slot;
+    i32 last_slot = 0;
+    for (auto& instruction : atom) {
+        if (instruction.op != OpCode::Save)
+            continue;
+        if (!first_slot.has_value() || instruction.argument < first_slot.value())
+            first_slot = instruction.argument;
+        last_slot = max(last_slot, instruction.argument);
+    }
+    if (!first_slot.has_value())
+        return atom;
+    Vector<Instruction> result;
+    result.append({ OpCode::ClearCaptures, first_slot.value(), last_slot - first_slot.value() + 1 });
+    append(result, atom);
+    return result;
+}
+
+static bool is_hex_digit(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+static u32 hex_value(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    return c - 'A' + 10;
+}
+
+Parser::Parser(const StringView& pattern, const Options& options)
+    : m_pattern(pattern)
+    , m_options(options)
+{
+}
+
+bool Parser::parse(Program& program)
+{
+    scan_capture_groups();
+
+    Fragment body;
+    if (!parse_disjunction(body))
+        return false;
+    if (!done())
+        return set_error("Unmatched ')'");
+
+    program.instructions.append({ OpCode::Save, 0 });
+    append(program.instructions, body);
+    program.instructions.append({ OpCode::Save, 1 });
+    program.instructions.append({ OpCode::Match });
+    program.classes = move(m_classes);
+    program.capture_group_count = m_capture_group_count;
+    program.ignore_case = m_options.ignore_case;
+    program.multiline = m_options.multiline;
+    program.has_word_boundaries = m_has_word_boundaries;
+    program.needs_backtracking = m_needs_backtracking;
+    return true;
+}
+
+void Parser::scan_capture_groups()
+{
+    bool in_class = false;
+    for (size_t i = 0; i < m_pattern.length(); ++i) {
+        char c = m_pattern[i];
+        if (c == '\\') {
+            ++i;
+            continue;
+        }
+        if (in_class) {
+            if (c == ']')
+                in_class = false;
+            continue;
+        }
+        if (c == '[') {
+            in_class = true;
+            continue;
+        }
+        if (c != '(')
+            continue;
+        auto rest = m_pattern.substring_view(i + 1, m_pattern.length() - i - 1);
+        if (!rest.starts_with('?')) {
+            m_group_names.append(String());
+            continue;
+        }
+        if (!rest.starts_with("?<") || rest.starts_with("?<=") || rest.starts_with("?<!"))
+            continue;
+        // A malformed name is reported when the group itself is parsed.
+        size_t name_length = 0;
+        while (2 + name_length < rest.length() && rest[2 + name_length] != '>')
+            ++name_length;
+        m_group_names.append(rest.substring_view(2, name_length));
+        m_has_named_groups = true;
+    }
+}
+
+bool Parser::parse_disjunction(Fragment& out)
+{
+    Vector<Fragment> alternatives;
+    do {
+        Fragment alternative;
+        if (!parse_alternative(alternative))
+            return false;
+        alternatives.append(move(alternative));
+    } while (consume('|'));
+
+    // Nest the alternatives to the right, so earlier ones keep their priority.
+    Fragment result = move(alternatives.last());
+    for (int i = alternatives.size() - 2; i >= 0; --i) {
+        result = alternation(alternatives[i], result);
+        if (!check_size(result))
+            return false;
+    }
+    append(out, result);
+    return check_size(out);
+}
+
+bool Parser::parse_alternative(Fragment& out)
+{
+    if (!m_backward) {
+        while (!done() && peek() != '|' && peek() != ')') {
+            if (!parse_term(out))
+                return false;
+        }
+        return true;
+    }
+
+    // Matching right to left starts with the last term.
+    Vector<Fragment> terms;
+    while (!done() && peek() != '|' && peek() != ')') {
+        Fragment term;
+        if (!parse_term(term))
+            return false;
+        terms.append(move(term));
+    }
+    for (int i = terms.size() - 1; i >= 0; --i)
+        append(out, terms[i]);
+    return check_size(out);
+}
+
+bool Parser::parse_term(Fragment& out)
+{
+    Optional<OpCode> assertion;
+    if (consume('^')) {
+        assertion = OpCode::AssertBegin;
+    } else if (consume('$')) {
+        assertion = OpCode::AssertEnd;
+    } else if (consume_specific("\\b")) {
+        assertion = OpCode::WordBoundary;
+    } else if (consume_specific("\\B")) {
+        assertion = OpCode::NotWordBoundary;
+    }
+
+    if (assertion.has_value()) {
+        if (assertion.value() == OpCode::WordBoundary || assertion.value() == OpCode::NotWordBoundary)
+            m_has_word_boundaries = true;
+        out.append({ assertion.value() });
+        size_t min;
+        Optional<size_t> max;
+        if (peek() == '*' || peek() == '+' || peek() == '?' || (peek() == '{' && parse_braced_quantifier(min, max)))
+            return set_error("Nothing to repeat");
+        return true;
+    }
+
+    Fragment atom;
+    if (!parse_atom(atom))
+        return false;
+    return parse_quantifier(out, atom);
+}
+
+bool Parser::parse_quantifier(Fragment& out, const Fragment& atom)
+{
+    size_t min;
+    Optional<size_t> max;
+    if (consume('*')) {
+        min = 0;
+    } else if (consume('+')) {
+        min = 1;
+    } else if (consume('?')) {
+        min = 0;
+        max = 1;
+    } else if (peek() != '{' || !parse_braced_quantifier(min, max)) {
+        append(out, atom);
+        return check_size(out);
+    }
+
+    bool greedy = !consume('?');
+    if (max.has_value() && max.value() < min)
+        return set_error("Numbers out of order in quantifier");
+    if (min > MAX_REPETITION_COUNT || (max.has_value() && max.value() > MAX_REPETITION_COUNT))
+        return set_error("Quantifier is too large");
+
+    auto required = iteration(atom);
+    auto optional_part = non_empty(required);
+    if (!check_size(optional_part))
+        return false;
+
+    Fragment result;
+    if (!max.has_value()) {
+        if (min == 0) {
+            result = star(optional_part, greedy);
+        } else if (optional_part.size() == required.size()) {
+            for (size_t i = 1; i < min; ++i)
+                append(result, required);
+            append(result, plus(required, greedy));
+        } else {
+            for (size_t i = 0; i < min; ++i)
+                append(result, required);
+            append(result, star(optional_part, greedy));
+        }
+    } else {
+        for (size_t i = 0; i < min; ++i)
+            append(result, required);
+        // x{2,4} becomes xx(x(x)?)?, so a later copy can only match if the earlier one did.
+        Fragment tail;
+        for (size_t i = min; i < max.value(); ++i) {
+            Fragment part = optional_part;
+            append(part, tail);
+            tail = optional(part, greedy);
+            if (!check_size(tail))
+                return false;
+        }
+        append(result, tail);
+    }
+    if (!check_size(result))
+        return false;
+    append(out, result);
+    return check_size(out);
+}
+
+bool Parser::parse_braced_quantifier(size_t& min, Optional<size_t>& max)
+{
+    auto parse_number = [this](size_t& number) {
+        if (peek() < '0' || peek() > '9')
+            return false;
+        number = 0;
+        while (peek() >= '0' && peek() <= '9') {
+            // Saturate, anything this large is rejected as too large anyway.
+            number = AK::min(number * 10 + (peek() - '0'), static_cast<size_t>(1000000000));
+            ++m_position;
+        }
+        return true;
+    };
+
+    auto start = m_position;
+    if (!consume('{') || !parse_number(min)) {
+        m_position = start;
+        return false;
+    }
+    if (consume(',')) {
+        size_t maximum;
+        if (parse_number(maximum))
+            max = maximum;
+        else
+            max = {};
+    } else {
+        max = min;
+    }
+    if (!consume('}')) {
+        m_position = start;
+        return false;
+    }
+    return true;
+}
+
+bool Parser::parse_atom(Fragment& out)
+{
+    if (consume('(')) {
+        if (consume_specific("?:")) {
+            if (!parse_disjunction(out))
+                return false;
+            if (!consume(')'))
+                return set_error("Unterminated group");
+            return true;
+        }
+        if (consume_specific("?="))
+            return parse_lookaround(out, OpCode::Lookahead);
+        if (consume_specific("?!"))
+            return parse_lookaround(out, OpCode::NegativeLookahead);
+        if (consume_specific("?<="))
+            return parse_lookaround(out, OpCode::Lookbehind);
+        if (consume_specific("?<!"))
+            return parse_lookaround(out, OpCode::NegativeLookbehind);
+        if (consume_specific("?<")) {
+            // Named groups are numbered like any other capture group, the name itself is not recorded.
+            while (!done() && peek() != '>') {
+                auto c = peek();
+                if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '$'))
+                    return set_error("Invalid capture group name");
+                ++m_position;
+            }
+            if (!consume('>'))
+                return set_error("Invalid capture group name");
+        } else if (peek() == '?') {
+            return set_error("Invalid group");
+        }
+
+        auto group_index = ++m_capture_group_count;
+        // Right to left, the end of the group is reached first.
+        auto start_slot = static_cast<i32>(group_index * 2);
+        auto end_slot = start_slot + 1;
+        out.append({ OpCode::Save, m_backward ? end_slot : start_slot });
+        if (!parse_disjunction(out))
+            return false;
+        if (!consume(')'))
+            return set_error("Unterminated group");
+        out.append({ OpCode::Save, m_backward ? start_slot : end_slot });
+        return true;
+    }
+
+    if (consume('.')) {
+        CharClass char_class;
+        if (m_options.dot_all)
+            char_class.add_range(0, MAX_CODE_POINT);
+        else
+            add_ranges(char_class, s_line_terminator_ranges, true);
+        emit_class(out, move(char_class));
+        return true;
+    }
+
+    if (peek() == '[')
+        return parse_class(out);
+
+    if (consume('\\')) {
+        if (done())
+            return set_error("\\ at end of pattern");
+        return parse_atom_escape(out);
+    }
+
+    if (peek() == '*' || peek() == '+' || peek() == '?')
+        return set_error("Nothing to repeat");
+
+    if (peek() == '{') {
+        size_t min;
+        Optional<size_t> max;
+        if (parse_braced_quantifier(min, max))
+            return set_error("Nothing to repeat");
+    }
+
+    CharClass char_class;
+    char_class.add(consume_code_point());
+    emit_class(out, move(char_class));
+    return true;
+}
+
+bool Parser::parse_lookaround(Fragment& out, OpCode op)
+{
+    bool was_backward = m_backward;
+    m_backward = op == OpCode::Lookbehind || op == OpCode::NegativeLookbehind;
+    Fragment body;
+    bool parsed = parse_disjunction(body);
+    m_backward = was_backward;
+    if (!parsed)
+        return false;
+    if (!consume(')'))
+        return set_error("Unterminated group");
+
+    out.append({ op, static_cast<i32>(body.size()) + 2 });
+    append(out, body);
+    out.append({ OpCode::Match });
+    m_needs_backtracking = true;
+    return check_size(out);
+}
+
+bool Parser::parse_named_backreference(Fragment& out)
+{
+    ASSERT(peek() == 'k');
+    ++m_position;
+    if (!consume('<'))
+        return set_error("Invalid named reference");
+    auto name_start = m_position;
+    while (!done() && peek() != '>')
+        ++m_position;
+    auto name = m_pattern.substring_view(name_start, m_position - name_start);
+    if (!consume('>'))
+        return set_error("Invalid named reference");
+    for (size_t i = 0; i < m_group_names.size(); ++i) {
+        if (m_group_names[i] == name) {
+            emit_backreference(out, i + 1);
+            return true;
+        }
+    }
+    return set_error("Invalid named reference");
+}
+
+bool Parser::parse_atom_escape(Fragment& out)
+{
+    if (peek() >= '1' && peek() <= '9') {
+        auto start = m_position;
+        size_t group_index = 0;
+        while (peek() >= '0' && peek() <= '9') {
+            group_index = AK::min(group_index * 10 + (peek() - '0'), static_cast<size_t>(1000000000));
+            ++m_position;
+        }
+        if (group_index <= m_group_names.size()) {
+            emit_backreference(out, group_index);
+            return true;
+        }
+        // There is no such group, so this is a legacy octal escape or an identity escape after all.
+        m_position = start;
+    }
+
+    // Without any named groups, \k is just the letter k.
+    if (peek() == 'k' && m_has_named_groups)
+        return parse_named_backreference(out);
+
+    CharClass char_class;
+    if (!parse_class_escape(char_class))
+        char_class.add(parse_character_escape());
+    emit_class(out, move(char_class));
+    return true;
+}
+
+bool Parser::parse_class(Fragment& out)
+{
+    ASSERT(peek() == '[');
+    ++m_position;
+
+    CharClass char_class;
+    if (consume('^'))
+        char_class.set_negated(true);
+
+    // Returns the code point of a single class atom, or nothing if it was a set like \d that went straight into the class.
+    auto parse_class_atom = [&]() -> Optional<u32> {
+        if (!consume('\\'))
+            return consume_code_point();
+        if (done()) {
+            set_error("\\ at end of pattern");
+            return {};
+        }
+        if (consume('b'))
+            return '\b';
+        if (consume('-'))
+            return '-';
+        if (parse_class_escape(char_class))
+            return {};
+        return parse_character_escape();
+    };
+
+    for (;;) {
+        if (done())
+            return set_error("Unterminated character class");
+        if (consume(']'))
+            break;
+
+        auto from = parse_class_atom();
+        if (!m_error.is_null())
+            return false;
+        if (!from.has_value())
+            continue;
+
+        if (peek() == '-' && peek(1) != ']' && m_position + 1 < m_pattern.length()) {
+            ++m_position;
+            auto to = parse_class_atom();
+            if (!m_error.is_null())
+                return false;
+            if (!to.has_value()) {
+                // Something like [a-\d], where the dash can only be a literal.
+                char_class.add(from.value());
+                char_class.add('-');
+                continue;
+            }
+            if (to.value() < from.value())
+                return set_error("Range out of order in character class");
+            char_class.add_range(from.value(), to.value());
+            continue;
+        }
+        char_class.add(from.value());
+    }
+
+    emit_class(out, move(char_class));
+    return true;
+}
+
+bool Parser::parse_class_escape(CharClass& char_class)
+{
+    switch (peek()) {
+    case 'd':
+    case 'D':
+        add_ranges(char_class, s_digit_ranges, peek() == 'D');
+        break;
+    case 'w':
+    case 'W':
+        add_ranges(char_class, s_word_ranges, peek() == 'W');
+        break;
+    case 's':
+    case 'S':
+        add_ranges(char_class, s_whitespace_ranges, peek() == 'S');
+        break;
+    default:
+        return false;
+    }
+    ++m_position;
+    return true;
+}
+
+u32 Parser::parse_character_escape()
+{
+    switch (peek()) {
+    case 't':
+        ++m_position;
+        return '\t';
+    case 'n':
+        ++m_position;
+        return '\n';
+    case 'v':
+        ++m_position;
+        return '\v';
+    case 'f':
+        ++m_position;
+        return '\f';
+    case 'r':
+        ++m_position;
+        return '\r';
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7': {
+        // Legacy octal escapes take up to three digits, as long as the value fits in a byte.
+        u32 code_point = 0;
+        for (size_t i = 0; i < 3 && peek() >= '0' && peek() <= '7' && code_point * 8 + (peek() - '0') <= 0377; ++i) {
+            code_point = code_point * 8 + (peek() - '0');
+            ++m_position;
+        }
+        return code_point;
+    }
+    case 'c': {
+        auto letter = peek(1);
+        if ((letter >= 'a' && letter <= 'z') || (letter >= 'A' && letter <= 'Z')) {
+            m_position += 2;
+            return letter % 32;
+        }
+        // A lone \c stands for the backslash itself, the c is parsed as a literal next.
+        return '\\';
+    }
+    case 'x':
+        if (is_hex_digit(peek(1)) && is_hex_digit(peek(2))) {
+            u32 code_point = hex_value(peek(1)) * 16 + hex_value(peek(2));
+            m_position += 3;
+            return code_point;
+        }
+        break;
+    case 'u':
+        if (is_hex_digit(peek(1)) && is_hex_digit(peek(2)) && is_hex_digit(peek(3)) && is_hex_digit(peek(4))) {
+            u32 code_point = 0;
+            for (size_t i = 1; i <= 4; ++i)
+                code_point = code_point * 16 + hex_value(peek(i));
+            m_position += 5;
+            return code_point;
+        }
+        if (peek(1) == '{' && is_hex_digit(peek(2))) {
+            auto start = m_position;
+            m_position += 2;
+            u32 code_point = 0;
+            while (is_hex_digit(peek()) && code_point <= MAX_CODE_POINT) {
+                code_point = code_point * 16 + hex_value(peek());
+                ++m_position;
+            }
+            if (consume('}') && code_point <= MAX_CODE_POINT)
+                return code_point;
+            m_position = start;
+        }
+        break;
+    default:
+        break;
+    }
+    // Anything else is an identity escape.
+    return consume_code_point();
+}
+
+void Parser::emit_class(Fragment& out, CharClass&& char_class)
+{
+    char_class.finalize(m_options.ignore_case);
+    m_classes.append(move(char_class));
+    out.append({ m_backward ? OpCode::BackwardClass : OpCode::Class, static_cast<i32>(m_classes.size() - 1), 1 });
+}
+
+void Parser::emit_backreference(Fragment& out, size_t group_index)
+{
+    out.append({ m_backward ? OpCode::BackwardBackreference : OpCode::Backreference, static_cast<i32>(group_index), 1 });
+    m_needs_backtracking = true;
+}
+
+bool Parser::check_size(const Fragment& fragment)
+{
+    if (fragment.size() > MAX_PROGRAM_SIZE)
+        return set_error("Regular expression is too large");
+    return true;
+}
+
+char Parser::peek(size_t ahead) const
+{
+    if (m_position + ahead >= m_pattern.length())
+        return 0;
+    return m_pattern[m_position + ahead];
+}
+
+bool Parser::consume(char c)
+{
+    if (done() || peek() != c)
+        return false;
+    ++m_position;
+    return true;
+}
+
+bool Parser::consume_specific(const char* string)
+{
+    StringView expected(string);
+    if (m_position + expected.length() > m_pattern.length())
+        return false;
+    if (m_pattern.substring_view(m_position, expected.length()) != expected)
+        return false;
+    m_position += expected.length();
+    return true;
+}
+
+u32 Parser::consume_code_point()
+{
+    size_t length;
+    auto code_point = decode_code_point(m_pattern, m_position, length);
+    m_position += length;
+    return code_point;
+}
+
+bool Parser::set_error(const String& error)
+{
+    if (m_error.is_null())
+        m_error = error;
+    return false;
+}
+
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/String.h>
+#include <AK/StringView.h>
+#include <LibRegex/Pattern.h>
+#include <LibRegex/Program.h>
+
+namespace Regex {
+
+// Parses ECMAScript pattern syntax and compiles it straight into a Program. Jumps are relative,
+// so the code for an atom can be copied as-is when a quantifier needs it more than once.
+class Parser {
+public:
+    Parser(const StringView& pattern, const Options&);
+
+    bool parse(Program&);
+    const String& error() const { return m_error; }
+
+private:
+    using Fragment = Vector<Instruction>;
+
+    bool parse_disjunction(Fragment&);
+    bool parse_alternative(Fragment&);
+    bool parse_term(Fragment&);
+    bool parse_atom(Fragment&);
+    bool parse_atom_escape(Fragment&);
+    bool parse_class(Fragment&);
+    bool parse_quantifier(Fragment&, const Fragment& atom);
+    bool parse_braced_quantifier(size_t& min, Optional<size_t>& max);
+    bool parse_lookaround(Fragment&, OpCode);
+    bool parse_named_backreference(Fragment&);
+
+    // Backreferences may come before the group they refer to, so the groups are found up front.
+    void scan_capture_groups();
+
+    // Parses an escape (after the backslash) that stands for a set, like \d. Returns false if it isn't one.
+    bool parse_class_escape(CharClass&);
+    u32 parse_character_escape();
+
+    void emit_class(Fragment&, CharClass&&);
+    void emit_backreference(Fragment&, size_t group_index);
+    bool check_size(const Fragment&);
+
+    bool done() const { return m_position >= m_pattern.length(); }
+    char peek(size_t ahead = 0) const;
+    bool consume(char);
+    bool consume_specific(const char*);
+    u32 consume_code_point();
+
+    bool set_error(const String&);
+
+    StringView m_pattern;
+    Options m_options;
+    size_t m_position { 0 };
+    Vector<CharClass> m_classes;
+    size_t m_capture_group_count { 0 };
+    // The name of every capture group in the pattern, or a null String if it has none.
+    Vector<String> m_group_names;
+    bool m_has_named_groups { false };
+    bool m_has_word_boundaries { false };
+    bool m_needs_backtracking { false };
+    // Set while parsing a lookbehind body, which is compiled to run right to left.
+    bool m_backward { false };
+    String m_error;
+};
+
+}
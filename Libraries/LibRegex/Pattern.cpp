@@ -0,0 +1,511 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <LibRegex/LazyDFA.h>
+#include <LibRegex/Parser.h>
+#include <LibRegex/Pattern.h>
+
+namespace Regex {
+
+// The threads of the Pike VM at one input position, in priority order. Each carries its own capture slots.
+class ThreadList {
+public:
+    ThreadList(size_t program_size, size_t slot_count)
+        : m_slot_count(slot_count)
+    {
+        m_marks.ensure_capacity(program_size);
+        for (size_t i = 0; i < program_size; ++i)
+            m_marks.unchecked_append(0);
+    }
+
+    void clear()
+    {
+        m_pcs.clear_with_capacity();
+        m_slots.clear_with_capacity();
+        ++m_generation;
+    }
+
+    // Returns false if pc was already visited at this position, in which case a thread with higher priority owns it.
+    bool mark(u32 pc)
+    {
+        if (m_marks[pc] == m_generation)
+            return false;
+        m_marks[pc] = m_generation;
+        return true;
+    }
+
+    void add(u32 pc, const ssize_t* slots)
+    {
+        m_pcs.append(pc);
+        m_slots.append(slots, m_slot_count);
+    }
+
+    size_t size() const { return m_pcs.size(); }
+    bool is_empty() const { return m_pcs.is_empty(); }
+    u32 pc_at(size_t index) const { return m_pcs[index]; }
+    const ssize_t* slots_at(size_t index) const { return m_slots.data() + index * m_slot_count; }
+
+private:
+    size_t m_slot_count { 0 };
+    Vector<u32> m_pcs;
+    Vector<ssize_t> m_slots;
+    Vector<u32> m_marks;
+    u32 m_generation { 1 };
+};
+
+static Match match_from_slots(const ssize_t* slots, size_t slot_count)
+{
+    Match match;
+    for (size_t group = 0; group < slot_count / 2; ++group) {
+        auto start_slot = slots[group * 2];
+        auto end_slot = slots[group * 2 + 1];
+        if (start_slot < 0 || end_slot < 0)
+            match.captures.append(Optional<Range>());
+        else
+            match.captures.append(Optional<Range>(Range { static_cast<size_t>(start_slot), static_cast<size_t>(end_slot) }));
+    }
+    return match;
+}
+
+class PikeVM {
+public:
+    PikeVM(const Program& program, const StringView& input)
+        : m_program(program)
+        , m_input(input)
+    {
+    }
+
+    Optional<Match> run(size_t start, bool anchored);
+
+private:
+    void add_thread(ThreadList&, u32 pc, ssize_t* slots, size_t position);
+
+    struct StackEntry {
+        u32 pc { 0 };
+        // When not -1, this entry restores a capture slot instead of visiting pc.
+        i32 restore_slot { -1 };
+        ssize_t restore_value { 0 };
+    };
+
+    const Program& m_program;
+    StringView m_input;
+    Vector<StackEntry> m_stack;
+};
+
+void PikeVM::add_thread(ThreadList& list, u32 start_pc, ssize_t* slots, size_t position)
+{
+    m_stack.append({ start_pc });
+    while (!m_stack.is_empty()) {
+        auto entry = m_stack.take_last();
+        if (entry.restore_slot >= 0) {
+            slots[entry.restore_slot] = entry.restore_value;
+            continue;
+        }
+
+        auto pc = entry.pc;
+        if (!list.mark(pc))
+            continue;
+
+        auto& instruction = m_program.instructions[pc];
+        switch (instruction.op) {
+        case OpCode::Jump:
+            m_stack.append({ pc + instruction.argument });
+            break;
+        case OpCode::Split:
+            // Pushed in reverse, so the preferred branch is explored (and claims its states) first.
+            m_stack.append({ pc + instruction.alternative });
+            m_stack.append({ pc + instruction.argument });
+            break;
+        case OpCode::Save:
+            m_stack.append({ 0, instruction.argument, slots[instruction.argument] });
+            slots[instruction.argument] = position;
+            m_stack.append({ pc + 1 });
+            break;
+        case OpCode::ClearCaptures:
+            for (i32 slot = instruction.argument; slot < instruction.argument + instruction.alternative; ++slot) {
+                m_stack.append({ 0, slot, slots[slot] });
+                slots[slot] = -1;
+            }
+            m_stack.append({ pc + 1 });
+            break;
+        case OpCode::Fail:
+            break;
+        case OpCode::AssertBegin:
+        case OpCode::AssertEnd:
+        case OpCode::WordBoundary:
+        case OpCode::NotWordBoundary:
+            if (assertion_holds(m_program, instruction.op, m_input, position))
+                m_stack.append({ pc + 1 });
+            break;
+        case OpCode::Class:
+        case OpCode::Match:
+            list.add(pc, slots);
+            break;
+        case OpCode::Backreference:
+        case OpCode::BackwardClass:
+        case OpCode::BackwardBackreference:
+        case OpCode::Lookahead:
+        case OpCode::NegativeLookahead:
+        case OpCode::Lookbehind:
+        case OpCode::NegativeLookbehind:
+            ASSERT_NOT_REACHED();
+        }
+    }
+}
+
+Optional<Match> PikeVM::run(size_t start, bool anchored)
+{
+    auto slot_count = m_program.slot_count();
+    auto program_size = m_program.instructions.size();
+    ThreadList current(program_size, slot_count);
+    ThreadList next(program_size, slot_count);
+    Vector<ssize_t> slots;
+    slots.resize(slot_count);
+    Vector<ssize_t> matched_slots;
+    bool matched = false;
+
+    current.clear();
+    size_t position = start;
+    for (;;) {
+        if (!matched && (!anchored || position == start)) {
+            for (auto& slot : slots)
+                slot = -1;
+            add_thread(current, 0, slots.data(), position);
+        }
+
+        bool at_end = position >= m_input.length();
+        if (current.is_empty() && (matched || anchored || at_end))
+            break;
+
+        u32 code_point = 0;
+        size_t length = 0;
+        if (!at_end)
+            code_point = decode_code_point(m_input, position, length);
+
+        next.clear();
+        for (size_t i = 0; i < current.size(); ++i) {
+            auto pc = current.pc_at(i);
+            auto& instruction = m_program.instructions[pc];
+            if (instruction.op == OpCode::Match) {
+                matched = true;
+                matched_slots.clear_with_capacity();
+                matched_slots.append(current.slots_at(i), slot_count);
+                // Threads after this one have lower priority, so they can't produce the preferred match.
+                break;
+            }
+            ASSERT(instruction.op == OpCode::Class);
+            if (at_end || !m_program.classes[instruction.argument].matches(code_point))
+                continue;
+            for (size_t slot = 0; slot < slot_count; ++slot)
+                slots[slot] = current.slots_at(i)[slot];
+            add_thread(next, pc + instruction.alternative, slots.data(), position + length);
+        }
+
+        if (at_end)
+            break;
+        swap(current, next);
+        position += length;
+    }
+
+    if (!matched)
+        return {};
+    return match_from_slots(matched_slots.data(), slot_count);
+}
+
+// Matches programs with backreferences or lookaround, which depend on what the current path has
+// captured and so can't be simulated in lockstep. It follows one path at a time in priority order,
+// and backs up to the most recent Split on failure. Like any backtracking matcher, it can take
+// exponential time on patterns like (a*)*\1b.
+class Backtracker {
+public:
+    Backtracker(const Program& program, const StringView& input)
+        : m_program(program)
+        , m_input(input)
+    {
+        m_slots.resize(program.slot_count());
+    }
+
+    Optional<Match> run(size_t start, bool anchored);
+
+private:
+    // Returns whether the program matches from pc, leaving the captures of that path in m_slots.
+    bool execute(u32 pc, size_t position);
+    // Compares the text of a capture group with the input that starts at position, or ends there if backward.
+    bool backreference_matches(i32 group_index, size_t position, bool backward, size_t& length) const;
+    bool lookaround_holds(const Instruction&, u32 pc, size_t position);
+
+    struct StackEntry {
+        u32 pc { 0 };
+        size_t position { 0 };
+        // When not -1, this entry restores a capture slot instead of resuming at pc.
+        i32 restore_slot { -1 };
+        ssize_t restore_value { 0 };
+    };
+
+    const Program& m_program;
+    StringView m_input;
+    Vector<ssize_t> m_slots;
+    Vector<StackEntry> m_stack;
+};
+
+static size_t previous_code_point_start(const StringView& input, size_t position)
+{
+    auto* bytes = reinterpret_cast<const u8*>(input.characters_without_null_termination());
+    size_t start = position - 1;
+    while (start > 0 && position - start < 4 && (bytes[start] & 0xc0) == 0x80)
+        --start;
+    return start;
+}
+
+static u32 to_ascii_lowercase(u32 code_point)
+{
+    if (code_point >= 'A' && code_point <= 'Z')
+        return code_point + 'a' - 'A';
+    return code_point;
+}
+
+bool Backtracker::backreference_matches(i32 group_index, size_t position, bool backward, size_t& length) const
+{
+    auto start = m_slots[group_index * 2];
+    auto end = m_slots[group_index * 2 + 1];
+    if (start < 0 || end < 0 || end < start) {
+        length = 0;
+        return true;
+    }
+    length = end - start;
+    if (backward) {
+        if (length > position)
+            return false;
+        position -= length;
+    } else if (position + length > m_input.length()) {
+        return false;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        u32 expected = m_input[start + i];
+        u32 actual = m_input[position + i];
+        if (m_program.ignore_case) {
+            expected = to_ascii_lowercase(expected);
+            actual = to_ascii_lowercase(actual);
+        }
+        if (expected != actual)
+            return false;
+    }
+    return true;
+}
+
+bool Backtracker::lookaround_holds(const Instruction& instruction, u32 pc, size_t position)
+{
+    bool negated = instruction.op == OpCode::NegativeLookahead || instruction.op == OpCode::NegativeLookbehind;
+    Vector<ssize_t, 32> saved_slots;
+    saved_slots.append(m_slots.data(), m_slots.size());
+
+    bool matched = execute(pc + 1, position);
+
+    // A lookaround never backtracks into its body, but the captures of a positive one stay until the
+    // outer path backs up past it. A negative one only holds if the body failed, so it never captures.
+    if (!matched)
+        return negated;
+    for (size_t slot = 0; slot < m_slots.size(); ++slot) {
+        if (m_slots[slot] == saved_slots[slot])
+            continue;
+        if (negated)
+            m_slots[slot] = saved_slots[slot];
+        else
+            m_stack.append({ 0, 0, static_cast<i32>(slot), saved_slots[slot] });
+    }
+    return !negated;
+}
+
+bool Backtracker::execute(u32 start_pc, size_t start_position)
+{
+    auto base = m_stack.size();
+    m_stack.append({ start_pc, start_position });
+    while (m_stack.size() > base) {
+        auto entry = m_stack.take_last();
+        if (entry.restore_slot >= 0) {
+            m_slots[entry.restore_slot] = entry.restore_value;
+            continue;
+        }
+
+        auto pc = entry.pc;
+        auto position = entry.position;
+        for (bool failed = false; !failed;) {
+            auto& instruction = m_program.instructions[pc];
+            switch (instruction.op) {
+            case OpCode::Class: {
+                size_t length = 0;
+                if (position >= m_input.length() || !m_program.classes[instruction.argument].matches(decode_code_point(m_input, position, length))) {
+                    failed = true;
+                    break;
+                }
+                position += length;
+                pc += instruction.alternative;
+                break;
+            }
+            case OpCode::BackwardClass: {
+                if (position == 0) {
+                    failed = true;
+                    break;
+                }
+                auto start = previous_code_point_start(m_input, position);
+                size_t length = 0;
+                if (!m_program.classes[instruction.argument].matches(decode_code_point(m_input, start, length))) {
+                    failed = true;
+                    break;
+                }
+                position = start;
+                pc += instruction.alternative;
+                break;
+            }
+            case OpCode::Split:
+                m_stack.append({ pc + instruction.alternative, position });
+                pc += instruction.argument;
+                break;
+            case OpCode::Jump:
+                pc += instruction.argument;
+                break;
+            case OpCode::Save:
+                m_stack.append({ 0, 0, instruction.argument, m_slots[instruction.argument] });
+                m_slots[instruction.argument] = position;
+                ++pc;
+                break;
+            case OpCode::ClearCaptures:
+                for (i32 slot = instruction.argument; slot < instruction.argument + instruction.alternative; ++slot) {
+                    m_stack.append({ 0, 0, slot, m_slots[slot] });
+                    m_slots[slot] = -1;
+                }
+                ++pc;
+                break;
+            case OpCode::Fail:
+                failed = true;
+                break;
+            case OpCode::AssertBegin:
+            case OpCode::AssertEnd:
+            case OpCode::WordBoundary:
+            case OpCode::NotWordBoundary:
+                if (assertion_holds(m_program, instruction.op, m_input, position))
+                    ++pc;
+                else
+                    failed = true;
+                break;
+            case OpCode::Backreference:
+            case OpCode::BackwardBackreference: {
+                bool backward = instruction.op == OpCode::BackwardBackreference;
+                size_t length;
+                if (!backreference_matches(instruction.argument, position, backward, length)) {
+                    failed = true;
+                    break;
+                }
+                position = backward ? position - length : position + length;
+                pc += length ? instruction.alternative : 1;
+                break;
+            }
+            case OpCode::Lookahead:
+            case OpCode::NegativeLookahead:
+            case OpCode::Lookbehind:
+            case OpCode::NegativeLookbehind:
+                if (lookaround_holds(instruction, pc, position))
+                    pc += instruction.argument;
+                else
+                    failed = true;
+                break;
+            case OpCode::Match:
+                // The alternatives we didn't try are dropped, along with the captures they would have restored.
+                m_stack.shrink(base);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+Optional<Match> Backtracker::run(size_t start, bool anchored)
+{
+    size_t position = start;
+    for (;;) {
+        for (auto& slot : m_slots)
+            slot = -1;
+        if (execute(0, position))
+            return match_from_slots(m_slots.data(), m_slots.size());
+        if (anchored || position >= m_input.length())
+            return {};
+        size_t length;
+        decode_code_point(m_input, position, length);
+        position += length;
+    }
+}
+
+Pattern::Pattern(const StringView& pattern, Options options)
+{
+    Parser parser(pattern, options);
+    if (!parser.parse(m_program))
+        m_error = parser.error();
+}
+
+Pattern::~Pattern()
+{
+}
+
+Optional<Match> Pattern::execute(const StringView& input, size_t start, bool anchored) const
+{
+    if (has_error() || start > input.length())
+        return {};
+    if (m_program.needs_backtracking) {
+        Backtracker backtracker(m_program, input);
+        return backtracker.run(start, anchored);
+    }
+    PikeVM vm(m_program, input);
+    return vm.run(start, anchored);
+}
+
+Optional<Match> Pattern::search(const StringView& input, size_t start) const
+{
+    // Most searches in a filtering loop fail, and the DFA rejects those without tracking any captures.
+    if (LazyDFA::can_handle(m_program) && !has_match(input, start))
+        return {};
+    return execute(input, start, false);
+}
+
+Optional<Match> Pattern::match_at(const StringView& input, size_t start) const
+{
+    return execute(input, start, true);
+}
+
+bool Pattern::has_match(const StringView& input, size_t start) const
+{
+    if (has_error() || start > input.length())
+        return false;
+    if (LazyDFA::can_handle(m_program)) {
+        if (!m_dfa)
+            m_dfa = make<LazyDFA>(m_program);
+        auto result = m_dfa->has_match(input, start);
+        if (result.has_value())
+            return result.value();
+    }
+    return execute(input, start, false).has_value();
+}
+
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/OwnPtr.h>
+#include <AK/String.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibRegex/Program.h>
+
+namespace Regex {
+
+class LazyDFA;
+
+struct Options {
+    bool ignore_case { false };
+    bool multiline { false };
+    bool dot_all { false };
+};
+
+struct Range {
+    size_t start { 0 };
+    size_t end { 0 };
+
+    size_t length() const { return end - start; }
+};
+
+struct Match {
+    // captures[0] is the whole match, captures[n] is the nth capture group if it took part in the match.
+    Vector<Optional<Range>> captures;
+
+    const Range& range() const { return captures[0].value(); }
+};
+
+// A compiled ECMAScript-style regular expression. Matching runs in time linear in the input:
+// a lazily built DFA answers whether there is a match at all, and a Pike VM that walks all
+// NFA threads in lockstep finds the match with its capture groups. Patterns that use
+// backreferences or lookaround assertions need backtracking, and are matched by a
+// backtracking engine instead, which has no such guarantee.
+// Positions are byte offsets into UTF-8 input.
+class Pattern {
+public:
+    explicit Pattern(const StringView& pattern, Options = {});
+    ~Pattern();
+
+    bool has_error() const { return !m_error.is_null(); }
+    const String& error() const { return m_error; }
+
+    size_t capture_group_count() const { return m_program.capture_group_count; }
+
+    // Finds the leftmost match that starts at or after start.
+    Optional<Match> search(const StringView& input, size_t start = 0) const;
+
+    // Only considers a match that starts exactly at start.
+    Optional<Match> match_at(const StringView& input, size_t start) const;
+
+    // Like search(), but without computing where the match is, which is a lot cheaper.
+    bool has_match(const StringView& input, size_t start = 0) const;
+
+private:
+    Optional<Match> execute(const StringView& input, size_t start, bool anchored) const;
+
+    Program m_program;
+    String m_error;
+    mutable OwnPtr<LazyDFA> m_dfa;
+};
+
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/Optional.h>
+#include <AK/QuickSort.h>
+#include <LibRegex/Program.h>
+
+namespace Regex {
+
+void CharClass::add_ranges(const CodePointRange* ranges, size_t count, bool negated)
+{
+    if (!negated) {
+        m_ranges.append(ranges, count);
+        return;
+    }
+    // The ranges of the predefined classes are sorted and disjoint, so the complement is just the gaps.
+    u32 next = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (ranges[i].from > next)
+            add_range(next, ranges[i].from - 1);
+        next = ranges[i].to + 1;
+    }
+    if (next <= MAX_CODE_POINT)
+        add_range(next, MAX_CODE_POINT);
+}
+
+bool CharClass::contains(u32 code_point) const
+{
+    for (auto& range : m_ranges) {
+        if (code_point >= range.from && code_point <= range.to)
+            return true;
+    }
+    return false;
+}
+
+void CharClass::finalize(bool ignore_case)
+{
+    if (ignore_case) {
+        for (u32 lowercase = 'a'; lowercase <= 'z'; ++lowercase) {
+            u32 uppercase = lowercase - 'a' + 'A';
+            bool has_lowercase = contains(lowercase);
+            bool has_uppercase = contains(uppercase);
+            if (has_lowercase && !has_uppercase)
+                add(uppercase);
+            else if (has_uppercase && !has_lowercase)
+                add(lowercase);
+        }
+    }
+    quick_sort(m_ranges, [](auto& a, auto& b) { return a.from < b.from; });
+    for (u32 code_point = 0; code_point < 128; ++code_point)
+        m_ascii[code_point] = contains(code_point) != m_negated;
+}
+
+bool is_word_character(u32 code_point)
+{
+    return (code_point >= 'a' && code_point <= 'z') || (code_point >= 'A' && code_point <= 'Z') || (code_point >= '0' && code_point <= '9') || code_point == '_';
+}
+
+bool is_line_terminator(u32 code_point)
+{
+    return code_point == '\n' || code_point == '\r' || code_point == 0x2028 || code_point == 0x2029;
+}
+
+static Optional<u32> code_point_before(const StringView& input, size_t position)
+{
+    if (position == 0)
+        return {};
+    size_t start = position - 1;
+    auto* bytes = reinterpret_cast<const u8*>(input.characters_without_null_termination());
+    while (start > 0 && position - start < 4 && (bytes[start] & 0xc0) == 0x80)
+        --start;
+    size_t length;
+    auto code_point = decode_code_point(input, start, length);
+    if (start + length != position)
+        return bytes[position - 1];
+    return code_point;
+}
+
+static Optional<u32> code_point_at(const StringView& input, size_t position)
+{
+    if (position >= input.length())
+        return {};
+    size_t length;
+    return decode_code_point(input, position, length);
+}
+
+bool assertion_holds(const Program& program, OpCode op, const StringView& input, size_t position)
+{
+    switch (op) {
+    case OpCode::AssertBegin: {
+        if (position == 0)
+            return true;
+        return program.multiline && is_line_terminator(code_point_before(input, position).value());
+    }
+    case OpCode::AssertEnd: {
+        if (position >= input.length())
+            return true;
+        return program.multiline && is_line_terminator(code_point_at(input, position).value());
+    }
+    case OpCode::WordBoundary:
+    case OpCode::NotWordBoundary: {
+        auto before = code_point_before(input, position);
+        auto after = code_point_at(input, position);
+        bool is_boundary = (before.has_value() && is_word_character(before.value())) != (after.has_value() && is_word_character(after.value()));
+        return is_boundary == (op == OpCode::WordBoundary);
+    }
+    default:
+        ASSERT_NOT_REACHED();
+    }
+}
+
+}
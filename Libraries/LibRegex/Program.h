@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <AK/StringView.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace Regex {
+
+static constexpr u32 MAX_CODE_POINT = 0x10ffff;
+
+struct CodePointRange {
+    u32 from { 0 };
+    u32 to { 0 };
+};
+
+class CharClass {
+public:
+    void add(u32 code_point) { add_range(code_point, code_point); }
+    void add_range(u32 from, u32 to) { m_ranges.append({ from, to }); }
+    void add_ranges(const CodePointRange*, size_t count, bool negated);
+
+    void set_negated(bool negated) { m_negated = negated; }
+
+    // Must be called once all ranges are in, it folds case and builds the ASCII lookup table.
+    void finalize(bool ignore_case);
+
+    bool matches(u32 code_point) const
+    {
+        if (code_point < 128)
+            return m_ascii[code_point];
+        return contains(code_point) != m_negated;
+    }
+
+private:
+    bool contains(u32 code_point) const;
+
+    Vector<CodePointRange> m_ranges;
+    bool m_negated { false };
+    bool m_ascii[128] {};
+};
+
+enum class OpCode : u8 {
+    // Consumes one code point if it is in classes[argument], and continues at pc + alternative.
+    Class,
+    // Continues at pc + argument, and at pc + alternative with lower priority.
+    Split,
+    // Continues at pc + argument.
+    Jump,
+    // Records the current position in capture slot argument.
+    Save,
+    // Resets alternative capture slots starting at argument, so a repeated group only reports its last iteration.
+    ClearCaptures,
+    // Ends the thread without a match.
+    Fail,
+    AssertBegin,
+    AssertEnd,
+    WordBoundary,
+    NotWordBoundary,
+    // Consumes the text capture group argument matched, and continues at pc + alternative if that was
+    // not empty. A group that didn't take part in the match matches the empty string.
+    Backreference,
+    // Like Class and Backreference, but consume what comes before the current position instead.
+    // Lookbehind bodies are matched right to left, as ECMAScript specifies.
+    BackwardClass,
+    BackwardBackreference,
+    // Continues at pc + argument if the body starting at pc + 1, which ends in its own Match, matches here.
+    Lookahead,
+    NegativeLookahead,
+    Lookbehind,
+    NegativeLookbehind,
+    Match,
+};
+
+struct Instruction {
+    OpCode op;
+    i32 argument { 0 };
+    i32 alternative { 0 };
+};
+
+struct Program {
+    Vector<Instruction> instructions;
+    Vector<CharClass> classes;
+    size_t capture_group_count { 0 };
+    bool ignore_case { false };
+    bool multiline { false };
+    bool has_word_boundaries { false };
+    // Backreferences and lookaround can't be matched by following all paths at once.
+    bool needs_backtracking { false };
+
+    // Slot 0 and 1 hold the bounds of the whole match, followed by two per capture group.
+    size_t slot_count() const { return (capture_group_count + 1) * 2; }
+};
+
+// Decodes the UTF-8 sequence at offset. Invalid or truncated sequences decode as a single byte,
+// so the engine never gets stuck on bad input.
+inline u32 decode_code_point(const StringView& input, size_t offset, size_t& length)
+{
+    auto* bytes = reinterpret_cast<const u8*>(input.characters_without_null_termination());
+    u8 lead = bytes[offset];
+    length = 1;
+    if (lead < 0x80)
+        return lead;
+
+    size_t sequence_length;
+    u32 code_point;
+    if ((lead & 0xe0) == 0xc0) {
+        sequence_length = 2;
+        code_point = lead & 0x1f;
+    } else if ((lead & 0xf0) == 0xe0) {
+        sequence_length = 3;
+        code_point = lead & 0x0f;
+    } else if ((lead & 0xf8) == 0xf0) {
+        sequence_length = 4;
+        code_point = lead & 0x07;
+    } else {
+        return lead;
+    }
+
+    if (offset + sequence_length > input.length())
+        return lead;
+    for (size_t i = 1; i < sequence_length; ++i) {
+        u8 continuation = bytes[offset + i];
+        if ((continuation & 0xc0) != 0x80)
+            return lead;
+        code_point = (code_point << 6) | (continuation & 0x3f);
+    }
+    length = sequence_length;
+    return code_point;
+}
+
+bool is_word_character(u32 code_point);
+bool is_line_terminator(u32 code_point);
+
+// Evaluates an empty-width assertion between the code points before and after position.
+bool assertion_holds(const Program&, OpCode, const StringView& input, size_t position);
+
+}
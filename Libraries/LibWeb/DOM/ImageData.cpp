@@ -25,7 +25,7 @@
  */
 
 #include <LibGfx/Bitmap.h>
-#include <LibJS/Runtime/Uint8ClampedArray.h>
+#include <LibJS/Runtime/TypedArray.h>
 #include <LibWeb/DOM/ImageData.h>
 
 namespace Web {
@@ -29,6 +29,7 @@
 #include <AK/SharedBuffer.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/File.h>
+#include <LibCore/MemoryPressureNotifier.h>
 #include <LibProtocol/Client.h>
 #include <LibProtocol/Download.h>
 #include <LibWeb/Loader/LoadRequest.h>
@@ -49,6 +50,11 @@ ResourceLoader::ResourceLoader()
     : m_protocol_client(Protocol::Client::construct())
     , m_user_agent("Mozilla/4.0 (SerenityOS; x86) LibWeb+LibJS (Not KHTML, nor Gecko) LibWeb")
 {
+    m_memory_pressure_notifier = Core::MemoryPressureNotifier::construct(this);
+    m_memory_pressure_notifier->on_change = [this](auto level) {
+        if (level != Core::MemoryPressureNotifier::Level::None)
+            purge_unused_resources();
+    };
 }
 
 void ResourceLoader::load_sync(const URL& url, Function<void(const ByteBuffer&, const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers)> success_callback, Function<void(const String&)> error_callback)
@@ -72,6 +78,19 @@ void ResourceLoader::load_sync(const URL& url, Function<void(const ByteBuffer&,
 
 static HashMap<LoadRequest, NonnullRefPtr<Resource>> s_resource_cache;
 
+void ResourceLoader::purge_unused_resources()
+{
+    // A resource that's still loading is kept alive by its load callbacks, so only finished ones can be unused.
+    Vector<LoadRequest> unused_requests;
+    for (auto& it : s_resource_cache) {
+        if (it.value->ref_count() == 1)
+            unused_requests.append(it.key);
+    }
+    for (auto& request : unused_requests)
+        s_resource_cache.remove(request);
+    dbg() << "ResourceLoader: Purged " << unused_requests.size() << " unused resources under memory pressure";
+}
+
 RefPtr<Resource> ResourceLoader::load_resource(Resource::Type type, const LoadRequest& request)
 {
     if (!request.is_valid())
@@ -31,6 +31,10 @@
 #include <LibCore/Object.h>
 #include <LibWeb/Loader/Resource.h>
 
+namespace Core {
+class MemoryPressureNotifier;
+}
+
 namespace Protocol {
 class Client;
 }
@@ -59,11 +63,15 @@ private:
     ResourceLoader();
     static bool is_port_blocked(int port);
 
+    // Drops cached resources that nothing is using anymore.
+    void purge_unused_resources();
+
     virtual void save_to(JsonObject&) override;
 
     int m_pending_loads { 0 };
 
     RefPtr<Protocol::Client> m_protocol_client;
+    RefPtr<Core::MemoryPressureNotifier> m_memory_pressure_notifier;
     String m_user_agent;
 };
 
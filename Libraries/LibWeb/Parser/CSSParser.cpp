@@ -24,6 +24,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <AK/Arena.h>
 #include <AK/HashMap.h>
 #include <LibWeb/CSS/PropertyID.h>
 #include <LibWeb/CSS/StyleSheet.h>
@@ -400,6 +401,15 @@ public:
         return original_index != index;
     }
 
+    // Strings that are only inspected while parsing are kept in the scratch arena,
+    // which is released in one go along with the parser.
+    StringView take_buffer_as_scratch_string()
+    {
+        auto string = scratch.copy(StringView(buffer.data(), buffer.size()));
+        buffer.clear();
+        return string;
+    }
+
     bool is_valid_selector_char(char ch) const
     {
         return isalnum(ch) || ch == '-' || ch == '_' || ch == '(' || ch == ')' || ch == '@';
@@ -524,8 +534,7 @@ public:
                     buffer.append(consume_one());
             }
 
-            auto pseudo_name = String::copy(buffer);
-            buffer.clear();
+            auto pseudo_name = take_buffer_as_scratch_string();
 
             // Ignore for now, otherwise we produce a "false positive" selector
             // and apply styles to the element itself, not its pseudo element
@@ -660,7 +669,7 @@ public:
     }
 
     struct ValueAndImportant {
-        String value;
+        StringView value;
         bool important { false };
     };
 
@@ -719,10 +728,7 @@ public:
         while (!buffer.is_empty() && isspace(buffer.last()))
             buffer.take_last();
 
-        auto string = String::copy(buffer);
-        buffer.clear();
-
-        return { string, important };
+        return { take_buffer_as_scratch_string(), important };
     }
 
     Optional<StyleProperty> parse_property()
@@ -737,8 +743,7 @@ public:
         buffer.clear();
         while (is_valid_property_name_char(peek()))
             buffer.append(consume_one());
-        auto property_name = String::copy(buffer);
-        buffer.clear();
+        auto property_name = take_buffer_as_scratch_string();
         consume_whitespace_or_comments();
         consume_specific(':');
         consume_whitespace_or_comments();
@@ -832,6 +837,7 @@ private:
 
     CurrentRule current_rule;
     Vector<char> buffer;
+    Arena scratch;
 
     size_t index = 0;
 
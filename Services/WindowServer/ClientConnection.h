@@ -65,6 +65,13 @@ public:
     void notify_about_new_screen_rect(const Gfx::Rect&);
     void post_paint_message(Window&, bool ignore_occlusion = false);
 
+    template<typename Callback>
+    void for_each_menu(Callback callback)
+    {
+        for (auto& it : m_menus)
+            callback(*it.value);
+    }
+
     Menu* find_menu_by_id(int menu_id)
     {
         auto menu = m_menus.get(menu_id);
@@ -168,6 +168,13 @@ Window& Menu::ensure_menu_window()
     return *m_menu_window;
 }
 
+void Menu::purge_menu_window()
+{
+    // The window (and its backing store) is recreated and redrawn the next time the menu opens.
+    ASSERT(!MenuManager::the().is_open(*this));
+    m_menu_window = nullptr;
+}
+
 int Menu::visible_item_count() const
 {
     if (!is_scrollable())
@@ -81,6 +81,7 @@ public:
 
     Window* menu_window() { return m_menu_window.ptr(); }
     Window& ensure_menu_window();
+    void purge_menu_window();
 
     Window* window_menu_of() { return m_window_menu_of; }
     void set_window_menu_of(Window& window) { m_window_menu_of = window.make_weak_ptr(); }
@@ -36,7 +36,9 @@
 #include <AK/SharedBuffer.h>
 #include <AK/StdLibExtras.h>
 #include <AK/Vector.h>
+#include <LibCore/MemoryPressureNotifier.h>
 #include <LibGfx/CharacterBitmap.h>
+#include <LibGfx/Emoji.h>
 #include <LibGfx/Font.h>
 #include <LibGfx/Painter.h>
 #include <LibGfx/StylePainter.h>
@@ -74,6 +76,12 @@ WindowManager::WindowManager(const Gfx::PaletteImpl& palette)
 
     reload_config(false);
 
+    m_memory_pressure_notifier = Core::MemoryPressureNotifier::construct(this);
+    m_memory_pressure_notifier->on_change = [this](auto level) {
+        if (level != Core::MemoryPressureNotifier::Level::None)
+            purge_caches();
+    };
+
     invalidate();
     Compositor::the().compose();
 }
@@ -82,6 +90,25 @@ WindowManager::~WindowManager()
 {
 }
 
+void WindowManager::purge_caches()
+{
+    // Closed menus keep their window and backing store around, just in case they're opened again.
+    // Leave them alone while any menu is open, since open menus peek at their submenus' windows.
+    if (!MenuManager::the().has_open_menu()) {
+        size_t purged_count = 0;
+        ClientConnection::for_each_client([&](ClientConnection& client) {
+            client.for_each_menu([&](Menu& menu) {
+                if (!menu.menu_window())
+                    return;
+                menu.purge_menu_window();
+                ++purged_count;
+            });
+        });
+        dbg() << "WindowManager: Purged " << purged_count << " closed menu windows under memory pressure";
+    }
+    Gfx::Emoji::purge_unused_emojis();
+}
+
 NonnullRefPtr<Cursor> WindowManager::get_cursor(const String& name, const Gfx::Point& hotspot)
 {
     auto path = m_config->read_entry("Cursor", name, "/res/cursors/arrow.png");
@@ -32,6 +32,7 @@
 #include <AK/WeakPtr.h>
 #include <LibCore/ConfigFile.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibCore/Forward.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/DisjointRectSet.h>
 #include <LibGfx/Painter.h>
@@ -169,6 +170,8 @@ public:
     void did_popup_a_menu(Badge<Menu>);
 
 private:
+    void purge_caches();
+
     NonnullRefPtr<Cursor> get_cursor(const String& name);
     NonnullRefPtr<Cursor> get_cursor(const String& name, const Gfx::Point& hotspot);
 
@@ -269,6 +272,7 @@ private:
     NonnullRefPtr<Gfx::PaletteImpl> m_palette;
 
     RefPtr<Core::ConfigFile> m_config;
+    RefPtr<Core::MemoryPressureNotifier> m_memory_pressure_notifier;
 
     WeakPtr<ClientConnection> m_dnd_client;
     String m_dnd_text;
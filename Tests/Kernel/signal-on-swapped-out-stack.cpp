@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Signal delivery pushes the signal frame onto the user stack from inside the scheduler,
+// with interrupts disabled. If that stack page had been swapped out, the kernel would try
+// to block on the swap-in right there and hang. Run this after swapon(8).
+
+static volatile sig_atomic_t s_got_signal = 0;
+
+static void handle_usr1(int)
+{
+    s_got_signal = 1;
+}
+
+static long read_memstat(const char* key)
+{
+    FILE* fp = fopen("/proc/memstat", "r");
+    if (!fp) {
+        perror("fopen");
+        return -1;
+    }
+    char buffer[1024];
+    size_t nread = fread(buffer, 1, sizeof(buffer) - 1, fp);
+    fclose(fp);
+    buffer[nread] = '\0';
+
+    char needle[64];
+    snprintf(needle, sizeof(needle), "\"%s\":", key);
+    const char* found = strstr(buffer, needle);
+    if (!found)
+        return -1;
+    return strtol(found + strlen(needle), nullptr, 10);
+}
+
+static void __attribute__((noinline)) dirty_stack()
+{
+    // Spread the stack over a bunch of pages, so there is plenty for the swapper to consider.
+    volatile char scratch[64 * 1024];
+    for (size_t i = 0; i < sizeof(scratch); i += 4096)
+        scratch[i] = 1;
+}
+
+int main()
+{
+    if (read_memstat("swap_total") <= 0) {
+        printf("Swap is not enabled, run swapon first.\n");
+        return 1;
+    }
+
+    pid_t child = fork();
+    if (child < 0) {
+        perror("fork");
+        return 1;
+    }
+
+    if (child == 0) {
+        signal(SIGUSR1, handle_usr1);
+        dirty_stack();
+        while (!s_got_signal)
+            sleep(1);
+        _exit(0);
+    }
+
+    // Push the system into swapping by touching more and more memory, until something was swapped out.
+    long swap_out_count_before = read_memstat("swap_out_count");
+    const size_t chunk_size = 16 * 1024 * 1024;
+    for (int i = 0; i < 256 && read_memstat("swap_out_count") <= swap_out_count_before; ++i) {
+        auto* chunk = (char*)mmap(nullptr, chunk_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, 0, 0);
+        if (chunk == MAP_FAILED)
+            break;
+        for (size_t offset = 0; offset < chunk_size; offset += PAGE_SIZE)
+            chunk[offset] = 1;
+    }
+    if (read_memstat("swap_out_count") <= swap_out_count_before)
+        printf("Warning: Nothing was swapped out, the test may not have exercised anything.\n");
+
+    // If delivering the signal hangs the kernel, we never get past this.
+    if (kill(child, SIGUSR1) < 0) {
+        perror("kill");
+        return 1;
+    }
+
+    int status = 0;
+    if (waitpid(child, &status, 0) < 0) {
+        perror("waitpid");
+        return 1;
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        printf("FAIL: Child did not handle the signal (status %d)\n", status);
+        return 1;
+    }
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+struct Record {
+    int key;
+    char payload[20];
+};
+
+static int compare_ints(const void* a, const void* b)
+{
+    int x = *static_cast<const int*>(a);
+    int y = *static_cast<const int*>(b);
+    return x < y ? -1 : x > y;
+}
+
+static int compare_records(const void* a, const void* b)
+{
+    return compare_ints(&static_cast<const Record*>(a)->key, &static_cast<const Record*>(b)->key);
+}
+
+enum class Pattern {
+    Random,
+    Sorted,
+    Reversed,
+    ManyDuplicates,
+};
+
+static const char* pattern_name(Pattern pattern)
+{
+    switch (pattern) {
+    case Pattern::Random:
+        return "random";
+    case Pattern::Sorted:
+        return "sorted";
+    case Pattern::Reversed:
+        return "reversed";
+    case Pattern::ManyDuplicates:
+        return "duplicates";
+    }
+    return "?";
+}
+
+static int make_key(Pattern pattern, size_t index, size_t count)
+{
+    switch (pattern) {
+    case Pattern::Random:
+        return rand();
+    case Pattern::Sorted:
+        return (int)index;
+    case Pattern::Reversed:
+        return (int)(count - index);
+    case Pattern::ManyDuplicates:
+        return rand() % 16;
+    }
+    return 0;
+}
+
+static double elapsed_ms(const timespec& start, const timespec& end)
+{
+    return (end.tv_sec - start.tv_sec) * 1000.0 + (end.tv_nsec - start.tv_nsec) / 1000000.0;
+}
+
+template<typename T, typename GetKey>
+static bool run(const char* type_name, Pattern pattern, size_t count, int (*compare)(const void*, const void*), GetKey get_key)
+{
+    auto* elements = static_cast<T*>(calloc(count, sizeof(T)));
+    if (!elements) {
+        perror("calloc");
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i)
+        get_key(elements[i]) = make_key(pattern, i, count);
+
+    timespec start;
+    timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    qsort(elements, count, sizeof(T), compare);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    bool sorted = true;
+    for (size_t i = 1; i < count; ++i) {
+        if (get_key(elements[i - 1]) > get_key(elements[i])) {
+            sorted = false;
+            break;
+        }
+    }
+    free(elements);
+
+    printf("%-8s %-10s %8zu elements: %10.2f ms%s\n", type_name, pattern_name(pattern), count, elapsed_ms(start, end), sorted ? "" : "  NOT SORTED!");
+    return sorted;
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = 200000;
+    if (argc > 1)
+        count = strtoul(argv[1], nullptr, 10);
+
+    srand(0);
+
+    static const Pattern patterns[] = { Pattern::Random, Pattern::Sorted, Pattern::Reversed, Pattern::ManyDuplicates };
+
+    bool ok = true;
+    for (auto pattern : patterns) {
+        ok &= run<int>("int", pattern, count, compare_ints, [](int& value) -> int& { return value; });
+        ok &= run<Record>("record", pattern, count, compare_records, [](Record& record) -> int& { return record.key; });
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Measures the throughput of the LibC memory and string functions
+// across a range of sizes and source/destination alignments.
+
+static double elapsed_ms(const timespec& start, const timespec& end)
+{
+    return (end.tv_sec - start.tv_sec) * 1000.0 + (end.tv_nsec - start.tv_nsec) / 1000000.0;
+}
+
+static const size_t sizes[] = { 7, 16, 64, 256, 1024, 4096, 65536, 1048576 };
+static const size_t alignments[] = { 0, 1, 7 };
+
+static const size_t buffer_size = 1048576 + 64;
+static unsigned char* s_source;
+static unsigned char* s_destination;
+static volatile size_t s_sink;
+
+template<typename Callback>
+static void run(const char* name, size_t size, size_t alignment, Callback callback)
+{
+    // Touch roughly 256 MiB per measurement, but at least run each case a few times.
+    size_t iterations = 256 * 1048576 / size;
+    if (iterations < 16)
+        iterations = 16;
+
+    timespec start;
+    timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (size_t i = 0; i < iterations; ++i)
+        callback(size, alignment);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double ms = elapsed_ms(start, end);
+    double megabytes = (double)size * iterations / 1048576;
+    printf("%-8s %8zu bytes, alignment %zu: %10.1f MiB/s\n", name, size, alignment, ms > 0 ? megabytes * 1000 / ms : 0.0);
+}
+
+int main()
+{
+    s_source = static_cast<unsigned char*>(malloc(buffer_size));
+    s_destination = static_cast<unsigned char*>(malloc(buffer_size));
+    if (!s_source || !s_destination) {
+        perror("malloc");
+        return 1;
+    }
+    memset(s_source, 'a', buffer_size);
+    memset(s_destination, 'a', buffer_size);
+
+    for (auto size : sizes) {
+        for (auto alignment : alignments) {
+            // Terminate the strings and place the searched-for byte at the very end.
+            s_source[alignment + size - 1] = 'z';
+            s_source[alignment + size] = '\0';
+            s_destination[alignment + size - 1] = 'z';
+
+            run("memcpy", size, alignment, [](size_t size, size_t alignment) {
+                memcpy(s_destination + (alignment ^ 1), s_source + alignment, size);
+            });
+            run("memset", size, alignment, [](size_t size, size_t alignment) {
+                memset(s_destination + alignment, 'a', size);
+            });
+            s_destination[alignment + size - 1] = 'z';
+            run("memcmp", size, alignment, [](size_t size, size_t alignment) {
+                s_sink = memcmp(s_destination + alignment, s_source + alignment, size);
+            });
+            run("memchr", size, alignment, [](size_t size, size_t alignment) {
+                s_sink = (size_t)memchr(s_source + alignment, 'z', size);
+            });
+            run("strlen", size, alignment, [](size_t, size_t alignment) {
+                s_sink = strlen((const char*)s_source + alignment);
+            });
+            run("strchr", size, alignment, [](size_t, size_t alignment) {
+                s_sink = (size_t)strchr((const char*)s_source + alignment, 'z');
+            });
+
+            s_source[alignment + size - 1] = 'a';
+            s_source[alignment + size] = 'a';
+        }
+    }
+
+    free(s_source);
+    free(s_destination);
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/MappedFile.h>
+#include <AK/StringView.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Measures how fast LibJS tokenizes and parses the scripts given on the command line.
+// Each file is processed several times and the fastest run is reported, so the numbers
+// reflect the lexer and parser rather than page faults on the first read.
+
+static double elapsed_seconds(const timespec& start, const timespec& end)
+{
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1000000000.0;
+}
+
+template<typename Callback>
+static double fastest_run(int iterations, Callback callback)
+{
+    double fastest = 0;
+    for (int i = 0; i < iterations; ++i) {
+        timespec start;
+        timespec end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        callback();
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        auto seconds = elapsed_seconds(start, end);
+        if (i == 0 || seconds < fastest)
+            fastest = seconds;
+    }
+    return fastest;
+}
+
+static double megabytes_per_second(size_t bytes, double seconds)
+{
+    if (seconds <= 0)
+        return 0;
+    return bytes / seconds / (1024 * 1024);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s [-n iterations] <script.js>...\n", argv[0]);
+        return 1;
+    }
+
+    int iterations = 10;
+    int first_file = 1;
+    if (argc > 3 && !strcmp(argv[1], "-n")) {
+        iterations = max(1, atoi(argv[2]));
+        first_file = 3;
+    }
+
+    size_t total_bytes = 0;
+    double total_lex_seconds = 0;
+    double total_parse_seconds = 0;
+    bool ok = true;
+
+    printf("%-40s %10s %8s %12s %12s\n", "script", "bytes", "tokens", "lex MB/s", "parse MB/s");
+    for (int i = first_file; i < argc; ++i) {
+        MappedFile file(argv[i]);
+        if (!file.is_valid()) {
+            perror(argv[i]);
+            ok = false;
+            continue;
+        }
+        StringView source(static_cast<const char*>(file.data()), file.size());
+
+        size_t token_count = 0;
+        auto lex_seconds = fastest_run(iterations, [&] {
+            token_count = 0;
+            JS::Lexer lexer(source);
+            while (lexer.next().type() != JS::TokenType::Eof)
+                ++token_count;
+        });
+
+        bool has_errors = false;
+        auto parse_seconds = fastest_run(iterations, [&] {
+            JS::Parser parser { JS::Lexer(source) };
+            parser.parse_program();
+            has_errors = parser.has_errors();
+        });
+
+        printf("%-40s %10zu %8zu %12.2f %12.2f%s\n", argv[i], source.length(), token_count,
+            megabytes_per_second(source.length(), lex_seconds),
+            megabytes_per_second(source.length(), parse_seconds),
+            has_errors ? "  (syntax errors)" : "");
+
+        total_bytes += source.length();
+        total_lex_seconds += lex_seconds;
+        total_parse_seconds += parse_seconds;
+    }
+
+    printf("%-40s %10zu %8s %12.2f %12.2f\n", "total", total_bytes, "",
+        megabytes_per_second(total_bytes, total_lex_seconds),
+        megabytes_per_second(total_bytes, total_parse_seconds));
+    return ok ? 0 : 1;
+}
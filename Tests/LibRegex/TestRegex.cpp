@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/TestSuite.h>
+
+#include <AK/StringBuilder.h>
+#include <LibRegex/LazyDFA.h>
+#include <LibRegex/Parser.h>
+#include <LibRegex/Pattern.h>
+
+using namespace Regex;
+
+// Joins the whole match and the captures, with U for captures that didn't take part in the match.
+static String captures(const StringView& pattern, const StringView& input, Options options = {})
+{
+    Pattern compiled(pattern, options);
+    ASSERT(!compiled.has_error());
+    auto match = compiled.search(input);
+    if (!match.has_value())
+        return "null";
+    StringBuilder builder;
+    for (size_t i = 0; i < match.value().captures.size(); ++i) {
+        if (i)
+            builder.append(',');
+        auto& capture = match.value().captures[i];
+        if (capture.has_value())
+            builder.append(input.substring_view(capture.value().start, capture.value().length()));
+        else
+            builder.append('U');
+    }
+    return builder.to_string();
+}
+
+static bool compile(const StringView& pattern, Program& program)
+{
+    Parser parser(pattern, {});
+    return parser.parse(program);
+}
+
+static size_t count_ops(const Program& program, OpCode op)
+{
+    size_t count = 0;
+    for (auto& instruction : program.instructions) {
+        if (instruction.op == op)
+            ++count;
+    }
+    return count;
+}
+
+static bool dfa_has_match(const StringView& pattern, const StringView& input)
+{
+    Program program;
+    EXPECT(compile(pattern, program));
+    EXPECT(LazyDFA::can_handle(program));
+    LazyDFA dfa(program);
+    auto result = dfa.has_match(input, 0);
+    EXPECT(result.has_value());
+    return result.value();
+}
+
+TEST_CASE(parser_errors)
+{
+    Program program;
+    EXPECT(!compile("a**", program));
+    EXPECT(!compile("(a", program));
+    EXPECT(!compile("a)", program));
+    EXPECT(!compile("a{2,1}", program));
+    EXPECT(!compile("(?<a>x)\\k<b>", program));
+    EXPECT(!compile("(?<=a", program));
+    EXPECT(compile("a{2,}?", program));
+}
+
+TEST_CASE(parser_backtracking)
+{
+    // Only patterns that need it are left to the backtracker, the rest keep the linear-time engines.
+    Program plain;
+    EXPECT(compile("(a)[\\1]\\2\\8\\k", plain));
+    EXPECT(!plain.needs_backtracking);
+    EXPECT(LazyDFA::can_handle(plain));
+
+    Program backreference;
+    EXPECT(compile("\\1(a)", backreference));
+    EXPECT(backreference.needs_backtracking);
+    EXPECT(!LazyDFA::can_handle(backreference));
+
+    Program lookbehind;
+    EXPECT(compile("(?<=a)b", lookbehind));
+    EXPECT(lookbehind.needs_backtracking);
+    EXPECT_EQ(count_ops(lookbehind, OpCode::BackwardClass), 1u);
+}
+
+TEST_CASE(parser_repeat_encoding)
+{
+    // An atom that always consumes input is repeated as is.
+    Program program;
+    EXPECT(compile("(?:ab)*", program));
+    EXPECT_EQ(count_ops(program, OpCode::Fail), 0u);
+    EXPECT_EQ(count_ops(program, OpCode::ClearCaptures), 0u);
+
+    // One that may not gets a copy for the iterations that must consume something.
+    Program nullable;
+    EXPECT(compile("(?:a|)*", nullable));
+    EXPECT_EQ(count_ops(nullable, OpCode::Fail), 1u);
+
+    Program with_captures;
+    EXPECT(compile("(a)+", with_captures));
+    EXPECT_EQ(count_ops(with_captures, OpCode::ClearCaptures), 1u);
+    EXPECT_EQ(with_captures.capture_group_count, 1u);
+}
+
+TEST_CASE(pike_vm_basic)
+{
+    EXPECT_EQ(captures("b+", "aabbbc"), "bbb");
+    EXPECT_EQ(captures("(a|ab)(c|bcd)(d*)", "abcd"), "abcd,a,bcd,");
+    EXPECT_EQ(captures("a+?", "aaa"), "a");
+    EXPECT_EQ(captures("x", "abc"), "null");
+    EXPECT_EQ(captures("^b", "a\nb", { false, true, false }), "b");
+
+    Pattern anchored("b");
+    EXPECT(!anchored.match_at("ab", 0).has_value());
+    EXPECT(anchored.match_at("ab", 1).has_value());
+}
+
+TEST_CASE(pike_vm_empty_iterations)
+{
+    EXPECT_EQ(captures("((?:^|[a-c].)?)", "b.b1_.", { true, false, false }), "b.,b.");
+    EXPECT_EQ(captures("(((?:^|\\s))+)", " x", { false, true, false }), " , , ");
+    EXPECT_EQ(captures("(a?){2,4}b", "aab"), "aab,a");
+    EXPECT_EQ(captures("(a*)*", "b"), ",U");
+    EXPECT_EQ(captures("(a*)+", "b"), ",");
+    EXPECT_EQ(captures("(?:a|())*", "aab"), "aa,U");
+    EXPECT_EQ(captures("(.*?)(a|)+$", "baa"), "baa,b,a");
+}
+
+TEST_CASE(pike_vm_captures_reset_per_iteration)
+{
+    EXPECT_EQ(captures("(?:((x)?))?.", "x"), "x,U,U");
+    EXPECT_EQ(captures("(^|a|\\.[a-c])?.", "a"), "a,U");
+    EXPECT_EQ(captures("(?:(a)|b)+", "ab"), "ab,U");
+    EXPECT_EQ(captures("(?:(a)|(b))*", "abab"), "abab,U,b");
+    EXPECT_EQ(captures("(z)((a+)?(b+)?(c))*", "zaacbbbcac"), "zaacbbbcac,z,ac,a,U,c");
+}
+
+TEST_CASE(pike_vm_repeated_empty_matches)
+{
+    // What String.prototype.replace with the g flag sees: the next search starts after a non-empty match.
+    Pattern pattern("(?:(?:((a)?\?)+?){1,2})");
+    auto first = pattern.search("a", 0);
+    EXPECT(first.has_value());
+    EXPECT_EQ(first.value().range().start, 0u);
+    EXPECT_EQ(first.value().range().end, 1u);
+    auto second = pattern.search("a", 1);
+    EXPECT(second.has_value());
+    EXPECT_EQ(second.value().range().length(), 0u);
+}
+
+TEST_CASE(backtracker_backreferences)
+{
+    EXPECT_EQ(captures("(a)\\1", "xaab"), "aa,a");
+    EXPECT_EQ(captures("(\\w+)\\s+\\1", "hello world world"), "world world,world");
+    EXPECT_EQ(captures("(?<quote>['\"]).*?\\k<quote>", "say 'hi'"), "'hi','");
+    EXPECT_EQ(captures("\\1(a)", "aa"), "a,a");
+    EXPECT_EQ(captures("(?:(a)|b)\\1c", "bc"), "bc,U");
+    EXPECT_EQ(captures("(A)\\1", "aA", { true, false, false }), "aA,a");
+    EXPECT_EQ(captures("(a*)+\\1b", "aaab"), "aaab,a");
+}
+
+TEST_CASE(backtracker_lookaround)
+{
+    EXPECT_EQ(captures("foo(?=bar)", "foobaz foobar"), "foo");
+    EXPECT_EQ(captures("foo(?!bar)", "foobar foobaz"), "foo");
+    EXPECT_EQ(captures("(?=(a+))a*b\\1", "baaabac"), "aba,a");
+    EXPECT_EQ(captures("(?!(a))b\\1", "ab"), "b,U");
+    EXPECT_EQ(captures("(?<=\\$)\\d+", "cost: $42"), "42");
+    EXPECT_EQ(captures("(?<!\\$)\\b\\d+", "$42 17"), "17");
+
+    // Lookbehinds match right to left, so greedy quantifiers in them take as much as they can to the left.
+    EXPECT_EQ(captures("(?<=(\\d+)(\\d+))$", "1053"), ",1,053");
+    EXPECT_EQ(captures("(?<=(a+?))b", "aaab"), "b,a");
+    EXPECT_EQ(captures("(?<=\\1(a))b", "aab"), "b,a");
+    EXPECT_EQ(captures("(?<!a(b))c", "abc xbc"), "c,U");
+}
+
+TEST_CASE(lazy_dfa)
+{
+    EXPECT(dfa_has_match("b+c", "aabbbc"));
+    EXPECT(!dfa_has_match("b+c", "aabbb"));
+    EXPECT(dfa_has_match("a$", "ba"));
+    EXPECT(!dfa_has_match("^a", "ba"));
+    EXPECT(dfa_has_match("(?:a|)*b", "aab"));
+    EXPECT(dfa_has_match("(?:|a)+$", "aaa"));
+    EXPECT(!dfa_has_match("(?:(?:|a)?){2}b", "aac"));
+    EXPECT(dfa_has_match("(?:(?:|a)?){2}b", "aab"));
+}
+
+TEST_MAIN(Regex)
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <AK/String.h>
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
+#include <LibCore/ArgsParser.h>
+#include <LibRegex/Pattern.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static bool invert_match = false;
+static bool count_only = false;
+static bool print_line_numbers = false;
+
+static String escape_fixed_string(const StringView& string)
+{
+    StringBuilder builder;
+    for (auto ch : string) {
+        if (strchr("\\^$.|?*+()[]{}", ch))
+            builder.append('\\');
+        builder.append(ch);
+    }
+    return builder.to_string();
+}
+
+// Returns the number of selected lines, or -1 if the file couldn't be opened.
+static int grep_file(const Regex::Pattern& pattern, const char* path, const char* display_name)
+{
+    FILE* file = stdin;
+    if (strcmp(path, "-") != 0) {
+        file = fopen(path, "r");
+        if (!file) {
+            fprintf(stderr, "grep: %s: %s\n", path, strerror(errno));
+            return -1;
+        }
+    }
+
+    int selected_lines = 0;
+    size_t line_number = 0;
+    char* line = nullptr;
+    size_t line_capacity = 0;
+    ssize_t line_length;
+    while ((line_length = getline(&line, &line_capacity, file)) >= 0) {
+        ++line_number;
+        StringView line_view(line, line_length);
+        if (line_view.ends_with('\n'))
+            line_view = line_view.substring_view(0, line_view.length() - 1);
+
+        if (pattern.has_match(line_view) == invert_match)
+            continue;
+        ++selected_lines;
+        if (count_only)
+            continue;
+        if (display_name)
+            printf("%s:", display_name);
+        if (print_line_numbers)
+            printf("%zu:", line_number);
+        fwrite(line_view.characters_without_null_termination(), 1, line_view.length(), stdout);
+        putchar('\n');
+    }
+    free(line);
+
+    if (count_only) {
+        if (display_name)
+            printf("%s:", display_name);
+        printf("%d\n", selected_lines);
+    }
+
+    if (file != stdin)
+        fclose(file);
+    return selected_lines;
+}
+
+int main(int argc, char** argv)
+{
+    bool ignore_case = false;
+    bool fixed_strings = false;
+    bool extended_syntax = false;
+    const char* pattern_string = nullptr;
+    Vector<const char*> files;
+
+    Core::ArgsParser args_parser;
+    args_parser.add_option(ignore_case, "Ignore case distinctions", "ignore-case", 'i');
+    args_parser.add_option(invert_match, "Select non-matching lines", "invert-match", 'v');
+    args_parser.add_option(count_only, "Only print a count of selected lines", "count", 'c');
+    args_parser.add_option(print_line_numbers, "Prefix each line with its line number", "line-number", 'n');
+    args_parser.add_option(fixed_strings, "Treat the pattern as a fixed string", "fixed-strings", 'F');
+    args_parser.add_option(extended_syntax, "Treat the pattern as an extended regular expression (the default)", "extended-regexp", 'E');
+    args_parser.add_positional_argument(pattern_string, "Pattern to search for", "pattern");
+    args_parser.add_positional_argument(files, "Files to search", "file", Core::ArgsParser::Required::No);
+    args_parser.parse(argc, argv);
+
+    Regex::Options options;
+    options.ignore_case = ignore_case;
+    String source = fixed_strings ? escape_fixed_string(pattern_string) : String(pattern_string);
+    Regex::Pattern pattern(source, options);
+    if (pattern.has_error()) {
+        fprintf(stderr, "grep: %s\n", pattern.error().characters());
+        return 2;
+    }
+
+    if (files.is_empty())
+        files.append("-");
+
+    bool had_error = false;
+    bool had_match = false;
+    for (auto* path : files) {
+        const char* display_name = nullptr;
+        if (files.size() > 1)
+            display_name = strcmp(path, "-") == 0 ? "(standard input)" : path;
+        int selected_lines = grep_file(pattern, path, display_name);
+        if (selected_lines < 0)
+            had_error = true;
+        else if (selected_lines > 0)
+            had_match = true;
+    }
+
+    if (had_error)
+        return 2;
+    return had_match ? 0 : 1;
+}
@@ -24,15 +24,12 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <AK/JsonArray.h>
-#include <AK/JsonObject.h>
-#include <AK/JsonValue.h>
-#include <AK/StringBuilder.h>
+#include <AK/JsonPullParser.h>
 #include <LibCore/File.h>
 #include <stdio.h>
 #include <unistd.h>
 
-static void print(const JsonValue& value, int indent = 0);
+static void print(JsonPullParser&, int indent = 0);
 static void print_indent(int indent)
 {
     for (int i = 0; i < indent; ++i)
@@ -62,51 +59,66 @@ int main(int argc, char** argv)
     }
 
     auto file_contents = file->read_all();
-    auto json = JsonValue::from_string(file_contents);
-
-    print(json);
+    JsonPullParser parser(file_contents);
+    parser.next();
+    print(parser);
     printf("\n");
 
+    if (parser.has_error() || parser.next() != JsonPullParser::Token::EndOfInput) {
+        fprintf(stderr, "jp: Failed to parse %s\n", argv[1]);
+        return 1;
+    }
+
     return 0;
 }
 
-void print(const JsonValue& value, int indent)
+// Prints the value starting at the parser's current token, without ever
+// building a tree of the whole document.
+void print(JsonPullParser& parser, int indent)
 {
-    if (value.is_object()) {
+    using Token = JsonPullParser::Token;
+    switch (parser.token()) {
+    case Token::BeginObject:
         printf("{\n");
-        value.as_object().for_each_member([&](auto& member_name, auto& member_value) {
+        while (parser.next() == Token::Key) {
             print_indent(indent + 1);
-            printf("\"\033[33;1m%s\033[0m\": ", member_name.characters());
-            print(member_value, indent + 1);
+            auto member_name = parser.string();
+            printf("\"\033[33;1m%.*s\033[0m\": ", (int)member_name.length(), member_name.characters_without_null_termination());
+            parser.next();
+            print(parser, indent + 1);
             printf(",\n");
-        });
+        }
         print_indent(indent);
         printf("}");
         return;
-    }
-    if (value.is_array()) {
+    case Token::BeginArray:
         printf("[\n");
-        value.as_array().for_each([&](auto& entry_value) {
+        while (parser.next() != Token::EndArray && !parser.has_error()) {
             print_indent(indent + 1);
-            print(entry_value, indent + 1);
+            print(parser, indent + 1);
             printf(",\n");
-        });
+        }
         print_indent(indent);
         printf("]");
         return;
+    case Token::String: {
+        auto string = parser.string();
+        printf("\033[31;1m\"%.*s\"\033[0m", (int)string.length(), string.characters_without_null_termination());
+        return;
     }
-    if (value.is_string())
-        printf("\033[31;1m");
-    else if (value.is_number())
+    case Token::Number:
         printf("\033[35;1m");
-    else if (value.is_bool())
+        break;
+    case Token::True:
+    case Token::False:
         printf("\033[32;1m");
-    else if (value.is_null() || value.is_undefined())
+        break;
+    case Token::Null:
+    case Token::Undefined:
         printf("\033[34;1m");
-    if (value.is_string())
-        putchar('"');
-    printf("%s", value.to_string().characters());
-    if (value.is_string())
-        putchar('"');
-    printf("\033[0m");
+        break;
+    default:
+        return;
+    }
+    printf("%s\033[0m", parser.to_string().characters());
 }
@@ -30,6 +30,7 @@
 #include <LibCore/ArgsParser.h>
 #include <LibCore/File.h>
 #include <LibJS/AST.h>
+#include <LibJS/Bytecode/Block.h>
 #include <LibJS/Console.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Parser.h>
@@ -66,6 +67,7 @@ private:
 };
 
 static bool s_dump_ast = false;
+static bool s_dump_bytecode = false;
 static bool s_print_last_result = false;
 static RefPtr<Line::Editor> s_editor;
 static int s_repl_line_level = 0;
@@ -340,6 +342,9 @@ bool parse_and_run(JS::Interpreter& interpreter, const StringView& source)
     if (s_dump_ast)
         program->dump(0);
 
+    if (s_dump_bytecode && !parser.has_errors())
+        program->bytecode().dump();
+
     if (parser.has_errors()) {
         auto error = parser.errors()[0];
         auto hint = error.source_location_hint(source);
@@ -549,10 +554,13 @@ int main(int argc, char** argv)
     bool gc_on_every_allocation = false;
     bool disable_syntax_highlight = false;
     bool test_mode = false;
+    bool use_bytecode = false;
     const char* script_path = nullptr;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
+    args_parser.add_option(s_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(use_bytecode, "Run with the bytecode interpreter", "bytecode", 'b');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
@@ -575,6 +583,7 @@ int main(int argc, char** argv)
         ReplConsoleClient console_client(interpreter->console());
         interpreter->console().set_client(console_client);
         interpreter->heap().set_should_collect_on_every_allocation(gc_on_every_allocation);
+        interpreter->set_bytecode_enabled(use_bytecode);
         if (test_mode)
             enable_test_mode(*interpreter);
 
@@ -857,6 +866,7 @@ int main(int argc, char** argv)
         ReplConsoleClient console_client(interpreter->console());
         interpreter->console().set_client(console_client);
         interpreter->heap().set_should_collect_on_every_allocation(gc_on_every_allocation);
+        interpreter->set_bytecode_enabled(use_bytecode);
         if (test_mode)
             enable_test_mode(*interpreter);
 